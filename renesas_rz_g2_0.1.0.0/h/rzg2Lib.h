@@ -32,6 +32,14 @@
 /*
 modification history
 --------------------
+19oct26,agt  documented the lock statistics argument
+19oct26,agt  resume through a BSP CPU context routine, removed
+             rzg2SystemResume()
+19oct26,agt  added buffered debug console mode
+19oct26,agt  added optional lock statistics
+19oct26,agt  added system suspend support
+19oct26,agt  added RZG2_REG_READ32() and RZG2_REG_WRITE32()
+19oct26,agt  added rzg2TimestampGet() and rzg2TimestampFreqGet()
 17sep19,hli  created (VXWPG-394)
 */
 
@@ -39,6 +47,7 @@ modification history
 #define __INCrzg2Libh
 
 #include <vxWorks.h>
+#include <semLib.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -52,6 +61,74 @@ extern "C" {
 #define RZ_G2_PRODUCT(id)         (((id) & 0x7F00U) >> 8)
 #define RZ_G2_CUT(id)             (((id) & 0x00FFU))
 
+/*
+ * Register accessors of the RZ/G2 drivers. These are the VxBus accessors
+ * unless defined before this file is included, as by the host build in
+ * test/host, which runs the drivers against a model of their register files.
+ */
+
+#ifndef RZG2_REG_READ32
+#define RZG2_REG_READ32(handle, pReg)       vxbRead32 ((handle), (pReg))
+#endif
+
+#ifndef RZG2_REG_WRITE32
+#define RZG2_REG_WRITE32(handle, pReg, val) vxbWrite32 ((handle), (pReg), (val))
+#endif
+
+/*
+ * Lock statistics of the RZ/G2 drivers. If RZG2_LOCK_STATS is defined, here or
+ * on the compiler command line, the instrumented register lock paths of the
+ * drivers record, for each class of register, how often the lock is taken, how
+ * often it is already held by another task, and the wait and hold times in
+ * rzg2TimestampGet() ticks. Otherwise the locks are taken directly, and the
+ * <pStats> and <takeTime> arguments are not evaluated. A caller finds the
+ * statistics of the class once, before the take, so that the lookup is not
+ * counted as hold time. RZG2_LOCK_TAKE() stores the time the lock was taken in
+ * the caller's UINT64 <takeTime>, which the caller passes, with the same
+ * statistics, to RZG2_LOCK_GIVE().
+ */
+
+#ifdef RZG2_LOCK_STATS
+#define RZG2_LOCK_TAKE(semId, pStats, takeTime) \
+    ((takeTime) = rzg2LockStatsTake ((semId), (pStats)))
+#define RZG2_LOCK_GIVE(semId, pStats, takeTime) \
+    rzg2LockStatsGive ((semId), (pStats), (takeTime))
+#else
+#define RZG2_LOCK_TAKE(semId, pStats, takeTime) \
+    (void)semTake ((semId), WAIT_FOREVER)
+#define RZG2_LOCK_GIVE(semId, pStats, takeTime) \
+    (void)semGive ((semId))
+#endif /* RZG2_LOCK_STATS */
+
+/* maximum number of system suspend hooks */
+
+#define RZG2_SUSPEND_HOOKS_MAX    8
+
+/* typedefs */
+
+/* system suspend save or resume restore hook, called with its <pArg> */
+
+typedef STATUS (*RZG2_SUSPEND_HOOK) (void * pArg);
+
+/*
+ * BSP CPU context save routine: returns 0 when the context is saved, and
+ * returns again, with a non-zero value, when the BSP resume code restores it
+ */
+
+typedef int (*RZG2_CPU_CTX_SAVE) (ULONG contextId);
+
+/* statistics of one lock class, updated while the lock is held */
+
+typedef struct rzg2LockStats
+    {
+    UINT32          acquires;       /* times taken */
+    UINT32          contended;      /* times held by another task */
+    UINT64          waitTotal;      /* sum of wait times */
+    UINT64          waitMax;        /* longest wait */
+    UINT64          holdTotal;      /* sum of hold times */
+    UINT64          holdMax;        /* longest hold */
+    } RZG2_LOCK_STAT;
+
 /* function declarations */
 
 IMPORT BOOL    rzg2Probe         (char * boardCompatibility);
@@ -66,6 +143,21 @@ IMPORT STATUS  rzg2CpuEnable     (unsigned cpuId, WIND_CPU_STATE * cpuState);
 #endif
 
 IMPORT UINT32  rzg2ProductIdGet (void);
+IMPORT UINT64  rzg2TimestampGet (void);
+IMPORT UINT32  rzg2TimestampFreqGet (void);
+IMPORT STATUS  rzg2SuspendHookAdd (RZG2_SUSPEND_HOOK saveRtn,
+                                   RZG2_SUSPEND_HOOK restoreRtn, void * pArg);
+IMPORT STATUS  rzg2SystemSuspend (RZG2_CPU_CTX_SAVE ctxSave,
+                                  PHYS_ADDR resumeEntry, ULONG contextId);
+IMPORT UINT64  rzg2ResumeTicksGet (void);
+IMPORT UINT64  rzg2LockStatsTake (SEM_ID semId, RZG2_LOCK_STAT * pStats);
+IMPORT void    rzg2LockStatsGive (SEM_ID semId, RZG2_LOCK_STAT * pStats,
+                                  UINT64 takeTime);
+IMPORT void    rzg2LockStatsShow (const char * pName,
+                                  const RZG2_LOCK_STAT * pStats);
+IMPORT STATUS  rzg2DebugRingStart (UINT32 ringSize, int priority);
+IMPORT void    rzg2DebugRingFlush (void);
+IMPORT void    rzg2DebugRingShow (void);
 
 #ifdef __cplusplus
 }
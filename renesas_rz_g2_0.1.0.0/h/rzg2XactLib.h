@@ -0,0 +1,100 @@
+/* rzg2XactLib.h - Renesas RZ/G2 clock and pin transaction library header */
+
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1) Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2) Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3) Neither the name of Wind River Systems nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+modification history
+--------------------
+19oct26,agt  created
+*/
+
+#ifndef __INCrzg2XactLibh
+#define __INCrzg2XactLibh
+
+#include <vxbFdtRsRzg2CpgMssr.h>
+#include <vxbFdtRsRzg2PfcPinMux.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* defines */
+
+#define RZG2_XACT_STEPS_MAX     16      /* steps in one transaction */
+
+/* typedefs */
+
+/* transaction step operations, in the order they are committed */
+
+typedef enum rzg2XactOp
+    {
+    RZG2_XACT_CLK_OFF,          /* gate a module clock */
+    RZG2_XACT_POC,              /* switch the signalling voltage of SD pads */
+    RZG2_XACT_CLK_RATE,         /* set the rate of a CPG divider clock */
+    RZG2_XACT_PFC_PROFILE,      /* apply a PFC drive and bias profile */
+    RZG2_XACT_CLK_ON            /* ungate a module clock */
+    } RZG2_XACT_OP;
+
+typedef struct rzg2XactStep
+    {
+    RZG2_XACT_OP        op;         /* operation */
+    VXB_CLK_ID          pClk;       /* clock of the clock operations */
+    UINT64              value;      /* clock rate, or voltage in mv */
+    UINT64              prevValue;  /* value replaced, for rollback */
+    UINT32              pocSel;     /* POC_SD0 or POC_SD3 */
+    RZG2_PFC_PROFILE    profile;    /* PFC drive and bias profile */
+    } RZG2_XACT_STEP;
+
+typedef struct rzg2Xact
+    {
+    UINT32              numSteps;   /* steps added */
+    BOOL                invalid;    /* a step could not be added */
+    UINT64              ticks;      /* duration of the last commit */
+    RZG2_XACT_STEP      steps [RZG2_XACT_STEPS_MAX];
+    } RZG2_XACT;
+
+/* function declarations */
+
+IMPORT void    rzg2XactInit         (RZG2_XACT * pXact);
+IMPORT STATUS  rzg2XactClkGate      (RZG2_XACT * pXact, VXB_CLK_ID pClk,
+                                     BOOL enable);
+IMPORT STATUS  rzg2XactClkRateSet   (RZG2_XACT * pXact, VXB_CLK_ID pClk,
+                                     UINT64 rate);
+IMPORT STATUS  rzg2XactPocSet       (RZG2_XACT * pXact, UINT32 pocSel,
+                                     UINT32 mv);
+IMPORT STATUS  rzg2XactProfileSet   (RZG2_XACT * pXact,
+                                     RZG2_PFC_PROFILE profile);
+IMPORT STATUS  rzg2XactCommit       (RZG2_XACT * pXact);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __INCrzg2XactLibh */
@@ -32,12 +32,18 @@
 /*
 modification history
 --------------------
+19oct26,agt  added rzg2CpgLockStatsShow()
+19oct26,agt  added rzg2CpgClkRatesSet()
+19oct26,agt  added rzg2CpgClkTreeShow()
+19oct26,agt  added Z clock frequency change definitions and DVFS API
 17sep19,hli  created (VXWPG-394)
 */
 
 #ifndef __INCvxbFdtRsRzg2CpgMssrh
 #define __INCvxbFdtRsRzg2CpgMssrh
 
+#include <subsys/clk/vxbClkLib.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -81,6 +87,8 @@ extern "C" {
 
 /* frequency contol register B */
 
+#define FRQCRB_KICK          (1U << 31)
+
 #define FRQCRB_ZTRFC_SHIFT   20
 #define FRQCRB_ZTRFC_MASK    (0x0FU << FRQCRB_ZTRFC_SHIFT)
 #define FRQCRB_ZTRFC(bits)   (((bits) & FRQCRB_ZTRFC_MASK) >> FRQCRB_ZTRFC_SHIFT)
@@ -108,6 +116,10 @@ extern "C" {
 #define FRQCRC_Z2FC_MASK     (0x01FU << FRQCRC_Z2FC_SHIFT)
 #define FRQCRC_Z2FC(bits)    (((bits) & FRQCRC_Z2FC_MASK) >> FRQCRC_Z2FC_SHIFT)
 
+/* Z clock multiplier is (32 - ZFC) / 32, giving 1/32 to 32/32 of the parent */
+
+#define FRQCRC_ZxFC_MULT_MAX 32U
+
 /* PLL enable control and status */
 
 #define PLLECR_PLL0ST        (1U << 8)
@@ -125,12 +137,13 @@ extern "C" {
 /* SD-IFn clock frequency control registers */
 
 #define SDnCKCR_SDnSRCFC_SHIFT       2
-#define SDnCKCR_SDnSRCFC_MASK        (0x01CU << SDnCKCR_SDnSRCFC_SHIFT)
+#define SDnCKCR_SDnSRCFC_MASK        (0x07U << SDnCKCR_SDnSRCFC_SHIFT)
 #define SDnCKCR_SDnSRCFC(bits)       (((bits) & SDnCKCR_SDnSRCFC_MASK) >> \
                                       SDnCKCR_SDnSRCFC_SHIFT)
 #define SDnCKCR_SDnSRCFC_VALID_MAX   4U
 
-#define SDnCKCR_SDnFC(bits)          ((bits) & 0x03U)
+#define SDnCKCR_SDnFC_MASK           0x03U
+#define SDnCKCR_SDnFC(bits)          ((bits) & SDnCKCR_SDnFC_MASK)
 #define SDnCKCR_SDnFC_VALID_MAX      2U
 
 #define SDnCKCR_STPnHCK              (1U << 9)
@@ -156,7 +169,8 @@ extern "C" {
 /* clock frequency control registers */
 
 #define CKCR_CKSTP          (1U << 8)
-#define CKCR_DIV(bits)      ((bits) & 0x03FU)
+#define CKCR_DIV_MASK       0x03FU
+#define CKCR_DIV(bits)      ((bits) & CKCR_DIV_MASK)
 
 /* module stop standby reset register offsets */
 
@@ -196,6 +210,16 @@ extern "C" {
 #define TMU_ALL_MSTP    (TMU0_MSTP125 | TMU1_MSTP124 | TMU2_MSTP123 | \
                          TMU3_MSTP122 | TMU4_MSTP121)
 
+/* function declarations */
+
+IMPORT STATUS  rzg2CpgDvfsZClkSet   (UINT64 zRate, UINT64 z2Rate);
+IMPORT STATUS  rzg2CpgClkRatesSet   (VXB_CLK_ID * pClks, const UINT64 * pRates,
+                                     UINT32 count);
+IMPORT void    rzg2CpgDvfsShow      (void);
+IMPORT void    rzg2CpgLockStatsShow (void);
+IMPORT STATUS  rzg2CpgPreEnableRelease (void);
+IMPORT void    rzg2CpgClkTreeShow   (BOOL csvFormat);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -32,12 +32,26 @@
 /*
 modification history
 --------------------
+19oct26,agt  added rzg2PfcLockStatsShow()
+19oct26,agt  added rzg2PfcProfilesRestore() and rzg2PfcPocVoltageGet()
+19oct26,agt  added HSCIF0/1, MSIOF0, RPC and CAN-FD0 pins, fixed
+             IPSR_RX2_A
+19oct26,agt  added drive and bias profiles
+19oct26,agt  added rzg2PfcPinStateCsvWrite()
+19oct26,agt  added pin handles and GPIO switching
+19oct26,agt  added POC voltage switching
+19oct26,agt  added PFC boot program
+19oct26,agt  widened DRVCTRL register field, added SCIF1_B and SCIF3/4/5 pads
+19oct26,agt  added rzg2PfcPinOwnerShow()
+19oct26,agt  added rzg2PfcPinStateSet()
 17sep19,hli  created (VXWPG-394)
 */
 
 #ifndef __INCvxbFdtRsRzg2PfcPinMuxh
 #define __INCvxbFdtRsRzg2PfcPinMuxh
 
+#include <hwif/vxBus.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -97,6 +111,7 @@ extern "C" {
 #define GPSR_REG(regPin)        ((regPin) >> 8)
 #define GPSR_MASK(regPin)       (1U << ((regPin) & 0x01FU))
 #define GPSR_NONE               0xFFFFFFFFU
+#define RZG2_PFC_PIN_NONE       GPSR_NONE   /* invalid pin handle */
 
 /* peripheral function select registers */
 
@@ -206,9 +221,11 @@ extern "C" {
 
 #define IPSR_RD                         IPSR_REG_POS (4U, 24U)
 #define IPSR_RX3_A                      IPSR_REG_POS (4U, 24U)
+#define IPSR_CANFD0_TX_A                IPSR_REG_POS (4U, 24U)
 
 #define IPSR_RD_WR                      IPSR_REG_POS (4U, 28U)
 #define IPSR_TX3_A                      IPSR_REG_POS (4U, 28U)
+#define IPSR_CANFD0_RX_A                IPSR_REG_POS (4U, 28U)
 
 /* peripheral function select register 5 */
 
@@ -313,17 +330,24 @@ extern "C" {
 #define IPSR_SCK5_B                     IPSR_REG_POS (11U, 24U)
 
 #define IPSR_RX0                        IPSR_REG_POS (11U, 28U)
+#define IPSR_HRX1_B                     IPSR_REG_POS (11U, 28U)
 
 /* peripheral function select register 12 */
 
 #define IPSR_TX0                        IPSR_REG_POS (12U, 0U)
+#define IPSR_HTX1_B                     IPSR_REG_POS (12U, 0U)
+
 #define IPSR_CTS0                       IPSR_REG_POS (12U, 4U)
 
 #define IPSR_RTS0                       IPSR_REG_POS (12U, 8U)
 #define IPSR_SCL2_A                     IPSR_REG_POS (12U, 8U)
 
 #define IPSR_RX1_A                      IPSR_REG_POS (12U, 12U)
+#define IPSR_HRX1_A                     IPSR_REG_POS (12U, 12U)
+
 #define IPSR_TX1_A                      IPSR_REG_POS (12U, 16U)
+#define IPSR_HTX1_A                     IPSR_REG_POS (12U, 16U)
+
 #define IPSR_CTS1                       IPSR_REG_POS (12U, 20U)
 #define IPSR_RTS1                       IPSR_REG_POS (12U, 24U)
 
@@ -336,7 +360,7 @@ extern "C" {
 #define IPSR_SD2_CD_B                   IPSR_REG_POS (13U, 0U)
 #define IPSR_SCL1_A                     IPSR_REG_POS (13U, 0U)
 
-#define IPSR_RX2_A                      IPSR_REG_POS (12U, 4U)
+#define IPSR_RX2_A                      IPSR_REG_POS (13U, 4U)
 #define IPSR_SD2_WP_B                   IPSR_REG_POS (13U, 4U)
 #define IPSR_SDA1_A                     IPSR_REG_POS (13U, 4U)
 
@@ -421,14 +445,32 @@ extern "C" {
 #define DRVCTRL_H_MASK          7U      /* 3 bits for H type buffers */
 #define DRVCTRL_F_MASK          3U      /* 2 bits for F type buffers */
 
+/* the register field holds DRVCTRL0 to DRVCTRL24, so it is 8 bits wide */
+
 #define DRVCTRL_REG_POS_MASK(reg, pos, mask) \
-                                (((mask) << 12) | ((reg) << 8) | (pos))
+                                (((mask) << 16) | ((reg) << 8) | (pos))
 
-#define DRVCTRL_BITMASK(rpm)    (((rpm) >> 12) & 0x0FU)
-#define DRVCTRL_REG(rpm)        (((rpm) >> 8)  & 0x0FU)
+#define DRVCTRL_BITMASK(rpm)    (((rpm) >> 16) & 0x0FU)
+#define DRVCTRL_REG(rpm)        (((rpm) >> 8)  & 0xFFU)
 #define DRVCTRL_SHIFT(rpm)      ((rpm) & 0x01FU)
 #define DRVCTRL_MASK(rpm)       (DRVCTRL_BITMASK (rpm) << DRVCTRL_SHIFT (rpm))
 
+#define DRVCTRL_QSPI0_SPCLK     DRVCTRL_REG_POS_MASK (0U, 28U, DRVCTRL_F_MASK)
+#define DRVCTRL_QSPI0_MOSI_IO0  DRVCTRL_REG_POS_MASK (0U, 24U, DRVCTRL_F_MASK)
+#define DRVCTRL_QSPI0_MISO_IO1  DRVCTRL_REG_POS_MASK (0U, 20U, DRVCTRL_F_MASK)
+#define DRVCTRL_QSPI0_IO2       DRVCTRL_REG_POS_MASK (0U, 16U, DRVCTRL_F_MASK)
+#define DRVCTRL_QSPI0_IO3       DRVCTRL_REG_POS_MASK (0U, 12U, DRVCTRL_F_MASK)
+#define DRVCTRL_QSPI0_SSL       DRVCTRL_REG_POS_MASK (0U, 8U,  DRVCTRL_F_MASK)
+#define DRVCTRL_QSPI1_SPCLK     DRVCTRL_REG_POS_MASK (0U, 4U,  DRVCTRL_F_MASK)
+#define DRVCTRL_QSPI1_MOSI_IO0  DRVCTRL_REG_POS_MASK (0U, 0U,  DRVCTRL_F_MASK)
+
+#define DRVCTRL_QSPI1_MISO_IO1  DRVCTRL_REG_POS_MASK (1U, 28U, DRVCTRL_F_MASK)
+#define DRVCTRL_QSPI1_IO2       DRVCTRL_REG_POS_MASK (1U, 24U, DRVCTRL_F_MASK)
+#define DRVCTRL_QSPI1_IO3       DRVCTRL_REG_POS_MASK (1U, 20U, DRVCTRL_F_MASK)
+#define DRVCTRL_QSPI1_SSL       DRVCTRL_REG_POS_MASK (1U, 16U, DRVCTRL_F_MASK)
+#define DRVCTRL_RPC_INT         DRVCTRL_REG_POS_MASK (1U, 12U, DRVCTRL_H_MASK)
+#define DRVCTRL_RPC_WP          DRVCTRL_REG_POS_MASK (1U, 8U,  DRVCTRL_H_MASK)
+#define DRVCTRL_RPC_RESET       DRVCTRL_REG_POS_MASK (1U, 4U,  DRVCTRL_H_MASK)
 #define DRVCTRL_AVB_RX_CTL      DRVCTRL_REG_POS_MASK (1U, 0U,  DRVCTRL_H_MASK)
 
 #define DRVCTRL_AVB_RXC         DRVCTRL_REG_POS_MASK (2U, 28U, DRVCTRL_H_MASK)
@@ -452,16 +494,25 @@ extern "C" {
 #define DRVCTRL_AVB_LINK        DRVCTRL_REG_POS_MASK (4U, 28U, DRVCTRL_H_MASK)
 #define DRVCTRL_AVB_MATCH       DRVCTRL_REG_POS_MASK (4U, 24U, DRVCTRL_H_MASK)
 #define DRVCTRL_AVB_CAPTURE     DRVCTRL_REG_POS_MASK (4U, 20U, DRVCTRL_H_MASK)
+#define DRVCTRL_IRQ0            DRVCTRL_REG_POS_MASK (4U, 16U, DRVCTRL_H_MASK)
+#define DRVCTRL_IRQ1            DRVCTRL_REG_POS_MASK (4U, 12U, DRVCTRL_H_MASK)
 
 #define DRVCTRL_PWM1            DRVCTRL_REG_POS_MASK (5U, 20U, DRVCTRL_H_MASK)
 #define DRVCTRL_PWM2            DRVCTRL_REG_POS_MASK (5U, 16U, DRVCTRL_H_MASK)
 
+#define DRVCTRL_A6              DRVCTRL_REG_POS_MASK (6U, 20U, DRVCTRL_H_MASK)
+#define DRVCTRL_A7              DRVCTRL_REG_POS_MASK (6U, 16U, DRVCTRL_H_MASK)
 #define DRVCTRL_A8              DRVCTRL_REG_POS_MASK (6U, 12U, DRVCTRL_H_MASK)
 #define DRVCTRL_A11             DRVCTRL_REG_POS_MASK (6U, 0U,  DRVCTRL_H_MASK)
 
+#define DRVCTRL_RD              DRVCTRL_REG_POS_MASK (8U, 12U, DRVCTRL_H_MASK)
+#define DRVCTRL_RD_WR           DRVCTRL_REG_POS_MASK (8U, 8U,  DRVCTRL_H_MASK)
 #define DRVCTRL_WE0             DRVCTRL_REG_POS_MASK (8U, 4U,  DRVCTRL_H_MASK)
 #define DRVCTRL_WE1             DRVCTRL_REG_POS_MASK (8U, 0U,  DRVCTRL_H_MASK)
 
+#define DRVCTRL_D12             DRVCTRL_REG_POS_MASK (10U, 4U,  DRVCTRL_H_MASK)
+#define DRVCTRL_D13             DRVCTRL_REG_POS_MASK (10U, 0U,  DRVCTRL_H_MASK)
+
 #define DRVCTRL_D14             DRVCTRL_REG_POS_MASK (11U, 28U, DRVCTRL_H_MASK)
 #define DRVCTRL_D15             DRVCTRL_REG_POS_MASK (11U, 24U, DRVCTRL_H_MASK)
 
@@ -504,6 +555,8 @@ extern "C" {
 #define DRVCTRL_SD1_CD          DRVCTRL_REG_POS_MASK (17U, 20U, DRVCTRL_H_MASK)
 #define DRVCTRL_SD1_WP          DRVCTRL_REG_POS_MASK (17U, 16U, DRVCTRL_H_MASK)
 #define DRVCTRL_SCK0            DRVCTRL_REG_POS_MASK (17U, 12U, DRVCTRL_H_MASK)
+#define DRVCTRL_RX0             DRVCTRL_REG_POS_MASK (17U, 8U,  DRVCTRL_H_MASK)
+#define DRVCTRL_TX0             DRVCTRL_REG_POS_MASK (17U, 4U,  DRVCTRL_H_MASK)
 #define DRVCTRL_CTS0            DRVCTRL_REG_POS_MASK (17U, 0U,  DRVCTRL_H_MASK)
 
 #define DRVCTRL_RTS0            DRVCTRL_REG_POS_MASK (18U, 28U, DRVCTRL_H_MASK)
@@ -515,8 +568,21 @@ extern "C" {
 #define DRVCTRL_TX2             DRVCTRL_REG_POS_MASK (18U, 4U,  DRVCTRL_H_MASK)
 #define DRVCTRL_RX2             DRVCTRL_REG_POS_MASK (18U, 0U,  DRVCTRL_H_MASK)
 
+#define DRVCTRL_HSCK0           DRVCTRL_REG_POS_MASK (19U, 28U, DRVCTRL_H_MASK)
+#define DRVCTRL_HRX0            DRVCTRL_REG_POS_MASK (19U, 24U, DRVCTRL_H_MASK)
+#define DRVCTRL_HTX0            DRVCTRL_REG_POS_MASK (19U, 20U, DRVCTRL_H_MASK)
+#define DRVCTRL_HCTS0           DRVCTRL_REG_POS_MASK (19U, 16U, DRVCTRL_H_MASK)
+#define DRVCTRL_HRTS0           DRVCTRL_REG_POS_MASK (19U, 12U, DRVCTRL_H_MASK)
+#define DRVCTRL_MSIOF0_SCK      DRVCTRL_REG_POS_MASK (19U, 8U,  DRVCTRL_H_MASK)
+#define DRVCTRL_MSIOF0_SYNC     DRVCTRL_REG_POS_MASK (19U, 4U,  DRVCTRL_H_MASK)
+#define DRVCTRL_MSIOF0_SS1      DRVCTRL_REG_POS_MASK (19U, 0U,  DRVCTRL_H_MASK)
+
+#define DRVCTRL_MSIOF0_TXD      DRVCTRL_REG_POS_MASK (20U, 28U, DRVCTRL_H_MASK)
+#define DRVCTRL_MSIOF0_SS2      DRVCTRL_REG_POS_MASK (20U, 24U, DRVCTRL_H_MASK)
+#define DRVCTRL_MSIOF0_RXD      DRVCTRL_REG_POS_MASK (20U, 20U, DRVCTRL_H_MASK)
 #define DRVCTRL_MLB_CLK         DRVCTRL_REG_POS_MASK (20U, 16U, DRVCTRL_H_MASK)
 #define DRVCTRL_MLB_SIG         DRVCTRL_REG_POS_MASK (20U, 12U, DRVCTRL_H_MASK)
+#define DRVCTRL_MLB_DAT         DRVCTRL_REG_POS_MASK (20U, 8U,  DRVCTRL_H_MASK)
 
 #define DRVCTRL_SSI_SCK6        DRVCTRL_REG_POS_MASK (22U, 8U,  DRVCTRL_H_MASK)
 #define DRVCTRL_SSI_WS6         DRVCTRL_REG_POS_MASK (22U, 4U,  DRVCTRL_H_MASK)
@@ -544,6 +610,21 @@ extern "C" {
 #define PU_REG(regPin)          ((regPin) >> 8)
 #define PU_MASK(regPin)         (1U << ((regPin) & 0x01FU))
 
+#define PU_QSPI0_SPCLK          PU_REG_PIN (0U, 0U)
+#define PU_QSPI0_MOSI_IO0       PU_REG_PIN (0U, 1U)
+#define PU_QSPI0_MISO_IO1       PU_REG_PIN (0U, 2U)
+#define PU_QSPI0_IO2            PU_REG_PIN (0U, 3U)
+#define PU_QSPI0_IO3            PU_REG_PIN (0U, 4U)
+#define PU_QSPI0_SSL            PU_REG_PIN (0U, 5U)
+#define PU_QSPI1_SPCLK          PU_REG_PIN (0U, 6U)
+#define PU_QSPI1_MOSI_IO0       PU_REG_PIN (0U, 7U)
+#define PU_QSPI1_MISO_IO1       PU_REG_PIN (0U, 8U)
+#define PU_QSPI1_IO2            PU_REG_PIN (0U, 9U)
+#define PU_QSPI1_IO3            PU_REG_PIN (0U, 10U)
+#define PU_QSPI1_SSL            PU_REG_PIN (0U, 11U)
+#define PU_RPC_INT              PU_REG_PIN (0U, 12U)
+#define PU_RPC_WP               PU_REG_PIN (0U, 13U)
+#define PU_RPC_RESET            PU_REG_PIN (0U, 14U)
 #define PU_AVB_RX_CTL           PU_REG_PIN (0U, 15U)
 #define PU_AVB_RXC              PU_REG_PIN (0U, 16U)
 #define PU_AVB_RD0              PU_REG_PIN (0U, 17U)
@@ -565,13 +646,21 @@ extern "C" {
 #define PU_AVB_LINK             PU_REG_PIN (1U, 0U)
 #define PU_AVB_MATCH            PU_REG_PIN (1U, 1U)
 #define PU_AVB_CAPTURE          PU_REG_PIN (1U, 2U)
+#define PU_IRQ0                 PU_REG_PIN (1U, 3U)
+#define PU_IRQ1                 PU_REG_PIN (1U, 4U)
 #define PU_PWM1                 PU_REG_PIN (1U, 10U)
 #define PU_PWM2                 PU_REG_PIN (1U, 11U)
+#define PU_A6                   PU_REG_PIN (1U, 18U)
+#define PU_A7                   PU_REG_PIN (1U, 19U)
 #define PU_A8                   PU_REG_PIN (1U, 20U)
 #define PU_A11                  PU_REG_PIN (1U, 23U)
 
+#define PU_RD                   PU_REG_PIN (2U, 4U)
+#define PU_RD_WR                PU_REG_PIN (2U, 5U)
 #define PU_WE0                  PU_REG_PIN (2U, 6U)
 #define PU_WE1                  PU_REG_PIN (2U, 7U)
+#define PU_D12                  PU_REG_PIN (2U, 22U)
+#define PU_D13                  PU_REG_PIN (2U, 23U)
 #define PU_D14                  PU_REG_PIN (2U, 24U)
 #define PU_D15                  PU_REG_PIN (2U, 25U)
 
@@ -610,6 +699,8 @@ extern "C" {
 #define PU_SD1_CD               PU_REG_PIN (4U, 10U)
 #define PU_SD1_WP               PU_REG_PIN (4U, 11U)
 #define PU_SCK0                 PU_REG_PIN (4U, 12U)
+#define PU_RX0                  PU_REG_PIN (4U, 13U)
+#define PU_TX0                  PU_REG_PIN (4U, 14U)
 #define PU_CTS0                 PU_REG_PIN (4U, 15U)
 #define PU_RTS0                 PU_REG_PIN (4U, 16U)
 #define PU_RX1                  PU_REG_PIN (4U, 17U)
@@ -619,6 +710,18 @@ extern "C" {
 #define PU_SCK2                 PU_REG_PIN (4U, 21U)
 #define PU_TX2                  PU_REG_PIN (4U, 22U)
 #define PU_RX2                  PU_REG_PIN (4U, 23U)
+#define PU_HSCK0                PU_REG_PIN (4U, 24U)
+#define PU_HRX0                 PU_REG_PIN (4U, 25U)
+#define PU_HTX0                 PU_REG_PIN (4U, 26U)
+#define PU_HCTS0                PU_REG_PIN (4U, 27U)
+#define PU_HRTS0                PU_REG_PIN (4U, 28U)
+#define PU_MSIOF0_SCK           PU_REG_PIN (4U, 29U)
+#define PU_MSIOF0_SYNC          PU_REG_PIN (4U, 30U)
+#define PU_MSIOF0_SS1           PU_REG_PIN (4U, 31U)
+
+#define PU_MSIOF0_TXD           PU_REG_PIN (5U, 0U)
+#define PU_MSIOF0_SS2           PU_REG_PIN (5U, 1U)
+#define PU_MSIOF0_RXD           PU_REG_PIN (5U, 2U)
 
 #define PU_SSI_SCK6             PU_REG_PIN (5U, 21U)
 #define PU_USB2_PWEN            PU_SSI_SCK6
@@ -627,6 +730,7 @@ extern "C" {
 
 #define PU_MLB_CLK              PU_REG_PIN (6U, 3U)
 #define PU_MLB_SIG              PU_REG_PIN (6U, 4U)
+#define PU_MLB_DAT              PU_REG_PIN (6U, 5U)
 
 #define PU_USB0_PWEN            PU_REG_PIN (5U, 31U)
 #define PU_USB0_OVC             PU_REG_PIN (6U, 0U)
@@ -720,8 +824,57 @@ extern "C" {
 #define POC_SD0             POC_REG_POS_MASK (0U, 0U,  0x3fU)   /* bit0-5 */
 #define POC_SD3             POC_REG_POS_MASK (0U, 19U, 0x7ffU)  /* bit19-29 */
 
+/* POC signalling voltages for rzg2PfcPocVoltageSet() */
+
+#define PFC_POC_MV_3V3      3300U
+#define PFC_POC_MV_1V8      1800U
+
 /* typedefs */
 
+/* PFC boot program entry: set the <mask> bits of register <offset> to <val> */
+
+typedef struct rzg2PfcBootWrite
+    {
+    UINT32  offset;             /* PFC register offset */
+    UINT32  mask;               /* register bits to set */
+    UINT32  val;                /* value of the masked bits */
+    } RZG2_PFC_BOOT_WRITE;
+
+/* pin handle, the GPSR register and bit of a pin */
+
+typedef UINT32 RZG2_PFC_PIN;
+
+/* drive and bias profile handle */
+
+typedef struct pfcPinProg * RZG2_PFC_PROFILE;
+
+/* POC supply hook, called with the POC field, voltage in mv and argument */
+
+typedef STATUS (*RZG2_PFC_POC_HOOK) (UINT32 pocSel, UINT32 mv, void * pArg);
+
+/* function declarations */
+
+IMPORT STATUS  rzg2PfcPinStateSet   (VXB_DEV_ID pDev, const char * pName);
+IMPORT void    rzg2PfcPinOwnerShow  (void);
+IMPORT void    rzg2PfcLockStatsShow (void);
+IMPORT void    rzg2PfcBootProgSet   (const RZG2_PFC_BOOT_WRITE * pWrites,
+                                     UINT32 numWrites);
+IMPORT void    rzg2PfcBootProgDump  (void);
+IMPORT void    rzg2PfcPocHookSet    (RZG2_PFC_POC_HOOK hook, void * pArg);
+IMPORT STATUS  rzg2PfcPocVoltageSet (UINT32 pocSel, UINT32 mv);
+IMPORT UINT32  rzg2PfcPocVoltageGet (UINT32 pocSel);
+IMPORT RZG2_PFC_PIN rzg2PfcPinHandleGet (const char * pName);
+IMPORT STATUS  rzg2PfcPinGpioSet    (RZG2_PFC_PIN pin, BOOL gpio);
+IMPORT STATUS  rzg2PfcPinsGpioSet   (const RZG2_PFC_PIN * pPins,
+                                     UINT32 numPins, BOOL gpio);
+IMPORT STATUS  rzg2PfcPinStateCsvWrite (int fd);
+IMPORT RZG2_PFC_PROFILE rzg2PfcProfileGet (const char * pName);
+IMPORT STATUS  rzg2PfcProfilesApply (const RZG2_PFC_PROFILE * pProfiles,
+                                     UINT32 numProfiles);
+IMPORT STATUS  rzg2PfcProfileApply  (RZG2_PFC_PROFILE profile);
+IMPORT STATUS  rzg2PfcProfilesRestore (const RZG2_PFC_PROFILE * pProfiles,
+                                       UINT32 numProfiles);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
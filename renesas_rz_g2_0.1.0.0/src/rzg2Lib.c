@@ -32,6 +32,14 @@
 /*
 modification history
 --------------------
+19oct26,agt  serialise the debug ring flush with the drain task, flush on
+             exceptions
+19oct26,agt  call the suspend hooks with interrupts unlocked, resume through
+             a BSP CPU context routine
+19oct26,agt  added buffered debug console mode
+19oct26,agt  added lock statistics routines
+19oct26,agt  added PSCI system suspend with driver context hooks
+19oct26,agt  added rzg2TimestampGet() and rzg2TimestampFreqGet()
 17sep19,hli  created (VXWPG-394)
 */
 
@@ -40,6 +48,40 @@ DESCRIPTION
 This library provides platform-specific functions for the Renesas RZ/G2
 processor.
 
+System suspend to RAM is entered with rzg2SystemSuspend(), which uses the PSCI
+SYSTEM_SUSPEND call of the ARM Trusted Firmware. The RZ/G2 drivers whose
+hardware context is lost in suspend register save and restore hooks with
+rzg2SuspendHookAdd() when they attach: the CPG driver saves its dividers and
+module stop registers, and the PFC driver its pin function, drive and bias
+registers. The save hooks are called in the reverse order of registration, and
+the restore hooks in the order of registration, so a driver is restored after
+the drivers that attached before it, which it may depend on.
+
+The hooks may block, so they are called with preemption and interrupts enabled;
+interrupts are only locked around the PSCI call, which is made through psciLib.
+
+The firmware resumes the boot core at the entry point given to
+rzg2SystemSuspend(), with the MMU off. The CPU side of resume is provided by the
+BSP: a context save routine, called by rzg2SystemSuspend() just before the PSCI
+call, and resume code at the entry point that re-enables the MMU and restores
+that context, so that rzg2SystemSuspend() continues as if the save routine had
+returned a second time. The driver contexts are then restored, and the time
+taken by the restore hooks is returned by rzg2ResumeTicksGet(). Only the boot
+core may be running when the system is suspended, so an SMP image must be
+configured for one CPU. The HiHope RZ/G2M BSP provides the context routine and
+resume code in sysALib.s, and suspends the board with sysSuspend().
+
+The debug console writes each character to the SCIF with polled output, so a
+kprintf() stalls the calling CPU for the time it takes to transmit. After
+rzg2DebugRingStart(), kernel debug output is instead appended to a ring buffer
+of the calling CPU, with interrupts locked on that CPU only, and a low priority
+task transmits the buffered output. Output that does not fit in a ring is
+dropped and counted. rzg2DebugRingFlush() transmits the buffered output
+synchronously and returns the debug console to synchronous output. It is called
+by rzg2Reset(), and by an exception hook, so that output is not lost when the
+system stops. rzg2DebugRingShow() reports the output buffered and dropped by
+each CPU.
+
 INCLUDE FILES: sysLib.h string.h intLib.h
 
 SEE ALSO:
@@ -51,11 +93,17 @@ SEE ALSO:
 
 #include <vxWorks.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <boardLib.h>
 #include <sysLib.h>
 #include <string.h>
 #include <intLib.h>
+#include <semLib.h>
+#include <taskLib.h>
+#include <excLib.h>
 #include <vxLib.h>
+#include <vxCpuLib.h>
+#include <vxAtomicLib.h>
 #include <cacheLib.h>
 #include <dllLib.h>
 #include <pmapLib.h>
@@ -147,6 +195,23 @@ SEE ALSO:
 #define SCIF_TDFE_POLL_COUNT_MAX        100U
 #define SCIF_TEND_POLL_COUNT_MAX        (SCIF_TDFE_POLL_COUNT_MAX * 10U)
 
+/*
+ * buffered debug console defaults: ring size per CPU, which must be a power of
+ * two, and priority and stack size of the task that transmits the output
+ */
+
+#define RZG2_DBG_RING_SIZE_DEF      4096U
+#define RZG2_DBG_RING_TASK_PRI_DEF  250
+#define RZG2_DBG_RING_TASK_STACK    4096
+
+/* characters transmitted from one ring before moving to the next */
+
+#define RZG2_DBG_RING_DRAIN_MAX     128U
+
+/* time a flush waits for a drain pass of the task to end, in microseconds */
+
+#define RZG2_DBG_RING_FLUSH_WAIT_US 100000U
+
 /* define for early debug out */
 
 #define DEBUG_EARLY_PRINT
@@ -156,6 +221,15 @@ SEE ALSO:
 #define RZG2_MODEL_DEFAULT          "Unknown RZ/G2 board"
 
 #define RZG2_PRODCUT_NODE           "renesas,r8a774a1-prr"
+
+/* PSCI SYSTEM_SUSPEND function identifier, queried with PSCI_FEATURES */
+
+#ifdef _WRS_CONFIG_LP64
+#define RZG2_PSCI_SYSTEM_SUSPEND    0xC400000EU
+#else /* !_WRS_CONFIG_LP64 */
+#define RZG2_PSCI_SYSTEM_SUSPEND    0x8400000EU
+#endif /* _WRS_CONFIG_LP64 */
+
 #define RZG2_SCIF_NODE              "renesas,rcar-h3-scif"
 
 /* externs */
@@ -172,6 +246,7 @@ IMPORT STATUS armMpCoreInit     (UINT32, WIND_CPU_STATE *, FUNCPTR);
 #endif /* _WRS_CONFIG_SMP */
 
 IMPORT VIRT_ADDR mmuPtMemBase;
+IMPORT FUNCPTR excExcepHook;
 
 /* locals */
 
@@ -187,6 +262,46 @@ LOCAL VIRT_ADDR rzg2UartBase;
 
 LOCAL UINT32 rzg2GenTimerFreq;
 
+/* system suspend hooks, in order of registration */
+
+LOCAL struct
+    {
+    RZG2_SUSPEND_HOOK   saveRtn;        /* called before suspend */
+    RZG2_SUSPEND_HOOK   restoreRtn;     /* called on resume */
+    void *              pArg;           /* hook argument */
+    } rzg2SuspendHooks [RZG2_SUSPEND_HOOKS_MAX];
+
+LOCAL UINT32 rzg2SuspendHookCount;
+
+/* serialises system suspend and the registration of its hooks */
+
+LOCAL SEM_ID rzg2SuspendMutex;
+
+/* duration of the last restore of the driver contexts */
+
+LOCAL UINT64 rzg2ResumeTicks;
+
+/*
+ * Debug console ring buffer of one CPU. Only the owning CPU, with interrupts
+ * locked, advances <head>, and only the drain advances <tail>.
+ */
+
+typedef struct rzg2DbgRing
+    {
+    char *          pBuf;           /* ring buffer */
+    volatile UINT32 head;           /* bytes appended */
+    volatile UINT32 tail;           /* bytes transmitted */
+    UINT32          drops;          /* writes dropped, ring full */
+    } RZG2_DBG_RING;
+
+LOCAL RZG2_DBG_RING *   rzg2DbgRings;       /* rings, one per CPU */
+LOCAL UINT32            rzg2DbgRingNum;     /* number of rings */
+LOCAL UINT32            rzg2DbgRingSize;    /* size of each ring */
+LOCAL TASK_ID           rzg2DbgRingTid = TASK_ID_NULL;  /* drain task */
+LOCAL atomic32_t        rzg2DbgRingClaim;   /* 1 while the rings are drained */
+LOCAL volatile BOOL     rzg2DbgRingFlushed; /* output synchronous again */
+LOCAL FUNCPTR           rzg2DbgRingExcHookPrev; /* chained exception hook */
+
 /* function declarations */
 
 LOCAL void   rzg2ProductRegRead  (void);
@@ -202,7 +317,13 @@ LOCAL void   rzg2DebugInit (BOOL earlyInit);
 LOCAL STATUS rzg2UartBaseAddrGet (BOOL earlyInit, VIRT_ADDR * pBaseAddr);
 LOCAL STATUS rzg2DebugWrite      (char * buffer, size_t len);
 LOCAL void   rzg2DebugWriteCh      (char ch);
+LOCAL STATUS rzg2DebugRingWrite  (char * buffer, size_t len);
+LOCAL UINT32 rzg2DebugRingDrain  (UINT32 maxChars);
+LOCAL void   rzg2DebugRingTask   (void);
+LOCAL int    rzg2DebugRingExcHook (TASK_ID tid, int vecNum, void * pEsf);
 LOCAL void   rzg2Core0Exit     (UINT32 apCore);
+LOCAL STATUS rzg2SuspendMutexInit (void);
+LOCAL STATUS rzg2SuspendRestore (UINT32 first);
 
 #ifdef _WRS_CONFIG_SMP
 LOCAL void   rzg2PspExit (UINT32 apCore);
@@ -709,6 +830,394 @@ LOCAL void rzg2DebugWriteCh
     SCIF_SCFSR_REG  = ~scfsrTxFlags;
     }
 
+/*******************************************************************************
+*
+* rzg2DebugRingWrite - append to the debug console ring of the current CPU
+*
+* This function is the kernel write hook in buffered mode. It appends the
+* contents of <buffer> to the ring buffer of the current CPU, with interrupts
+* locked on that CPU so that the append is not interleaved with another task or
+* an ISR on the same CPU. No lock is shared with the other CPUs or with the
+* drain task. If the ring does not have room for the whole buffer, nothing is
+* appended and the drop is counted.
+*
+* RETURNS: OK.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2DebugRingWrite
+    (
+    char * buffer,
+    size_t len
+    )
+    {
+    RZG2_DBG_RING * pRing;
+    UINT32          head;
+    UINT32          i;
+    int             key;
+
+    if (buffer == NULL)
+        {
+        return OK;
+        }
+
+    key = intCpuLock ();
+
+    pRing = &rzg2DbgRings [vxCpuIndexGet ()];
+    head = pRing->head;
+
+    if (len > (size_t)(rzg2DbgRingSize - (head - pRing->tail)))
+        {
+        pRing->drops++;
+        }
+    else
+        {
+        for (i = 0; i < (UINT32)len; i++)
+            {
+            pRing->pBuf [(head + i) & (rzg2DbgRingSize - 1U)] = buffer [i];
+            }
+
+        /* publish the characters before the new head */
+
+        VX_MEM_BARRIER_W ();
+        pRing->head = head + (UINT32)len;
+        }
+
+    intCpuUnlock (key);
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2DebugRingDrain - transmit buffered debug console output
+*
+* This function transmits up to <maxChars> characters from each CPU's ring
+* buffer to the debug console, using polled output. The caller must hold the
+* drain claim, so that the drain task and rzg2DebugRingFlush() do not both
+* advance a ring's tail.
+*
+* RETURNS: the number of characters transmitted.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL UINT32 rzg2DebugRingDrain
+    (
+    UINT32 maxChars
+    )
+    {
+    RZG2_DBG_RING * pRing;
+    UINT32          total = 0;
+    UINT32          count;
+    UINT32          tail;
+    UINT32          cpu;
+    UINT32          i;
+    char            ch;
+
+    for (cpu = 0; cpu < rzg2DbgRingNum; cpu++)
+        {
+        pRing = &rzg2DbgRings [cpu];
+        tail = pRing->tail;
+        count = pRing->head - tail;
+
+        /* read the characters only after the head that published them */
+
+        VX_MEM_BARRIER_R ();
+
+        if (count > maxChars)
+            {
+            count = maxChars;
+            }
+
+        for (i = 0; i < count; i++)
+            {
+            ch = pRing->pBuf [(tail + i) & (rzg2DbgRingSize - 1U)];
+            rzg2DebugWriteCh (ch);
+
+            /* insert carriage return after newline */
+
+            if (ch == '\n')
+                {
+                rzg2DebugWriteCh ('\r');
+                }
+            }
+
+        /* release the space only after the characters have been read */
+
+        VX_MEM_BARRIER_RW ();
+        pRing->tail = tail + count;
+
+        total += count;
+        }
+
+    return total;
+    }
+
+/*******************************************************************************
+*
+* rzg2DebugRingTask - debug console drain task
+*
+* This task transmits the buffered debug console output, and sleeps for a
+* clock tick when there is none. It runs at low priority, so the polled output
+* only uses CPU time that no other task needs. Each pass over the rings is made
+* with the drain claim held, and the task exits once rzg2DebugRingFlush() has
+* returned the console to synchronous output.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2DebugRingTask (void)
+    {
+    UINT32  count;
+
+    while (!rzg2DbgRingFlushed)
+        {
+        count = 0;
+
+        if (vxAtomic32Cas (&rzg2DbgRingClaim, 0, 1))
+            {
+            count = rzg2DebugRingDrain (RZG2_DBG_RING_DRAIN_MAX);
+            (void) vxAtomic32Set (&rzg2DbgRingClaim, 0);
+            }
+
+        if (count == 0)
+            {
+            (void) taskDelay (1);
+            }
+        }
+
+    rzg2DbgRingTid = TASK_ID_NULL;
+    }
+
+/*******************************************************************************
+*
+* rzg2DebugRingExcHook - flush the debug console output on an exception
+*
+* This function is the exception hook installed by rzg2DebugRingStart(). It
+* transmits the buffered output, so that the output leading to the exception is
+* seen, and then calls the hook it replaced, if any.
+*
+* RETURNS: the value returned by the replaced hook, or 0.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL int rzg2DebugRingExcHook
+    (
+    TASK_ID tid,            /* task that took the exception */
+    int     vecNum,         /* exception vector */
+    void *  pEsf            /* exception stack frame */
+    )
+    {
+    rzg2DebugRingFlush ();
+
+    if (rzg2DbgRingExcHookPrev != NULL)
+        {
+        return rzg2DbgRingExcHookPrev (tid, vecNum, pEsf);
+        }
+
+    return 0;
+    }
+
+/*******************************************************************************
+*
+* rzg2DebugRingStart - buffer the kernel debug console output
+*
+* This routine switches the kernel debug console to buffered mode. A ring
+* buffer of <ringSize> bytes, a power of two, is allocated for each configured
+* CPU, and a drain task is spawned at <priority>. The kernel write hook then
+* appends to the ring of the calling CPU instead of transmitting, so kprintf()
+* no longer busy-waits on the SCIF. If <ringSize> is 0, or <priority> is
+* negative, defaults of 4096 bytes and priority 250 are used.
+*
+* An exception hook is installed, chained to any hook set before, which calls
+* rzg2DebugRingFlush() so that the output is not lost when a task takes an
+* exception. The SCIF transmit interrupt is not used, because the UART may also
+* be the console of the SIO driver, which owns its interrupts.
+*
+* RETURNS: OK, or ERROR if the debug console is not initialised, buffered mode
+* is already started, <ringSize> is not a power of two, or the rings or the
+* task cannot be created.
+*
+* ERRNO: N/A.
+*/
+
+STATUS rzg2DebugRingStart
+    (
+    UINT32  ringSize,       /* ring size per CPU, power of two, 0 for default */
+    int     priority        /* drain task priority, negative for default */
+    )
+    {
+    RZG2_DBG_RING * pRings;
+    UINT32          num = (UINT32) vxCpuConfiguredGet ();
+    UINT32          cpu;
+
+    if (ringSize == 0)
+        {
+        ringSize = RZG2_DBG_RING_SIZE_DEF;
+        }
+
+    if (priority < 0)
+        {
+        priority = RZG2_DBG_RING_TASK_PRI_DEF;
+        }
+
+    if ((rzg2UartBase == 0) || (rzg2DbgRings != NULL) || rzg2DbgRingFlushed ||
+        ((ringSize & (ringSize - 1U)) != 0))
+        {
+        return ERROR;
+        }
+
+    pRings = (RZG2_DBG_RING *) calloc (num, sizeof (RZG2_DBG_RING));
+    if (pRings == NULL)
+        {
+        return ERROR;
+        }
+
+    for (cpu = 0; cpu < num; cpu++)
+        {
+        pRings [cpu].pBuf = (char *) malloc (ringSize);
+        if (pRings [cpu].pBuf == NULL)
+            {
+            goto errOut;
+            }
+        }
+
+    rzg2DbgRingSize = ringSize;
+    rzg2DbgRingNum = num;
+    rzg2DbgRings = pRings;
+
+    rzg2DbgRingTid = taskSpawn ("tDbgRing", priority, 0,
+                                RZG2_DBG_RING_TASK_STACK,
+                                (FUNCPTR) rzg2DebugRingTask,
+                                0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    if (rzg2DbgRingTid == TASK_ID_ERROR)
+        {
+        rzg2DbgRings = NULL;
+        rzg2DbgRingTid = TASK_ID_NULL;
+        goto errOut;
+        }
+
+    _func_kwrite = rzg2DebugRingWrite;
+
+    rzg2DbgRingExcHookPrev = excExcepHook;
+    excHookAdd ((FUNCPTR) rzg2DebugRingExcHook);
+
+    return OK;
+
+errOut:
+    for (cpu = 0; cpu < num; cpu++)
+        {
+        free (pRings [cpu].pBuf);
+        }
+
+    free (pRings);
+
+    return ERROR;
+    }
+
+/*******************************************************************************
+*
+* rzg2DebugRingFlush - transmit the buffered debug console output now
+*
+* This routine returns the kernel debug console to synchronous output, then
+* transmits all the output buffered by each CPU, with polled output, and waits
+* for the end of transmission. It is intended for use when the system is
+* stopping, such as from an exception hook or a reboot, and can be called from
+* interrupt context. It does nothing if buffered mode is not started.
+*
+* If the drain task is transmitting on another CPU, the flush waits for it to
+* finish its pass over the rings, which is bounded. If it does not finish in
+* time, as when the other CPU has been stopped, the flush goes ahead.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+void rzg2DebugRingFlush (void)
+    {
+    unsigned txPollCount = 0;
+    UINT32   waitUs = 0;
+    BOOL     claimed;
+
+    if ((rzg2DbgRings == NULL) || (rzg2UartBase == 0))
+        {
+        return;
+        }
+
+    /* later output is synchronous, and the drain task stops */
+
+    rzg2DbgRingFlushed = TRUE;
+    _func_kwrite = rzg2DebugWrite;
+
+    while (!(claimed = vxAtomic32Cas (&rzg2DbgRingClaim, 0, 1)) &&
+           (waitUs++ < RZG2_DBG_RING_FLUSH_WAIT_US))
+        {
+        rzg2UsDelay (1);
+        }
+
+    while (rzg2DebugRingDrain (rzg2DbgRingSize) != 0)
+        {
+        }
+
+    if (claimed)
+        {
+        (void) vxAtomic32Set (&rzg2DbgRingClaim, 0);
+        }
+
+    /* wait for end of transmission */
+
+    while ((SCIF_SCFSR_REG & SCFSR_TEND) == 0 &&
+           ++txPollCount < SCIF_TEND_POLL_COUNT_MAX)
+        {
+        rzg2UsDelay (SCIF_TX_POLL_DELAY_US);
+        }
+    }
+
+/*******************************************************************************
+*
+* rzg2DebugRingShow - show the buffered debug console statistics
+*
+* This routine displays, for each CPU, the debug console output appended to its
+* ring, the output not yet transmitted, and the number of writes dropped because
+* the ring was full.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+void rzg2DebugRingShow (void)
+    {
+    RZG2_DBG_RING * pRing;
+    UINT32          cpu;
+
+    if (rzg2DbgRings == NULL)
+        {
+        printf ("debug console buffering not started\n");
+        return;
+        }
+
+    printf ("ring size %u bytes\n", rzg2DbgRingSize);
+    if (rzg2DbgRingFlushed)
+        {
+        printf ("flushed, output is synchronous\n");
+        }
+    printf ("%-4s %12s %10s %10s\n", "CPU", "appended", "pending", "dropped");
+
+    for (cpu = 0; cpu < rzg2DbgRingNum; cpu++)
+        {
+        pRing = &rzg2DbgRings [cpu];
+        printf ("%-4u %12u %10u %10u\n", cpu, pRing->head,
+                pRing->head - pRing->tail, pRing->drops);
+        }
+    }
+
 /*******************************************************************************
 *
 * rzg2UsDelay - delay (busy-wait) for a number of microseconds
@@ -887,6 +1396,45 @@ LOCAL UINT64 rzg2CounterValueGet (void)
     return __inline__Rzg2GetVirtTimerCnt();
     }
 
+/*******************************************************************************
+*
+* rzg2TimestampGet - get the free-running timestamp counter value
+*
+* This function returns the ARM core generic timer virtual counter value. It is
+* provided so that the RZ/G2 drivers can time hardware sequences with a
+* resolution better than the system clock tick. The counter runs at the rate
+* returned by rzg2TimestampFreqGet().
+*
+* RETURNS: Counter value.
+*
+* ERRNO: N/A.
+*
+* \NOMANUAL
+*/
+
+UINT64 rzg2TimestampGet (void)
+    {
+    return rzg2CounterValueGet ();
+    }
+
+/*******************************************************************************
+*
+* rzg2TimestampFreqGet - get the free-running timestamp counter frequency
+*
+* This function returns the frequency of the counter read by rzg2TimestampGet().
+*
+* RETURNS: counter frequency (in Hz).
+*
+* ERRNO: N/A.
+*
+* \NOMANUAL
+*/
+
+UINT32 rzg2TimestampFreqGet (void)
+    {
+    return rzg2GenTimerFreq;
+    }
+
 /*******************************************************************************
 *
 * rzg2Reset - system reset
@@ -908,6 +1456,10 @@ void rzg2Reset
     )
     {
 
+    /* do not lose the buffered debug output */
+
+    rzg2DebugRingFlush ();
+
     if ((sysWarmBootFunc == NULL) ||(startType == BOOT_CLEAR))
         {
         goto cold;
@@ -1051,3 +1603,356 @@ STATUS rzg2CpuEnable
     }
 
 #endif /* _WRS_CONFIG_SMP */
+
+/*******************************************************************************
+*
+* rzg2SuspendMutexInit - create the system suspend mutex
+*
+* This routine creates the mutex that serialises system suspend and the
+* registration of suspend hooks, if it has not been created yet. It is first
+* called when a driver attaches.
+*
+* RETURNS: OK, or ERROR if the mutex cannot be created.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2SuspendMutexInit (void)
+    {
+    if (rzg2SuspendMutex == SEM_ID_NULL)
+        {
+        rzg2SuspendMutex = semMCreate (SEM_Q_PRIORITY | SEM_DELETE_SAFE |
+                                       SEM_INVERSION_SAFE);
+        if (rzg2SuspendMutex == SEM_ID_NULL)
+            {
+            return ERROR;
+            }
+        }
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2SuspendHookAdd - add a system suspend hook
+*
+* This routine registers the routines <saveRtn> and <restoreRtn>, called with
+* <pArg>, to save a driver's hardware context before the system is suspended
+* and to restore it on resume. Either routine may be NULL. Save routines are
+* called in the reverse order of registration, and restore routines in the
+* order of registration. It is normally called by a driver's attach routine.
+*
+* RETURNS: OK, or ERROR if no routine is given or the hook table is full.
+*
+* ERRNO: N/A.
+*/
+
+STATUS rzg2SuspendHookAdd
+    (
+    RZG2_SUSPEND_HOOK   saveRtn,        /* context save routine */
+    RZG2_SUSPEND_HOOK   restoreRtn,     /* context restore routine */
+    void *              pArg            /* argument of the routines */
+    )
+    {
+    STATUS  status = ERROR;
+
+    if (((saveRtn == NULL) && (restoreRtn == NULL)) ||
+        (rzg2SuspendMutexInit () != OK))
+        {
+        return ERROR;
+        }
+
+    (void) semTake (rzg2SuspendMutex, WAIT_FOREVER);
+
+    if (rzg2SuspendHookCount < RZG2_SUSPEND_HOOKS_MAX)
+        {
+        rzg2SuspendHooks [rzg2SuspendHookCount].saveRtn = saveRtn;
+        rzg2SuspendHooks [rzg2SuspendHookCount].restoreRtn = restoreRtn;
+        rzg2SuspendHooks [rzg2SuspendHookCount].pArg = pArg;
+        rzg2SuspendHookCount++;
+        status = OK;
+        }
+
+    (void) semGive (rzg2SuspendMutex);
+
+    return status;
+    }
+
+/*******************************************************************************
+*
+* rzg2SuspendRestore - call the system resume hooks
+*
+* This routine calls the restore routine of each registered suspend hook from
+* hook <first>, in the order of registration, and records the time taken. Every
+* hook is called, even if an earlier one fails.
+*
+* RETURNS: OK, or ERROR if a hook fails.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2SuspendRestore
+    (
+    UINT32  first       /* first hook to restore */
+    )
+    {
+    UINT64  startTicks = rzg2TimestampGet ();
+    STATUS  status = OK;
+    UINT32  i;
+
+    for (i = first; i < rzg2SuspendHookCount; i++)
+        {
+        if ((rzg2SuspendHooks [i].restoreRtn != NULL) &&
+            (rzg2SuspendHooks [i].restoreRtn (rzg2SuspendHooks [i].pArg) !=
+             OK))
+            {
+            RZG2_LIB_DBG_MSG ("suspend hook %u restore failed\n", i);
+            status = ERROR;
+            }
+        }
+
+    rzg2ResumeTicks = rzg2TimestampGet () - startTicks;
+
+    return status;
+    }
+
+/*******************************************************************************
+*
+* rzg2SystemSuspend - suspend the system to RAM
+*
+* This routine saves the driver contexts with the registered suspend hooks, and
+* then suspends the system with the PSCI SYSTEM_SUSPEND call. The firmware
+* resumes the boot core at the physical address <resumeEntry>, with the MMU off
+* and <contextId> in the first argument register.
+*
+* Just before the PSCI call, with interrupts locked, the BSP routine <ctxSave>
+* is called with <contextId> to save the CPU context, and returns 0. The BSP
+* resume code at <resumeEntry> must restore the MMU and that context, so that
+* <ctxSave> returns again with a non-zero value. The driver contexts are then
+* restored, interrupts are unlocked, and this routine returns OK.
+*
+* This routine must be called by a task, with the devices quiesced. The hooks
+* may take driver mutexes or call a PMIC driver, so they run with preemption
+* and interrupts enabled; a mutex serialises this routine against another
+* suspend and against rzg2SuspendHookAdd(), but not against other tasks using
+* the drivers, which the caller must stop first.
+*
+* PSCI only grants SYSTEM_SUSPEND when every other core is off. VxWorks SMP
+* does not take the secondary cores of a running system offline, so in an SMP
+* image this routine returns ERROR unless the image is configured for one CPU.
+*
+* RETURNS: OK after resume, or ERROR if no context routine is given, other cores
+* are configured, the firmware does not support SYSTEM_SUSPEND, a save hook
+* fails, or the firmware denies the request, in which case the saved contexts
+* are restored.
+*
+* ERRNO: N/A.
+*/
+
+STATUS rzg2SystemSuspend
+    (
+    RZG2_CPU_CTX_SAVE   ctxSave,        /* BSP CPU context save routine */
+    PHYS_ADDR           resumeEntry,    /* physical address to resume at */
+    ULONG               contextId       /* argument passed to the resume code */
+    )
+    {
+    STATUS  status = OK;
+    UINT32  i;
+    int     key;
+
+    if ((ctxSave == NULL) || INT_CONTEXT () ||
+        (rzg2SuspendMutexInit () != OK))
+        {
+        return ERROR;
+        }
+
+#ifdef _WRS_CONFIG_SMP
+    if (vxCpuConfiguredGet () > 1U)
+        {
+        RZG2_LIB_DBG_MSG ("system suspend needs the other cores off\n");
+        return ERROR;
+        }
+#endif /* _WRS_CONFIG_SMP */
+
+    if (vxPsciFeatures (RZG2_PSCI_SYSTEM_SUSPEND) == PSCI_NOT_SUPPORTED)
+        {
+        RZG2_LIB_DBG_MSG ("PSCI SYSTEM_SUSPEND not supported\n");
+        return ERROR;
+        }
+
+    (void) semTake (rzg2SuspendMutex, WAIT_FOREVER);
+
+    for (i = rzg2SuspendHookCount; i > 0U; i--)
+        {
+        if ((rzg2SuspendHooks [i - 1U].saveRtn != NULL) &&
+            (rzg2SuspendHooks [i - 1U].saveRtn (rzg2SuspendHooks [i - 1U].pArg)
+             != OK))
+            {
+            RZG2_LIB_DBG_MSG ("suspend hook %u save failed\n", i - 1U);
+            status = ERROR;
+            break;
+            }
+        }
+
+    if (status == OK)
+        {
+        key = intCpuLock ();
+
+        if (ctxSave (contextId) == 0)
+            {
+            (void) vxPsciSysSuspend ((SMC_SZ) resumeEntry, (SMC_SZ) contextId);
+
+            /* the call only returns if the firmware denied the request */
+
+            RZG2_LIB_DBG_MSG ("PSCI SYSTEM_SUSPEND denied\n");
+            status = ERROR;
+            }
+
+        intCpuUnlock (key);
+        }
+
+    /* restore the contexts saved, from the first hook not failed */
+
+    if (rzg2SuspendRestore (i) != OK)
+        {
+        status = ERROR;
+        }
+
+    (void) semGive (rzg2SuspendMutex);
+
+    return status;
+    }
+
+/*******************************************************************************
+*
+* rzg2ResumeTicksGet - get the duration of the last driver context restore
+*
+* This routine returns the time taken by the restore hooks on the last resume,
+* in rzg2TimestampGet() ticks.
+*
+* RETURNS: the restore duration, or 0 if the system has not been resumed.
+*
+* ERRNO: N/A.
+*/
+
+UINT64 rzg2ResumeTicksGet (void)
+    {
+    return rzg2ResumeTicks;
+    }
+
+/*******************************************************************************
+*
+* rzg2LockStatsTake - take a driver lock and record its statistics
+*
+* This routine takes the mutex <semId> and updates the lock statistics
+* <pStats>. The lock is first tried without waiting, so that a take that has to
+* wait for another task is counted as contended. It is used by the
+* RZG2_LOCK_TAKE() macro when RZG2_LOCK_STATS is defined, and must not be
+* called from interrupt context.
+*
+* RETURNS: the time the lock was taken, in rzg2TimestampGet() ticks.
+*
+* ERRNO: N/A.
+*
+* \NOMANUAL
+*/
+
+UINT64 rzg2LockStatsTake
+    (
+    SEM_ID              semId,      /* driver mutex */
+    RZG2_LOCK_STAT *    pStats      /* statistics of the lock class */
+    )
+    {
+    UINT64  startTicks = rzg2TimestampGet ();
+    UINT64  takeTime;
+    UINT64  wait;
+    BOOL    contended = FALSE;
+
+    if (semTake (semId, NO_WAIT) != OK)
+        {
+        contended = TRUE;
+        (void) semTake (semId, WAIT_FOREVER);
+        }
+
+    /* the statistics are protected by the lock from here */
+
+    takeTime = rzg2TimestampGet ();
+    wait = takeTime - startTicks;
+
+    pStats->acquires++;
+    if (contended)
+        {
+        pStats->contended++;
+        }
+
+    pStats->waitTotal += wait;
+    if (wait > pStats->waitMax)
+        {
+        pStats->waitMax = wait;
+        }
+
+    return takeTime;
+    }
+
+/*******************************************************************************
+*
+* rzg2LockStatsGive - give a driver lock and record its hold time
+*
+* This routine records the time the mutex <semId> was held since <takeTime>,
+* as returned by rzg2LockStatsTake(), in the lock statistics <pStats>, then
+* gives the mutex. It is used by the RZG2_LOCK_GIVE() macro when
+* RZG2_LOCK_STATS is defined.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*
+* \NOMANUAL
+*/
+
+void rzg2LockStatsGive
+    (
+    SEM_ID              semId,      /* driver mutex */
+    RZG2_LOCK_STAT *    pStats,     /* statistics of the lock class */
+    UINT64              takeTime    /* time the lock was taken */
+    )
+    {
+    UINT64  hold = rzg2TimestampGet () - takeTime;
+
+    pStats->holdTotal += hold;
+    if (hold > pStats->holdMax)
+        {
+        pStats->holdMax = hold;
+        }
+
+    (void) semGive (semId);
+    }
+
+/*******************************************************************************
+*
+* rzg2LockStatsShow - show the statistics of a lock class
+*
+* This routine prints one line with the statistics <pStats> of the lock class
+* <pName>: the number of takes, the number of contended takes, and the average
+* and maximum wait and hold times in rzg2TimestampGet() ticks. It is used by
+* the lock statistics show routines of the drivers.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*
+* \NOMANUAL
+*/
+
+void rzg2LockStatsShow
+    (
+    const char *            pName,      /* lock class name */
+    const RZG2_LOCK_STAT *  pStats      /* statistics of the lock class */
+    )
+    {
+    UINT32  n = (pStats->acquires == 0U) ? 1U : pStats->acquires;
+
+    printf ("%-14s %10u %10u %10llu %10llu %10llu %10llu\n", pName,
+            pStats->acquires, pStats->contended, pStats->waitTotal / n,
+            pStats->waitMax, pStats->holdTotal / n, pStats->holdMax);
+    }
@@ -0,0 +1,611 @@
+/* rzg2XactLib.c - Renesas RZ/G2 clock and pin transaction library */
+
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1) Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2) Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3) Neither the name of Wind River Systems nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+modification history
+--------------------
+19oct26,agt  created
+*/
+
+/*
+DESCRIPTION
+This library groups the CPG and PFC changes of a multi-step interface mode
+switch, such as moving an SD/eMMC port to a faster bus speed mode, into one
+transaction.
+
+A transaction is a caller-owned RZG2_XACT initialized with rzg2XactInit(). The
+steps are added with rzg2XactClkGate(), rzg2XactClkRateSet(), rzg2XactPocSet()
+and rzg2XactProfileSet(), in any order, and rzg2XactCommit() applies them in the
+safe order of an interface switch: module clocks are gated first, then the
+signalling voltage is switched, the clock dividers are set, the drive and bias
+profiles are applied, and module clocks are ungated last. Steps of the same
+kind keep the order they were added in.
+
+The clock rate steps are applied with one rzg2CpgClkRatesSet() call, and the
+profile steps with one rzg2PfcProfilesApply() call, so each CPG and PFC register
+changed by them is unlocked and written once. No lock is held across the whole
+commit: each driver takes its own lock only around its batch of writes.
+
+If a step fails, the steps already applied are undone in the reverse order,
+leaving the clocks and pins as they were before the commit.
+
+INCLUDE FILES: rzg2XactLib.h
+
+SEE ALSO: vxbFdtRsRzg2CpgMssr, vxbFdtRsRzg2PfcPinMux
+*/
+
+/* includes */
+
+#include <vxWorks.h>
+#include <hwif/vxBus.h>
+#include <subsys/clk/vxbClkLib.h>
+
+#include <rzg2Lib.h>
+#include <rzg2XactLib.h>
+
+/* forward declarations */
+
+LOCAL STATUS rzg2XactStepAdd (RZG2_XACT * pXact, RZG2_XACT_OP op,
+                              VXB_CLK_ID pClk, UINT64 value, UINT32 pocSel,
+                              RZG2_PFC_PROFILE profile);
+LOCAL void   rzg2XactSort (RZG2_XACT * pXact);
+LOCAL UINT32 rzg2XactRunLength (RZG2_XACT * pXact, UINT32 first);
+LOCAL STATUS rzg2XactRunApply (RZG2_XACT * pXact, UINT32 first,
+                               UINT32 count, UINT32 * pDone);
+LOCAL void   rzg2XactRunUndo (RZG2_XACT * pXact, UINT32 first, UINT32 count);
+
+/*******************************************************************************
+*
+* rzg2XactInit - initialize a clock and pin transaction
+*
+* This routine empties the transaction <pXact>, so steps can be added to it.
+*
+* RETURNS: N/A
+*
+* ERRNO: N/A
+*/
+
+void rzg2XactInit
+    (
+    RZG2_XACT * pXact   /* transaction */
+    )
+    {
+    if (pXact == NULL)
+        {
+        return;
+        }
+
+    pXact->numSteps = 0U;
+    pXact->invalid  = FALSE;
+    pXact->ticks    = 0U;
+    }
+
+/*******************************************************************************
+*
+* rzg2XactStepAdd - add a step to a transaction
+*
+* This routine appends a step to the transaction <pXact>. If the transaction is
+* full, it is marked invalid so that rzg2XactCommit() rejects it.
+*
+* RETURNS: OK, or ERROR if the transaction is full.
+*
+* ERRNO: N/A
+*/
+
+LOCAL STATUS rzg2XactStepAdd
+    (
+    RZG2_XACT *         pXact,      /* transaction */
+    RZG2_XACT_OP        op,         /* operation */
+    VXB_CLK_ID          pClk,       /* clock, or NULL */
+    UINT64              value,      /* clock rate or voltage */
+    UINT32              pocSel,     /* POC field, or 0 */
+    RZG2_PFC_PROFILE    profile     /* profile, or NULL */
+    )
+    {
+    RZG2_XACT_STEP *    pStep;
+
+    if (pXact->numSteps >= RZG2_XACT_STEPS_MAX)
+        {
+        pXact->invalid = TRUE;
+        return ERROR;
+        }
+
+    pStep = &pXact->steps [pXact->numSteps++];
+
+    pStep->op        = op;
+    pStep->pClk      = pClk;
+    pStep->value     = value;
+    pStep->prevValue = 0U;
+    pStep->pocSel    = pocSel;
+    pStep->profile   = profile;
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2XactClkGate - add a module clock gate step to a transaction
+*
+* This routine adds to the transaction <pXact> a step that ungates the clock
+* <pClk> if <enable> is TRUE, or gates it otherwise. Gating steps are committed
+* before all other steps, and ungating steps after them.
+*
+* RETURNS: OK, or ERROR if a parameter is invalid or the transaction is full.
+*
+* ERRNO: N/A
+*/
+
+STATUS rzg2XactClkGate
+    (
+    RZG2_XACT *     pXact,      /* transaction */
+    VXB_CLK_ID      pClk,       /* module clock */
+    BOOL            enable      /* TRUE to ungate, FALSE to gate */
+    )
+    {
+    if (pXact == NULL)
+        {
+        return ERROR;
+        }
+
+    if (pClk == NULL)
+        {
+        pXact->invalid = TRUE;
+        return ERROR;
+        }
+
+    return rzg2XactStepAdd (pXact, enable ? RZG2_XACT_CLK_ON : RZG2_XACT_CLK_OFF,
+                            pClk, 0U, 0U, NULL);
+    }
+
+/*******************************************************************************
+*
+* rzg2XactClkRateSet - add a clock rate step to a transaction
+*
+* This routine adds to the transaction <pXact> a step that sets the CPG divider
+* clock <pClk> to the highest frequency that does not exceed <rate>. All rate
+* steps of a transaction are applied together by rzg2CpgClkRatesSet().
+*
+* RETURNS: OK, or ERROR if a parameter is invalid or the transaction is full.
+*
+* ERRNO: N/A
+*/
+
+STATUS rzg2XactClkRateSet
+    (
+    RZG2_XACT *     pXact,      /* transaction */
+    VXB_CLK_ID      pClk,       /* CPG divider clock */
+    UINT64          rate        /* requested frequency */
+    )
+    {
+    if (pXact == NULL)
+        {
+        return ERROR;
+        }
+
+    if ((pClk == NULL) || (rate == 0U))
+        {
+        pXact->invalid = TRUE;
+        return ERROR;
+        }
+
+    return rzg2XactStepAdd (pXact, RZG2_XACT_CLK_RATE, pClk, rate, 0U, NULL);
+    }
+
+/*******************************************************************************
+*
+* rzg2XactPocSet - add a signalling voltage step to a transaction
+*
+* This routine adds to the transaction <pXact> a step that switches the pads of
+* the POC field <pocSel> (POC_SD0 or POC_SD3) to <mv> millivolts through
+* rzg2PfcPocVoltageSet().
+*
+* RETURNS: OK, or ERROR if a parameter is invalid or the transaction is full.
+*
+* ERRNO: N/A
+*/
+
+STATUS rzg2XactPocSet
+    (
+    RZG2_XACT *     pXact,      /* transaction */
+    UINT32          pocSel,     /* POC_SD0 or POC_SD3 */
+    UINT32          mv          /* PFC_POC_MV_1V8 or PFC_POC_MV_3V3 */
+    )
+    {
+    if (pXact == NULL)
+        {
+        return ERROR;
+        }
+
+    if (((pocSel != POC_SD0) && (pocSel != POC_SD3)) ||
+        ((mv != PFC_POC_MV_1V8) && (mv != PFC_POC_MV_3V3)))
+        {
+        pXact->invalid = TRUE;
+        return ERROR;
+        }
+
+    return rzg2XactStepAdd (pXact, RZG2_XACT_POC, NULL, (UINT64) mv, pocSel,
+                            NULL);
+    }
+
+/*******************************************************************************
+*
+* rzg2XactProfileSet - add a drive and bias profile step to a transaction
+*
+* This routine adds to the transaction <pXact> a step that applies the PFC
+* profile <profile>, as returned by rzg2PfcProfileGet(). All profile steps of a
+* transaction are applied together by rzg2PfcProfilesApply().
+*
+* RETURNS: OK, or ERROR if a parameter is invalid or the transaction is full.
+*
+* ERRNO: N/A
+*/
+
+STATUS rzg2XactProfileSet
+    (
+    RZG2_XACT *         pXact,      /* transaction */
+    RZG2_PFC_PROFILE    profile     /* profile handle */
+    )
+    {
+    if (pXact == NULL)
+        {
+        return ERROR;
+        }
+
+    if (profile == NULL)
+        {
+        pXact->invalid = TRUE;
+        return ERROR;
+        }
+
+    return rzg2XactStepAdd (pXact, RZG2_XACT_PFC_PROFILE, NULL, 0U, 0U,
+                            profile);
+    }
+
+/*******************************************************************************
+*
+* rzg2XactSort - sort the steps of a transaction into commit order
+*
+* This routine sorts the steps of the transaction <pXact> by operation. The
+* sort is stable, so steps of the same operation keep the order they were added
+* in.
+*
+* RETURNS: N/A
+*
+* ERRNO: N/A
+*/
+
+LOCAL void rzg2XactSort
+    (
+    RZG2_XACT * pXact   /* transaction */
+    )
+    {
+    RZG2_XACT_STEP  step;
+    UINT32          i;
+    UINT32          j;
+
+    for (i = 1U; i < pXact->numSteps; i++)
+        {
+        step = pXact->steps [i];
+
+        for (j = i; (j > 0U) && (pXact->steps [j - 1U].op > step.op); j--)
+            {
+            pXact->steps [j] = pXact->steps [j - 1U];
+            }
+
+        pXact->steps [j] = step;
+        }
+    }
+
+/*******************************************************************************
+*
+* rzg2XactRunLength - get the number of steps with the same operation
+*
+* This routine returns the number of consecutive steps of the sorted transaction
+* <pXact>, starting at step <first>, that have the same operation.
+*
+* RETURNS: the number of steps in the run.
+*
+* ERRNO: N/A
+*/
+
+LOCAL UINT32 rzg2XactRunLength
+    (
+    RZG2_XACT * pXact,  /* transaction */
+    UINT32      first   /* first step of the run */
+    )
+    {
+    UINT32  last = first + 1U;
+
+    while ((last < pXact->numSteps) &&
+           (pXact->steps [last].op == pXact->steps [first].op))
+        {
+        last++;
+        }
+
+    return last - first;
+    }
+
+/*******************************************************************************
+*
+* rzg2XactRunApply - apply a run of steps with the same operation
+*
+* This routine applies the <count> steps of the transaction <pXact> starting at
+* step <first>, which all have the same operation, and records the value each
+* step replaces. Clock rate and profile runs are applied in one batch. The
+* number of steps applied is returned in <pDone>, so that a failed run of
+* single steps can be undone.
+*
+* RETURNS: OK, or ERROR if a step fails.
+*
+* ERRNO: N/A
+*/
+
+LOCAL STATUS rzg2XactRunApply
+    (
+    RZG2_XACT * pXact,  /* transaction */
+    UINT32      first,  /* first step of the run */
+    UINT32      count,  /* number of steps in the run */
+    UINT32 *    pDone   /* returned number of steps applied */
+    )
+    {
+    RZG2_XACT_STEP *    pStep = &pXact->steps [first];
+    VXB_CLK_ID          clks [RZG2_XACT_STEPS_MAX];
+    UINT64              rates [RZG2_XACT_STEPS_MAX];
+    RZG2_PFC_PROFILE    profiles [RZG2_XACT_STEPS_MAX];
+    UINT32              mv;
+    UINT32              i;
+
+    *pDone = 0U;
+
+    switch (pStep->op)
+        {
+        case RZG2_XACT_CLK_RATE:
+            for (i = 0U; i < count; i++)
+                {
+                pStep [i].prevValue = vxbClkRateGet (pStep [i].pClk);
+                clks [i]  = pStep [i].pClk;
+                rates [i] = pStep [i].value;
+                }
+
+            if (rzg2CpgClkRatesSet (clks, rates, count) != OK)
+                {
+                return ERROR;
+                }
+
+            *pDone = count;
+            return OK;
+
+        case RZG2_XACT_PFC_PROFILE:
+            for (i = 0U; i < count; i++)
+                {
+                profiles [i] = pStep [i].profile;
+                }
+
+            if (rzg2PfcProfilesApply (profiles, count) != OK)
+                {
+                return ERROR;
+                }
+
+            *pDone = count;
+            return OK;
+
+        default:
+            break;
+        }
+
+    for (i = 0U; i < count; i++, pStep++)
+        {
+        switch (pStep->op)
+            {
+            case RZG2_XACT_CLK_OFF:
+                if (vxbClkDisable (pStep->pClk) != OK)
+                    {
+                    return ERROR;
+                    }
+                break;
+
+            case RZG2_XACT_CLK_ON:
+                if (vxbClkEnable (pStep->pClk) != OK)
+                    {
+                    return ERROR;
+                    }
+                break;
+
+            case RZG2_XACT_POC:
+                mv = rzg2PfcPocVoltageGet (pStep->pocSel);
+                if ((mv == 0U) ||
+                    (rzg2PfcPocVoltageSet (pStep->pocSel,
+                                           (UINT32) pStep->value) != OK))
+                    {
+                    return ERROR;
+                    }
+                pStep->prevValue = (UINT64) mv;
+                break;
+
+            default:
+                return ERROR;
+            }
+
+        (*pDone)++;
+        }
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2XactRunUndo - undo a run of applied steps with the same operation
+*
+* This routine undoes the <count> applied steps of the transaction <pXact>
+* starting at step <first>, which all have the same operation, in the reverse
+* order. Undo is best effort: a step that fails to undo does not stop the
+* others.
+*
+* RETURNS: N/A
+*
+* ERRNO: N/A
+*/
+
+LOCAL void rzg2XactRunUndo
+    (
+    RZG2_XACT * pXact,  /* transaction */
+    UINT32      first,  /* first step of the run */
+    UINT32      count   /* number of applied steps in the run */
+    )
+    {
+    RZG2_XACT_STEP *    pStep = &pXact->steps [first];
+    VXB_CLK_ID          clks [RZG2_XACT_STEPS_MAX];
+    UINT64              rates [RZG2_XACT_STEPS_MAX];
+    RZG2_PFC_PROFILE    profiles [RZG2_XACT_STEPS_MAX];
+    UINT32              i;
+
+    if (count == 0U)
+        {
+        return;
+        }
+
+    switch (pStep->op)
+        {
+        case RZG2_XACT_CLK_RATE:
+            for (i = 0U; i < count; i++)
+                {
+                clks [i]  = pStep [i].pClk;
+                rates [i] = pStep [i].prevValue;
+                }
+
+            (void) rzg2CpgClkRatesSet (clks, rates, count);
+            return;
+
+        case RZG2_XACT_PFC_PROFILE:
+            for (i = 0U; i < count; i++)
+                {
+                profiles [i] = pStep [i].profile;
+                }
+
+            (void) rzg2PfcProfilesRestore (profiles, count);
+            return;
+
+        default:
+            break;
+        }
+
+    for (i = count; i > 0U; i--)
+        {
+        pStep = &pXact->steps [first + i - 1U];
+
+        switch (pStep->op)
+            {
+            case RZG2_XACT_CLK_OFF:
+                (void) vxbClkEnable (pStep->pClk);
+                break;
+
+            case RZG2_XACT_CLK_ON:
+                (void) vxbClkDisable (pStep->pClk);
+                break;
+
+            case RZG2_XACT_POC:
+                (void) rzg2PfcPocVoltageSet (pStep->pocSel,
+                                             (UINT32) pStep->prevValue);
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+
+/*******************************************************************************
+*
+* rzg2XactCommit - commit a clock and pin transaction
+*
+* This routine applies the steps of the transaction <pXact> in commit order:
+* module clock gating, signalling voltage, clock rates, drive and bias profiles,
+* then module clock ungating. The clock rate steps are applied in one batch,
+* and so are the profile steps. If a step fails, the steps already applied are
+* undone in the reverse order. The duration of the commit, in rzg2TimestampGet()
+* ticks, is stored in the transaction.
+*
+* The transaction is left sorted and may be committed again. This routine must
+* not be called from interrupt context.
+*
+* RETURNS: OK, or ERROR if the transaction is invalid or a step fails.
+*
+* ERRNO: N/A
+*/
+
+STATUS rzg2XactCommit
+    (
+    RZG2_XACT * pXact   /* transaction */
+    )
+    {
+    UINT32  runFirst [RZG2_XACT_STEPS_MAX];
+    UINT32  runCount [RZG2_XACT_STEPS_MAX];
+    UINT32  runs = 0U;
+    UINT32  first;
+    UINT32  done;
+    UINT64  start;
+    STATUS  status = OK;
+
+    if ((pXact == NULL) || pXact->invalid)
+        {
+        return ERROR;
+        }
+
+    start = rzg2TimestampGet ();
+
+    rzg2XactSort (pXact);
+
+    for (first = 0U; first < pXact->numSteps; first += runCount [runs++])
+        {
+        runFirst [runs] = first;
+        runCount [runs] = rzg2XactRunLength (pXact, first);
+
+        if (rzg2XactRunApply (pXact, first, runCount [runs], &done) != OK)
+            {
+            rzg2XactRunUndo (pXact, first, done);
+            status = ERROR;
+            break;
+            }
+        }
+
+    if (status != OK)
+        {
+        while (runs > 0U)
+            {
+            runs--;
+            rzg2XactRunUndo (pXact, runFirst [runs], runCount [runs]);
+            }
+        }
+
+    pXact->ticks = rzg2TimestampGet () - start;
+
+    return status;
+    }
@@ -32,6 +32,17 @@
 /*
 modification history
 --------------------
+19oct26,agt  look up the lock statistics class before taking the lock
+19oct26,agt  added optional register lock statistics
+19oct26,agt  added divider and module stop context save and restore
+19oct26,agt  added module clock pre-enable at attach
+19oct26,agt  added rzg2CpgClkRatesSet()
+19oct26,agt  register access through RZG2_REG_READ32/WRITE32
+19oct26,agt  skip writes of clock bits already set, count skipped writes
+19oct26,agt  added lazy clock initialisation, pooled clock allocation
+19oct26,agt  added divider rate setting and boot clock plan
+19oct26,agt  added clock tree show routine
+19oct26,agt  added Z clock DVFS sequencing and latency statistics
 17sep19,hli  created (VXWPG-394)
 */
 
@@ -191,7 +202,107 @@ The clock names and associated parameters for clocks in the MSSR domain:
 
 \te
 
-The clkRateSet, clkParentSet and clkExtCtrl methods are not supported.
+The clkRateSet method is supported for the z and z2 CPU cluster clocks and for
+the programmable dividers: sdNh, sdN, rpc, rpcd2, hdmi, mso and canfd. Each
+divider is set to the highest frequency that does not exceed the requested rate.
+A divider output that is running is stopped while its divisor is changed. The
+clkParentSet and clkExtCtrl methods are not supported.
+
+A boot clock plan can be described in the device tree with the standard
+<assigned-clocks> and <assigned-clock-rates> properties, either in the CPG node
+or in any enabled node. At attach the driver collects every assignment that
+refers to a CPG clock and applies them together before the clocks are
+registered with vxbClkLib. The changes are applied in clock tree order, so
+parents are set before their children, and the divider outputs affected are
+stopped in one pass, reprogrammed, and restarted in one pass, with one write per
+register in each pass. Client drivers therefore do not need to set their clock
+rates during their own attach. The time taken to apply the plan is shown by
+rzg2CpgClkTreeShow(). For example:
+
+\cs
+    &cpg
+        {
+        assigned-clocks = <&cpg 39>,    /@ sd0 @/
+                          <&cpg 52>,    /@ mso @/
+                          <&cpg 53>;    /@ canfd @/
+        assigned-clock-rates = <200000000>, <66666666>, <40000000>;
+        };
+\ce
+
+By default every clock is initialised at attach, which reads the hardware state
+of each clock to set its initial reference count. If the CPG node has the
+<renesas,lazy-clocks> property, only the clocks referenced by the <clocks>
+property of enabled nodes, and their ancestors, are initialised at attach. Any
+other clock is initialised when it is first enabled, disabled or has its rate
+set. Every clock object is still created at attach, because a clock specifier
+selects a clock by its index in the static clock list registered with
+vxbClkLib, but the clocks and their contexts are allocated as arrays and the
+clock names refer to the driver's tables. For example:
+
+\cs
+    &cpg
+        {
+        renesas,lazy-clocks;
+        };
+\ce
+
+Frequency changes of the z and z2 clocks use the hardware frequency change
+sequence of the CPG. The new multipliers are staged in FRQCRC, and the change is
+committed by setting FRQCRB.KICK, which the CPG clears when the new frequency is
+in effect. Both clusters can be changed with a single commit by calling
+rzg2CpgDvfsZClkSet() directly, which avoids the vxbClkLib parent walk and is
+intended for governors that adjust the CPU frequency frequently. The duration of
+each commit is measured with the generic timer counter and can be displayed with
+rzg2CpgDvfsShow().
+
+The complete clock tree, with the rate, hardware status and reference count of
+each clock, can be displayed with rzg2CpgClkTreeShow(). The CPG clock rates are
+calculated in a single pass over the tree, each clock reusing the rate of its
+parent, and the MSSR module status registers are read once each. Passing TRUE
+prints the same information in CSV format, one line per clock.
+
+If the CPG node has the <renesas,pre-enable-clocks> property, the module clocks
+referenced by the <clocks> property of enabled nodes are started at attach,
+rather than one at a time by each driver. Each SMSTPCR register is written once
+for all its clocks, and the MSTPSR registers are polled once until all of them
+have started. The clocks started this way get no reference count from
+vxbClksInit(), unlike the clocks started by the boot firmware, so a driver's
+first enable writes nothing, and its matching disable stops the clock. A
+referenced module clock is started even if no driver claims its node;
+rzg2CpgPreEnableRelease(), called once the drivers have attached, stops the
+clocks that no driver has enabled. rzg2CpgClkTreeShow() reports the number of
+clocks started and the time taken. For example:
+
+\cs
+    &cpg
+        {
+        renesas,pre-enable-clocks;
+        };
+\ce
+
+Most module clocks, and the PLLs, are already running when VxWorks starts, as
+the boot firmware uses them. Enabling or disabling a clock whose register bits
+already have the requested value writes nothing, so no CPGWPR unlock is done
+either. rzg2CpgClkTreeShow() reports the number of register writes, and of
+writes skipped because the value was already set.
+
+The driver registers system suspend hooks with rzg2SuspendHookAdd(). Before
+suspend, the divider control registers of the clocks it sets, FRQCRC and the
+SMSTPCR registers are saved. On resume they are restored in that order, writing
+only the registers that differ, so the dividers are set before the modules they
+feed are restarted, and the MSTPSR registers are polled once for all the module
+clocks that were running.
+
+If the driver is built with RZG2_LOCK_STATS defined, the CPG mutex taken to
+enable and disable clocks records, for PLLECR, the divider control registers
+and the SMSTPCR registers, how often it is taken and contended, and its wait
+and hold times. rzg2CpgLockStatsShow() displays them.
+
+The DVFSCR0 and DVFSCR1 registers are reported by rzg2CpgDvfsShow() but are not
+written, as their programming sequence is not published for the RZ/G2M. Note
+that the DVFS module clock (198) is the clock of the IIC for DVFS, which is the
+PMIC interface, and is therefore handled by the I2C driver like any other module
+clock.
 
 INCLUDE FILES: vxBus.h vxbClkLib.h string.h vxbFdtLib.h
 
@@ -213,6 +324,7 @@ SEE ALSO: vxbClkLib,
 #include <hwif/vxBus.h>
 #include <hwif/buslib/vxbFdtLib.h>
 
+#include <rzg2Lib.h>
 #include <vxbFdtRsRzg2CpgMssr.h>
 #include <vxbFdtRsRzg2Rst.h>
 
@@ -258,6 +370,50 @@ LOCAL UINT32 cpgDbgMask = CPG_DBG_ALL;
 #define CPG_DOMAIN_NAME     "CPG"
 #define MSSR_DOMAIN_NAME    "MSSR"
 
+/* CPU cluster clock indexes in rzg2CpgClocks */
+
+#define CPG_Z_CLK_INDEX     14U
+#define CPG_Z2_CLK_INDEX    15U
+
+/* RPC clock indexes in rzg2CpgClocks, sharing the RPCCKCR divider fields */
+
+#define CPG_RPC_CLK_INDEX   47U
+#define CPG_RPCD2_CLK_INDEX 48U
+
+/* maximum polls of FRQCRB.KICK, each one register read */
+
+#define CPG_KICK_POLL_MAX   1000U
+
+/* maximum polls of the MSTPSR registers, each one pass over the registers */
+
+#define CPG_MSTP_POLL_MAX   1000U
+
+/* number of SMSTPCR and MSTPSR registers */
+
+#define CPG_MSTP_REGS       12U
+
+/* number of divider control registers saved over system suspend */
+
+#define CPG_CTX_DIV_REGS    10U
+
+/* register classes of the lock statistics */
+
+#define CPG_LOCK_PLL        0U      /* PLLECR */
+#define CPG_LOCK_DIV        1U      /* divider control registers */
+#define CPG_LOCK_MSTP       2U      /* SMSTPCRn */
+#define CPG_LOCK_CLASSES    3U
+
+/* maximum number of clock rates set in one batch, as by the boot clock plan */
+
+#define CPG_DIV_BATCH_MAX   24U
+
+/* divisor ranges of the programmable dividers */
+
+#define CPG_SDH_SRCFC_MAX   4U      /* SDnH divided by 1, 2, 4, 8 or 16 */
+#define CPG_SDH_SRCFC_HSTP  2U      /* SDnH must be stopped from /4 */
+#define CPG_SD_FC_MAX       1U      /* SDn divided by 2 or 4 */
+#define CPG_CKCR_DIV_MAX    64U     /* CKCR dividers divide by 1 to 64 */
+
 /* typedefs */
 
 /* structure to store the CPG information */
@@ -266,10 +422,39 @@ typedef struct vxbFdtCpgMssrInstance
     {
     VXB_DEV_ID      pDev;           /* VxBus driver ID */
     VXB_RESOURCE *  pCpgClkList;    /* static clock list */
+    VXB_CLK *       pClkPool;       /* clocks, in static clock list order */
+    void *          pCpgClkData;    /* CPG clock contexts */
+    void *          pMssrClkData;   /* MSSR clock contexts */
+    UINT8 *         pClkReady;      /* non-zero once each clock initialised */
+    BOOL            lazyInit;       /* initialise unreferenced clocks on use */
+    UINT32          clkInitCount;   /* clocks initialised so far */
     VXB_RESOURCE *  memRes;         /* mapped memory resource */
     VIRT_ADDR       regBase;        /* mapped CPG register base */
     void *          handle;         /* register memory access handle */
     SEM_ID          semMutex;       /* register access protection */
+    UINT32          dvfsCount;      /* Z clock frequency changes committed */
+    UINT32          dvfsTimeouts;   /* commits not completed by the CPG */
+    UINT64          dvfsLastTicks;  /* duration of last commit */
+    UINT64          dvfsMinTicks;   /* shortest commit */
+    UINT64          dvfsMaxTicks;   /* longest commit */
+    UINT64          dvfsTotalTicks; /* sum of all commit durations */
+    UINT32          planClocks;     /* clocks set by the boot clock plan */
+    UINT64          planTicks;      /* time to apply the boot clock plan */
+    UINT64          attachTicks;    /* time to attach */
+    UINT32          regWrites;      /* register writes */
+    UINT32          regSkips;       /* writes skipped, value already set */
+    BOOL            preEnable;      /* enable referenced gates at attach */
+    UINT32          preEnableGates; /* module clocks enabled at attach */
+    UINT32          preEnabled [CPG_MSTP_REGS]; /* started at attach */
+    UINT64          preEnableTicks; /* time to enable them */
+    BOOL            ctxValid;       /* context saved for system suspend */
+    UINT32          ctxDiv [CPG_CTX_DIV_REGS];  /* divider control registers */
+    UINT32          ctxFrqcrc;      /* FRQCRC */
+    UINT32          ctxMstpcr [CPG_MSTP_REGS];  /* SMSTPCRn */
+    UINT64          ctxRestoreTicks;    /* time of the last restore */
+#ifdef RZG2_LOCK_STATS
+    RZG2_LOCK_STAT  lockStats [CPG_LOCK_CLASSES];   /* by register class */
+#endif /* RZG2_LOCK_STATS */
     } VXB_FDT_CPG_INSTANCE;
 
 /* CPG specific dividers */
@@ -331,6 +516,26 @@ typedef struct mssrClkData
     UINT32 regBit;
     } MSSR_CLK_DATA;
 
+/* new divisor setting for a divider, as applied by rzg2CpgDividersApply() */
+
+typedef struct cpgDivSetting
+    {
+    UINT32          reg;            /* control register offset */
+    UINT32          mask;           /* divisor fields to change */
+    UINT32          bits;           /* new divisor field values */
+    UINT32          stopBits;       /* outputs stopped during the change */
+    UINT64          rate;           /* resulting clock rate */
+    } CPG_DIV_SETTING;
+
+/* divider control register saved over system suspend */
+
+typedef struct cpgCtxDiv
+    {
+    UINT32          reg;            /* control register offset */
+    UINT32          divMask;        /* divisor fields */
+    UINT32          stopMask;       /* output stop bits */
+    } CPG_CTX_DIV;
+
 typedef struct mssrClkDesc
     {
     char *          name;
@@ -345,8 +550,11 @@ LOCAL STATUS vxbFdtRzg2CpgMssrAttach (VXB_DEV_ID pDev);
 LOCAL STATUS rzg2CpgMssrClkEnable (struct vxb_clk * pClk);
 LOCAL STATUS rzg2CpgMssrClkDisable (struct vxb_clk * pClk);
 LOCAL UINT64 rzg2CpgMssrClkRateGet (struct vxb_clk * pClk, UINT64 parentRate);
+LOCAL STATUS rzg2CpgMssrClkRateSet (struct vxb_clk * pClk, UINT64 parentRate,
+                                    UINT64 rate);
 LOCAL UINT32 rzg2CpgMssrClkStatusGet (struct vxb_clk * pClk);
 LOCAL STATUS rzg2CpgMssrClkInit (struct vxb_clk * pClk);
+LOCAL void rzg2CpgClkLazyInit (struct vxb_clk * pClk);
 
 /* locals */
 
@@ -388,7 +596,7 @@ LOCAL VXB_CLK_FUNC rzg2CpgMssrMethods =
     {
     rzg2CpgMssrClkEnable,       /* clkEnable */
     rzg2CpgMssrClkDisable,      /* clkDisable */
-    NULL,                       /* No clkRateSet */
+    rzg2CpgMssrClkRateSet,      /* clkRateSet */
     rzg2CpgMssrClkRateGet,      /* clkRateGet */
     rzg2CpgMssrClkStatusGet,    /* clkStatusGet */
     NULL,                       /* No clkParentSet */
@@ -481,7 +689,7 @@ LOCAL const CPG_CLK_DESC rzg2CpgClocks [] =
     { "sd2",        42, VXB_CLK_DIVIDER,    0U, 0U, 2U, DIV_SD },       /* 43 */
 
     { "sd3h",       13, VXB_CLK_DIVIDER,    0U, 0U, 3U, DIV_SDH },      /* 44 */
-    { "sd3",        40, VXB_CLK_DIVIDER,    0U, 0U, 3U, DIV_SD },       /* 45 */
+    { "sd3",        44, VXB_CLK_DIVIDER,    0U, 0U, 3U, DIV_SD },       /* 45 */
 
     { "lb",         9, VXB_CLK_DIVIDER,    0U, 0U, 0U, DIV_LB },        /* 46 */
 
@@ -769,6 +977,10 @@ LOCAL const MSSR_CLK_DESC rzg2MssrClocks [] =
     };
 #define RZG2_MSSR_TOTAL_CLOCKS    (NELEMENTS (rzg2MssrClocks))
 
+/* CPG instance, for the routines called directly rather than via vxbClkLib */
+
+LOCAL VXB_FDT_CPG_INSTANCE * pRzg2Cpg = NULL;
+
 /* external mode pins from RST module */
 
 LOCAL UINT32 rstModePins;
@@ -807,7 +1019,7 @@ LOCAL UINT32 sdifRegisters [] = { SD0CKCR, SD1CKCR, SD2CKCR, SD3CKCR };
 
 /* MSTPSR registers */
 
-LOCAL UINT32 mstpsrOffset [] =
+LOCAL UINT32 mstpsrOffset [CPG_MSTP_REGS] =
     {
     MSTPSR0,
     MSTPSR1,
@@ -825,7 +1037,7 @@ LOCAL UINT32 mstpsrOffset [] =
 
 /* SMSTPCR registers */
 
-LOCAL UINT32 mstpcrOffset [] =
+LOCAL UINT32 mstpcrOffset [CPG_MSTP_REGS] =
     {
     SMSTPCR0,
     SMSTPCR1,
@@ -841,6 +1053,40 @@ LOCAL UINT32 mstpcrOffset [] =
     SMSTPCR11
     };
 
+/* divider control registers saved over system suspend */
+
+LOCAL const CPG_CTX_DIV cpgCtxDiv [CPG_CTX_DIV_REGS] =
+    {
+    {SD0CKCR,    SDnCKCR_SDnSRCFC_MASK | SDnCKCR_SDnFC_MASK,
+                 SDnCKCR_STPnHCK | SDnCKCR_STPnCK},
+    {SD1CKCR,    SDnCKCR_SDnSRCFC_MASK | SDnCKCR_SDnFC_MASK,
+                 SDnCKCR_STPnHCK | SDnCKCR_STPnCK},
+    {SD2CKCR,    SDnCKCR_SDnSRCFC_MASK | SDnCKCR_SDnFC_MASK,
+                 SDnCKCR_STPnHCK | SDnCKCR_STPnCK},
+    {SD3CKCR,    SDnCKCR_SDnSRCFC_MASK | SDnCKCR_SDnFC_MASK,
+                 SDnCKCR_STPnHCK | SDnCKCR_STPnCK},
+    {RPCCKCR,    RPCCKCR_RPC_DIV_MASK | RPCCKCR_RPCD2_DIV_MASK,
+                 RPCCKCR_CKSTP2 | RPCCKCR_CKSTP},
+    {CANFDCKCR,  CKCR_DIV_MASK, CKCR_CKSTP},
+    {MSOCKCR,    CKCR_DIV_MASK, CKCR_CKSTP},
+    {HDMICKCR,   CKCR_DIV_MASK, CKCR_CKSTP},
+    {CSI0CKCR,   CKCR_DIV_MASK, CKCR_CKSTP},
+    {CSIREFCKCR, CKCR_DIV_MASK, CKCR_CKSTP}
+    };
+
+#ifdef RZG2_LOCK_STATS
+
+/* lock statistics register class names */
+
+LOCAL const char * cpgLockClassName [CPG_LOCK_CLASSES] =
+    {
+    "PLLECR",
+    "divider",
+    "SMSTPCR"
+    };
+
+#endif /* RZG2_LOCK_STATS */
+
 /* globals */
 
 VXB_DRV vxbFdtRsRzg2CpgMssrDrv =
@@ -873,35 +1119,30 @@ LOCAL UINT32 rzg2CpgRead32
     UINT32                  offset
     )
     {
-    return vxbRead32 (pCpg->handle, (UINT32 *)(pCpg->regBase + offset));
+    return RZG2_REG_READ32 (pCpg->handle, (UINT32 *)(pCpg->regBase + offset));
     }
 
 /*******************************************************************************
 *
-* rzg2CpgSetBit32 - set individual bits in a 32-bit CPG register
+* rzg2CpgWrite32 - write a 32-bit CPG register
 *
-* This function sets just the individual <bits> in a 32-bit CPG register at
-* <offset>.
+* This function writes <val> to the 32-bit CPG register at <offset>, unlocking
+* the register first if CPG write protection is enabled. The caller must hold
+* the CPG mutex, so that the unlock and the write are not separated by another
+* register write.
 *
 * RETURNS: N/A.
 *
 * ERRNO: N/A.
 */
 
-LOCAL void rzg2CpgSetBit32
+LOCAL void rzg2CpgWrite32
     (
     VXB_FDT_CPG_INSTANCE *  pCpg,
     UINT32                  offset,
-    UINT32                  bits
+    UINT32                  val
     )
     {
-    UINT32 val;
-
-    (void)semTake (pCpg->semMutex, WAIT_FOREVER);
-
-    val = vxbRead32 (pCpg->handle, (UINT32 *)(pCpg->regBase + offset));
-    val |= bits;
-
     /*
      * If write protection is enabled, a target register can only be written
      * after writing the inverted data value to CPGWPR.
@@ -909,12 +1150,93 @@ LOCAL void rzg2CpgSetBit32
 
     if ((rzg2CpgRead32 (pCpg, CPGWPCR) & CPGWPCR_WPE) == CPGWPCR_WPE)
         {
-        vxbWrite32 (pCpg->handle, (UINT32 *)(pCpg->regBase + CPGWPR), ~val);
+        RZG2_REG_WRITE32 (pCpg->handle, (UINT32 *)(pCpg->regBase + CPGWPR),
+                          ~val);
         }
 
-    vxbWrite32 (pCpg->handle, (UINT32 *)(pCpg->regBase + offset), val);
+    RZG2_REG_WRITE32 (pCpg->handle, (UINT32 *)(pCpg->regBase + offset), val);
 
-    (void)semGive (pCpg->semMutex);
+    pCpg->regWrites++;
+    }
+
+#ifdef RZG2_LOCK_STATS
+
+/*******************************************************************************
+*
+* rzg2CpgLockClassGet - get the lock statistics class of a CPG register
+*
+* This function returns the lock statistics class of the CPG register at
+* <offset>, as updated by rzg2CpgSetBit32() and rzg2CpgClrBit32().
+*
+* RETURNS: the register class.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL UINT32 rzg2CpgLockClassGet
+    (
+    UINT32  offset      /* CPG register offset */
+    )
+    {
+    UINT32  i;
+
+    if (offset == PLLECR)
+        {
+        return CPG_LOCK_PLL;
+        }
+
+    for (i = 0U; i < CPG_MSTP_REGS; i++)
+        {
+        if (offset == mstpcrOffset [i])
+            {
+            return CPG_LOCK_MSTP;
+            }
+        }
+
+    return CPG_LOCK_DIV;
+    }
+
+#endif /* RZG2_LOCK_STATS */
+
+/*******************************************************************************
+*
+* rzg2CpgSetBit32 - set individual bits in a 32-bit CPG register
+*
+* This function sets just the individual <bits> in a 32-bit CPG register at
+* <offset>. The register is not written, nor unlocked, if the bits are already
+* set, as for the clocks enabled by the boot firmware.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2CpgSetBit32
+    (
+    VXB_FDT_CPG_INSTANCE *  pCpg,
+    UINT32                  offset,
+    UINT32                  bits
+    )
+    {
+    UINT32 val;
+#ifdef RZG2_LOCK_STATS
+    RZG2_LOCK_STAT * pStats = &pCpg->lockStats [rzg2CpgLockClassGet (offset)];
+    UINT64 takeTime;
+#endif /* RZG2_LOCK_STATS */
+
+    RZG2_LOCK_TAKE (pCpg->semMutex, pStats, takeTime);
+
+    val = rzg2CpgRead32 (pCpg, offset);
+    if ((val & bits) == bits)
+        {
+        pCpg->regSkips++;
+        }
+    else
+        {
+        rzg2CpgWrite32 (pCpg, offset, val | bits);
+        }
+
+    RZG2_LOCK_GIVE (pCpg->semMutex, pStats, takeTime);
     }
 
 /*******************************************************************************
@@ -922,7 +1244,8 @@ LOCAL void rzg2CpgSetBit32
 * rzg2CpgClrBit32 - clear individual bits in a 32-bit CPG register
 *
 * This function clears just the individual <bits> in a 32-bit CPG register at
-* <offset>.
+* <offset>. The register is not written, nor unlocked, if the bits are already
+* clear, as for the module clocks enabled by the boot firmware.
 *
 * RETURNS: N/A.
 *
@@ -937,25 +1260,24 @@ LOCAL void rzg2CpgClrBit32
     )
     {
     UINT32 val;
+#ifdef RZG2_LOCK_STATS
+    RZG2_LOCK_STAT * pStats = &pCpg->lockStats [rzg2CpgLockClassGet (offset)];
+    UINT64 takeTime;
+#endif /* RZG2_LOCK_STATS */
 
-    (void)semTake (pCpg->semMutex, WAIT_FOREVER);
-
-    val = vxbRead32 (pCpg->handle, (UINT32 *)(pCpg->regBase + offset));
-    val &= ~bits;
-
-    /*
-     * If write protection is enabled, a target register can only be written
-     * after writing the inverted data value to CPGWPR.
-     */
+    RZG2_LOCK_TAKE (pCpg->semMutex, pStats, takeTime);
 
-    if ((rzg2CpgRead32 (pCpg, CPGWPCR) & CPGWPCR_WPE) == CPGWPCR_WPE)
+    val = rzg2CpgRead32 (pCpg, offset);
+    if ((val & bits) == 0U)
         {
-        vxbWrite32 (pCpg->handle, (UINT32 *)(pCpg->regBase + CPGWPR), ~val);
+        pCpg->regSkips++;
+        }
+    else
+        {
+        rzg2CpgWrite32 (pCpg, offset, val & ~bits);
         }
 
-    vxbWrite32 (pCpg->handle, (UINT32 *)(pCpg->regBase + offset), val);
-
-    (void)semGive (pCpg->semMutex);
+    RZG2_LOCK_GIVE (pCpg->semMutex, pStats, takeTime);
     }
 
 /*******************************************************************************
@@ -1017,7 +1339,8 @@ LOCAL STATUS rzg2RstModePinsRead
 
     /* read the RST Mode Monitor Register */
 
-    *pModePins = vxbRead32 (resAdr.pHandle, (UINT32 *)(resAdr.virtAddr + MODEMR));
+    *pModePins = RZG2_REG_READ32 (resAdr.pHandle,
+                                  (UINT32 *)(resAdr.virtAddr + MODEMR));
 
     RZG2_DBG_MSG (CPG_DBG_INFO, "RST MODEMR: %08x\n", *pModePins);
 
@@ -1158,6 +1481,8 @@ LOCAL STATUS rzg2CpgMssrClkStatusSet
 
     pCpg = (VXB_FDT_CPG_INSTANCE *) vxbDevSoftcGet (pClk->pDev);
 
+    rzg2CpgClkLazyInit (pClk);
+
     switch (pClk->clkType)
         {
         case VXB_CLK_FIX_RATE:
@@ -1808,509 +2133,2192 @@ LOCAL UINT64 rzg2CpgMssrClkRateGet
 
 /*******************************************************************************
 *
-* rzg2CpgMssrClkStatusGet - get CPG/MMSR clock status
+* rzg2CpgZClkFcGet - get the FRQCRC field value for a Z clock rate
 *
-* This routine get the clock status for the specified CPG/MSSR clock.
+* This function calculates the ZFC or Z2FC field value that gives the highest Z
+* clock frequency not exceeding <rate>, for a parent PLL running at
+* <parentRate>. The field value is returned in <pFc>.
 *
-* RETURNS: CLOCK_STATUS_ENABLED if the clock is on, CLOCK_STATUS_GATED if the
-* clock is off, and CLOCK_STATUS_UNKNOWN for indeterminate status, or error.
+* RETURNS: OK if the rate can be generated, ERROR otherwise.
 *
 * ERRNO: N/A.
 */
 
-LOCAL UINT32 rzg2CpgMssrClkStatusGet
+LOCAL STATUS rzg2CpgZClkFcGet
     (
-    struct vxb_clk * pClk
+    UINT64      parentRate,     /* frequency of parent PLL */
+    UINT64      rate,           /* requested frequency */
+    UINT32 *    pFc             /* returned field value */
     )
     {
-    VXB_FDT_CPG_INSTANCE *  pCpg;           /* CPG driver data */
-    MSSR_CLK_DATA *         pMssrClk;       /* MSSR clock data */
-    CPG_CLK_DATA *          pCpgClk;        /* CPG clock data */
-    UINT32                  cpgReg = 0U;    /* CPG/MSSR register offset */
-    UINT32                  bitMask;        /* Register bit mask */
-    UINT32                  clockStatus = CLOCK_STATUS_UNKNOWN;
+    UINT64 mult;
 
-    if (pClk == NULL)
+    if ((parentRate == 0U) || (parentRate == CLOCK_RATE_INVALID) ||
+        (rate > parentRate))
         {
-        return CLOCK_STATUS_UNKNOWN;
+        return ERROR;
         }
 
-    pCpg = (VXB_FDT_CPG_INSTANCE *) vxbDevSoftcGet (pClk->pDev);
-
-    switch (pClk->clkType)
+    mult = (rate * FRQCRC_ZxFC_MULT_MAX) / parentRate;
+    if (mult == 0U)
         {
-        case VXB_CLK_FIX_RATE:
-            /* fixed rate root clocks always on in CPG */
-
-            clockStatus = CLOCK_STATUS_ENABLED;
-            break;
-
-        case VXB_CLK_FIX_FACTOR:
-            /* depends on parent, from stored VXB_CLK setting */
-
-            clockStatus = pClk->parentClock->clkStatus;
-            break;
-
-        case VXB_CLK_PLL:
-            pCpgClk = (CPG_CLK_DATA *)pClk->clkContext;
-            bitMask = rzg2CpgRead32 (pCpg, PLLECR) &
-                      PLLECR_PLLnST (pCpgClk->variable.index);
-            if (bitMask == 0U)
-                {
-                clockStatus = CLOCK_STATUS_GATED;
-                }
-            else
-                {
-                clockStatus = CLOCK_STATUS_ENABLED;
-                }
-            break;
-
-        case VXB_CLK_DIVIDER:
-            pCpgClk = (CPG_CLK_DATA *)pClk->clkContext;
+        return ERROR;
+        }
 
-            if (rzg2CpgDividerStatusRegMaskGet (pCpgClk, &cpgReg, &bitMask) == OK)
-                {
-                if (cpgReg != 0U)
-                    {
-                    if ((rzg2CpgRead32 (pCpg, cpgReg) & bitMask) == 0U)
-                        {
-                        clockStatus = CLOCK_STATUS_ENABLED;
-                        }
-                    else
-                        {
-                        clockStatus = CLOCK_STATUS_GATED;
-                        }
-                    }
-                else
-                    {
-                    /* depends on parent, from stored VXB_CLK setting */
+    *pFc = FRQCRC_ZxFC_MULT_MAX - (UINT32)mult;
 
-                    clockStatus = pClk->parentClock->clkStatus;
-                    }
-                }
-            break;
+    return OK;
+    }
 
-        case VXB_CLK_GATE:
-            /* MSSR module clock */
+/*******************************************************************************
+*
+* rzg2CpgKickWait - wait for a frequency change to complete
+*
+* This function polls FRQCRB until the CPG has cleared the KICK bit, indicating
+* that the last frequency change is complete. The caller must hold the CPG
+* mutex.
+*
+* RETURNS: OK if KICK is clear, ERROR on timeout.
+*
+* ERRNO: N/A.
+*/
 
-            pMssrClk = (MSSR_CLK_DATA *)pClk->clkContext;
-            cpgReg = mstpsrOffset [pMssrClk->moduleReg];
-            bitMask = 1U << pMssrClk->regBit;
-            if ((rzg2CpgRead32 (pCpg, cpgReg) & bitMask) == 0U)
-                {
-                clockStatus = CLOCK_STATUS_ENABLED;
-                }
-            else
-                {
-                clockStatus = CLOCK_STATUS_GATED;
-                }
-            break;
+LOCAL STATUS rzg2CpgKickWait
+    (
+    VXB_FDT_CPG_INSTANCE *  pCpg
+    )
+    {
+    UINT32 poll;
 
-        default:
-            RZG2_DBG_MSG (CPG_DBG_ERR, "Unexpected clock type\n");
-            break;
+    for (poll = 0U; poll < CPG_KICK_POLL_MAX; poll++)
+        {
+        if ((rzg2CpgRead32 (pCpg, FRQCRB) & FRQCRB_KICK) == 0U)
+            {
+            return OK;
+            }
         }
 
-    return clockStatus;
+    return ERROR;
     }
 
 /*******************************************************************************
 *
-* rzg2CpgMssrClkInit - CPG/MMSR clock initialisation
-*
-* This routine initialise the clock status for the specified CPG/MSSR clock.
+* rzg2CpgZClkCommit - stage and commit a Z clock frequency change
 *
-* This function is required to set an initial reference count for all software
-* controllable clocks whose initial hardware status is enabled.
+* This function writes the FRQCRC fields selected by <mask> with <bits> and
+* then sets FRQCRB.KICK, so that the CPG changes the Z and Z2 clock frequencies
+* together. The time from staging the new value until the CPG reports
+* completion is accumulated in the DVFS statistics. Nothing is written if the
+* fields already hold the requested values.
 *
-* RETURNS: OK if clock initialised, ERROR otherwise.
+* RETURNS: OK if the change is complete, ERROR otherwise.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS rzg2CpgMssrClkInit
+LOCAL STATUS rzg2CpgZClkCommit
     (
-    struct vxb_clk * pClk
+    VXB_FDT_CPG_INSTANCE *  pCpg,       /* CPG driver data */
+    UINT32                  mask,       /* FRQCRC fields to change */
+    UINT32                  bits        /* new FRQCRC field values */
     )
     {
-    VXB_FDT_CPG_INSTANCE *  pCpg;       /* CPG driver data */
-    CPG_CLK_DATA *          pCpgClk;    /* CPG clock data */
-    STATUS                  retStatus = OK;
+    STATUS  retStatus = ERROR;
+    UINT32  frqcrc;
+    UINT64  startTicks;
+    UINT64  ticks;
+#ifdef RZG2_LOCK_STATS
+    UINT64  takeTime;
+#endif /* RZG2_LOCK_STATS */
 
-    if (pClk == NULL)
-        {
-        return ERROR;
-        }
+    RZG2_LOCK_TAKE (pCpg->semMutex, &pCpg->lockStats [CPG_LOCK_DIV],
+                    takeTime);
 
-    pCpg = (VXB_FDT_CPG_INSTANCE *) vxbDevSoftcGet (pClk->pDev);
-    pCpgClk = (CPG_CLK_DATA *)pClk->clkContext;
+    /* FRQCRC must not be written while a change is in progress */
 
-    if (vxbClkStatusGet (pClk) == CLOCK_STATUS_ENABLED)
+    if (rzg2CpgKickWait (pCpg) == OK)
         {
-        switch (pClk->clkType)
+        frqcrc = rzg2CpgRead32 (pCpg, FRQCRC);
+        if ((frqcrc & mask) == bits)
             {
-            case VXB_CLK_PLL:
+            retStatus = OK;
+            }
+        else
+            {
+            startTicks = rzg2TimestampGet ();
+
+            rzg2CpgWrite32 (pCpg, FRQCRC, (frqcrc & ~mask) | bits);
+            rzg2CpgWrite32 (pCpg, FRQCRB,
+                            rzg2CpgRead32 (pCpg, FRQCRB) | FRQCRB_KICK);
+
+            if (rzg2CpgKickWait (pCpg) == OK)
+                {
+                ticks = rzg2TimestampGet () - startTicks;
+
+                if ((pCpg->dvfsCount == 0U) || (ticks < pCpg->dvfsMinTicks))
+                    {
+                    pCpg->dvfsMinTicks = ticks;
+                    }
+                if (ticks > pCpg->dvfsMaxTicks)
+                    {
+                    pCpg->dvfsMaxTicks = ticks;
+                    }
+                pCpg->dvfsLastTicks = ticks;
+                pCpg->dvfsTotalTicks += ticks;
+                pCpg->dvfsCount++;
+
+                retStatus = OK;
+                }
+            }
+        }
+
+    if (retStatus == ERROR)
+        {
+        pCpg->dvfsTimeouts++;
+        RZG2_DBG_MSG (CPG_DBG_ERR, "FRQCRB.KICK timeout\n");
+        }
+
+    RZG2_LOCK_GIVE (pCpg->semMutex, &pCpg->lockStats [CPG_LOCK_DIV],
+                    takeTime);
+
+    return retStatus;
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgDivSettingGet - get the divisor setting for a divider clock rate
+*
+* This function calculates the divisor field values that give the highest
+* frequency not exceeding <rate> for the divider clock <pClk>, when its parent
+* runs at <parentRate>. The register, fields, output stop bits and the resulting
+* rate are returned in <pSet>. Nothing is written to the hardware.
+*
+* The rpc and rpcd2 clocks share one set of fields, so setting either one also
+* changes the other.
+*
+* RETURNS: OK if the rate can be generated, ERROR otherwise.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2CpgDivSettingGet
+    (
+    struct vxb_clk *    pClk,       /* VxBus clock */
+    UINT64              parentRate, /* frequency of parent clock */
+    UINT64              rate,       /* requested frequency */
+    CPG_DIV_SETTING *   pSet        /* returned setting */
+    )
+    {
+    CPG_DIV_TYPE    type;
+    UINT32          index;
+    UINT32          fc;
+    UINT32          rpcDiv;
+    UINT32          rpcd2Div;
+    UINT64          target;
+    UINT64          div;
+
+    if ((pClk == NULL) || (pClk->clkType != VXB_CLK_DIVIDER) ||
+        (pClk->clkContext == NULL) || (rate == 0U) ||
+        (parentRate == 0U) || (parentRate == CLOCK_RATE_INVALID))
+        {
+        return ERROR;
+        }
+
+    type = ((CPG_CLK_DATA *) pClk->clkContext)->variable.type;
+    index = ((CPG_CLK_DATA *) pClk->clkContext)->variable.index;
+
+    (void)memset (pSet, 0, sizeof (CPG_DIV_SETTING));
+
+    switch (type)
+        {
+        case DIV_SYSCPU:
+            if (rzg2CpgZClkFcGet (parentRate, rate, &fc) == ERROR)
+                {
+                return ERROR;
+                }
+
+            pSet->reg = FRQCRC;
+            if (index == 1U)
+                {
+                pSet->mask = FRQCRC_ZFC_MASK;
+                pSet->bits = fc << FRQCRC_ZFC_SHIFT;
+                }
+            else
+                {
+                pSet->mask = FRQCRC_Z2FC_MASK;
+                pSet->bits = fc << FRQCRC_Z2FC_SHIFT;
+                }
+            pSet->rate = parentRate * (FRQCRC_ZxFC_MULT_MAX - fc) /
+                         FRQCRC_ZxFC_MULT_MAX;
+            break;
+
+        case DIV_SDH:
+            if (index >= NELEMENTS (sdifRegisters))
+                {
+                return ERROR;
+                }
+
+            for (fc = 0U; fc < CPG_SDH_SRCFC_MAX; fc++)
+                {
+                if ((parentRate >> fc) <= rate)
+                    {
+                    break;
+                    }
+                }
+
+            if ((parentRate >> fc) > rate)
+                {
+                return ERROR;
+                }
+
+            pSet->reg = sdifRegisters [index];
+            pSet->mask = SDnCKCR_SDnSRCFC_MASK;
+            pSet->bits = fc << SDnCKCR_SDnSRCFC_SHIFT;
+            pSet->stopBits = SDnCKCR_STPnCK;
+
+            /*
+             * SDnH must be stopped at the lower rates, so must be unused. At
+             * the higher rates, SDnH is restarted if it is in use, as it may
+             * have been stopped by a lower rate setting.
+             */
+
+            if (fc >= CPG_SDH_SRCFC_HSTP)
+                {
+                if (pClk->clkRefs != 0U)
+                    {
+                    return ERROR;
+                    }
+
+                pSet->mask |= SDnCKCR_STPnHCK;
+                pSet->bits |= SDnCKCR_STPnHCK;
+                }
+            else if (pClk->clkRefs != 0U)
+                {
+                pSet->mask |= SDnCKCR_STPnHCK;
+                }
+
+            pSet->rate = parentRate >> fc;
+            break;
+
+        case DIV_SD:
+            if (index >= NELEMENTS (sdifRegisters))
+                {
+                return ERROR;
+                }
+
+            for (fc = 0U; fc < CPG_SD_FC_MAX; fc++)
+                {
+                if ((parentRate / (2U << fc)) <= rate)
+                    {
+                    break;
+                    }
+                }
+
+            if ((parentRate / (2U << fc)) > rate)
+                {
+                return ERROR;
+                }
+
+            pSet->reg = sdifRegisters [index];
+            pSet->mask = SDnCKCR_SDnFC_MASK;
+            pSet->bits = fc;
+            pSet->stopBits = SDnCKCR_STPnCK;
+            pSet->rate = parentRate / (2U << fc);
+            break;
+
+        case DIV_RPCSRC:
+            /*
+             * RPC is the parent divided by 5 or 6 and then by 2, 4, 6 or 8,
+             * and RPCD2 is half of RPC. Choose the fastest combination.
+             */
+
+            target = (index == 0U) ? rate : (rate * 2U);
+            div = 0U;
+
+            for (rpcDiv = RCPCKCR_RPC_DIV_VALID_MIN; rpcDiv <= 3U; rpcDiv++)
+                {
+                for (fc = 1U; fc <= 7U; fc += 2U)
+                    {
+                    if ((parentRate / ((rpcDiv + 3U) * (fc + 1U)) <= target) &&
+                        ((div == 0U) ||
+                         (((rpcDiv + 3U) * (fc + 1U)) < div)))
+                        {
+                        div = (rpcDiv + 3U) * (fc + 1U);
+                        pSet->bits = (rpcDiv << RPCCKCR_RPC_DIV_SHIFT) |
+                                     (fc << RPCCKCR_RPCD2_DIV_SHIFT);
+                        }
+                    }
+                }
+
+            if (div == 0U)
+                {
+                return ERROR;
+                }
+
+            rpcd2Div = (index == 0U) ? 1U : 2U;
+
+            pSet->reg = RPCCKCR;
+            pSet->mask = RPCCKCR_RPC_DIV_MASK | RPCCKCR_RPCD2_DIV_MASK;
+            pSet->stopBits = RPCCKCR_CKSTP | RPCCKCR_CKSTP2;
+            pSet->rate = parentRate / (div * rpcd2Div);
+            break;
+
+        case DIV_HDMIIF:
+        case DIV_CSI0:
+        case DIV_CSIREF:
+        case DIV_MSIOF:
+        case DIV_CANFD:
+            div = (parentRate + rate - 1U) / rate;
+            if (div > CPG_CKCR_DIV_MAX)
+                {
+                return ERROR;
+                }
+
+            switch (type)
+                {
+                case DIV_HDMIIF:
+                    pSet->reg = HDMICKCR;
+                    break;
+
+                case DIV_CSI0:
+                    pSet->reg = CSI0CKCR;
+                    break;
+
+                case DIV_CSIREF:
+                    pSet->reg = CSIREFCKCR;
+                    break;
+
+                case DIV_MSIOF:
+                    pSet->reg = MSOCKCR;
+                    break;
+
+                default:
+                    pSet->reg = CANFDCKCR;
+                    break;
+                }
+
+            pSet->mask = CKCR_DIV_MASK;
+            pSet->bits = (UINT32)div - 1U;
+            pSet->stopBits = CKCR_CKSTP;
+            pSet->rate = parentRate / div;
+            break;
+
+        default:
+            return ERROR;
+        }
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgDividersApply - apply a batch of divisor settings
+*
+* This function applies the <count> divisor settings in <pSet>, in order, so a
+* later setting of the same fields overrides an earlier one. The settings are
+* first merged per register. The divider outputs that are running in each
+* changed register are then stopped with one write per register, the new
+* divisors are written, and only the outputs stopped here are restarted, again
+* with one write per register. Registers that already hold the requested values
+* are not written. Z clock changes are committed together in one FRQCRB.KICK
+* sequence.
+*
+* RETURNS: OK if all settings are applied, ERROR otherwise.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2CpgDividersApply
+    (
+    VXB_FDT_CPG_INSTANCE *  pCpg,       /* CPG driver data */
+    CPG_DIV_SETTING *       pSet,       /* settings to apply */
+    UINT32                  count       /* number of settings */
+    )
+    {
+    UINT32  reg [CPG_DIV_BATCH_MAX];
+    UINT32  mask [CPG_DIV_BATCH_MAX];
+    UINT32  bits [CPG_DIV_BATCH_MAX];
+    UINT32  stopBits [CPG_DIV_BATCH_MAX];
+    UINT32  value [CPG_DIV_BATCH_MAX];
+    UINT32  zMask = 0U;
+    UINT32  zBits = 0U;
+    UINT32  regs = 0U;
+    UINT32  i;
+    UINT32  j;
+#ifdef RZG2_LOCK_STATS
+    UINT64  takeTime;
+#endif /* RZG2_LOCK_STATS */
+
+    if (count > CPG_DIV_BATCH_MAX)
+        {
+        return ERROR;
+        }
+
+    /* merge the settings per register */
+
+    for (i = 0U; i < count; i++)
+        {
+        if (pSet [i].reg == FRQCRC)
+            {
+            zMask |= pSet [i].mask;
+            zBits = (zBits & ~pSet [i].mask) | pSet [i].bits;
+            continue;
+            }
+
+        for (j = 0U; j < regs; j++)
+            {
+            if (reg [j] == pSet [i].reg)
+                {
+                break;
+                }
+            }
+
+        if (j == regs)
+            {
+            reg [j] = pSet [i].reg;
+            mask [j] = 0U;
+            bits [j] = 0U;
+            stopBits [j] = 0U;
+            regs++;
+            }
+
+        mask [j] |= pSet [i].mask;
+        bits [j] = (bits [j] & ~pSet [i].mask) | pSet [i].bits;
+        stopBits [j] |= pSet [i].stopBits;
+        }
+
+    RZG2_LOCK_TAKE (pCpg->semMutex, &pCpg->lockStats [CPG_LOCK_DIV],
+                    takeTime);
+
+    /* stop the running outputs of the registers that change */
+
+    for (j = 0U; j < regs; j++)
+        {
+        value [j] = rzg2CpgRead32 (pCpg, reg [j]);
+        if ((value [j] & mask [j]) == bits [j])
+            {
+            mask [j] = 0U;
+            pCpg->regSkips++;
+            continue;
+            }
+
+        stopBits [j] &= ~value [j] & ~mask [j];
+        if (stopBits [j] != 0U)
+            {
+            value [j] |= stopBits [j];
+            rzg2CpgWrite32 (pCpg, reg [j], value [j]);
+            }
+        }
+
+    /* program the new divisors */
+
+    for (j = 0U; j < regs; j++)
+        {
+        if (mask [j] != 0U)
+            {
+            value [j] = (value [j] & ~mask [j]) | bits [j];
+            rzg2CpgWrite32 (pCpg, reg [j], value [j]);
+            }
+        }
+
+    /* restart the outputs stopped above */
+
+    for (j = 0U; j < regs; j++)
+        {
+        if ((mask [j] != 0U) && (stopBits [j] != 0U))
+            {
+            rzg2CpgWrite32 (pCpg, reg [j], value [j] & ~stopBits [j]);
+            }
+        }
+
+    RZG2_LOCK_GIVE (pCpg->semMutex, &pCpg->lockStats [CPG_LOCK_DIV],
+                    takeTime);
+
+    if (zMask != 0U)
+        {
+        return rzg2CpgZClkCommit (pCpg, zMask, zBits);
+        }
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgRatesApply - set the rates of a batch of CPG clocks
+*
+* This function sets the <count> CPG clocks <pIndex> to the rates <pRate> in one
+* batch. The new rate of each clock is calculated in rzg2CpgClocks table order,
+* which lists parents before their children, so each clock is set using the new
+* rate of its parent. The settings are collected in the same order and applied
+* with rzg2CpgDividersApply(). The new rate of every CPG clock is then read back
+* from the registers and returned in <pNewRate>.
+*
+* RETURNS: OK if the rates are set, ERROR otherwise.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2CpgRatesApply
+    (
+    VXB_FDT_CPG_INSTANCE *  pCpg,       /* CPG driver data */
+    const UINT32 *          pIndex,     /* CPG clock indexes */
+    const UINT64 *          pRate,      /* requested rates */
+    UINT32                  count,      /* number of clocks */
+    UINT64 *                pNewRate    /* new rates, RZG2_CPG_TOTAL_CLOCKS */
+    )
+    {
+    VXB_CLK_ID *    pClkList = (VXB_CLK_ID *) pCpg->pCpgClkList;
+    CPG_DIV_SETTING setting [CPG_DIV_BATCH_MAX];
+    UINT32          settings = 0U;
+    UINT64          parentRate;
+    int             parent;
+    UINT32          i;
+    UINT32          j;
+
+    /* calculate the new rates parents first, collecting the settings */
+
+    for (i = 0U; i < RZG2_CPG_TOTAL_CLOCKS; i++)
+        {
+        parent = rzg2CpgClocks [i].parentIndex;
+        parentRate = (parent < 0) ? 0U : pNewRate [parent];
+
+        for (j = 0U; j < count; j++)
+            {
+            if (pIndex [j] == i)
+                {
+                break;
+                }
+            }
+
+        if (j == count)
+            {
+            if ((parent >= 0) && (parentRate == CLOCK_RATE_INVALID))
+                {
+                pNewRate [i] = CLOCK_RATE_INVALID;
+                }
+            else
+                {
+                pNewRate [i] = rzg2CpgMssrClkRateGet (pClkList [i], parentRate);
+                }
+            continue;
+            }
+
+        if (rzg2CpgDivSettingGet (pClkList [i], parentRate, pRate [j],
+                                  &setting [settings]) == ERROR)
+            {
+            RZG2_DBG_MSG (CPG_DBG_ERR, "%s cannot be set to %lld\n",
+                          rzg2CpgClocks [i].name, pRate [j]);
+            return ERROR;
+            }
+
+        pNewRate [i] = setting [settings++].rate;
+        }
+
+    if (rzg2CpgDividersApply (pCpg, setting, settings) == ERROR)
+        {
+        return ERROR;
+        }
+
+    /*
+     * A setting also changes the clock sharing its fields, rpc or rpcd2, and
+     * the clocks derived from it, and if both are in the batch the later one
+     * in table order wins. Read the new rates back from the registers.
+     */
+
+    for (i = 0U; i < RZG2_CPG_TOTAL_CLOCKS; i++)
+        {
+        parent = rzg2CpgClocks [i].parentIndex;
+        parentRate = (parent < 0) ? 0U : pNewRate [parent];
+
+        if ((parent >= 0) && (parentRate == CLOCK_RATE_INVALID))
+            {
+            pNewRate [i] = CLOCK_RATE_INVALID;
+            }
+        else
+            {
+            pNewRate [i] = rzg2CpgMssrClkRateGet (pClkList [i], parentRate);
+            }
+        }
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgSiblingGet - get the clock sharing divider fields with a clock
+*
+* The rpc and rpcd2 clocks are both divided from pll1 by the RPCCKCR fields, so
+* setting the rate of one changes the other.
+*
+* RETURNS: the rzg2CpgClocks index of the clock sharing the fields of clock
+* <index>, or -1 if there is none.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL int rzg2CpgSiblingGet
+    (
+    UINT32  index       /* rzg2CpgClocks index */
+    )
+    {
+    if (index == CPG_RPC_CLK_INDEX)
+        {
+        return (int) CPG_RPCD2_CLK_INDEX;
+        }
+
+    if (index == CPG_RPCD2_CLK_INDEX)
+        {
+        return (int) CPG_RPC_CLK_INDEX;
+        }
+
+    return -1;
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgMssrClkRateSet - set CPG clock rate
+*
+* This routine sets the clock frequency for the specified CPG divider clock to
+* the highest frequency that does not exceed <rate>. The z and z2 CPU cluster
+* clocks and the sdNh, sdN, rpc, rpcd2, hdmi, mso and canfd dividers are
+* supported.
+*
+* RETURNS: OK if the rate is set, ERROR otherwise.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2CpgMssrClkRateSet
+    (
+    struct vxb_clk *    pClk,       /* VxBus clock */
+    UINT64              parentRate, /* frequency of parent clock */
+    UINT64              rate        /* requested frequency */
+    )
+    {
+    VXB_FDT_CPG_INSTANCE *  pCpg;       /* CPG driver data */
+    CPG_DIV_SETTING         setting;    /* new divisor setting */
+
+    if (rzg2CpgDivSettingGet (pClk, parentRate, rate, &setting) == ERROR)
+        {
+        return ERROR;
+        }
+
+    pCpg = (VXB_FDT_CPG_INSTANCE *) vxbDevSoftcGet (pClk->pDev);
+
+    rzg2CpgClkLazyInit (pClk);
+
+    return rzg2CpgDividersApply (pCpg, &setting, 1U);
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgDvfsZClkSet - set the CPU cluster clock frequencies
+*
+* This routine changes the z clock to <zRate> and the z2 clock to <z2Rate> in a
+* single hardware frequency change. A rate of zero leaves that clock unchanged.
+* Each clock is set to the highest frequency that does not exceed the requested
+* rate, in steps of 1/32 of the parent PLL frequency.
+*
+* This routine does not go through vxbClkLib, so it is quick enough to be called
+* whenever the CPU frequency governor runs. It must not be called from interrupt
+* context.
+*
+* RETURNS: OK if the frequencies are set, ERROR otherwise.
+*
+* ERRNO: N/A.
+*/
+
+STATUS rzg2CpgDvfsZClkSet
+    (
+    UINT64  zRate,      /* new z clock frequency, or 0 */
+    UINT64  z2Rate      /* new z2 clock frequency, or 0 */
+    )
+    {
+    VXB_FDT_CPG_INSTANCE *  pCpg = pRzg2Cpg;
+    VXB_CLK_ID *            pClkList;
+    VXB_CLK_ID              pZClk;
+    VXB_CLK_ID              pZ2Clk;
+    UINT32                  mask = 0U;
+    UINT32                  bits = 0U;
+    UINT32                  fc;
+
+    if (pCpg == NULL)
+        {
+        return ERROR;
+        }
+
+    pClkList = (VXB_CLK_ID *) pCpg->pCpgClkList;
+    pZClk = pClkList [CPG_Z_CLK_INDEX];
+    pZ2Clk = pClkList [CPG_Z2_CLK_INDEX];
+
+    if (zRate != 0U)
+        {
+        if (rzg2CpgZClkFcGet (pZClk->parentClock->clkRate, zRate,
+                              &fc) == ERROR)
+            {
+            return ERROR;
+            }
+
+        mask |= FRQCRC_ZFC_MASK;
+        bits |= fc << FRQCRC_ZFC_SHIFT;
+        }
+
+    if (z2Rate != 0U)
+        {
+        if (rzg2CpgZClkFcGet (pZ2Clk->parentClock->clkRate, z2Rate,
+                              &fc) == ERROR)
+            {
+            return ERROR;
+            }
+
+        mask |= FRQCRC_Z2FC_MASK;
+        bits |= fc << FRQCRC_Z2FC_SHIFT;
+        }
+
+    if (mask == 0U)
+        {
+        return OK;
+        }
+
+    if (rzg2CpgZClkCommit (pCpg, mask, bits) == ERROR)
+        {
+        return ERROR;
+        }
+
+    /* keep the rates cached by vxbClkLib up to date */
+
+    if (zRate != 0U)
+        {
+        pZClk->clkRate = rzg2CpgMssrClkRateGet (pZClk,
+                                                pZClk->parentClock->clkRate);
+        }
+
+    if (z2Rate != 0U)
+        {
+        pZ2Clk->clkRate = rzg2CpgMssrClkRateGet (pZ2Clk,
+                                                 pZ2Clk->parentClock->clkRate);
+        }
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgClkRatesSet - set the rates of several CPG clocks together
+*
+* This routine sets each of the <count> CPG divider clocks <pClks> to the highest
+* frequency that does not exceed the matching rate in <pRates>, in one batch: the
+* outputs of each changed register are stopped, reprogrammed and restarted with
+* one write, and one CPGWPR unlock, per register in each pass. A clock may be a
+* child of another clock in the batch. The rates cached by vxbClkLib for the
+* clocks and their descendants are updated.
+*
+* This routine is used for changes that must be made together, such as the SD
+* clock dividers of an interface mode switch, and does not go through the
+* vxbClkLib parent walk. It must not be called from interrupt context.
+*
+* RETURNS: OK if the rates are set, ERROR if the CPG is not attached, a clock is
+* not a CPG clock or cannot be set to the rate, or too many clocks are given.
+*
+* ERRNO: N/A.
+*/
+
+STATUS rzg2CpgClkRatesSet
+    (
+    VXB_CLK_ID *    pClks,      /* CPG clocks */
+    const UINT64 *  pRates,     /* requested frequencies */
+    UINT32          count       /* number of clocks */
+    )
+    {
+    VXB_FDT_CPG_INSTANCE *  pCpg = pRzg2Cpg;
+    VXB_CLK_ID *            pClkList;
+    UINT64                  newRate [RZG2_CPG_TOTAL_CLOCKS];
+    UINT32                  index [CPG_DIV_BATCH_MAX];
+    BOOL                    changed [RZG2_CPG_TOTAL_CLOCKS];
+    int                     parent;
+    int                     sibling;
+    UINT32                  i;
+
+    if ((pCpg == NULL) || (pClks == NULL) || (pRates == NULL) ||
+        (count == 0U) || (count > CPG_DIV_BATCH_MAX))
+        {
+        return ERROR;
+        }
+
+    pClkList = (VXB_CLK_ID *) pCpg->pCpgClkList;
+
+    for (i = 0U; i < count; i++)
+        {
+        if ((pClks [i] < pCpg->pClkPool) ||
+            (pClks [i] >= &pCpg->pClkPool [RZG2_CPG_TOTAL_CLOCKS]))
+            {
+            return ERROR;
+            }
+
+        index [i] = (UINT32)(pClks [i] - pCpg->pClkPool);
+        rzg2CpgClkLazyInit (pClks [i]);
+        }
+
+    if (rzg2CpgRatesApply (pCpg, index, pRates, count, newRate) == ERROR)
+        {
+        return ERROR;
+        }
+
+    /* keep the rates cached by vxbClkLib up to date, parents first */
+
+    (void)memset (changed, 0, sizeof (changed));
+
+    for (i = 0U; i < count; i++)
+        {
+        changed [index [i]] = TRUE;
+
+        sibling = rzg2CpgSiblingGet (index [i]);
+        if (sibling >= 0)
+            {
+            changed [sibling] = TRUE;
+            }
+        }
+
+    for (i = 0U; i < RZG2_CPG_TOTAL_CLOCKS; i++)
+        {
+        parent = rzg2CpgClocks [i].parentIndex;
+        if (changed [i] || ((parent >= 0) && changed [parent]))
+            {
+            changed [i] = TRUE;
+            pClkList [i]->clkRate = newRate [i];
+            }
+        }
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgDvfsShow - show the CPU cluster clock frequency change statistics
+*
+* This routine displays the current z and z2 clock frequencies, the related CPG
+* registers, and the number and duration of the frequency changes committed so
+* far. Durations are given in generic timer ticks and in nanoseconds.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+void rzg2CpgDvfsShow (void)
+    {
+    VXB_FDT_CPG_INSTANCE *  pCpg = pRzg2Cpg;
+    VXB_CLK_ID *            pClkList;
+    UINT64                  freq = (UINT64) rzg2TimestampFreqGet ();
+    UINT64                  avgTicks = 0U;
+
+    if ((pCpg == NULL) || (freq == 0U))
+        {
+        printf ("CPG not available\n");
+        return;
+        }
+
+    pClkList = (VXB_CLK_ID *) pCpg->pCpgClkList;
+
+    printf ("z  clock: %llu Hz\n",
+            vxbClkRateGet (pClkList [CPG_Z_CLK_INDEX]));
+    printf ("z2 clock: %llu Hz\n",
+            vxbClkRateGet (pClkList [CPG_Z2_CLK_INDEX]));
+    printf ("FRQCRB 0x%08x FRQCRC 0x%08x DVFSCR0 0x%08x DVFSCR1 0x%08x\n",
+            rzg2CpgRead32 (pCpg, FRQCRB), rzg2CpgRead32 (pCpg, FRQCRC),
+            rzg2CpgRead32 (pCpg, DVFSCR0), rzg2CpgRead32 (pCpg, DVFSCR1));
+
+    (void)semTake (pCpg->semMutex, WAIT_FOREVER);
+
+    if (pCpg->dvfsCount != 0U)
+        {
+        avgTicks = pCpg->dvfsTotalTicks / pCpg->dvfsCount;
+        }
+
+    printf ("changes: %u, timeouts: %u\n", pCpg->dvfsCount,
+            pCpg->dvfsTimeouts);
+    printf ("ticks  : last %llu min %llu max %llu avg %llu\n",
+            pCpg->dvfsLastTicks, pCpg->dvfsMinTicks, pCpg->dvfsMaxTicks,
+            avgTicks);
+    printf ("ns     : last %llu min %llu max %llu avg %llu\n",
+            pCpg->dvfsLastTicks * 1000000000ULL / freq,
+            pCpg->dvfsMinTicks * 1000000000ULL / freq,
+            pCpg->dvfsMaxTicks * 1000000000ULL / freq,
+            avgTicks * 1000000000ULL / freq);
+
+    (void)semGive (pCpg->semMutex);
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgLockStatsShow - show the CPG register lock statistics
+*
+* This routine displays, for each class of register enabled or disabled through
+* the CPG mutex (PLLECR, divider control registers and SMSTPCRn), the number of
+* times the mutex was taken, how many of those found it held by another task,
+* and the average and maximum wait and hold times in generic timer ticks. The
+* statistics are only recorded if the driver is built with RZG2_LOCK_STATS
+* defined.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+void rzg2CpgLockStatsShow (void)
+    {
+#ifdef RZG2_LOCK_STATS
+    VXB_FDT_CPG_INSTANCE *  pCpg = pRzg2Cpg;
+    RZG2_LOCK_STAT          stats [CPG_LOCK_CLASSES];
+    UINT32                  i;
+
+    if (pCpg == NULL)
+        {
+        printf ("CPG not available\n");
+        return;
+        }
+
+    (void)semTake (pCpg->semMutex, WAIT_FOREVER);
+    (void)memcpy (stats, pCpg->lockStats, sizeof (stats));
+    (void)semGive (pCpg->semMutex);
+
+    printf ("ticks at %u Hz\n", rzg2TimestampFreqGet ());
+    printf ("%-14s %10s %10s %10s %10s %10s %10s\n", "register", "takes",
+            "contended", "wait avg", "wait max", "hold avg", "hold max");
+
+    for (i = 0U; i < CPG_LOCK_CLASSES; i++)
+        {
+        rzg2LockStatsShow (cpgLockClassName [i], &stats [i]);
+        }
+#else
+    printf ("CPG lock statistics not enabled, build with RZG2_LOCK_STATS\n");
+#endif /* RZG2_LOCK_STATS */
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgMssrClkStatusGet - get CPG/MMSR clock status
+*
+* This routine get the clock status for the specified CPG/MSSR clock.
+*
+* RETURNS: CLOCK_STATUS_ENABLED if the clock is on, CLOCK_STATUS_GATED if the
+* clock is off, and CLOCK_STATUS_UNKNOWN for indeterminate status, or error.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL UINT32 rzg2CpgMssrClkStatusGet
+    (
+    struct vxb_clk * pClk
+    )
+    {
+    VXB_FDT_CPG_INSTANCE *  pCpg;           /* CPG driver data */
+    MSSR_CLK_DATA *         pMssrClk;       /* MSSR clock data */
+    CPG_CLK_DATA *          pCpgClk;        /* CPG clock data */
+    UINT32                  cpgReg = 0U;    /* CPG/MSSR register offset */
+    UINT32                  bitMask;        /* Register bit mask */
+    UINT32                  clockStatus = CLOCK_STATUS_UNKNOWN;
+
+    if (pClk == NULL)
+        {
+        return CLOCK_STATUS_UNKNOWN;
+        }
+
+    pCpg = (VXB_FDT_CPG_INSTANCE *) vxbDevSoftcGet (pClk->pDev);
+
+    switch (pClk->clkType)
+        {
+        case VXB_CLK_FIX_RATE:
+            /* fixed rate root clocks always on in CPG */
+
+            clockStatus = CLOCK_STATUS_ENABLED;
+            break;
+
+        case VXB_CLK_FIX_FACTOR:
+            /* depends on parent, from stored VXB_CLK setting */
+
+            clockStatus = pClk->parentClock->clkStatus;
+            break;
+
+        case VXB_CLK_PLL:
+            pCpgClk = (CPG_CLK_DATA *)pClk->clkContext;
+            bitMask = rzg2CpgRead32 (pCpg, PLLECR) &
+                      PLLECR_PLLnST (pCpgClk->variable.index);
+            if (bitMask == 0U)
+                {
+                clockStatus = CLOCK_STATUS_GATED;
+                }
+            else
+                {
+                clockStatus = CLOCK_STATUS_ENABLED;
+                }
+            break;
+
+        case VXB_CLK_DIVIDER:
+            pCpgClk = (CPG_CLK_DATA *)pClk->clkContext;
+
+            if (rzg2CpgDividerStatusRegMaskGet (pCpgClk, &cpgReg, &bitMask) == OK)
+                {
+                if (cpgReg != 0U)
+                    {
+                    if ((rzg2CpgRead32 (pCpg, cpgReg) & bitMask) == 0U)
+                        {
+                        clockStatus = CLOCK_STATUS_ENABLED;
+                        }
+                    else
+                        {
+                        clockStatus = CLOCK_STATUS_GATED;
+                        }
+                    }
+                else
+                    {
+                    /* depends on parent, from stored VXB_CLK setting */
+
+                    clockStatus = pClk->parentClock->clkStatus;
+                    }
+                }
+            break;
+
+        case VXB_CLK_GATE:
+            /* MSSR module clock */
+
+            pMssrClk = (MSSR_CLK_DATA *)pClk->clkContext;
+            cpgReg = mstpsrOffset [pMssrClk->moduleReg];
+            bitMask = 1U << pMssrClk->regBit;
+            if ((rzg2CpgRead32 (pCpg, cpgReg) & bitMask) == 0U)
+                {
+                clockStatus = CLOCK_STATUS_ENABLED;
+                }
+            else
+                {
+                clockStatus = CLOCK_STATUS_GATED;
+                }
+            break;
+
+        default:
+            RZG2_DBG_MSG (CPG_DBG_ERR, "Unexpected clock type\n");
+            break;
+        }
+
+    return clockStatus;
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgClkRefsInit - set the initial reference count of a CPG/MSSR clock
+*
+* This function is required to set an initial reference count for all software
+* controllable clocks whose initial hardware status is enabled. A module clock
+* started by rzg2CpgGatesPreEnable() is not counted, as no driver owns that
+* reference: the first driver enable then takes the count to 1, and the matching
+* disable stops the clock again.
+*
+* RETURNS: OK if clock initialised, ERROR otherwise.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2CpgClkRefsInit
+    (
+    struct vxb_clk * pClk
+    )
+    {
+    VXB_FDT_CPG_INSTANCE *  pCpg;       /* CPG driver data */
+    CPG_CLK_DATA *          pCpgClk;    /* CPG clock data */
+    MSSR_CLK_DATA *         pMssrClk;   /* MSSR clock data */
+    STATUS                  retStatus = OK;
+
+    pCpg = (VXB_FDT_CPG_INSTANCE *) vxbDevSoftcGet (pClk->pDev);
+    pCpgClk = (CPG_CLK_DATA *)pClk->clkContext;
+
+    if (vxbClkStatusGet (pClk) == CLOCK_STATUS_ENABLED)
+        {
+        switch (pClk->clkType)
+            {
+            case VXB_CLK_PLL:
 
                 /* no software control for PLL1 */
 
-                if (pCpgClk->variable.index != 1U)
-                    {
-                    pClk->clkRefs = 1U;
-                    }
-                break;
+                if (pCpgClk->variable.index != 1U)
+                    {
+                    pClk->clkRefs = 1U;
+                    }
+                break;
+
+            case VXB_CLK_DIVIDER:
+                switch (pCpgClk->variable.type)
+                    {
+                    case DIV_SDH:
+                    case DIV_SD:
+                    case DIV_RPCSRC:
+                    case DIV_HDMIIF:
+                    case DIV_CSI0:
+                    case DIV_CSIREF:
+                    case DIV_MSIOF:
+                    case DIV_CANFD:
+
+                        /* controllable dividers */
+
+                        pClk->clkRefs = 1U;
+                        break;
+
+                    case DIV_SYSCPU:
+                    case DIV_RTCPU:
+                    case DIV_COMMON:
+                    case DIV_LB:
+                    case DIV_EXTAL:
+
+                        /* always on dividers */
+
+                        break;
+
+                    default:
+                        RZG2_DBG_MSG (CPG_DBG_ERR, "Unexpected CPG divider type\n");
+                        retStatus = ERROR;
+                        break;
+                    }
+                break;
+
+            case VXB_CLK_GATE:
+
+                /* module clocks, except those started at attach */
+
+                pMssrClk = (MSSR_CLK_DATA *)pClk->clkContext;
+                if ((pCpg->preEnabled [pMssrClk->moduleReg] &
+                     (1U << pMssrClk->regBit)) == 0U)
+                    {
+                    pClk->clkRefs = 1U;
+                    }
+                break;
+
+            case VXB_CLK_FIX_RATE:
+            case VXB_CLK_FIX_FACTOR:
+
+                /* no software control for these fixed clocks */
+
+                break;
+
+            default:
+                RZG2_DBG_MSG (CPG_DBG_ERR, "Unexpected clock type\n");
+                retStatus = ERROR;
+                break;
+
+            }
+        }
+
+    return retStatus;
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgMssrClkInit - CPG/MMSR clock initialisation
+*
+* This routine initialises the clock status for the specified CPG/MSSR clock.
+*
+* In lazy mode, a clock that is not referenced from the device tree is left
+* uninitialised here, and is initialised by rzg2CpgClkLazyInit() when it is
+* first used.
+*
+* RETURNS: OK if clock initialised, ERROR otherwise.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2CpgMssrClkInit
+    (
+    struct vxb_clk * pClk
+    )
+    {
+    VXB_FDT_CPG_INSTANCE *  pCpg;       /* CPG driver data */
+
+    if (pClk == NULL)
+        {
+        return ERROR;
+        }
+
+    pCpg = (VXB_FDT_CPG_INSTANCE *) vxbDevSoftcGet (pClk->pDev);
+
+    if (pCpg->pClkReady [pClk - pCpg->pClkPool] == 0U)
+        {
+        return OK;
+        }
+
+    pCpg->clkInitCount++;
+
+    return rzg2CpgClkRefsInit (pClk);
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgClkLazyInit - initialise a clock on first use
+*
+* This function completes the initialisation of a clock left uninitialised by
+* rzg2CpgMssrClkInit() in lazy mode, after first initialising its ancestors. A
+* clock that was left running by the boot loader therefore gains its initial
+* reference when it is first enabled or has its rate set. It does nothing for a
+* clock that is already initialised.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2CpgClkLazyInit
+    (
+    struct vxb_clk * pClk           /* VxBus clock */
+    )
+    {
+    VXB_FDT_CPG_INSTANCE *  pCpg;       /* CPG driver data */
+    UINT8 *                 pReady;     /* clock initialised flag */
+
+    pCpg = (VXB_FDT_CPG_INSTANCE *) vxbDevSoftcGet (pClk->pDev);
+    if (!pCpg->lazyInit)
+        {
+        return;
+        }
+
+    pReady = &pCpg->pClkReady [pClk - pCpg->pClkPool];
+
+    (void)semTake (pCpg->semMutex, WAIT_FOREVER);
+
+    if (*pReady == 0U)
+        {
+        if (pClk->parentClock != NULL)
+            {
+            rzg2CpgClkLazyInit (pClk->parentClock);
+            }
+
+        (void)rzg2CpgClkRefsInit (pClk);
+
+        *pReady = 1U;
+        pCpg->clkInitCount++;
+        }
+
+    (void)semGive (pCpg->semMutex);
+    }
+
+/******************************************************************************
+*
+* rzg2CpgClocksCreate - create CPG clocks list
+*
+* This function fills the previously allocated space pointed to by <pClkList>
+* with a NULL terminated array of clocks required for static clock
+* initialisation. The <numClks> parameter specifies the number of clocks
+* to initialise, and the resource pointed to by <pClkList> must be sufficient
+* for this number of clocks and an additional NULL entry.
+*
+* The VxBus clocks and their contexts are taken from the <pClkPool> and
+* <pClkData> arrays, which must each hold <numClks> entries and are owned by the
+* calling function. The clock names refer to the <rzg2CpgClocks> table.
+*
+* The main structure of the clock tree is predefined by the <rzg2CpgClocks> table.
+*
+* A static clock list is used (rather than dynamic clock registration) because
+* this allows all the clocks to be associated with a single clock controller in
+* the device tree.
+*
+* RETURNS: OK, or ERROR if initialisation failed.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2CpgClocksCreate
+    (
+    VXB_DEV_ID          pDev,       /* our device */
+    VXB_CLK_DOMAIN *    pDomain,    /* domain for these clocks */
+    VXB_CLK_ID  *       pClkList,   /* array of static clocks created */
+    VXB_CLK *           pClkPool,   /* clocks to fill in */
+    CPG_CLK_DATA *      pClkData,   /* clock contexts to fill in */
+    UINT                numClks     /* number of clocks to initialise */
+    )
+    {
+    CPG_CLK_DESC *      pClkDesc;       /* instance of our clock descriptor */
+    size_t              i;              /* index to clocks */
+    VXB_CLK_ID          pVxbClk;        /* instance of VxBus clock */
+    CPG_CLK_DATA *      pCpgClkData;    /* CPG clock specific context */
+
+    /* sanity check parameters */
+
+    if ((pDev == NULL) || (pDomain == NULL) || (pClkList == NULL) ||
+        (pClkPool == NULL) || (pClkData == NULL))
+        {
+        return ERROR;
+        }
+
+    /* NULL terminate empty list first, in case of error */
+
+    pClkList[0] = NULL;
+
+    /* validate numClks */
+
+    if (numClks != RZG2_CPG_TOTAL_CLOCKS)
+        {
+        RZG2_DBG_MSG (CPG_DBG_ERR, "Unexpected number of CPG clocks\n");
+        return ERROR;
+        }
+
+    for (i = 0; i < numClks; i++)
+        {
+        /* take the clock from the pool and add to array */
+
+        pVxbClk = &pClkPool[i];
+
+        pClkList[i]   = pVxbClk;
+        pClkList[i+1] = NULL;
+
+        /* attach clock specific context area to clock */
+
+        pCpgClkData = &pClkData[i];
+        pVxbClk->clkContext = pCpgClkData;
+
+        /* reference our table of clock configuration */
+
+        pClkDesc = (CPG_CLK_DESC *) &rzg2CpgClocks[i];
+
+        /* copy common elements */
+
+        pVxbClk->pDev = pDev;
+        pVxbClk->clkDomain = pDomain;
+        pVxbClk->clkFuncs = &rzg2CpgMssrMethods;
+
+        pVxbClk->clkName = pClkDesc->name;
+
+        pVxbClk->clkType = pClkDesc->type;
+        pCpgClkData->rate = CLOCK_RATE_INVALID;
+
+        /* root clock has no parent */
+
+        if (pClkDesc->parentIndex < 0)
+            {
+            pVxbClk->parentClock = NULL;
+            }
+        else
+            {
+            pVxbClk->parentClock = pClkList[pClkDesc->parentIndex];
+            }
+
+        /* initialise context according to clock type */
+
+        switch (pVxbClk->clkType)
+            {
+            case VXB_CLK_FIX_RATE:
+                pCpgClkData->rate = rzg2FdtFixedClockGet (pClkDesc->name);
+                pVxbClk->clkRate  = pCpgClkData->rate;
+                break;
+
+            case VXB_CLK_FIX_FACTOR:
+                pCpgClkData->factor.mult = pClkDesc->mult;
+                pCpgClkData->factor.div  = pClkDesc->div;
+                break;
+
+            case VXB_CLK_PLL:
+            case VXB_CLK_DIVIDER:
+                pCpgClkData->variable.index = pClkDesc->index;
+                pCpgClkData->variable.type  = pClkDesc->divider;
+                break;
+
+            default:
+                RZG2_DBG_MSG (CPG_DBG_ERR, "clock type error\n");
+                return ERROR;
+                break;
+            }
+
+        /*
+         * A static clock driver should use DEFINE_VXB_CLOCK to initialise the
+         * static clocks. We're dynamically creating a list of static clocks so
+         * need to initialise the clocks in the same way.
+         */
+
+        DLL_INIT (&pVxbClk->clkNode);
+        DLL_INIT (&pVxbClk->rootClkNode);
+        pVxbClk->clkStatus = 0U;
+        pVxbClk->clkRefs   = 0U;
+        pVxbClk->parentName   = NULL;
+        pVxbClk->parentNames  = NULL;
+        pVxbClk->parentClocks = NULL;
+        pVxbClk->parentNum = 1U;
+        pVxbClk->parentIdx = 0U;
+        DLL_INIT (&pVxbClk->parentNode);
+        DLL_INIT (&pVxbClk->childClkList);
+        }
+
+    return OK;
+    }
+
+/******************************************************************************
+*
+* rzg2MssrClocksCreate - create MSSR clocks list
+*
+* This function fills the previously allocated space pointed to by <pClkList>
+* with a NULL terminated array of clocks required for static clock
+* initialisation. The <numClks> parameter specifies the number of clocks
+* to initialise, and the resource pointed to by <pClkList> must be sufficient
+* for this number of clocks and an additional NULL entry.
+*
+* The VxBus clocks and their contexts are taken from the <pClkPool> and
+* <pClkData> arrays, which must each hold <numClks> entries and are owned by the
+* calling function. The clock names refer to the <rzg2MssrClocks> table.
+*
+* The main structure of the clock tree is predefined by the <rzg2MssrClocks> table.
+*
+* A static clock list is used (rather than dynamic clock registration) because
+* this allows all the clocks to be associated with a single clock controller in
+* the device tree.
+*
+* RETURNS: OK, or ERROR if initialisation failed.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2MssrClocksCreate
+    (
+    VXB_DEV_ID          pDev,       /* our device */
+    VXB_CLK_DOMAIN *    pDomain,    /* domain for these clocks */
+    VXB_CLK_ID  *       pClkList,   /* array of static clocks created */
+    VXB_CLK *           pClkPool,   /* clocks to fill in */
+    MSSR_CLK_DATA *     pClkData,   /* clock contexts to fill in */
+    UINT                numClks     /* number of clocks to initialise */
+    )
+    {
+    MSSR_CLK_DESC *     pClkDesc;       /* instance of our clock descriptor */
+    size_t              i;              /* index to clocks */
+    VXB_CLK_ID          pVxbClk;        /* instance of VxBus clock */
+    MSSR_CLK_DATA *     pMssrClkData;   /* MSSR clock specific context */
+
+    /* sanity check parameters */
+
+    if ((pDev == NULL) || (pDomain == NULL) || (pClkList == NULL) ||
+        (pClkPool == NULL) || (pClkData == NULL))
+        {
+        return ERROR;
+        }
+
+    /* NULL terminate empty list first, in case of error */
+
+    pClkList[0] = NULL;
+
+    /* validate numClks */
+
+    if (numClks != RZG2_MSSR_TOTAL_CLOCKS)
+        {
+        RZG2_DBG_MSG (CPG_DBG_ERR, "Unexpected number of MSSR clocks\n");
+        return ERROR;
+        }
+
+    for (i = 0; i < numClks; i++)
+        {
+        /* take the clock from the pool and add to array */
+
+        pVxbClk = &pClkPool[i];
+
+        pClkList[i]   = pVxbClk;
+        pClkList[i+1] = NULL;
+
+        /* attach clock specific context area to clock */
+
+        pMssrClkData = &pClkData[i];
+        pVxbClk->clkContext = pMssrClkData;
+
+        /* reference our table of clock configuration */
+
+        pClkDesc = (MSSR_CLK_DESC *) &rzg2MssrClocks[i];
+
+        /* copy common elements */
+
+        pVxbClk->pDev = pDev;
+        pVxbClk->clkDomain = pDomain;
+        pVxbClk->clkFuncs = &rzg2CpgMssrMethods;
+
+        pVxbClk->clkName = pClkDesc->name;
+
+        pVxbClk->clkType = VXB_CLK_GATE;
+        if (pClkDesc->parentIndex <= 0)
+            {
+            pVxbClk->parentClock = NULL;
+            }
+        else
+            {
+            pVxbClk->parentClock =
+                (pClkList - RZG2_CPG_TOTAL_CLOCKS)[pClkDesc->parentIndex];
+            }
+
+        /* initialise context */
+
+        pMssrClkData->moduleReg = pClkDesc->moduleBit.moduleReg;
+        pMssrClkData->regBit = pClkDesc->moduleBit.regBit;
+
+        /*
+         * A static clock driver should use DEFINE_VXB_CLOCK to initialise the
+         * static clocks. We're dynamically creating a list of static clocks so
+         * need to initialise the clocks in the same way.
+         */
+
+        DLL_INIT (&pVxbClk->clkNode);
+        DLL_INIT (&pVxbClk->rootClkNode);
+        pVxbClk->clkStatus = 0U;
+        pVxbClk->clkRefs   = 0U;
+        pVxbClk->parentName   = NULL;
+        pVxbClk->parentNames  = NULL;
+        pVxbClk->parentClocks = NULL;
+        pVxbClk->parentNum = 1U;
+        pVxbClk->parentIdx = 0U;
+        DLL_INIT (&pVxbClk->parentNode);
+        DLL_INIT (&pVxbClk->childClkList);
+        }
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgClkMark - mark a clock and its ancestors to be initialised at attach
+*
+* This function marks the clock at <index> in the static clock list, and every
+* clock between it and its root clock, to be initialised by vxbClksInit().
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2CpgClkMark
+    (
+    VXB_FDT_CPG_INSTANCE *  pCpg,       /* CPG driver data */
+    UINT32                  index       /* static clock list index */
+    )
+    {
+    int clkIndex = (int)index;
+
+    if (index >= (RZG2_CPG_TOTAL_CLOCKS + RZG2_MSSR_TOTAL_CLOCKS))
+        {
+        return;
+        }
+
+    /* an MSSR clock has at most one CPG parent */
+
+    if (index >= RZG2_CPG_TOTAL_CLOCKS)
+        {
+        pCpg->pClkReady [index] = 1U;
+        clkIndex = rzg2MssrClocks [index - RZG2_CPG_TOTAL_CLOCKS].parentIndex;
+        if (clkIndex <= 0)
+            {
+            return;
+            }
+        }
+
+    while ((clkIndex >= 0) && (pCpg->pClkReady [clkIndex] == 0U))
+        {
+        pCpg->pClkReady [clkIndex] = 1U;
+        clkIndex = rzg2CpgClocks [clkIndex].parentIndex;
+        }
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgClkRefsScan - find the clocks referenced from the device tree
+*
+* This function scans the <clocks> property of every enabled FDT node. In lazy
+* mode each referenced CPG or MSSR clock is marked, with its ancestors, to be
+* initialised at attach. If <pGateMask> is not NULL, the bit of each referenced
+* MSSR clock is also set in <pGateMask>, which has one mask per SMSTPCR
+* register. The clock specifiers of other clock providers are skipped using
+* their <#clock-cells> property.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2CpgClkRefsScan
+    (
+    VXB_FDT_CPG_INSTANCE *  pCpg,       /* CPG driver data */
+    int                     cpgOffset,  /* FDT offset of the CPG node */
+    UINT32 *                pGateMask   /* SMSTPCR bits, or NULL */
+    )
+    {
+    const MSSR_CLK_DESC *   pMssrDesc;
+    const UINT32 *  pClocks;
+    const UINT32 *  pProp;
+    int             clocksLen;
+    int             provOffset;
+    int             offset;
+    int             depth = 0;
+    int             cell;
+    UINT32          cells;
+    UINT32          index;
+
+    for (offset = vxFdtNextNode (0, &depth); offset > 0;
+         offset = vxFdtNextNode (offset, &depth))
+        {
+        if (!vxFdtIsEnabled (offset))
+            {
+            continue;
+            }
+
+        pClocks = (const UINT32 *) vxFdtPropGet (offset, "clocks", &clocksLen);
+        if (pClocks == NULL)
+            {
+            continue;
+            }
+
+        clocksLen /= (int)sizeof (UINT32);
+
+        /* each clock specifier is a phandle followed by #clock-cells cells */
+
+        cell = 0;
+        while (cell < clocksLen)
+            {
+            provOffset = vxFdtNodeOffsetByPhandle (vxFdt32ToCpu (pClocks [cell]));
+            if (provOffset < 0)
+                {
+                break;
+                }
+
+            pProp = (const UINT32 *) vxFdtPropGet (provOffset, "#clock-cells",
+                                                   NULL);
+            cells = (pProp == NULL) ? 0U : vxFdt32ToCpu (*pProp);
+
+            if ((provOffset == cpgOffset) && (cells == 1U) &&
+                ((cell + 1) < clocksLen))
+                {
+                index = vxFdt32ToCpu (pClocks [cell + 1]);
+
+                if (pCpg->lazyInit)
+                    {
+                    rzg2CpgClkMark (pCpg, index);
+                    }
+
+                if ((pGateMask != NULL) &&
+                    (index >= RZG2_CPG_TOTAL_CLOCKS) &&
+                    (index < (RZG2_CPG_TOTAL_CLOCKS + RZG2_MSSR_TOTAL_CLOCKS)))
+                    {
+                    pMssrDesc = &rzg2MssrClocks [index - RZG2_CPG_TOTAL_CLOCKS];
+                    pGateMask [pMssrDesc->moduleBit.moduleReg] |=
+                        1U << pMssrDesc->moduleBit.regBit;
+                    }
+                }
+
+            cell += 1 + (int)cells;
+            }
+        }
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgMstpWait - wait for a set of module clocks to start
+*
+* This function polls the MSTPSR registers until every bit of <pRunMask>, one
+* mask per register, reads as zero, so that the module clocks are running. The
+* caller must hold the CPG mutex.
+*
+* RETURNS: OK if all the clocks have started, ERROR on timeout.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2CpgMstpWait
+    (
+    VXB_FDT_CPG_INSTANCE *  pCpg,       /* CPG driver data */
+    const UINT32 *          pRunMask    /* MSTPSR bits to wait for */
+    )
+    {
+    UINT32  pending;
+    UINT32  poll;
+    UINT32  i;
+
+    for (poll = 0U; poll < CPG_MSTP_POLL_MAX; poll++)
+        {
+        pending = 0U;
+        for (i = 0U; i < CPG_MSTP_REGS; i++)
+            {
+            if (pRunMask [i] != 0U)
+                {
+                pending |= rzg2CpgRead32 (pCpg, mstpsrOffset [i]) &
+                           pRunMask [i];
+                }
+            }
+
+        if (pending == 0U)
+            {
+            return OK;
+            }
+        }
+
+    return ERROR;
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgGatesPreEnable - enable a set of module clocks in one pass
+*
+* This function clears the bits <pGateMask>, one mask per SMSTPCR register, so
+* that the module clocks are started together: each SMSTPCR register with a
+* stopped clock is unlocked and written once. The MSTPSR registers are then
+* polled until every clock has started, rather than after each clock. The
+* clocks started here are recorded, so that rzg2CpgClkRefsInit() gives them no
+* reference count.
+*
+* RETURNS: OK if all the clocks have started, ERROR on timeout.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2CpgGatesPreEnable
+    (
+    VXB_FDT_CPG_INSTANCE *  pCpg,       /* CPG driver data */
+    const UINT32 *          pGateMask   /* SMSTPCR bits to clear */
+    )
+    {
+    UINT64  startTicks = rzg2TimestampGet ();
+    STATUS  status;
+    UINT32  val;
+    UINT32  i;
+#ifdef RZG2_LOCK_STATS
+    UINT64  takeTime;
+#endif /* RZG2_LOCK_STATS */
+
+    RZG2_LOCK_TAKE (pCpg->semMutex, &pCpg->lockStats [CPG_LOCK_MSTP],
+                    takeTime);
+
+    for (i = 0U; i < NELEMENTS (mstpcrOffset); i++)
+        {
+        if (pGateMask [i] == 0U)
+            {
+            continue;
+            }
 
-            case VXB_CLK_DIVIDER:
-                switch (pCpgClk->variable.type)
-                    {
-                    case DIV_SDH:
-                    case DIV_SD:
-                    case DIV_RPCSRC:
-                    case DIV_HDMIIF:
-                    case DIV_CSI0:
-                    case DIV_CSIREF:
-                    case DIV_MSIOF:
-                    case DIV_CANFD:
+        val = rzg2CpgRead32 (pCpg, mstpcrOffset [i]);
+        if ((val & pGateMask [i]) == 0U)
+            {
+            pCpg->regSkips++;
+            }
+        else
+            {
+            rzg2CpgWrite32 (pCpg, mstpcrOffset [i], val & ~pGateMask [i]);
 
-                        /* controllable dividers */
+            /* count the clocks started, one stopped bit at a time */
 
-                        pClk->clkRefs = 1U;
-                        break;
+            pCpg->preEnabled [i] = val & pGateMask [i];
+            for (val &= pGateMask [i]; val != 0U; val &= val - 1U)
+                {
+                pCpg->preEnableGates++;
+                }
+            }
+        }
 
-                    case DIV_SYSCPU:
-                    case DIV_RTCPU:
-                    case DIV_COMMON:
-                    case DIV_LB:
-                    case DIV_EXTAL:
+    status = rzg2CpgMstpWait (pCpg, pGateMask);
 
-                        /* always on dividers */
+    RZG2_LOCK_GIVE (pCpg->semMutex, &pCpg->lockStats [CPG_LOCK_MSTP],
+                    takeTime);
 
-                        break;
+    pCpg->preEnableTicks = rzg2TimestampGet () - startTicks;
 
-                    default:
-                        RZG2_DBG_MSG (CPG_DBG_ERR, "Unexpected CPG divider type\n");
-                        retStatus = ERROR;
-                        break;
-                    }
-                break;
+    return status;
+    }
 
-            case VXB_CLK_GATE:
+/*******************************************************************************
+*
+* rzg2CpgPreEnableRelease - stop the pre-enabled module clocks not in use
+*
+* This routine stops each module clock started at attach for the
+* <renesas,pre-enable-clocks> property that no driver has enabled, for example
+* because no driver in the image claims the node referencing it. The SMSTPCR
+* registers are written once each. It is intended to be called once, after the
+* drivers have attached, for example from usrAppInit(), and must not run while
+* a driver enables one of these clocks for the first time.
+*
+* RETURNS: OK, or ERROR if the CPG is not attached.
+*
+* ERRNO: N/A.
+*/
 
-                /* all module clocks */
+STATUS rzg2CpgPreEnableRelease (void)
+    {
+    VXB_FDT_CPG_INSTANCE *  pCpg = pRzg2Cpg;
+    const MSSR_CLK_DATA *   pMssrClk;
+    VXB_CLK *               pClk;
+    UINT32                  stopMask [CPG_MSTP_REGS];
+    UINT32                  val;
+    UINT32                  i;
+#ifdef RZG2_LOCK_STATS
+    UINT64                  takeTime;
+#endif /* RZG2_LOCK_STATS */
 
-                pClk->clkRefs = 1U;
-                break;
+    if (pCpg == NULL)
+        {
+        return ERROR;
+        }
 
-            case VXB_CLK_FIX_RATE:
-            case VXB_CLK_FIX_FACTOR:
+    (void)memset (stopMask, 0, sizeof (stopMask));
 
-                /* no software control for these fixed clocks */
+    for (i = 0U; i < RZG2_MSSR_TOTAL_CLOCKS; i++)
+        {
+        pClk = &pCpg->pClkPool [RZG2_CPG_TOTAL_CLOCKS + i];
+        pMssrClk = (const MSSR_CLK_DATA *) pClk->clkContext;
 
-                break;
+        if ((pClk->clkRefs == 0U) &&
+            ((pCpg->preEnabled [pMssrClk->moduleReg] &
+              (1U << pMssrClk->regBit)) != 0U))
+            {
+            stopMask [pMssrClk->moduleReg] |= 1U << pMssrClk->regBit;
+            }
+        }
 
-            default:
-                RZG2_DBG_MSG (CPG_DBG_ERR, "Unexpected clock type\n");
-                retStatus = ERROR;
-                break;
+    RZG2_LOCK_TAKE (pCpg->semMutex, &pCpg->lockStats [CPG_LOCK_MSTP],
+                    takeTime);
+
+    for (i = 0U; i < CPG_MSTP_REGS; i++)
+        {
+        pCpg->preEnabled [i] = 0U;
 
+        if (stopMask [i] != 0U)
+            {
+            val = rzg2CpgRead32 (pCpg, mstpcrOffset [i]);
+            rzg2CpgWrite32 (pCpg, mstpcrOffset [i], val | stopMask [i]);
             }
         }
 
-    return retStatus;
+    RZG2_LOCK_GIVE (pCpg->semMutex, &pCpg->lockStats [CPG_LOCK_MSTP],
+                    takeTime);
+
+    return OK;
     }
 
-/******************************************************************************
-*
-* rzg2CpgClocksCreate - create CPG clocks list
-*
-* This function fills the previously allocated space pointed to by <pClkList>
-* with a NULL terminated array of clocks required for static clock
-* initialisation. The <numClks> parameter specifies the number of clocks
-* to initialise, and the resource pointed to by <pClkList> must be sufficient
-* for this number of clocks and an additional NULL entry.
-*
-* Additional space for VxBus clocks is allocated by this function and it is the
-* responsibility of the calling function to free this resource.
+/*******************************************************************************
 *
-* The main structure of the clock tree is predefined by the <rzg2CpgClocks> table.
+* rzg2CpgCtxSave - save the CPG context for system suspend
 *
-* A static clock list is used (rather than dynamic clock registration) because
-* this allows all the clocks to be associated with a single clock controller in
-* the device tree.
+* This function is the CPG system suspend hook. It saves the divider control
+* registers of the clocks set by this driver, FRQCRC, and the SMSTPCR registers
+* in the driver data, so that rzg2CpgCtxRestore() can restore them on resume.
 *
-* RETURNS: OK, or ERROR if initialisation failed.
+* RETURNS: OK.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS rzg2CpgClocksCreate
+LOCAL STATUS rzg2CpgCtxSave
     (
-    VXB_DEV_ID          pDev,       /* our device */
-    VXB_CLK_DOMAIN *    pDomain,    /* domain for these clocks */
-    VXB_CLK_ID  *       pClkList,   /* array of static clocks created */
-    UINT                numClks     /* number of clocks to initialise */
+    void *  pArg        /* CPG driver data */
     )
     {
-    CPG_CLK_DESC *      pClkDesc;       /* instance of our clock descriptor */
-    size_t              i;              /* index to clocks */
-    VXB_CLK_ID          pVxbClk;        /* instance of VxBus clock */
-    CPG_CLK_DATA *      pCpgClkData;    /* CPG clock specific context */
+    VXB_FDT_CPG_INSTANCE *  pCpg = (VXB_FDT_CPG_INSTANCE *) pArg;
+    UINT32                  i;
+#ifdef RZG2_LOCK_STATS
+    UINT64                  takeTime;
+#endif /* RZG2_LOCK_STATS */
 
-    /* sanity check parameters */
+    RZG2_LOCK_TAKE (pCpg->semMutex, &pCpg->lockStats [CPG_LOCK_DIV],
+                    takeTime);
 
-    if ((pDev == NULL) || (pDomain == NULL) || (pClkList == NULL))
+    for (i = 0U; i < CPG_CTX_DIV_REGS; i++)
         {
-        return ERROR;
+        pCpg->ctxDiv [i] = rzg2CpgRead32 (pCpg, cpgCtxDiv [i].reg);
         }
 
-    /* NULL terminate empty list first, in case of error */
+    pCpg->ctxFrqcrc = rzg2CpgRead32 (pCpg, FRQCRC);
 
-    pClkList[0] = NULL;
+    for (i = 0U; i < CPG_MSTP_REGS; i++)
+        {
+        pCpg->ctxMstpcr [i] = rzg2CpgRead32 (pCpg, mstpcrOffset [i]);
+        }
 
-    /* validate numClks */
+    pCpg->ctxValid = TRUE;
 
-    if (numClks != RZG2_CPG_TOTAL_CLOCKS)
+    RZG2_LOCK_GIVE (pCpg->semMutex, &pCpg->lockStats [CPG_LOCK_DIV],
+                    takeTime);
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgCtxRestore - restore the CPG context on resume from system suspend
+*
+* This function is the CPG system resume hook. It restores the context saved by
+* rzg2CpgCtxSave(), dividers first, while the modules they feed are still
+* stopped, then the SMSTPCR registers. The divisors and the Z clock multipliers
+* are restored as one rzg2CpgDividersApply() batch, so each running divider
+* output is stopped while its divisor changes, the Z clocks change with one
+* FRQCRB.KICK, and an output that was stopped when the context was saved, such
+* as SDnH at a low SDnSRCFC rate, is stopped in the same write as the divisor
+* change. Outputs that were running are restarted after the batch. Only the
+* registers that differ from the saved values are written, and the MSTPSR
+* registers are polled once until every module clock that was running has
+* restarted.
+*
+* RETURNS: OK, or ERROR if no context is saved or a clock does not start.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2CpgCtxRestore
+    (
+    void *  pArg        /* CPG driver data */
+    )
+    {
+    VXB_FDT_CPG_INSTANCE *  pCpg = (VXB_FDT_CPG_INSTANCE *) pArg;
+    const MSSR_CLK_DATA *   pBit;
+    CPG_DIV_SETTING         setting [CPG_CTX_DIV_REGS + 1U];
+    UINT32                  runMask [CPG_MSTP_REGS];
+    UINT64                  startTicks = rzg2TimestampGet ();
+    STATUS                  status = OK;
+    UINT32                  stopped;
+    UINT32                  i;
+#ifdef RZG2_LOCK_STATS
+    UINT64                  takeTime;
+#endif /* RZG2_LOCK_STATS */
+
+    if (!pCpg->ctxValid)
         {
-        RZG2_DBG_MSG (CPG_DBG_ERR, "Unexpected number of CPG clocks\n");
         return ERROR;
         }
 
-    for (i = 0; i < numClks; i++)
+    for (i = 0U; i < CPG_CTX_DIV_REGS; i++)
         {
-        /* allocate space for clock and add to array */
+        stopped = pCpg->ctxDiv [i] & cpgCtxDiv [i].stopMask;
 
-        pVxbClk = (VXB_CLK_ID) vxbMemAlloc(sizeof (VXB_CLK));
-        if (pVxbClk == NULL)
-            {
-            RZG2_DBG_MSG (CPG_DBG_ERR, "vxbMemAlloc error\n");
-            return ERROR;
-            }
+        setting [i].reg = cpgCtxDiv [i].reg;
+        setting [i].mask = cpgCtxDiv [i].divMask | stopped;
+        setting [i].bits = pCpg->ctxDiv [i] & setting [i].mask;
+        setting [i].stopBits = cpgCtxDiv [i].stopMask & ~stopped;
+        setting [i].rate = 0U;
+        }
 
-        pClkList[i]   = pVxbClk;
-        pClkList[i+1] = NULL;
+    setting [i].reg = FRQCRC;
+    setting [i].mask = FRQCRC_ZFC_MASK | FRQCRC_Z2FC_MASK;
+    setting [i].bits = pCpg->ctxFrqcrc & setting [i].mask;
+    setting [i].stopBits = 0U;
+    setting [i].rate = 0U;
 
-        /* allocate clock specific context area and attach to clock */
+    if (rzg2CpgDividersApply (pCpg, setting, CPG_CTX_DIV_REGS + 1U) == ERROR)
+        {
+        status = ERROR;
+        }
 
-        pVxbClk->clkContext = vxbMemAlloc (sizeof (CPG_CLK_DATA));
-        if (pVxbClk->clkContext == NULL)
+    /* start the outputs that were running, but were stopped over suspend */
+
+    for (i = 0U; i < CPG_CTX_DIV_REGS; i++)
+        {
+        stopped = cpgCtxDiv [i].stopMask & ~pCpg->ctxDiv [i];
+        if (stopped != 0U)
             {
-            RZG2_DBG_MSG (CPG_DBG_ERR, "vxbMemAlloc error\n");
-            return ERROR;
+            rzg2CpgClrBit32 (pCpg, cpgCtxDiv [i].reg, stopped);
             }
-        pCpgClkData = (CPG_CLK_DATA *) pVxbClk->clkContext;
-
-        /* reference our table of clock configuration */
-
-        pClkDesc = (CPG_CLK_DESC *) &rzg2CpgClocks[i];
+        }
 
-        /* copy common elements */
+    /* wait only for the running clocks known to the driver */
 
-        pVxbClk->pDev = pDev;
-        pVxbClk->clkDomain = pDomain;
-        pVxbClk->clkFuncs = &rzg2CpgMssrMethods;
+    (void)memset (runMask, 0, sizeof (runMask));
 
-        pVxbClk->clkName = vxbMemAlloc (strlen(pClkDesc->name) + 1);
-        if (pVxbClk->clkName == NULL)
+    for (i = 0U; i < RZG2_MSSR_TOTAL_CLOCKS; i++)
+        {
+        pBit = &rzg2MssrClocks [i].moduleBit;
+        if ((pCpg->ctxMstpcr [pBit->moduleReg] & (1U << pBit->regBit)) == 0U)
             {
-            RZG2_DBG_MSG (CPG_DBG_ERR, "vxbMemAlloc error\n");
-            return ERROR;
+            runMask [pBit->moduleReg] |= 1U << pBit->regBit;
             }
-        strncpy (pVxbClk->clkName, pClkDesc->name, strlen(pClkDesc->name) + 1);
-
-        pVxbClk->clkType = pClkDesc->type;
-        pCpgClkData->rate = CLOCK_RATE_INVALID;
+        }
 
-        /* root clock has no parent */
+    RZG2_LOCK_TAKE (pCpg->semMutex, &pCpg->lockStats [CPG_LOCK_MSTP],
+                    takeTime);
 
-        if (pClkDesc->parentIndex < 0)
+    for (i = 0U; i < CPG_MSTP_REGS; i++)
+        {
+        if (rzg2CpgRead32 (pCpg, mstpcrOffset [i]) == pCpg->ctxMstpcr [i])
             {
-            pVxbClk->parentClock = NULL;
+            pCpg->regSkips++;
             }
         else
             {
-            pVxbClk->parentClock = pClkList[pClkDesc->parentIndex];
+            rzg2CpgWrite32 (pCpg, mstpcrOffset [i], pCpg->ctxMstpcr [i]);
             }
+        }
 
-        /* initialise context according to clock type */
-
-        switch (pVxbClk->clkType)
-            {
-            case VXB_CLK_FIX_RATE:
-                pCpgClkData->rate = rzg2FdtFixedClockGet (pClkDesc->name);
-                pVxbClk->clkRate  = pCpgClkData->rate;
-                break;
-
-            case VXB_CLK_FIX_FACTOR:
-                pCpgClkData->factor.mult = pClkDesc->mult;
-                pCpgClkData->factor.div  = pClkDesc->div;
-                break;
-
-            case VXB_CLK_PLL:
-            case VXB_CLK_DIVIDER:
-                pCpgClkData->variable.index = pClkDesc->index;
-                pCpgClkData->variable.type  = pClkDesc->divider;
-                break;
-
-            default:
-                RZG2_DBG_MSG (CPG_DBG_ERR, "clock type error\n");
-                return ERROR;
-                break;
-            }
+    if (rzg2CpgMstpWait (pCpg, runMask) == ERROR)
+        {
+        status = ERROR;
+        }
 
-        /*
-         * A static clock driver should use DEFINE_VXB_CLOCK to initialise the
-         * static clocks. We're dynamically creating a list of static clocks so
-         * need to initialise the clocks in the same way.
-         */
+    RZG2_LOCK_GIVE (pCpg->semMutex, &pCpg->lockStats [CPG_LOCK_MSTP],
+                    takeTime);
 
-        DLL_INIT (&pVxbClk->clkNode);
-        DLL_INIT (&pVxbClk->rootClkNode);
-        pVxbClk->clkStatus = 0U;
-        pVxbClk->clkRefs   = 0U;
-        pVxbClk->parentName   = NULL;
-        pVxbClk->parentNames  = NULL;
-        pVxbClk->parentClocks = NULL;
-        pVxbClk->parentNum = 1U;
-        pVxbClk->parentIdx = 0U;
-        DLL_INIT (&pVxbClk->parentNode);
-        DLL_INIT (&pVxbClk->childClkList);
-        }
+    pCpg->ctxRestoreTicks = rzg2TimestampGet () - startTicks;
 
-    return OK;
+    return status;
     }
 
-/******************************************************************************
-*
-* rzg2MssrClocksCreate - create MSSR clocks list
-*
-* This function fills the previously allocated space pointed to by <pClkList>
-* with a NULL terminated array of clocks required for static clock
-* initialisation. The <numClks> parameter specifies the number of clocks
-* to initialise, and the resource pointed to by <pClkList> must be sufficient
-* for this number of clocks and an additional NULL entry.
-*
-* Additional space for VxBus clocks is allocated by this function and it is the
-* responsibility of the calling function to free this resource.
+/*******************************************************************************
 *
-* The main structure of the clock tree is predefined by the <rzg2MssrClocks> table.
+* rzg2CpgClkPlanNodeRead - read the CPG clock assignments of one FDT node
 *
-* A static clock list is used (rather than dynamic clock registration) because
-* this allows all the clocks to be associated with a single clock controller in
-* the device tree.
+* This function appends to <index> and <rate> the <assigned-clocks> entries of
+* the node at <offset> that refer to the CPG node <cpgOffset>, with the matching
+* <assigned-clock-rates> values. A clock assigned again replaces its earlier
+* rate. Entries with a zero rate, and entries for other providers or for MSSR
+* clocks, are skipped. <pCount> holds the number of entries on entry and exit.
 *
-* RETURNS: OK, or ERROR if initialisation failed.
+* RETURNS: N/A.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS rzg2MssrClocksCreate
+LOCAL void rzg2CpgClkPlanNodeRead
     (
-    VXB_DEV_ID          pDev,       /* our device */
-    VXB_CLK_DOMAIN *    pDomain,    /* domain for these clocks */
-    VXB_CLK_ID  *       pClkList,   /* array of static clocks created */
-    UINT                numClks     /* number of clocks to initialise */
+    int         offset,         /* FDT node offset */
+    int         cpgOffset,      /* FDT offset of the CPG node */
+    UINT32      clockCells,     /* #clock-cells of the CPG node */
+    UINT32 *    index,          /* CPG clock indexes */
+    UINT64 *    rate,           /* requested rates */
+    UINT32 *    pCount          /* number of entries */
     )
     {
-    MSSR_CLK_DESC *     pClkDesc;       /* instance of our clock descriptor */
-    size_t              i;              /* index to clocks */
-    VXB_CLK_ID          pVxbClk;        /* instance of VxBus clock */
-    MSSR_CLK_DATA *     pMssrClkData;   /* MSSR clock specific context */
-
-    /* sanity check parameters */
-
-    if ((pDev == NULL) || (pDomain == NULL) || (pClkList == NULL))
+    const UINT32 *  pClocks;
+    const UINT32 *  pRates;
+    int             clocksLen;
+    int             ratesLen;
+    int             cell;
+    int             entry;
+    UINT32          clkIndex;
+    UINT32          clkRate;
+    UINT32          i;
+
+    pClocks = (const UINT32 *) vxFdtPropGet (offset, "assigned-clocks",
+                                             &clocksLen);
+    pRates = (const UINT32 *) vxFdtPropGet (offset, "assigned-clock-rates",
+                                            &ratesLen);
+    if ((pClocks == NULL) || (pRates == NULL))
         {
-        return ERROR;
+        return;
         }
 
-    /* NULL terminate empty list first, in case of error */
-
-    pClkList[0] = NULL;
+    clocksLen /= (int)sizeof (UINT32);
+    ratesLen /= (int)sizeof (UINT32);
 
-    /* validate numClks */
+    /* each clock specifier is a phandle followed by #clock-cells cells */
 
-    if (numClks != RZG2_MSSR_TOTAL_CLOCKS)
+    cell = 0;
+    for (entry = 0; entry < ratesLen; entry++)
         {
-        RZG2_DBG_MSG (CPG_DBG_ERR, "Unexpected number of MSSR clocks\n");
-        return ERROR;
-        }
+        if (cell >= clocksLen)
+            {
+            break;
+            }
+
+        if (vxFdtNodeOffsetByPhandle (vxFdt32ToCpu (pClocks [cell])) !=
+            cpgOffset)
+            {
+            /* the cells of another provider are unknown, so stop here */
+
+            break;
+            }
+
+        if ((clockCells != 1U) || ((cell + 1) >= clocksLen))
+            {
+            break;
+            }
 
-    for (i = 0; i < numClks; i++)
-        {
-        /* allocate space for clock and add to array */
+        clkIndex = vxFdt32ToCpu (pClocks [cell + 1]);
+        clkRate = vxFdt32ToCpu (pRates [entry]);
+        cell += 2;
 
-        pVxbClk = (VXB_CLK_ID)vxbMemAlloc(sizeof (VXB_CLK));
-        if (pVxbClk == NULL)
+        if ((clkIndex >= RZG2_CPG_TOTAL_CLOCKS) || (clkRate == 0U))
             {
-            RZG2_DBG_MSG (CPG_DBG_ERR, "vxbMemAlloc error\n");
-            return ERROR;
+            continue;
             }
-        pClkList[i]   = pVxbClk;
-        pClkList[i+1] = NULL;
 
-        /* allocate clock specific context area and attach to clock */
+        for (i = 0U; i < *pCount; i++)
+            {
+            if (index [i] == clkIndex)
+                {
+                break;
+                }
+            }
 
-        pVxbClk->clkContext = vxbMemAlloc (sizeof (MSSR_CLK_DATA));
-        if (pVxbClk->clkContext == NULL)
+        if (i == *pCount)
             {
-            RZG2_DBG_MSG (CPG_DBG_ERR, "vxbMemAlloc error\n");
-            return ERROR;
+            if (*pCount >= CPG_DIV_BATCH_MAX)
+                {
+                RZG2_DBG_MSG (CPG_DBG_ERR, "clock plan too large\n");
+                return;
+                }
+
+            (*pCount)++;
             }
-        pMssrClkData = (MSSR_CLK_DATA *)pVxbClk->clkContext;
 
-        /* reference our table of clock configuration */
+        index [i] = clkIndex;
+        rate [i] = (UINT64)clkRate;
+        }
+    }
 
-        pClkDesc = (MSSR_CLK_DESC *) &rzg2MssrClocks[i];
+/*******************************************************************************
+*
+* rzg2CpgClkPlanApply - apply the boot clock plan from the device tree
+*
+* This function collects the <assigned-clocks> and <assigned-clock-rates>
+* entries that refer to CPG clocks, from the CPG node and from every enabled
+* node, and applies them in one batch with rzg2CpgRatesApply(). The time taken
+* is recorded for rzg2CpgClkTreeShow().
+*
+* RETURNS: OK if the plan is applied or there is no plan, ERROR otherwise.
+*
+* ERRNO: N/A.
+*/
 
-        /* copy common elements */
+LOCAL STATUS rzg2CpgClkPlanApply
+    (
+    VXB_FDT_CPG_INSTANCE *  pCpg        /* CPG driver data */
+    )
+    {
+    UINT64          newRate [RZG2_CPG_TOTAL_CLOCKS];
+    UINT64          planRate [CPG_DIV_BATCH_MAX];
+    UINT32          planIndex [CPG_DIV_BATCH_MAX];
+    UINT32          planCount = 0U;
+    UINT32          clockCells = 0U;
+    const UINT32 *  pProp;
+    UINT64          startTicks;
+    STATUS          retStatus;
+    int             cpgOffset;
+    int             offset;
+    int             depth = 0;
+
+    cpgOffset = vxbFdtDevGet (pCpg->pDev)->offset;
+
+    pProp = (const UINT32 *) vxFdtPropGet (cpgOffset, "#clock-cells", NULL);
+    if (pProp != NULL)
+        {
+        clockCells = vxFdt32ToCpu (*pProp);
+        }
 
-        pVxbClk->pDev = pDev;
-        pVxbClk->clkDomain = pDomain;
-        pVxbClk->clkFuncs = &rzg2CpgMssrMethods;
+    /* the CPG node itself is the usual place for the plan */
 
-        pVxbClk->clkName = vxbMemAlloc (strlen(pClkDesc->name) + 1);
-        if (pVxbClk->clkName == NULL)
-            {
-            RZG2_DBG_MSG (CPG_DBG_ERR, "vxbMemAlloc error\n");
-            return ERROR;
-            }
-        strncpy (pVxbClk->clkName, pClkDesc->name, strlen(pClkDesc->name) + 1);
+    rzg2CpgClkPlanNodeRead (cpgOffset, cpgOffset, clockCells, planIndex,
+                            planRate, &planCount);
 
-        pVxbClk->clkType = VXB_CLK_GATE;
-        if (pClkDesc->parentIndex <= 0)
-            {
-            pVxbClk->parentClock = NULL;
-            }
-        else
+    for (offset = vxFdtNextNode (0, &depth); offset > 0;
+         offset = vxFdtNextNode (offset, &depth))
+        {
+        if ((offset != cpgOffset) && vxFdtIsEnabled (offset))
             {
-            pVxbClk->parentClock =
-                (pClkList - RZG2_CPG_TOTAL_CLOCKS)[pClkDesc->parentIndex];
+            rzg2CpgClkPlanNodeRead (offset, cpgOffset, clockCells, planIndex,
+                                    planRate, &planCount);
             }
+        }
 
-        /* initialise context */
+    if (planCount == 0U)
+        {
+        return OK;
+        }
 
-        pMssrClkData->moduleReg = pClkDesc->moduleBit.moduleReg;
-        pMssrClkData->regBit = pClkDesc->moduleBit.regBit;
+    startTicks = rzg2TimestampGet ();
 
-        /*
-         * A static clock driver should use DEFINE_VXB_CLOCK to initialise the
-         * static clocks. We're dynamically creating a list of static clocks so
-         * need to initialise the clocks in the same way.
-         */
+    retStatus = rzg2CpgRatesApply (pCpg, planIndex, planRate, planCount,
+                                   newRate);
 
-        DLL_INIT (&pVxbClk->clkNode);
-        DLL_INIT (&pVxbClk->rootClkNode);
-        pVxbClk->clkStatus = 0U;
-        pVxbClk->clkRefs   = 0U;
-        pVxbClk->parentName   = NULL;
-        pVxbClk->parentNames  = NULL;
-        pVxbClk->parentClocks = NULL;
-        pVxbClk->parentNum = 1U;
-        pVxbClk->parentIdx = 0U;
-        DLL_INIT (&pVxbClk->parentNode);
-        DLL_INIT (&pVxbClk->childClkList);
-        }
+    pCpg->planTicks = rzg2TimestampGet () - startTicks;
+    pCpg->planClocks = planCount;
 
-    return OK;
+    return retStatus;
     }
 
 /*******************************************************************************
@@ -2355,10 +4363,14 @@ LOCAL STATUS vxbFdtRzg2CpgMssrAttach
     VXB_RESOURCE_ADR *  pResAdr;
     VXB_CLK_DOMAIN *    pCpgDomain;
     VXB_CLK_DOMAIN *    pMssrDomain;
-    VXB_CLK_ID          pClk;
+    UINT64              startTicks;
+    UINT32              gateMask [NELEMENTS (mstpcrOffset)];
+    int                 cpgOffset;
 
     RZG2_DBG_MSG (CPG_DBG_INFO, "Enter %s \n", __FUNCTION__);
 
+    startTicks = rzg2TimestampGet ();
+
     /* check for valid parameter */
 
     if (pDev == NULL)
@@ -2375,6 +4387,8 @@ LOCAL STATUS vxbFdtRzg2CpgMssrAttach
         return ERROR;
         }
 
+    (void)memset (pCpg, 0, sizeof (VXB_FDT_CPG_INSTANCE));
+
     vxbDevSoftcSet (pDev, (void *)pCpg);
     pCpg->pDev = pDev;
 
@@ -2460,10 +4474,33 @@ LOCAL STATUS vxbFdtRzg2CpgMssrAttach
         goto errOut;
         }
 
+    /*
+     * Allocate the clocks, their contexts and their initialised flags as
+     * arrays in clock list order, rather than each clock separately.
+     */
+
+    pCpg->pClkPool = vxbMemAlloc (sizeof (VXB_CLK) *
+                                  (RZG2_CPG_TOTAL_CLOCKS +
+                                   RZG2_MSSR_TOTAL_CLOCKS));
+    pCpg->pCpgClkData = vxbMemAlloc (sizeof (CPG_CLK_DATA) *
+                                     RZG2_CPG_TOTAL_CLOCKS);
+    pCpg->pMssrClkData = vxbMemAlloc (sizeof (MSSR_CLK_DATA) *
+                                      RZG2_MSSR_TOTAL_CLOCKS);
+    pCpg->pClkReady = vxbMemAlloc (RZG2_CPG_TOTAL_CLOCKS +
+                                   RZG2_MSSR_TOTAL_CLOCKS);
+    if ((pCpg->pClkPool == NULL) || (pCpg->pCpgClkData == NULL) ||
+        (pCpg->pMssrClkData == NULL) || (pCpg->pClkReady == NULL))
+        {
+        RZG2_DBG_MSG (CPG_DBG_ERR, "vxbMemAlloc error\n");
+        goto errOut;
+        }
+
     /* create the CPG and MSSR clock domains */
 
     if (rzg2CpgClocksCreate (pDev, pCpgDomain,
                              (VXB_CLK_ID *) pCpg->pCpgClkList,
+                             pCpg->pClkPool,
+                             (CPG_CLK_DATA *) pCpg->pCpgClkData,
                              RZG2_CPG_TOTAL_CLOCKS) == ERROR)
         {
         RZG2_DBG_MSG (CPG_DBG_ERR, "cpgClksCreate error\n");
@@ -2473,12 +4510,56 @@ LOCAL STATUS vxbFdtRzg2CpgMssrAttach
     if (rzg2MssrClocksCreate (pDev, pMssrDomain,
                               (VXB_CLK_ID *) (pCpg->pCpgClkList) +
                               RZG2_CPG_TOTAL_CLOCKS,
+                              pCpg->pClkPool + RZG2_CPG_TOTAL_CLOCKS,
+                              (MSSR_CLK_DATA *) pCpg->pMssrClkData,
                               RZG2_MSSR_TOTAL_CLOCKS) == ERROR)
         {
         RZG2_DBG_MSG (CPG_DBG_ERR, "mssrClksCreate error\n");
         goto errOut;
         }
 
+    /*
+     * In lazy mode only the clocks referenced from the device tree, and their
+     * ancestors, are initialised by vxbClksInit(). Otherwise all are.
+     */
+
+    cpgOffset = vxbFdtDevGet (pDev)->offset;
+    pCpg->lazyInit = (vxFdtPropGet (cpgOffset, "renesas,lazy-clocks",
+                                    NULL) != NULL);
+    pCpg->preEnable = (vxFdtPropGet (cpgOffset, "renesas,pre-enable-clocks",
+                                     NULL) != NULL);
+
+    (void)memset (gateMask, 0, sizeof (gateMask));
+
+    if (pCpg->lazyInit || pCpg->preEnable)
+        {
+        rzg2CpgClkRefsScan (pCpg, cpgOffset,
+                            pCpg->preEnable ? gateMask : NULL);
+        }
+
+    if (!pCpg->lazyInit)
+        {
+        (void)memset (pCpg->pClkReady, 1,
+                      RZG2_CPG_TOTAL_CLOCKS + RZG2_MSSR_TOTAL_CLOCKS);
+        }
+
+    /* apply the boot clock plan before the clocks are first used */
+
+    if (rzg2CpgClkPlanApply (pCpg) == ERROR)
+        {
+        RZG2_DBG_MSG (CPG_DBG_ERR, "boot clock plan error\n");
+        }
+
+    /*
+     * Start the referenced module clocks before vxbClksInit(), which gives the
+     * clocks started here no reference count.
+     */
+
+    if (pCpg->preEnable && (rzg2CpgGatesPreEnable (pCpg, gateMask) == ERROR))
+        {
+        RZG2_DBG_MSG (CPG_DBG_ERR, "module clock pre-enable timeout\n");
+        }
+
     /* initialise the static clocks from the created list */
 
     if (vxbClksInit (pDev, (VXB_CLK_ID *)pCpg->pCpgClkList, NULL) == ERROR)
@@ -2487,6 +4568,18 @@ LOCAL STATUS vxbFdtRzg2CpgMssrAttach
         goto errOut;
         }
 
+    pCpg->attachTicks = rzg2TimestampGet () - startTicks;
+
+    pRzg2Cpg = pCpg;
+
+    /* save and restore the clock settings over system suspend */
+
+    if (rzg2SuspendHookAdd (rzg2CpgCtxSave, rzg2CpgCtxRestore,
+                            (void *) pCpg) == ERROR)
+        {
+        RZG2_DBG_MSG (CPG_DBG_ERR, "rzg2SuspendHookAdd error\n");
+        }
+
     RZG2_DBG_MSG (CPG_DBG_INFO, "vxbFdtRzg2CpgMssrAttach OK\n");
 
     return OK;
@@ -2497,17 +4590,10 @@ errOut:
 
     /* free CPG clock resources */
 
-    pClk = (VXB_CLK_ID)pCpg->pCpgClkList;
-    while (pClk != NULL)
-        {
-        (void)vxbMemFree (pClk->clkContext);
-        (void)vxbMemFree (pClk->clkName);
-        (void)vxbMemFree (pClk);
-
-        /* coverity[use_after_free]: FALSE */
-
-        pClk++;
-        }
+    (void)vxbMemFree (pCpg->pClkReady);
+    (void)vxbMemFree (pCpg->pMssrClkData);
+    (void)vxbMemFree (pCpg->pCpgClkData);
+    (void)vxbMemFree (pCpg->pClkPool);
     (void)vxbMemFree (pCpg->pCpgClkList);
 
     (void)vxbResourceFree (pDev, pCpg->memRes);
@@ -2517,3 +4603,308 @@ errOut:
 
     return ERROR;
     }
+
+/*******************************************************************************
+*
+* rzg2CpgClkTypeName - get the name of a clock type
+*
+* RETURNS: a short name for the clock type.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL const char * rzg2CpgClkTypeName
+    (
+    VXB_CLK_TYPE type
+    )
+    {
+    switch (type)
+        {
+        case VXB_CLK_FIX_RATE:      return "fixed";
+        case VXB_CLK_FIX_FACTOR:    return "factor";
+        case VXB_CLK_PLL:           return "pll";
+        case VXB_CLK_DIVIDER:       return "divider";
+        case VXB_CLK_GATE:          return "gate";
+        default:                    return "unknown";
+        }
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgClkStatusName - get the name of a clock status
+*
+* RETURNS: a short name for the clock status.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL const char * rzg2CpgClkStatusName
+    (
+    UINT32 status
+    )
+    {
+    switch (status)
+        {
+        case CLOCK_STATUS_ENABLED:  return "on";
+        case CLOCK_STATUS_GATED:    return "off";
+        default:                    return "unknown";
+        }
+    }
+
+/*******************************************************************************
+*
+* rzg2CpgClkTreeShow - show the CPG and MSSR clock tree
+*
+* This routine displays every CPG and MSSR clock with its parent, type, rate,
+* hardware status and vxbClkLib reference count. The attach time and the number
+* of clocks initialised so far are shown first, followed by the number of clocks
+* set by the boot clock plan and the time taken, if a plan was applied.
+*
+* The CPG clock rates and states are calculated in one pass over the
+* rzg2CpgClocks table, which lists parents before their children, so each
+* clock reuses the result already calculated for its parent instead of walking
+* up the tree. PLLECR and the MSSR status registers are read once each. The CPG
+* clocks are then printed as a tree, followed by the MSSR module clocks.
+*
+* If <csvFormat> is TRUE, one comma separated line is printed per clock
+* instead, in table order, preceded by a header line.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+void rzg2CpgClkTreeShow
+    (
+    BOOL csvFormat      /* TRUE for CSV output */
+    )
+    {
+    VXB_FDT_CPG_INSTANCE *  pCpg = pRzg2Cpg;
+    VXB_CLK_ID *            pClkList;
+    VXB_CLK_ID              pClk;
+    CPG_CLK_DATA *          pCpgClk;
+    MSSR_CLK_DATA *         pMssrClk;
+    UINT64                  rate [RZG2_CPG_TOTAL_CLOCKS];
+    UINT32                  status [RZG2_CPG_TOTAL_CLOCKS];
+    int                     firstChild [RZG2_CPG_TOTAL_CLOCKS];
+    int                     nextSibling [RZG2_CPG_TOTAL_CLOCKS];
+    int                     stack [RZG2_CPG_TOTAL_CLOCKS];
+    int                     depth [RZG2_CPG_TOTAL_CLOCKS];
+    UINT32                  mstpsr [NELEMENTS (mstpsrOffset)];
+    UINT32                  pllecr;
+    UINT32                  cpgReg;
+    UINT32                  bitMask;
+    UINT32                  mssrStatus;
+    int                     parent;
+    int                     child;
+    int                     idx;
+    int                     level;
+    int                     sp;
+    int                     i;
+
+    if (pCpg == NULL)
+        {
+        printf ("CPG not available\n");
+        return;
+        }
+
+    pClkList = (VXB_CLK_ID *) pCpg->pCpgClkList;
+
+    /* snapshot the status registers shared by many clocks */
+
+    pllecr = rzg2CpgRead32 (pCpg, PLLECR);
+    for (i = 0; i < (int)NELEMENTS (mstpsrOffset); i++)
+        {
+        mstpsr [i] = rzg2CpgRead32 (pCpg, mstpsrOffset [i]);
+        }
+
+    /* calculate CPG rates and states, parents first */
+
+    for (i = 0; i < (int)RZG2_CPG_TOTAL_CLOCKS; i++)
+        {
+        pClk = pClkList [i];
+        pCpgClk = (CPG_CLK_DATA *) pClk->clkContext;
+        parent = rzg2CpgClocks [i].parentIndex;
+
+        firstChild [i] = -1;
+        nextSibling [i] = -1;
+
+        if (parent < 0)
+            {
+            rate [i] = rzg2CpgMssrClkRateGet (pClk, 0U);
+            status [i] = CLOCK_STATUS_ENABLED;
+            continue;
+            }
+
+        if (rate [parent] == CLOCK_RATE_INVALID)
+            {
+            rate [i] = CLOCK_RATE_INVALID;
+            }
+        else
+            {
+            rate [i] = rzg2CpgMssrClkRateGet (pClk, rate [parent]);
+            }
+
+        status [i] = status [parent];
+
+        if (pClk->clkType == VXB_CLK_PLL)
+            {
+            if ((pllecr & PLLECR_PLLnST (pCpgClk->variable.index)) == 0U)
+                {
+                status [i] = CLOCK_STATUS_GATED;
+                }
+            }
+        else if (pClk->clkType == VXB_CLK_DIVIDER)
+            {
+            if (rzg2CpgDividerStatusRegMaskGet (pCpgClk, &cpgReg,
+                                                &bitMask) == ERROR)
+                {
+                status [i] = CLOCK_STATUS_UNKNOWN;
+                }
+            else if ((cpgReg != 0U) &&
+                     ((rzg2CpgRead32 (pCpg, cpgReg) & bitMask) != 0U))
+                {
+                status [i] = CLOCK_STATUS_GATED;
+                }
+            }
+        }
+
+    /*
+     * Link the children of each clock. Inserting at the head leaves each list
+     * in reverse table order, so that pushing a list onto the walk stack pops
+     * the children in table order.
+     */
+
+    for (i = 0; i < (int)RZG2_CPG_TOTAL_CLOCKS; i++)
+        {
+        parent = rzg2CpgClocks [i].parentIndex;
+        if (parent >= 0)
+            {
+            nextSibling [i] = firstChild [parent];
+            firstChild [parent] = i;
+            }
+        }
+
+    if (csvFormat)
+        {
+        printf ("index,name,parent,type,rate,status,refs\n");
+        }
+    else
+        {
+        printf ("attach: %llu ticks at %u Hz, %u of %u clocks initialised%s\n",
+                pCpg->attachTicks, rzg2TimestampFreqGet (), pCpg->clkInitCount,
+                (UINT32)(RZG2_CPG_TOTAL_CLOCKS + RZG2_MSSR_TOTAL_CLOCKS),
+                pCpg->lazyInit ? " (lazy)" : "");
+
+        if (pCpg->planClocks != 0U)
+            {
+            printf ("boot clock plan: %u clocks set in %llu ticks at %u Hz\n",
+                    pCpg->planClocks, pCpg->planTicks, rzg2TimestampFreqGet ());
+            }
+
+        if (pCpg->preEnable)
+            {
+            printf ("module clock pre-enable: %u clocks started in %llu ticks "
+                    "at %u Hz\n", pCpg->preEnableGates, pCpg->preEnableTicks,
+                    rzg2TimestampFreqGet ());
+            }
+
+        if (pCpg->ctxRestoreTicks != 0U)
+            {
+            printf ("resume context restore: %llu ticks at %u Hz\n",
+                    pCpg->ctxRestoreTicks, rzg2TimestampFreqGet ());
+            }
+
+        printf ("register writes: %u, %u skipped as already set\n\n",
+                pCpg->regWrites, pCpg->regSkips);
+
+        printf ("%-24s %-8s %12s %-8s %s\n", "CPG clock", "type", "rate (Hz)",
+                "status", "refs");
+        }
+
+    for (i = 0; i < (int)RZG2_CPG_TOTAL_CLOCKS; i++)
+        {
+        if (rzg2CpgClocks [i].parentIndex >= 0)
+            {
+            continue;
+            }
+
+        /* depth first walk from each root */
+
+        sp = 0;
+        stack [sp] = i;
+        depth [sp++] = 0;
+
+        while (sp > 0)
+            {
+            idx = stack [--sp];
+            level = depth [sp];
+
+            pClk = pClkList [idx];
+            parent = rzg2CpgClocks [idx].parentIndex;
+
+            if (csvFormat)
+                {
+                printf ("%d,%s,%s,%s,%llu,%s,%u\n", idx, pClk->clkName,
+                        (parent < 0) ? "" : pClkList [parent]->clkName,
+                        rzg2CpgClkTypeName (pClk->clkType),
+                        (rate [idx] == CLOCK_RATE_INVALID) ? 0ULL : rate [idx],
+                        rzg2CpgClkStatusName (status [idx]), pClk->clkRefs);
+                }
+            else
+                {
+                printf ("%*s%-*s %-8s %12llu %-8s %u\n", level * 2, "",
+                        24 - (level * 2), pClk->clkName,
+                        rzg2CpgClkTypeName (pClk->clkType),
+                        (rate [idx] == CLOCK_RATE_INVALID) ? 0ULL : rate [idx],
+                        rzg2CpgClkStatusName (status [idx]), pClk->clkRefs);
+                }
+
+            for (child = firstChild [idx]; child >= 0;
+                 child = nextSibling [child])
+                {
+                depth [sp] = level + 1;
+                stack [sp++] = child;
+                }
+            }
+        }
+
+    /* MSSR module clocks */
+
+    if (!csvFormat)
+        {
+        printf ("\n%-24s %-8s %12s %-8s %s\n", "MSSR clock", "register",
+                "bit", "status", "refs");
+        }
+
+    for (i = 0; i < (int)RZG2_MSSR_TOTAL_CLOCKS; i++)
+        {
+        pClk = pClkList [RZG2_CPG_TOTAL_CLOCKS + i];
+        pMssrClk = (MSSR_CLK_DATA *) pClk->clkContext;
+
+        if ((mstpsr [pMssrClk->moduleReg] & (1U << pMssrClk->regBit)) == 0U)
+            {
+            mssrStatus = CLOCK_STATUS_ENABLED;
+            }
+        else
+            {
+            mssrStatus = CLOCK_STATUS_GATED;
+            }
+
+        if (csvFormat)
+            {
+            printf ("%d,%s,%s,%s,,%s,%u\n", (int)RZG2_CPG_TOTAL_CLOCKS + i,
+                    pClk->clkName,
+                    (pClk->parentClock == NULL) ? "" :
+                    pClk->parentClock->clkName,
+                    rzg2CpgClkTypeName (pClk->clkType),
+                    rzg2CpgClkStatusName (mssrStatus), pClk->clkRefs);
+            }
+        else
+            {
+            printf ("%-24s %-8u %12u %-8s %u\n", pClk->clkName,
+                    pMssrClk->moduleReg, pMssrClk->regBit,
+                    rzg2CpgClkStatusName (mssrStatus), pClk->clkRefs);
+            }
+        }
+    }
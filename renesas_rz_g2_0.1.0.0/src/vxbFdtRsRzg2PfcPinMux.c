@@ -32,6 +32,30 @@
 /*
 modification history
 --------------------
+19oct26,agt  refer to rzg2PfcBootGen for the boot program
+19oct26,agt  size the pin state property name for any state number
+19oct26,agt  look up the lock statistics class before taking the lock
+19oct26,agt  call the POC supply hook for POCCTRL changes of a transaction
+19oct26,agt  added optional register lock statistics
+19oct26,agt  added register context save and restore for system suspend
+19oct26,agt  added rzg2PfcProfilesRestore() and rzg2PfcPocVoltageGet()
+19oct26,agt  register access through RZG2_REG_READ32/WRITE32
+19oct26,agt  skip the GPIO pass if no selection changes, count skipped writes
+19oct26,agt  added HSCIF0/1, MSIOF0, RPC and CAN-FD0 pin groups
+19oct26,agt  added drive and bias profiles
+19oct26,agt  decoded pin state show and CSV export from a register snapshot
+19oct26,agt  added interrupt-safe GPIO/peripheral pin switching
+19oct26,agt  added rzg2PfcPocVoltageSet(), checked power-source length
+19oct26,agt  added boot program dump and apply
+19oct26,agt  pads shared by several pin groups, SCIF3/4/5 pins, generated
+             tables
+19oct26,agt  added pin ownership and conflict detection
+19oct26,agt  cache pin programs by configuration node
+19oct26,agt  added pin state programs and vxbPinMuxDisable
+19oct26,agt  index function and module selections by group
+19oct26,agt  added shadow register transactions
+19oct26,agt  resolve pin lists once per configuration node
+19oct26,agt  added hashed pin name index
 17sep19,hli  (VXWPG-394)
 */
 
@@ -76,6 +100,18 @@ must also contain pin configuration nodes that are referenced by the pin mux
 client user. This is described in the Pin Mux Drivers section of the VxWorks 7
 BSP and Driver Guide, and vxbPinMuxLib reference documentation.
 
+A pad can belong to several pin groups, for example A8 and A11 are used by
+both I2C6_A and SCIF3_B. The pins of a configuration node must have at least
+one group in common, and the first common group that selects the "function" of
+the node is used.
+
+The pin, group and function tables, and the pin name index, are generated by
+tools/rzg2PfcTblGen.py from the pin description in tools/pfc, which is a set
+of CSV files. Adding pins or functions is a change to these files: run the
+script, and commit the CSV files and the generated vxbFdtRsRzg2PfcPinMuxIds.h
+and vxbFdtRsRzg2PfcPinMuxTbl.h together. The script checks the description,
+and the driver checks the generated tables when the PFC is attached.
+
 Node names and labels are not specified by the driver but can be used to
 identify meaningful groups of pin configurations. In order to group pin
 configurations, this driver supports subnodes within a configuration node.
@@ -102,7 +138,10 @@ pins:       Required. A string list of pins to which the configuration will
             "sipF38", for HFBGA/SoC and BGA/SiP packages. These are defined in
             the pin function spreadsheet referenced in the RZ/G2M hardware
             manual, and can be found on the board schematic. The "soc" or "sip"
-            prefix must be used to identify the package.
+            prefix must be used to identify the package. Pins that have no
+            package name in the driver are named by GPIO port and bit, eg
+            "GP1_23", and dedicated pins without one by signal, eg
+            "QSPI0_SPCLK".
 \ce
 
 One or more of the following properties should be present to specify the
@@ -110,8 +149,9 @@ configuration to apply:
 
 \cs
 function:       A single string function to select on the multiplexed pins.
-                Currently supported functions are "etherAvb", "mmc0", "scif1",
-                and "scif2".
+                Currently supported functions are "etheravb", "sdhi0", "mmc0",
+                "mmc1", "scif0" to "scif5", "hscif0", "hscif1", "msiof0",
+                "canfd0", "rpc", "i2c0" to "i2c6", "usb0", "usb1" and "usb3".
 
 bias-disable:   Disable pull-up/down control on pins.
 
@@ -125,7 +165,119 @@ drive-control:  An integer value, in eighths, to set the output driving ability
 gpio-enable:    Enables GPIO, instead of peripheral function, on pins.
 \ce
 
-vxbPinMuxDisable is not supported.
+The configuration nodes of a pin mux state are applied as one transaction. The
+changes accumulate in a shadow copy of the PFC registers, and are then written
+with one write, and one PMMR unlock, per changed register. Registers whose
+value does not change are not written. Pins whose function changes are switched
+to GPIO mode before the function selection registers are written, and back to
+peripheral mode afterwards. If no function or module selection changes, as when
+the boot firmware has already set up the pins, the pins are left in peripheral
+mode, so that live pins such as the console do not glitch. The show routine
+reports the register writes, and the writes skipped as already set. If any
+configuration node is invalid, no register is written.
+
+Each configuration node is compiled once into a pin program, which holds the
+register fields the node changes. The nodes under the PFC node are compiled at
+attach, and any other node the first time it is enabled. The programs are cached
+by node, so enabling a node again, for example after a resume, replays its
+program without reading the device tree. Enabling a node saves the values its
+program replaces, so that vxbPinMuxDisable can restore them.
+
+A pin mux client can also switch between named pin states at runtime with
+rzg2PfcPinStateSet(), for example to park its pins in GPIO mode while it is
+suspended. The states are named by the client's "pinmux-names" property, where
+the Nth name selects the "pinmux-N" property:
+
+\cs
+    scif1: serial@e6e68000
+        {
+        ...
+        pinmux-0 = <&scif1Pins>;
+        pinmux-1 = <&scif1SleepPins>;
+        pinmux-names = "default", "sleep";
+        };
+\ce
+
+All the configuration nodes of a state are written in one transaction.
+
+Most boards configure the same pins at every boot. rzg2PfcBootProgDump() prints
+the register writes of the enabled configuration nodes as a C array, which a
+BSP can build into the image and pass to rzg2PfcBootProgSet() before the PFC is
+attached. The host program rzg2PfcBootGen, in test/host of this layer, builds
+this driver for the build host and prints the array for the default pin mux
+states of the enabled nodes of a compiled device tree, so the BSP build can
+generate it, as the HiHope RZ/G2M BSP does. The PFC attach then writes the array in one transaction, and does not
+compile the configuration nodes; a node is compiled when it is first enabled,
+and finds its registers already set. As for any transaction, pins only pass
+through GPIO mode if a function or module selection changes, so pins already set
+by the boot firmware, such as the console, do not glitch. The register values
+replaced by the boot program are kept, and are restored when a node is disabled.
+In debug builds each such node is checked against the boot program.
+
+The SD0 and SD3 pads are switched between 3.3 V and 1.8 V signalling with
+rzg2PfcPocVoltageSet(), which an SDHI driver calls during the signal voltage
+switch of UHS-I and HS200 cards. The routine can be called from interrupt
+context. If a hook was set with rzg2PfcPocHookSet(), it is called first, to
+switch the regulator supplying the pads. The number of switches and the last
+and longest switch times are displayed by vxbPinMuxShow().
+
+A driver can take a multiplexed pin as GPIO for a short time, for example to
+recover an I2C bus or to hold a serial line in break, and give it back to the
+peripheral. rzg2PfcPinHandleGet() returns a handle for a named pin, and
+rzg2PfcPinGpioSet() or rzg2PfcPinsGpioSet() switch one pin or several pins of
+the same GPSR register with one register write. These routines take no
+semaphore and can be called from interrupt context; the IPSR function
+selection of the pins is not changed.
+
+In verbose mode, vxbPinMuxShow() decodes the state of each pin known to the
+driver: GPIO or peripheral mode, the selected function and MOD_SEL variant, the
+drive strength in eighths, the pull and the POC signalling voltage.
+rzg2PfcPinStateCsvWrite() writes the same state as CSV to a file descriptor,
+for example STD_OUT, for diagnostics scripts. Both read each PFC register once
+into a snapshot, and decode the pins from the snapshot.
+
+A configuration node that sets only "drive-control" and bias properties can be
+used as a drive and bias profile, switched at run time by a driver changing
+operating mode, for example an RGMII link going to 1000 Mbit/s, or an SD/MMC
+host during tuning:
+
+\cs
+    &pfc
+        {
+        avbDrive1g: avb-drive-1g
+            {
+            pins = "sipA15", "sipB15", "sipB16";
+            drive-control = <8>;
+            };
+
+        avbDrive100m: avb-drive-100m
+            {
+            pins = "sipA15", "sipB15", "sipB16";
+            drive-control = <4>;
+            };
+        };
+\ce
+
+rzg2PfcProfileGet() returns a handle for the profile node with the given name
+under the PFC node, with its DRVCTRL, PUEN and PUD changes already resolved.
+rzg2PfcProfilesApply() writes several profiles in one transaction.
+
+If the driver is built with RZG2_LOCK_STATS defined, the PFC mutex records how
+often it is taken and contended, and its wait and hold times, for transactions
+and for each class of register changed outside them. rzg2PfcLockStatsShow()
+displays them.
+
+The driver registers system suspend hooks with rzg2SuspendHookAdd(). Before
+suspend, the GPSR, IPSR, MOD_SEL, DRVCTRL, PUEN, PUD and POCCTRL registers are
+saved. On resume they are restored as one transaction, like a pin mux state, so
+only the registers that differ are written, and the POC fields through
+rzg2PfcPocVoltageSet().
+
+The driver records the configuration node that last multiplexed each GPSR pin.
+If a node multiplexes a pin that another enabled node owns, the conflict is
+recorded with both owners, and the new node takes the pin. Disabling a node
+releases its pins. rzg2PfcPinOwnerShow() lists the owned pins and the recorded
+conflicts.
 
 INCLUDE FILES: vxBus.h vxbClkLib.h string.h vxbFdtLib.h
 
@@ -139,14 +291,17 @@ SEE ALSO: vxbPinMuxLib,
 #include <vxWorks.h>
 #include <string.h>
 #include <stdio.h>
+#include <fioLib.h>
 #include <intLib.h>
 #include <semLib.h>
+#include <spinLockLib.h>
 #include <vxFdtLib.h>
 
 #include <hwif/vxBus.h>
 #include <hwif/buslib/vxbFdtLib.h>
 #include <subsys/pinmux/vxbPinMuxLib.h>
 
+#include <rzg2Lib.h>
 #include <vxbFdtRsRzg2PfcPinMux.h>
 
 /* defines */
@@ -194,11 +349,6 @@ LOCAL UINT32 pfcDbgMask = PFC_DBG_ALL;
 #define PFC_FDT_FUNCTION     "function"
 #define PFC_FDT_PINS         "pins"
 
-/* PFC power-source value in mv*/
-
-#define PFC_MILLIVOLT_3V3     3300
-#define PFC_MILLIVOLT_1V8     1800
-
 /*
  * The longest expected pin, group or function name (AVB_AVTP_CAPTURE_A).
  * This is used as a safety net for strncmp string comparisons.
@@ -206,6 +356,35 @@ LOCAL UINT32 pfcDbgMask = PFC_DBG_ALL;
 
 #define PFC_NAME_LEN_MAX      20
 
+/* client pin state properties */
+
+#define PFC_FDT_PINMUX_NAMES  "pinmux-names"
+#define PFC_FDT_STATE_DEFAULT "default"
+#define PFC_FDT_PINMUX_LEN    20    /* "pinmux-" and any int */
+
+/* the most configuration nodes in one client pin state */
+
+#define PFC_STATE_NODES_MAX   8
+
+/* the most pins in one configuration node "pins" property */
+
+#define PFC_NODE_PINS_MAX     64
+
+/* number of 32-bit words in the PFC register block, PMMR to MOD_SEL2 */
+
+#define PFC_REG_WORDS         (PFC_MOD_SEL (NUM_MOD_SEL_REGS) / 4U)
+
+/* classes of the lock statistics: transactions, then by register */
+
+#define PFC_LOCK_XACT         0U      /* rzg2PfcXactBegin() to XactEnd() */
+#define PFC_LOCK_GPSR         1U      /* GPSRn */
+#define PFC_LOCK_IPSR         2U      /* IPSRn */
+#define PFC_LOCK_DRVCTRL      3U      /* DRVCTRLn */
+#define PFC_LOCK_PULL         4U      /* PUENn and PUDn */
+#define PFC_LOCK_MOD_SEL      5U      /* MOD_SELn */
+#define PFC_LOCK_OTHER        6U      /* POCCTRL and other registers */
+#define PFC_LOCK_CLASSES      7U
+
 /*
  * The "drive-control" property is specified by a range from 1 to 8 inclusive.
  * The DRV Control (DRVCTRL) Register values for each pin can be 3 bits for H
@@ -220,98 +399,133 @@ LOCAL UINT32 pfcDbgMask = PFC_DBG_ALL;
 
 #define PFC_PIN_DESC_TBL_END(pPin)     (pPin->sipName == NULL)
 
+/*
+ * The pin name index is an open addressing hash table of pfcPins indexes,
+ * generated with the tables. Its size, PFC_PIN_HASH_SIZE, is a power of two, at
+ * least twice the number of pins, so that most lookups compare a single name.
+ */
+
+#define PFC_PIN_HASH_EMPTY    0xffffU
+
+/* pin group mask bit */
+
+#define PFC_GROUP_BIT(groupId)  ((UINT64) 1 << (groupId))
+
+/*
+ * The pin program cache is an open addressing hash table of programs, keyed by
+ * FDT node offset. It is kept at most three quarters full.
+ */
+
+#define PFC_PROG_HASH_BITS    7U
+#define PFC_PROG_HASH_SIZE    (1U << PFC_PROG_HASH_BITS)
+#define PFC_PROG_MAX          ((PFC_PROG_HASH_SIZE * 3U) / 4U)
+#define PFC_PROG_HASH_MULT    2654435761U
+
+/* pin ownership, by GPSR register and bit, and recorded conflicts */
+
+#define PFC_PIN_OWNERS        (NUM_GPSR_REGS * 32U)
+#define PFC_CONFLICTS_MAX     16U
+
+/* FNV-1a hash parameters */
+
+#define PFC_FNV_OFFSET        2166136261U
+#define PFC_FNV_PRIME         16777619U
+
 /* typedefs */
 
+/* one register change of a pin program */
+
+typedef struct pfcPinStep
+    {
+    UINT16              offset;         /* PFC register offset */
+    UINT32              mask;           /* register bits set by the program */
+    UINT32              val;            /* value of the masked bits */
+    UINT32              gpio;           /* GPSR pins changing function */
+    UINT32              saved;          /* masked bits replaced by the program */
+    } PFC_PIN_STEP;
+
+/* pin program compiled from a configuration node */
+
+typedef struct pfcPinProg
+    {
+    int                 nodeOffset;     /* FDT configuration node */
+    UINT32              numSteps;       /* number of register changes */
+    BOOL                savedValid;     /* saved values can be restored */
+    BOOL                isProfile;      /* used as a drive and bias profile */
+    PFC_PIN_STEP *      pSteps;         /* register changes, after program */
+    } PFC_PIN_PROG;
+
+/* pin claimed by a configuration node while another node owned it */
+
+typedef struct pfcPinConflict
+    {
+    UINT32              pin;            /* GPSR register and bit */
+    int                 prevOwner;      /* FDT node that owned the pin */
+    int                 newOwner;       /* FDT node that claimed the pin */
+    } PFC_PIN_CONFLICT;
+
+/* snapshot of the PFC registers, decoded by the show and export routines,
+ * and saved over system suspend */
+
+typedef struct pfcRegSnap
+    {
+    UINT32              gpsr [NUM_GPSR_REGS];       /* GPSRn */
+    UINT32              ipsr [NUM_IPSR_REGS];       /* IPSRn */
+    UINT32              modSel [NUM_MOD_SEL_REGS];  /* MOD_SELn */
+    UINT32              drvCtrl [NUM_DRVTRL_REGS];  /* DRVCTRLn */
+    UINT32              puen [NUM_PUEN_REGS];       /* PUENn */
+    UINT32              pud [NUM_PUD_REGS];         /* PUDn */
+    UINT32              pocCtrl;                    /* POCCTRL */
+    } PFC_REG_SNAP;
+
 typedef struct pfcPinmuxDrvCtrl
     {
     VXB_PINMUX_CTRL *   pPinMuxCtrl;    /* pin mux controller representation */
+    const struct pfcFuncDesc * pFuncSel;    /* function selection table */
     VXB_RESOURCE *      memRes;         /* mapped memory resource */
     VIRT_ADDR           regBase;        /* mapped PFC register base */
     void *              pHandle;        /* register memory access handle */
     SEM_ID              mutex;          /* register access protection */
+    spinlockIsr_t       regLock;        /* PMMR unlock and write protection */
+    BOOL                xactActive;     /* register changes are shadowed */
+    UINT32              xactCount;      /* registers changed in transaction */
+    UINT16              xactRegs [PFC_REG_WORDS];   /* changed register words */
+    UINT8               xactValid [PFC_REG_WORDS];  /* shadow value is held */
+    UINT32              xactVal [PFC_REG_WORDS];    /* shadow register values */
+    UINT32              xactMask [PFC_REG_WORDS];   /* shadow bits changed */
+    UINT32              xactGpio [NUM_GPSR_REGS];   /* GPSR bits set to GPIO */
+    UINT16 *            pFuncFirst;     /* first pFuncOrder entry of groups */
+    UINT16 *            pFuncOrder;     /* function selections by group */
+    UINT16 *            pModFirst;      /* first pModOrder entry of groups */
+    UINT16 *            pModOrder;      /* module selections by group */
+    PFC_PIN_PROG *      progHash [PFC_PROG_HASH_SIZE];  /* program cache */
+    UINT32              numProgs;       /* number of cached programs */
+    UINT32              pinClaimed [NUM_GPSR_REGS]; /* GPSR pins with owner */
+    int                 pinOwner [PFC_PIN_OWNERS];  /* owning FDT nodes */
+    PFC_PIN_CONFLICT    conflicts [PFC_CONFLICTS_MAX];  /* last conflicts */
+    UINT32              numConflicts;   /* conflicts since attach */
+    BOOL                bootApplied;    /* boot program has been written */
+    UINT32              bootPrev [PFC_REG_WORDS];   /* values before boot */
+    UINT32              bootMask [PFC_REG_WORDS];   /* bits set by boot */
+    UINT32              pocSwitches;    /* POC voltage switches */
+    UINT64              pocLastTicks;   /* last POC voltage switch time */
+    UINT64              pocMaxTicks;    /* longest POC voltage switch time */
+    UINT32              regWrites;      /* register writes */
+    UINT32              regSkips;       /* writes skipped, value already set */
+    BOOL                ctxValid;       /* context saved for system suspend */
+    PFC_REG_SNAP        ctxSnap;        /* registers saved for system suspend */
+#ifdef RZG2_LOCK_STATS
+    RZG2_LOCK_STAT      lockStats [PFC_LOCK_CLASSES];   /* by class */
+    UINT64              xactTakeTime;   /* time the transaction took the lock */
+#endif /* RZG2_LOCK_STATS */
     } PFC_PINMUX_DRVCTRL;
 
 /*
- * Supported pin groups, named after a pin group's primary function. This list
- * is incomplete and will be expanded to support additional pin groups, as
- * required by future drivers.
- */
-
-typedef enum pfcGroupId
-    {
-    GRP_NONE,
-    GRP_CANFD0_A,
-    GRP_CANFD0_B,
-    GRP_SCIF0,
-    GRP_SCIF1_A,
-    GRP_SCIF1_B,
-    GRP_SCIF2_A,
-    GRP_SCIF2_B,
-    GRP_SCIF3_A,
-    GRP_SCIF3_B,
-    GRP_SCIF4_A,
-    GRP_SCIF4_B,
-    GRP_SCIF4_C,
-    GRP_SCIF5_A,
-    GRP_SCIF5_B,
-    GRP_ETHERAVB,
-    GRP_HSCIF1_A,
-    GRP_HSCIF1_B,
-    GRP_SDHI0,
-    GRP_SDHI0_DATA4,
-    GRP_SDHI0_CTRL,
-    GRP_SDHI1,
-    GRP_SDHI2,
-    GRP_SDHI3,
-    GRP_SDHI3_DATA4,
-    GRP_SDHI3_CTRL,
-    GRP_I2C0,
-    GRP_I2C1_A,
-    GRP_I2C1_B,
-    GRP_I2C2_A,
-    GRP_I2C2_B,
-    GRP_I2C3,
-    GRP_I2C5,
-    GRP_I2C6_A,
-    GRP_I2C6_B,
-    GRP_I2C6_C,
-    GRP_USB0,
-    GRP_USB1,
-    GRP_USB3,
-    } PFC_GROUP_ID;
-
-/*
- * Supported functions. This list is incomplete and will be expanded to support
- * additional functions, as required by future drivers.
+ * pin group and function IDs, generated with the pin tables by
+ * tools/rzg2PfcTblGen.py
  */
 
-typedef enum pfcFuncId
-    {
-    FN_NONE,
-    FN_SCIF0,
-    FN_SCIF1,
-    FN_SCIF2,
-    FN_SCIF3,   
-    FN_SCIF4,
-    FN_SCIF5,
-    FN_ETHERAVB,
-    FN_SDHI0,
-    FN_SDHI1,
-    FN_SDHI2,
-    FN_SDHI3,
-    FN_MMC0,
-    FN_MMC1,
-    FN_I2C0,
-    FN_I2C1,
-    FN_I2C2,
-    FN_I2C3,
-    FN_I2C4,
-    FN_I2C5,
-    FN_I2C6,
-    FN_USB0,
-    FN_USB1,
-    FN_USB3
-    } PFC_FUNC_ID;
+#include "vxbFdtRsRzg2PfcPinMuxIds.h"
 
 typedef struct pfcFunction
     {
@@ -328,6 +542,18 @@ typedef enum pfcPinPullState
     PIN_PU_PULL_DOWN
     } PFC_PIN_PULL_STATE;
 
+/* decoded state of a pin */
+
+typedef struct pfcPinState
+    {
+    const char *        mode;           /* "gpio", "periph" or "fixed" */
+    const char *        funcName;       /* selected function, or "-" */
+    char                variant;        /* MOD_SEL variant, or '-' */
+    UINT32              drvEighths;     /* drive strength in eighths */
+    PFC_PIN_PULL_STATE  pull;           /* pull state */
+    UINT32              pocMv;          /* POC voltage in mv, 0 if none */
+    } PFC_PIN_STATE;
+
 /* pin descriptor used to define supported pins in pfcPins table */
 
 typedef struct pfcPinDesc
@@ -363,7 +589,7 @@ typedef struct pfcPocDesc
     {
     PFC_FUNC_ID     funcId;             /* function to apply */
     UINT32          pocMask;            /* POC selection field */
-    UINT32          pocVal;             /* POC value */
+    PFC_GROUP_ID    padGroup;           /* pin group of the POC pads */
     } PFC_POC_DESC;
 
 typedef STATUS (PFC_PIN_HANDLER)       /* pin configuration function */
@@ -389,6 +615,7 @@ LOCAL STATUS vxbFdtRzg2PfcPinMuxAttach (VXB_DEV_ID pDev);
 LOCAL STATUS vxbFdtRzg2PfcPinMuxShutdown (VXB_DEV_ID pDev);
 LOCAL STATUS vxbFdtRzg2PfcPinMuxDetach (VXB_DEV_ID pDev);
 LOCAL STATUS vxbFdtRzg2PfcPinMuxEnable (VXB_DEV_ID pDev, INT32 offset);
+LOCAL STATUS vxbFdtRzg2PfcPinMuxDisable (VXB_DEV_ID pDev, INT32 offset);
 LOCAL void   vxbFdtRzg2PfcPinMuxShow     (VXB_DEV_ID pDev, INT32 verbose);
 
 LOCAL VXB_DRV_METHOD vxbFdtPfcPinMuxMethodList[] =
@@ -398,359 +625,24 @@ LOCAL VXB_DRV_METHOD vxbFdtPfcPinMuxMethodList[] =
         { VXB_DEVMETHOD_CALL(vxbDevShutdown),   vxbFdtRzg2PfcPinMuxShutdown },
         { VXB_DEVMETHOD_CALL(vxbDevDetach),     vxbFdtRzg2PfcPinMuxDetach },
         { VXB_DEVMETHOD_CALL(vxbPinMuxEnable),  vxbFdtRzg2PfcPinMuxEnable },
+        { VXB_DEVMETHOD_CALL(vxbPinMuxDisable), vxbFdtRzg2PfcPinMuxDisable },
         { VXB_DEVMETHOD_CALL(vxbPinMuxShow),    (FUNCPTR)vxbFdtRzg2PfcPinMuxShow },
         VXB_DEVMETHOD_END
     };
 
 /*
- * supported PFC pin configuration definitions
- *
- * The names in this table are the pin names that can be referenced in the
- * device tree when setting pin configurations.
- * This table can be expanded to support additional pins and groups.
- */
-
-LOCAL const PFC_PIN_DESC pfcPins [] =
-    {
-    /* sipName  gpsrRegBit              puRegBit   drvMask         group */
-
-    /* SCIF0 */
-
-    {"sipF37",  GPSR_REG_PIN (5U, 3U),  PU_CTS0,   DRVCTRL_CTS0,   GRP_SCIF0},
-
-    /* SCIF1 */
-    
-    {"sipE39",  GPSR_REG_PIN (5U, 5U),  PU_RX1,    DRVCTRL_RX1,    GRP_SCIF1_A},
-    {"sipE38",  GPSR_REG_PIN (5U, 6U),  PU_TX1,    DRVCTRL_TX1,    GRP_SCIF1_A},
-    {"sipH38",  GPSR_REG_PIN (5U, 7U),  PU_CTS1,   DRVCTRL_CTS1,   GRP_SCIF1_A},
-    {"sipH39",  GPSR_REG_PIN (5U, 8U),  PU_RTS1,   DRVCTRL_RTS1,   GRP_SCIF1_A},
-
-    /* SCIF2 */
-    
-    {"sipL39",  GPSR_REG_PIN (5U, 9U),  PU_SCK2,   DRVCTRL_SCK2,   GRP_SCIF2_A},
-    {"sipF38",  GPSR_REG_PIN (5U, 10U), PU_TX2,    DRVCTRL_TX2,    GRP_SCIF2_A},
-    {"sipF39",  GPSR_REG_PIN (5U, 11U), PU_RX2,    DRVCTRL_RX2,    GRP_SCIF2_A},
-
-    /* etheravb */
-
-    {"sipA16",  GPSR_NONE,  PU_AVB_RX_CTL,    DRVCTRL_AVB_RX_CTL,    GRP_ETHERAVB},
-    {"sipB19",  GPSR_NONE,  PU_AVB_RXC,       DRVCTRL_AVB_RXC,       GRP_ETHERAVB},
-    {"sipA13",  GPSR_NONE,  PU_AVB_RD0,       DRVCTRL_AVB_RD0,       GRP_ETHERAVB},
-    {"sipB13",  GPSR_NONE,  PU_AVB_RD1,       DRVCTRL_AVB_RD1,       GRP_ETHERAVB},
-    {"sipA14",  GPSR_NONE,  PU_AVB_RD2,       DRVCTRL_AVB_RD2,       GRP_ETHERAVB},
-    {"sipB14",  GPSR_NONE,  PU_AVB_RD3,       DRVCTRL_AVB_RD3,       GRP_ETHERAVB},
-    {"sipA8",   GPSR_NONE,  PU_AVB_TX_CTL,    DRVCTRL_AVB_TX_CTL,    GRP_ETHERAVB},
-    {"sipA19",  GPSR_NONE,  PU_AVB_TXC,       DRVCTRL_AVB_TXC,       GRP_ETHERAVB},
-    {"sipA18",  GPSR_NONE,  PU_AVB_TD0,       DRVCTRL_AVB_TD0,       GRP_ETHERAVB},
-    {"sipB18",  GPSR_NONE,  PU_AVB_TD1,       DRVCTRL_AVB_TD1,       GRP_ETHERAVB},
-    {"sipA17",  GPSR_NONE,  PU_AVB_TD2,       DRVCTRL_AVB_TD2,       GRP_ETHERAVB},
-    {"sipB17",  GPSR_NONE,  PU_AVB_TD3,       DRVCTRL_AVB_TD3,       GRP_ETHERAVB},
-    {"sipA12",  GPSR_NONE,  PU_AVB_TXCREFCLK, DRVCTRL_AVB_TXCREFCLK, GRP_ETHERAVB},
-    {"sipA9",   GPSR_NONE,  PU_AVB_MDIO,      DRVCTRL_AVB_MDIO,      GRP_ETHERAVB},
-    {"sipA15",  GPSR_REG_PIN (2U, 9U),  PU_AVB_MDC,    DRVCTRL_AVB_MDC,    GRP_ETHERAVB},
-    {"sipB15",  GPSR_REG_PIN (2U, 10U), PU_AVB_MAGIC,  DRVCTRL_AVB_MAGIC,  GRP_ETHERAVB},
-    {"sipB16",  GPSR_REG_PIN (2U, 11U), PU_AVB_PHY_INT,DRVCTRL_AVB_PHY_INT,GRP_ETHERAVB},
-    {"sipB9",   GPSR_REG_PIN (2U, 12U), PU_AVB_LINK,   DRVCTRL_AVB_LINK,   GRP_ETHERAVB},
-
-    /* SD0 */
-    
-    {"sipT35", GPSR_REG_PIN (3U, 0U),  PU_SD0_CLK,    DRVCTRL_SD0_CLK,  GRP_SDHI0 },
-    {"sipU33", GPSR_REG_PIN (3U, 1U),  PU_SD0_CMD,    DRVCTRL_SD0_CMD,  GRP_SDHI0 },
-    {"sipT33", GPSR_REG_PIN (3U, 2U),  PU_SD0_DAT0,   DRVCTRL_SD0_DAT0, GRP_SDHI0 },
-    {"sipT32", GPSR_REG_PIN (3U, 3U),  PU_SD0_DAT1,   DRVCTRL_SD0_DAT1, GRP_SDHI0 },
-    {"sipU35", GPSR_REG_PIN (3U, 4U),  PU_SD0_DAT2,   DRVCTRL_SD0_DAT2, GRP_SDHI0 },
-    {"sipU34", GPSR_REG_PIN (3U, 5U),  PU_SD0_DAT3,   DRVCTRL_SD0_DAT3, GRP_SDHI0 },
-
-    /* SD1 */
-
-    {"sipA27",  GPSR_REG_PIN (3U, 8U),  PU_SD1_DAT0,   DRVCTRL_SD1_DAT0, GRP_SDHI1},
-    {"sipB27",  GPSR_REG_PIN (3U, 9U),  PU_SD1_DAT1,   DRVCTRL_SD1_DAT1, GRP_SDHI1},
-    {"sipC27",  GPSR_REG_PIN (3U, 10U), PU_SD1_DAT2,   DRVCTRL_SD1_DAT2, GRP_SDHI1},
-    {"sipD27",  GPSR_REG_PIN (3U, 11U), PU_SD1_DAT3,   DRVCTRL_SD1_DAT3, GRP_SDHI1},
-
-    /* SD2 */
-
-    {"sipA26",  GPSR_REG_PIN (4U, 0U),  PU_SD2_CLK,    DRVCTRL_SD2_CLK,  GRP_SDHI2},
-    {"sipA25",  GPSR_REG_PIN (4U, 1U),  PU_SD2_CMD,    DRVCTRL_SD2_CMD,  GRP_SDHI2},
-    {"sipD26",  GPSR_REG_PIN (4U, 2U),  PU_SD2_DAT0,   DRVCTRL_SD2_DAT0, GRP_SDHI2},
-    {"sipC25",  GPSR_REG_PIN (4U, 3U),  PU_SD2_DAT1,   DRVCTRL_SD2_DAT1, GRP_SDHI2},
-    {"sipD24",  GPSR_REG_PIN (4U, 4U),  PU_SD2_DAT2,   DRVCTRL_SD2_DAT2, GRP_SDHI2},
-    {"sipD23",  GPSR_REG_PIN (4U, 5U),  PU_SD2_DAT3,   DRVCTRL_SD2_DAT3, GRP_SDHI2},
-    {"sipB25",  GPSR_REG_PIN (4U, 6U),  PU_SD2_DS,     DRVCTRL_SD2_DAT3, GRP_SDHI2},
-
-    /* SD3 */
-
-    {"sipM35", GPSR_REG_PIN (4U, 7U),  PU_SD3_CLK,    DRVCTRL_SD3_CLK,  GRP_SDHI3 },
-    {"sipM31", GPSR_REG_PIN (4U, 8U),  PU_SD3_CMD,    DRVCTRL_SD3_CMD,  GRP_SDHI3 },
-    {"sipL33", GPSR_REG_PIN (4U, 9U),  PU_SD3_DAT0,   DRVCTRL_SD3_DAT0, GRP_SDHI3 },
-    {"sipM30", GPSR_REG_PIN (4U, 10U), PU_SD3_DAT1,   DRVCTRL_SD3_DAT1, GRP_SDHI3 },
-    {"sipM32", GPSR_REG_PIN (4U, 11U), PU_SD3_DAT2,   DRVCTRL_SD3_DAT2, GRP_SDHI3 },
-    {"sipL34", GPSR_REG_PIN (4U, 12U), PU_SD3_DAT3,   DRVCTRL_SD3_DAT3, GRP_SDHI3 },
-    {"sipM33", GPSR_REG_PIN (4U, 13U), PU_SD3_DAT4,   DRVCTRL_SD3_DAT4, GRP_SDHI3 },
-    {"sipN33", GPSR_REG_PIN (4U, 14U), PU_SD3_DAT5,   DRVCTRL_SD3_DAT5, GRP_SDHI3 },
-    {"sipN32", GPSR_REG_PIN (4U, 15U), PU_SD3_DAT6,   DRVCTRL_SD3_DAT6, GRP_SDHI3 },
-    {"sipN31", GPSR_REG_PIN (4U, 16U), PU_SD3_DAT7,   DRVCTRL_SD3_DAT7, GRP_SDHI3 },
-    {"sipN30", GPSR_REG_PIN (4U, 17U), PU_SD3_DS,     DRVCTRL_SD3_DAT7, GRP_SDHI3 },
-    
-    /* I2C0 */
-
-    {"sipC29",  GPSR_REG_PIN (3U, 14U), PU_SD1_CD,  DRVCTRL_SD1_CD, GRP_I2C0},
-    {"sipB29",  GPSR_REG_PIN (3U, 15U), PU_SD1_WP,  DRVCTRL_SD1_WP, GRP_I2C0},
-
-    /* I2C1_A */
-
-    {"sipAB34", GPSR_REG_PIN (5U, 10U), PU_TX2,     DRVCTRL_TX2,    GRP_I2C1_A},
-    {"sipAB33", GPSR_REG_PIN (5U, 11U), PU_RX2,     DRVCTRL_RX2,    GRP_I2C1_A},
-
-    /* I2C1_B */
-
-    {"sipAA39", GPSR_REG_PIN (5U, 23U), PU_MLB_CLK, DRVCTRL_MLB_CLK,GRP_I2C1_B},
-    {"sipJ39",  GPSR_REG_PIN (5U, 24U), PU_MLB_SIG, DRVCTRL_MLB_SIG,GRP_I2C1_B},
-
-    /* I2C2_A */
-
-    {"sipG39",  GPSR_REG_PIN (5U, 4U),  PU_RTS0,    DRVCTRL_RTS0,   GRP_I2C2_A},
-    {"sipK39",  GPSR_REG_PIN (5U, 0U),  PU_SCK0,    DRVCTRL_SCK0,   GRP_I2C2_A},
-
-    /* I2C2_B */
-
-    {"sipV31",  GPSR_REG_PIN (3U, 12U), PU_SD0_CD,  DRVCTRL_SD0_CD, GRP_I2C2_B},
-    {"sipV30",  GPSR_REG_PIN (3U, 13U), PU_SD0_WP,  DRVCTRL_SCK0,   GRP_I2C2_B},
-
-    /* I2C3 */
-
-    {"sipB6",   GPSR_REG_PIN (2U, 7U),  PU_PWM1,    DRVCTRL_PWM1,   GRP_I2C3},
-    {"sipA6",   GPSR_REG_PIN (2U, 8U),  PU_PWM2,    DRVCTRL_PWM2,   GRP_I2C3},
-
-    /* I2C5 */
-
-    {"sipB11",  GPSR_REG_PIN (2U, 13U), PU_AVB_MATCH,   DRVCTRL_AVB_MATCH,   GRP_I2C5},
-    {"sipA11",  GPSR_REG_PIN (2U, 14U), PU_AVB_CAPTURE, DRVCTRL_AVB_CAPTURE, GRP_I2C5},
-
-    /* I2C6_A */
-
-    {"sipJ1",   GPSR_REG_PIN (1U, 11U), PU_A11,     DRVCTRL_A11,    GRP_I2C6_A},
-    {"sipK2",   GPSR_REG_PIN (1U, 8U),  PU_A8,      DRVCTRL_A8,     GRP_I2C6_A},
-
-    /* I2C6_B */
-
-    {"sipB1",   GPSR_REG_PIN (1U, 25U), PU_WE0,     DRVCTRL_WE0,    GRP_I2C6_B},
-    {"sipD2",   GPSR_REG_PIN (1U, 26U), PU_WE1,     DRVCTRL_WE1,    GRP_I2C6_B},
-
-    /* I2C6_C */
-
-    {"sipR2",   GPSR_REG_PIN (0U, 14U), PU_D14,     DRVCTRL_D14,    GRP_I2C6_C},
-    {"sipR1",   GPSR_REG_PIN (0U, 15U), PU_D15,     DRVCTRL_D15,    GRP_I2C6_C},
-
-    /* USB 3.0 */
-
-    {"sipAJ33", GPSR_REG_PIN (6U, 28U), PU_USB3_PWEN, DRVCTRL_USB3_PWEN,  GRP_USB3 },
-    {"sipAH30", GPSR_REG_PIN (6U, 29U), PU_USB3_OVC,  DRVCTRL_USB3_OVC,   GRP_USB3 },
-
-    /* USB2 ch1 */
-
-    {"sipAH34", GPSR_REG_PIN (6U, 26U), PU_USB1_PWEN, DRVCTRL_USB1_PWEN,  GRP_USB1 },
-    {"sipAH33", GPSR_REG_PIN (6U, 27U), PU_USB1_OVC,  DRVCTRL_USB1_OVC,   GRP_USB1 },
-
-    /* USB2 ch0 */
-
-    {"sipAH31", GPSR_REG_PIN (6U, 24U), PU_USB0_PWEN, DRVCTRL_USB0_PWEN,  GRP_USB0 },
-    {"sipAH32", GPSR_REG_PIN (6U, 25U), PU_USB0_OVC,  DRVCTRL_USB0_OVC,   GRP_USB0 },
-
-    {NULL,      GPSR_NONE,              0U,          0,             GRP_NONE}
-    };
-
-/* function names referenced in the device tree, mapped to enumeration */
-
-LOCAL const PFC_FUNCTION pfcFuncs [] =
-    {
-    { FN_SCIF0,     "scif0" },
-    { FN_SCIF1,     "scif1" },
-    { FN_SCIF2,     "scif2" },
-    { FN_SCIF3,     "scif3" },
-    { FN_SCIF4,     "scif4" },
-    { FN_SCIF4,     "scif5" },
-    { FN_ETHERAVB,  "etheravb" },
-    { FN_SDHI0,     "sdhi0" },
-    { FN_MMC0,      "mmc0" },
-    { FN_MMC1,      "mmc1" },
-    { FN_SDHI3,     "sdhi3" },
-    { FN_I2C0,      "i2c0" },
-    { FN_I2C1,      "i2c1" },
-    { FN_I2C2,      "i2c2" },
-    { FN_I2C3,      "i2c3" },
-    { FN_I2C3,      "i2c4" },
-    { FN_I2C5,      "i2c5" },
-    { FN_I2C6,      "i2c6" },
-    { FN_USB0,      "usb0" },
-    { FN_USB1,      "usb1" },
-    { FN_USB3,      "usb3" }
-    };
-#define PFC_NUM_FUNCS   (NELEMENTS (pfcFuncs))
-
-/*
- * supported PFC peripheral function selections
- *
- * This table defines the supported peripheral functions associated with groups
- * of pins, together with the setting required in the appropriate IPSR register.
- * This table can be expanded to support additional function options.
- */
-
-LOCAL const PFC_FUNC_DESC xPfcFuncSel [] =
-    {
-    /*  group       function     ipsrMask            ipsrVal */
-
-    { GRP_SCIF0,    FN_SCIF0,    IPSR_RX0,           0U }, /* RX0 */
-    { GRP_SCIF0,    FN_SCIF0,    IPSR_TX0,           0U }, /* TX0 */
-
-    { GRP_SCIF1_A,  FN_SCIF1,    IPSR_RX1_A,         0U }, /* RX1_A */
-    { GRP_SCIF1_A,  FN_SCIF1,    IPSR_TX1_A,         0U }, /* TX1_A */
-    { GRP_SCIF1_A,  FN_SCIF1,    IPSR_CTS1,          0U }, /* CTS1# */
-    { GRP_SCIF1_A,  FN_SCIF1,    IPSR_RTS1,          0U }, /* RTS1# */
-    { GRP_SCIF1_B,  FN_SCIF1,    IPSR_RX1_B,         1U }, /* RX1_B */
-    { GRP_SCIF1_B,  FN_SCIF1,    IPSR_TX1_B,         1U }, /* TX1_B */
-    { GRP_SCIF1_B,  FN_SCIF1,    IPSR_CTS1,          0U }, /* CTS1# */
-    { GRP_SCIF1_B,  FN_SCIF1,    IPSR_RTS1,          0U }, /* RTS1# */
-
-    { GRP_SCIF2_A,  FN_SCIF2,    IPSR_TX2_A,         0U }, /* TX2_A */
-    { GRP_SCIF2_A,  FN_SCIF2,    IPSR_RX2_A,         0U }, /* RX2_A */
-    { GRP_SCIF2_B,  FN_SCIF2,    IPSR_TX2_B,         1U }, /* TX2_B */
-    { GRP_SCIF2_B,  FN_SCIF2,    IPSR_RX2_B,         1U }, /* RX2_B */
-
-    { GRP_SCIF3_A,  FN_SCIF2,    IPSR_TX3_A,         3U }, /* TX3_A */
-    { GRP_SCIF3_A,  FN_SCIF2,    IPSR_RX3_A,         3U }, /* RX3_A */
-    { GRP_SCIF3_B,  FN_SCIF3,    IPSR_TX3_B,         1U }, /* TX3_B */
-    { GRP_SCIF3_B,  FN_SCIF3,    IPSR_RX3_B,         1U }, /* RX3_B */
-
-    { GRP_SCIF4_A,  FN_SCIF4,    IPSR_TX4_A,         3U }, /* TX4_A */
-    { GRP_SCIF4_A,  FN_SCIF4,    IPSR_RX4_A,         3U }, /* RX4_A */
-    { GRP_SCIF4_B,  FN_SCIF4,    IPSR_TX4_B,         3U }, /* TX4_B */
-    { GRP_SCIF4_B,  FN_SCIF4,    IPSR_RX4_B,         3U }, /* RX4_B */
-    { GRP_SCIF4_C,  FN_SCIF4,    IPSR_TX4_C,         3U }, /* TX4_C */
-    { GRP_SCIF4_C,  FN_SCIF4,    IPSR_RX4_C,         3U }, /* RX4_C */
-
-    { GRP_SCIF5_A,  FN_SCIF5,    IPSR_TX5_A,         1U }, /* TX5_A */
-    { GRP_SCIF5_A,  FN_SCIF5,    IPSR_RX5_A,         1U }, /* RX5_A */
-    { GRP_SCIF5_B,  FN_SCIF5,    IPSR_TX5_B,         0xaU }, /* TX5_B */
-    { GRP_SCIF5_B,  FN_SCIF5,    IPSR_RX5_B,         0xaU }, /* RX5_B */
-
-    { GRP_ETHERAVB, FN_ETHERAVB, IPSR_AVB_MDC,       0U }, /* AVB_MDC */
-    { GRP_ETHERAVB, FN_ETHERAVB, IPSR_AVB_PHY_INT,   0U }, /* AVB_PHY_INT */
-    { GRP_ETHERAVB, FN_ETHERAVB, IPSR_AVB_LINK,      0U }, /* AVB_AVB_LINK */
-
-    { GRP_SDHI0,	FN_SDHI0,	 IPSR_SD0_DAT0,      0U }, /* SD0 DAT0 */
-    { GRP_SDHI0,	FN_SDHI0,	 IPSR_SD0_DAT1,      0U }, /* SD0 DAT1 */
-    { GRP_SDHI0,	FN_SDHI0,	 IPSR_SD0_DAT2,      0U }, /* SD0 DAT2 */
-    { GRP_SDHI0,	FN_SDHI0,	 IPSR_SD0_DAT3,      0U }, /* SD0 DAT3 */
-    { GRP_SDHI0,	FN_SDHI0,	 IPSR_SD0_CLK,	     0U }, /* SD0 CLK */
-    { GRP_SDHI0,	FN_SDHI0,	 IPSR_SD0_CMD,	     0U }, /* SD0 CMD */
-
-    { GRP_SDHI1,    FN_MMC0,     IPSR_SD1_DAT0,      1U }, /* MMC0_DAT4 */
-    { GRP_SDHI1,    FN_MMC0,     IPSR_SD1_DAT1,      1U }, /* MMC0_DAT5 */
-    { GRP_SDHI1,    FN_MMC0,     IPSR_SD1_DAT2,      1U }, /* MMC0_DAT6 */
-    { GRP_SDHI1,    FN_MMC0,     IPSR_SD1_DAT3,      1U }, /* MMC0_DAT7 */
-    { GRP_SDHI2,    FN_MMC0,     IPSR_SD2_CLK,       0U }, /* MMC0_CLK */
-    { GRP_SDHI2,    FN_MMC0,     IPSR_SD2_CMD,       0U }, /* MMC0_CMD */
-    { GRP_SDHI2,    FN_MMC0,     IPSR_SD2_DAT0,      0U }, /* MMC0_DAT0 */
-    { GRP_SDHI2,    FN_MMC0,     IPSR_SD2_DAT1,      0U }, /* MMC0_DAT1 */
-    { GRP_SDHI2,    FN_MMC0,     IPSR_SD2_DAT2,      0U }, /* MMC0_DAT2 */
-    { GRP_SDHI2,    FN_MMC0,     IPSR_SD2_DAT3,      0U }, /* MMC0_DAT3 */
-    { GRP_SDHI2,    FN_MMC0,     IPSR_SD2_DS,        0U }, /* MMC0_DS */
-
-    { GRP_SDHI3,    FN_MMC1,     IPSR_SD3_CMD,       0U }, /* MMC1 CMD */
-    { GRP_SDHI3,    FN_MMC1,     IPSR_SD3_CLK,       0U }, /* MMC1_CLK */
-    { GRP_SDHI3,    FN_MMC1,     IPSR_SD3_DAT0,      0U }, /* MMC1_DAT0 */
-    { GRP_SDHI3,    FN_MMC1,     IPSR_SD3_DAT1,      0U }, /* MMC1_DAT1 */
-    { GRP_SDHI3,    FN_MMC1,     IPSR_SD3_DAT2,      0U }, /* MMC1_DAT2 */
-    { GRP_SDHI3,    FN_MMC1,     IPSR_SD3_DAT3,      0U }, /* MMC1_DAT3 */
-    { GRP_SDHI3,    FN_MMC1,     IPSR_SD3_DAT4,      0U }, /* MMC1_DAT4 */
-    { GRP_SDHI3,    FN_MMC1,     IPSR_SD3_DAT5,      0U }, /* MMC1_DAT5 */
-    { GRP_SDHI3,    FN_MMC1,     IPSR_SD3_DAT6,      0U }, /* MMC1_DAT6 */
-    { GRP_SDHI3,    FN_MMC1,     IPSR_SD3_DAT7,      0U }, /* MMC1_DAT7 */
-    { GRP_SDHI3,    FN_MMC1,     IPSR_SD3_DS,        0U }, /* MMC1_DS */
-
-    /* no function select for I2C 0,3,4,5 */
-
-    { GRP_I2C1_A,   FN_I2C1,     IPSR_SCL1_A,        4U }, /* SCL1_A */
-    { GRP_I2C1_A,   FN_I2C1,     IPSR_SDA1_A,        4U }, /* SDA1_A */
-    { GRP_I2C1_B,   FN_I2C1,     IPSR_SCL1_B,        4U }, /* SCL1_B */
-    { GRP_I2C1_B,   FN_I2C1,     IPSR_SDA1_B,        4U }, /* SDA1_B */
-
-    { GRP_I2C2_A,   FN_I2C2,     IPSR_SCL2_A,        4U }, /* SCL2_A */
-    { GRP_I2C2_A,   FN_I2C2,     IPSR_SDA2_A,        4U }, /* SDA2_A */
-    { GRP_I2C2_B,   FN_I2C2,     IPSR_SCL2_B,        4U }, /* SCL2_A */
-    { GRP_I2C2_B,   FN_I2C2,     IPSR_SDA2_B,        4U }, /* SDA2_A */
-
-    { GRP_I2C6_A,   FN_I2C6,     IPSR_SCL6_A,        7U }, /* SCL6_A */
-    { GRP_I2C6_A,   FN_I2C6,     IPSR_SDA6_A,        7U }, /* SDA6_A */
-    { GRP_I2C6_B,   FN_I2C6,     IPSR_SCL6_B,        7U }, /* SCL6_B */
-    { GRP_I2C6_B,   FN_I2C6,     IPSR_SDA6_B,        7U }, /* SDA6_B */
-    { GRP_I2C6_C,   FN_I2C6,     IPSR_SCL6_C,        7U }, /* SCL6_C */
-    { GRP_I2C6_C,   FN_I2C6,     IPSR_SDA6_C,        7U }, /* SDA6_C */
-
-    { GRP_USB0,   	FN_USB0,     IPSR_USB0_PWEN,     0U }, /* USB0_PWEN */
-    { GRP_USB0,   	FN_USB0,     IPSR_USB0_OVC,      0U }, /* USB0_OVC */
-
-    { GRP_USB1,   	FN_USB1,     IPSR_USB1_PWEN,     0U }, /* USB1_PWEN */
-    { GRP_USB1,   	FN_USB1,     IPSR_USB1_OVC,      0U }, /* USB1_OVC */
-
-    { GRP_USB3,   	FN_USB3,     IPSR_USB30_PWEN,    0U }, /* USB30_PWEN */
-    { GRP_USB3,   	FN_USB3,     IPSR_USB30_OVC,     0U }, /* USB30_OVC */
-
-    { GRP_NONE,     FN_NONE,     0U,                 0U }  /* list terminator */
-    };
-
-/*
- *  supported PFC module selections
- *
- *  This table defines the function assignments to pin groups, together with the
- *  setting required in the MOD_SEL register.
- *  This table can be expanded to support additional module selections.
+ * pin, pin group, function, function selection and module selection tables,
+ * and the pin name index, generated from tools/pfc by tools/rzg2PfcTblGen.py
  */
 
-LOCAL const PFC_MOD_DESC pfcModuleSel [] =
-    {
-    /* group        function   modSelMask      modSelVal */
-    { GRP_SCIF1_A,  FN_SCIF1,  MOD_SEL_SCIF1,  0U },    /* RX1_A/TX1_A */
-    { GRP_SCIF1_B,  FN_SCIF1,  MOD_SEL_SCIF1,  1U },    /* RX1_B/TX1_B */
-
-    { GRP_SCIF2_A,  FN_SCIF2,  MOD_SEL_SCIF2,  0U },    /* RX2_A/TX2_A */
-    { GRP_SCIF2_B,  FN_SCIF2,  MOD_SEL_SCIF2,  1U },    /* RX2_B/TX2_B */
-
-    { GRP_SCIF3_A,  FN_SCIF3,  MOD_SEL_SCIF3,  0U },    /* RX3_A/TX3_A */
-    { GRP_SCIF3_B,  FN_SCIF3,  MOD_SEL_SCIF3,  1U },    /* RX3_B/TX3_B */
-
-    { GRP_SCIF4_A,  FN_SCIF4,  MOD_SEL_SCIF4,  0U },    /* RX4_A/TX4_A */
-    { GRP_SCIF4_B,  FN_SCIF4,  MOD_SEL_SCIF4,  1U },    /* RX4_B/TX4_B */
-    { GRP_SCIF4_C,  FN_SCIF4,  MOD_SEL_SCIF4,  2U },    /* RX4_C/TX4_C */
-
-    { GRP_SCIF5_A,  FN_SCIF5,  MOD_SEL_SCIF5,  0U },    /* RX5_A/TX5_A */
-    { GRP_SCIF5_B,  FN_SCIF5,  MOD_SEL_SCIF5,  1U },    /* RX5_B/TX5_B */
-
-    { GRP_I2C0,     FN_I2C0,   MOD_SEL_I2C0,   1U },    /* SCL0/SDA0 */
-
-    { GRP_I2C1_A,   FN_I2C1,   MOD_SEL_I2C1,   0U },    /* SCL1/SDA1_A */
-    { GRP_I2C1_B,   FN_I2C1,   MOD_SEL_I2C1,   1U },    /* SCL1/SDA1_B */
-
-    { GRP_I2C2_A,   FN_I2C2,   MOD_SEL_I2C2,   0U },    /* SCL2/SDA2_A */
-    { GRP_I2C2_B,   FN_I2C2,   MOD_SEL_I2C2,   1U },    /* SCL2/SDA2_B */
-
-    { GRP_I2C3,     FN_I2C3,   MOD_SEL_I2C3,   1U },    /* SCL3/SDA3 */
-    { GRP_I2C5,     FN_I2C5,   MOD_SEL_I2C5,   1U },    /* SCL5/SDA5 */
-
-    { GRP_I2C6_A,   FN_I2C6,   MOD_SEL_I2C6,   0U },    /* SCL6/SDA6_A */
-    { GRP_I2C6_B,   FN_I2C6,   MOD_SEL_I2C6,   1U },    /* SCL6/SDA6_B */
-    { GRP_I2C6_C,   FN_I2C6,   MOD_SEL_I2C6,   2U },    /* SCL6/SDA6_C */
-
-    { GRP_NONE,     FN_NONE,   0U,             0U }     /* list terminator */
-    };
+#include "vxbFdtRsRzg2PfcPinMuxTbl.h"
 
 LOCAL const PFC_POC_DESC pfcPocSel [] =
     {
-    /* function pocMask  pocVal */
-    { FN_SDHI0, POC_SD0, 0x3fU  },      /* RX1_A/TX1_A/SCIF_CLK_A */
-    { FN_SDHI3, POC_SD3, 0x7ffU },      /* RX2_A/TX2_A/SCK2 */
-    { FN_NONE,  0U,      0U }           /* list terminator */
+    /* function pocMask  padGroup */
+    { FN_SDHI0, POC_SD0, GRP_SDHI0 },   /* SD0 CLK/CMD/DAT0-3 */
+    { FN_SDHI3, POC_SD3, GRP_SDHI3 },   /* SD3 CLK/CMD/DAT0-7/DS */
+    { FN_NONE,  0U,      GRP_NONE }     /* list terminator */
     };
 
 /* forward declarations for pin configuration handlers */
@@ -780,6 +672,20 @@ LOCAL const PFC_PIN_CONF pfcConfs [] =
 
 LOCAL const char pfcPocConfs [] = "power-source";
 
+/* the attached PFC instance, used by rzg2PfcPinStateSet() */
+
+LOCAL PFC_PINMUX_DRVCTRL * pRzg2Pfc = NULL;
+
+/* boot program, set by the BSP with rzg2PfcBootProgSet() */
+
+LOCAL const RZG2_PFC_BOOT_WRITE * pRzg2PfcBootWrites = NULL;
+LOCAL UINT32 rzg2PfcBootWritesNum = 0U;
+
+/* POC supply hook, set by the BSP with rzg2PfcPocHookSet() */
+
+LOCAL RZG2_PFC_POC_HOOK rzg2PfcPocHook = NULL;
+LOCAL void * pRzg2PfcPocHookArg = NULL;
+
 /* pin pull state used for verbose show method */
 
 LOCAL const char * pfcPinPullStateStr [] =
@@ -792,6 +698,7 @@ LOCAL const char * pfcPinPullStateStr [] =
 /* forward declarations */
 
 LOCAL PFC_PIN_HANDLER rzg2PfcPeriphEnable;
+LOCAL PFC_PIN_DESC * rzg2PfcPinGet (char * pinName);
 
 LOCAL const VXB_FDT_DEV_MATCH_ENTRY vxbFdtPfcPinMuxMatch [] =
     {
@@ -834,88 +741,127 @@ LOCAL UINT32 rzg2PfcRegRead
     UINT32                  offset      /* PFC register offset */
     )
     {
-    return vxbRead32 (pPfc->pHandle, (UINT32 *)(pPfc->regBase + offset));
+    return RZG2_REG_READ32 (pPfc->pHandle,
+                            (UINT32 *)(pPfc->regBase + offset));
     }
 
 /*******************************************************************************
 *
-* rzg2PfcRegBitSet - set individual bits in a PFC register
+* rzg2PfcRegUpdate - update bits of a PFC register
 *
-* This function sets just the individual <bits> in a PFC register at <offset>.
+* This function sets the <mask> bits of the PFC register at <offset> to <val>.
+* For all registers except PUENn and PUDn, writing is first enabled by writing
+* the inverted value to PMMR. The register is not written if its value does not
+* change.
+*
+* The register is read and written under the register spinlock, so this
+* function can be used from interrupt context, no other write can take the PMMR
+* unlock, and bits changed concurrently by rzg2PfcPocVoltageSet() or
+* rzg2PfcPinsGpioSet() are not lost.
 *
 * RETURNS: N/A.
 *
 * ERRNO: N/A.
 */
 
-LOCAL void rzg2PfcRegBitSet
+LOCAL void rzg2PfcRegUpdate
     (
     PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
     UINT32                  offset,     /* PFC register offset */
-    UINT32                  bits        /* bits to set */
+    UINT32                  mask,       /* bits to update */
+    UINT32                  val         /* value of the masked bits */
     )
     {
-    UINT32 val;
+    UINT32 cur;
+    UINT32 upd;
 
-    (void)semTake (pPfc->mutex, WAIT_FOREVER);
-
-    val = vxbRead32 (pPfc->pHandle, (UINT32 *)(pPfc->regBase + offset));
-    val |= bits;
+    SPIN_LOCK_ISR_TAKE (&pPfc->regLock);
 
-    /*
-     * For all registers except PUENn and PUDn, enable writing to PFC register
-     * by first writing inverted data to PMMR.
-     */
+    cur = rzg2PfcRegRead (pPfc, offset);
+    upd = (cur & ~mask) | (val & mask);
+    if (upd != cur)
+        {
+        if ((offset < PFC_PUEN(0)) || (offset > PFC_PUD(6)))
+            {
+            RZG2_REG_WRITE32 (pPfc->pHandle,
+                              (UINT32 *)(pPfc->regBase + PFC_PMMR), ~upd);
+            }
 
-    if ((offset < PFC_PUEN(0)) || (offset > PFC_PUD(6)))
+        RZG2_REG_WRITE32 (pPfc->pHandle, (UINT32 *)(pPfc->regBase + offset),
+                          upd);
+        pPfc->regWrites++;
+        }
+    else
         {
-        vxbWrite32 (pPfc->pHandle, (UINT32 *)(pPfc->regBase + PFC_PMMR), ~val);
+        pPfc->regSkips++;
         }
 
-    vxbWrite32 (pPfc->pHandle, (UINT32 *)(pPfc->regBase + offset), val);
-
-    (void)semGive (pPfc->mutex);
+    SPIN_LOCK_ISR_GIVE (&pPfc->regLock);
     }
 
+#ifdef RZG2_LOCK_STATS
+
+/* lock statistics class names */
+
+LOCAL const char * pfcLockClassName [PFC_LOCK_CLASSES] =
+    {
+    "transaction",
+    "GPSR",
+    "IPSR",
+    "DRVCTRL",
+    "PUEN/PUD",
+    "MOD_SEL",
+    "other"
+    };
+
 /*******************************************************************************
 *
-* rzg2PfcRegBitClr - clear individual bits in a PFC register
+* rzg2PfcLockClassGet - get the lock statistics class of a PFC register
 *
-* This function clears just the individual <bits> in a PFC register at <offset>.
+* This function returns the lock statistics class of the PFC register at
+* <offset>, as updated by rzg2PfcRegMaskAndSet().
 *
-* RETURNS: N/A.
+* RETURNS: the register class.
 *
 * ERRNO: N/A.
 */
 
-LOCAL void rzg2PfcRegBitClr
+LOCAL UINT32 rzg2PfcLockClassGet
     (
-    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
-    UINT32                  offset,     /* PFC register offset */
-    UINT32                  bits        /* bits to clear */
+    UINT32  offset      /* PFC register offset */
     )
     {
-    UINT32 val;
+    if ((offset >= PFC_GPSR (0)) && (offset < PFC_GPSR (NUM_GPSR_REGS)))
+        {
+        return PFC_LOCK_GPSR;
+        }
 
-    (void)semTake (pPfc->mutex, WAIT_FOREVER);
+    if ((offset >= PFC_IPSR (0)) && (offset < PFC_IPSR (NUM_IPSR_REGS)))
+        {
+        return PFC_LOCK_IPSR;
+        }
 
-    val = vxbRead32 (pPfc->pHandle, (UINT32 *)(pPfc->regBase + offset));
-    val &= ~bits;
+    if ((offset >= PFC_DRVCTRL (0)) && (offset < PFC_DRVCTRL (NUM_DRVTRL_REGS)))
+        {
+        return PFC_LOCK_DRVCTRL;
+        }
 
-    /*
-     * For all registers except PUENn and PUDn, enable writing to PFC register
-     * by first writing inverted data to PMMR.
-     */
+    if ((offset >= PFC_PUEN (0)) && (offset < PFC_PUD (NUM_PUD_REGS)))
+        {
+        return PFC_LOCK_PULL;
+        }
 
-    if ((offset < PFC_PUEN(0)) || (offset > PFC_PUD(6)))
+    if ((offset >= PFC_MOD_SEL (0)) &&
+        (offset < PFC_MOD_SEL (NUM_MOD_SEL_REGS)))
         {
-        vxbWrite32 (pPfc->pHandle, (UINT32 *)(pPfc->regBase + PFC_PMMR), ~val);
+        return PFC_LOCK_MOD_SEL;
         }
-    vxbWrite32 (pPfc->pHandle, (UINT32 *)(pPfc->regBase + offset), val);
 
-    (void)semGive (pPfc->mutex);
+    return PFC_LOCK_OTHER;
     }
 
+#endif /* RZG2_LOCK_STATS */
+
 /*******************************************************************************
 *
 * rzg2PfcRegMaskAndSet - mask and set bits in a PFC register
@@ -923,6 +869,10 @@ LOCAL void rzg2PfcRegBitClr
 * This function clears the <mask> bits then sets <bits> in a PFC register at
 * <offset>.
 *
+* While a transaction is open, the change is made to the shadow copy of the
+* register instead, and is written by rzg2PfcXactEnd(). The first change to a
+* register in a transaction reads the register into the shadow copy.
+*
 * RETURNS: N/A.
 *
 * ERRNO: N/A.
@@ -936,905 +886,3573 @@ LOCAL void rzg2PfcRegMaskAndSet
     UINT32                  bits        /* bits to set */
     )
     {
-    UINT32 val;
+    UINT32 word = offset / 4U;
+#ifdef RZG2_LOCK_STATS
+    RZG2_LOCK_STAT * pStats = &pPfc->lockStats [rzg2PfcLockClassGet (offset)];
+    UINT64 takeTime;
+#endif /* RZG2_LOCK_STATS */
 
-    (void)semTake (pPfc->mutex, WAIT_FOREVER);
+    RZG2_LOCK_TAKE (pPfc->mutex, pStats, takeTime);
+
+    if (pPfc->xactActive && (word < PFC_REG_WORDS))
+        {
+        if (pPfc->xactValid [word] == 0U)
+            {
+            pPfc->xactVal [word] = rzg2PfcRegRead (pPfc, offset);
+            pPfc->xactValid [word] = 1U;
+            pPfc->xactRegs [pPfc->xactCount++] = (UINT16) word;
+            }
 
-    val = vxbRead32 (pPfc->pHandle, (UINT32 *)(pPfc->regBase + offset));
-    val &= ~mask;
-    val |= bits;
+        /* remember GPSR pins that pass through GPIO mode */
 
-    /*
-     * For all registers except PUENn and PUDn, enable writing to PFC register
-     * by first writing inverted data to PMMR.
-     */
+        if ((offset >= PFC_GPSR (0)) && (offset < PFC_GPSR (NUM_GPSR_REGS)))
+            {
+            pPfc->xactGpio [(offset - PFC_GPSR (0)) / 4U] |= mask & ~bits;
+            }
 
-    if ((offset < PFC_PUEN(0)) || (offset > PFC_PUD(6)))
+        pPfc->xactVal [word] = (pPfc->xactVal [word] & ~mask) | bits;
+        pPfc->xactMask [word] |= mask | bits;
+        }
+    else
         {
-        vxbWrite32 (pPfc->pHandle, (UINT32 *)(pPfc->regBase + PFC_PMMR), ~val);
+        rzg2PfcRegUpdate (pPfc, offset, mask | bits, bits);
         }
 
-    vxbWrite32 (pPfc->pHandle, (UINT32 *)(pPfc->regBase + offset), val);
-
-    (void)semGive (pPfc->mutex);
+    RZG2_LOCK_GIVE (pPfc->mutex, pStats, takeTime);
     }
 
 /*******************************************************************************
 *
-* rzg2PfcFuncIdGet - get the PFC function ID
+* rzg2PfcRegBitSet - set individual bits in a PFC register
 *
-* This function gets the function ID for the named group.
+* This function sets just the individual <bits> in a PFC register at <offset>.
 *
-* RETURNS: Function ID, or FN_NONE if the function name is not valid.
+* RETURNS: N/A.
 *
 * ERRNO: N/A.
 */
 
-LOCAL PFC_FUNC_ID rzg2PfcFuncIdGet
+LOCAL void rzg2PfcRegBitSet
     (
-    char *          funcName
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    UINT32                  offset,     /* PFC register offset */
+    UINT32                  bits        /* bits to set */
     )
     {
-    PFC_FUNC_ID     funcId = FN_NONE;
-    UINT32          i;
-
-    if (funcName == NULL)
-        {
-        return FN_NONE;
-        }
-
-    /* search the list of function names */
-
-    for (i = 0; i < PFC_NUM_FUNCS; i++)
-        {
-        if (strncmp (pfcFuncs[i].funcName, funcName, PFC_NAME_LEN_MAX) == 0)
-            {
-            funcId = pfcFuncs[i].funcId;
-            break;
-            }
-        }
-
-    return funcId;
+    rzg2PfcRegMaskAndSet (pPfc, offset, 0U, bits);
     }
 
 /*******************************************************************************
 *
-* rzg2PfcPinGet - get the PFC pin descriptor
+* rzg2PfcRegBitClr - clear individual bits in a PFC register
 *
-* This function gets the pin descriptor for the named pin.
+* This function clears just the individual <bits> in a PFC register at <offset>.
 *
-* RETURNS: pin descriptor, or NULL if no matching pin found.
+* RETURNS: N/A.
 *
 * ERRNO: N/A.
 */
 
-LOCAL PFC_PIN_DESC * rzg2PfcPinGet
+LOCAL void rzg2PfcRegBitClr
     (
-    char *  pinName
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    UINT32                  offset,     /* PFC register offset */
+    UINT32                  bits        /* bits to clear */
     )
     {
-    PFC_PIN_DESC * pPin;
-
-    if (pinName == NULL)
-        {
-        return NULL;
-        }
+    rzg2PfcRegMaskAndSet (pPfc, offset, bits, 0U);
+    }
 
-    pPin = (PFC_PIN_DESC *) &pfcPins [0];
+/*******************************************************************************
+*
+* rzg2PfcXactBegin - open a PFC register transaction
+*
+* This function opens a transaction, in which changes made through
+* rzg2PfcRegMaskAndSet() accumulate in a shadow copy of the PFC registers. The
+* PFC mutex is held until the transaction is closed by rzg2PfcXactEnd().
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
 
-    while (!PFC_PIN_DESC_TBL_END(pPin))
-        {
-        if ((strncmp (pPin->sipName, pinName, PFC_NAME_LEN_MAX) == 0))
-            {
-            return pPin;
-            }
-        pPin++;
-        }
+LOCAL void rzg2PfcXactBegin
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc        /* pin mux controller instance */
+    )
+    {
+    RZG2_LOCK_TAKE (pPfc->mutex, &pPfc->lockStats [PFC_LOCK_XACT],
+                    pPfc->xactTakeTime);
 
-    return NULL;
+    pPfc->xactActive = TRUE;
+    pPfc->xactCount = 0U;
+    (void)memset (pPfc->xactGpio, 0, sizeof (pPfc->xactGpio));
     }
 
 /*******************************************************************************
 *
-* rzg2PfcPinsGroupGet - validate and get the PFC group ID for a list of pins
+* rzg2PfcXactPocSupply - switch the POC supplies for a transaction
 *
-* This function validates the list of pins as all belonging to the same
-* functional group and returns the group ID. The pins must also have a GPSR
-* entry.
+* This function calls the POC supply hook, if set, for each POC field that the
+* open transaction changes, as rzg2PfcPocVoltageSet() does, so that pin programs
+* with a "power-source" property keep the pads and their regulator at the same
+* voltage. It is called by rzg2PfcXactEnd() before POCCTRL is written.
 *
-* RETURNS: group ID, or GRP_NONE if the pins are not in a single group or any
-* don't have a GPSR entry.
+* RETURNS: the POCCTRL bits that may be written: the changed bits, less the POC
+* fields whose supply hook failed.
 *
 * ERRNO: N/A.
 */
 
-LOCAL PFC_GROUP_ID rzg2PfcPinsGroupGet
+LOCAL UINT32 rzg2PfcXactPocSupply
     (
-    char *          pPinsProp,      /* pins property */
-    int             pPinsPropLen,   /* pins property length */
-    PFC_FUNC_ID     funcId          /* function ID */
+    PFC_PINMUX_DRVCTRL *    pPfc        /* pin mux controller instance */
     )
     {
-    PFC_GROUP_ID    groupId = GRP_NONE;
-    PFC_PIN_DESC *  pPin;
-    int             stringLen;
-
-    if ((pPinsProp == NULL) || (pPinsPropLen <= 0))
+    RZG2_PFC_POC_HOOK       hook = rzg2PfcPocHook;
+    const PFC_POC_DESC *    pPocCtrl;
+    UINT32                  word = PFC_POCCTRL / 4U;
+    UINT32                  mask = pPfc->xactMask [word];
+    UINT32                  changed;
+    UINT32                  field;
+    UINT32                  mv;
+
+    changed = (rzg2PfcRegRead (pPfc, PFC_POCCTRL) ^ pPfc->xactVal [word]) &
+              mask;
+
+    for (pPocCtrl = &pfcPocSel [0];
+         (hook != NULL) && (pPocCtrl->funcId != FN_NONE); pPocCtrl++)
         {
-        return GRP_NONE;
+        field = POC_MASK (pPocCtrl->pocMask);
+        if ((changed & field) == 0U)
+            {
+            continue;
+            }
+
+        mv = ((pPfc->xactVal [word] & field) == 0U) ? PFC_POC_MV_1V8 :
+                                                      PFC_POC_MV_3V3;
+
+        if (hook (pPocCtrl->pocMask, mv, pRzg2PfcPocHookArg) != OK)
+            {
+            RZG2_DBG_MSG (PFC_DBG_ERR, "POC supply hook failed\n");
+            mask &= ~field;
+            }
         }
 
-    /* operate on each pin in the "pins" property stringList */
+    return mask;
+    }
 
-    while (pPinsPropLen >  0)
-        {
+/*******************************************************************************
+*
+* rzg2PfcXactEnd - close a PFC register transaction
+*
+* This function closes the transaction opened by rzg2PfcXactBegin(). If
+* <commit> is TRUE, each register changed in the transaction is written once,
+* and registers whose value has not changed are not written. The GPSR
+* registers are written in two steps around the other registers: first the pins
+* that were set to GPIO mode during the transaction are switched to GPIO, and
+* after the function selections are written the final GPSR values are written.
+* This keeps the order required when a pin function is changed. The first step
+* is left out if no IPSR or MOD_SEL field changes. A POC field change first
+* calls the POC supply hook, and is left out if the hook fails. If <commit> is
+* FALSE, the changes are discarded.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
 
-        /* retrieve, and validate, the descriptor for the pin name */
+LOCAL void rzg2PfcXactEnd
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    BOOL                    commit      /* TRUE to write the changes */
+    )
+    {
+    UINT32  offset;
+    UINT32  word;
+    UINT32  reg;
+    UINT32  i;
+    BOOL    selChange = FALSE;
 
-        pPin = rzg2PfcPinGet (pPinsProp);
-        if ((pPin == NULL) || (pPin->gpsrRegBit == GPSR_NONE))
+    /*
+     * Only the bits changed in the transaction are written, each under the
+     * register spinlock, so that GPSR and POCCTRL bits switched concurrently
+     * by the interrupt-safe routines are kept.
+     */
+
+    if (commit)
+        {
+        /*
+         * Pins only pass through GPIO mode if a function or module selection
+         * changes. The state set by the boot firmware is left as it is, so
+         * that live pins, such as the console, do not glitch.
+         */
+
+        for (i = 0U; (i < pPfc->xactCount) && !selChange; i++)
             {
-            return GRP_NONE;
+            word = pPfc->xactRegs [i];
+            offset = word * 4U;
+            if (((offset >= PFC_IPSR (0)) &&
+                 (offset < PFC_IPSR (NUM_IPSR_REGS))) ||
+                ((offset >= PFC_MOD_SEL (0)) &&
+                 (offset < PFC_MOD_SEL (NUM_MOD_SEL_REGS))))
+                {
+                selChange = (((rzg2PfcRegRead (pPfc, offset) ^
+                               pPfc->xactVal [word]) &
+                              pPfc->xactMask [word]) != 0U);
+                }
             }
 
-        /* compare group ID of all pins */
+        /* switch the pad supplies before the pads, as for a voltage switch */
 
-        if (groupId == GRP_NONE)
+        word = PFC_POCCTRL / 4U;
+        if (pPfc->xactValid [word] != 0U)
             {
-            groupId = pPin->groupId;
+            pPfc->xactMask [word] = rzg2PfcXactPocSupply (pPfc);
             }
-        else
+
+        /* switch the pins changing function to GPIO mode */
+
+        for (reg = 0U; selChange && (reg < NUM_GPSR_REGS); reg++)
             {
-            /* invalidate group ID if mismatched */
+            if (pPfc->xactGpio [reg] != 0U)
+                {
+                rzg2PfcRegUpdate (pPfc, PFC_GPSR (reg), pPfc->xactGpio [reg],
+                                  0U);
+                }
+            }
+
+        /* write the other registers that changed */
 
-            if (pPin->groupId != groupId)
+        for (i = 0U; i < pPfc->xactCount; i++)
+            {
+            word = pPfc->xactRegs [i];
+            offset = word * 4U;
+            if ((offset >= PFC_GPSR (0)) && (offset < PFC_GPSR (NUM_GPSR_REGS)))
                 {
-                groupId = GRP_NONE;
-                break;
+                continue;
                 }
+
+            rzg2PfcRegUpdate (pPfc, offset, pPfc->xactMask [word],
+                              pPfc->xactVal [word]);
             }
 
-        /* potentially move onto the next pin in the "pins" stringList */
+        /* write the final GPSR values */
 
-        stringLen = (int) (strlen (pPinsProp) + 1);
-        pPinsPropLen  -= stringLen;
-        pPinsProp += stringLen;
+        for (reg = 0U; reg < NUM_GPSR_REGS; reg++)
+            {
+            word = PFC_GPSR (reg) / 4U;
+            if (pPfc->xactValid [word] != 0U)
+                {
+                rzg2PfcRegUpdate (pPfc, PFC_GPSR (reg), pPfc->xactMask [word],
+                                  pPfc->xactVal [word]);
+                }
+            }
         }
 
-    return groupId;
+    for (i = 0U; i < pPfc->xactCount; i++)
+        {
+        pPfc->xactValid [pPfc->xactRegs [i]] = 0U;
+        pPfc->xactMask [pPfc->xactRegs [i]] = 0U;
+        }
+
+    pPfc->xactCount = 0U;
+    pPfc->xactActive = FALSE;
+
+    RZG2_LOCK_GIVE (pPfc->mutex, &pPfc->lockStats [PFC_LOCK_XACT],
+                    pPfc->xactTakeTime);
     }
 
 /*******************************************************************************
 *
-* rzg2PfcPeriphEnable - enable PFC Peripheral function
-*
-* This function enables peripheral functionality of the requested pin using the
-* GPIO/Peripheral Function Select Registers.
+* rzg2PfcXactRegGet - get the current value of a PFC register
 *
-* It is passed as a parameter to, and called from, rzg2PfcFdtPinListHandle so it
-* is of PFC_PIN_HANDLE type. The pProp and propLen properties defined by the
-* PFC_PIN_HANDLE type are not used in this handler.
+* This function returns the value of the PFC register at <offset> as seen by the
+* open transaction: the shadow value if the register has been changed in the
+* transaction, or the register value otherwise.
 *
-* RETURNS: OK if pin configured, ERROR if pin controller, pin descriptor or pin
-* register is invalid.
+* RETURNS: the current register value.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS rzg2PfcPeriphEnable
+LOCAL UINT32 rzg2PfcXactRegGet
     (
     PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
-    PFC_PIN_DESC *          pPin,       /* pin descriptor */
-    char *                  pProp,      /* property (not used) */
-    int                     propLen     /* property length (not used) */
+    UINT32                  offset      /* PFC register offset */
     )
     {
-    if ((pPfc == NULL) || (pPin == NULL) || (pPin->gpsrRegBit == GPSR_NONE))
+    UINT32 word = offset / 4U;
+
+    if (pPfc->xactActive && (word < PFC_REG_WORDS) &&
+        (pPfc->xactValid [word] != 0U))
         {
-        return ERROR;
+        return pPfc->xactVal [word];
         }
 
-    RZG2_DBG_MSG (PFC_DBG_INFO, "Enabling peripheral function on %s\n",
-                  pPin->sipName);
-
-    /* GPSR register bit is 1 for Peripheral function */
-
-    rzg2PfcRegBitSet (pPfc, PFC_GPSR (GPSR_REG (pPin->gpsrRegBit)),
-                      GPSR_MASK (pPin->gpsrRegBit));
-
-    return OK;
+    return rzg2PfcRegRead (pPfc, offset);
     }
 
 /*******************************************************************************
 *
-* rzg2PfcGpioEnable - enable PFC GPIO function
+* rzg2PfcFuncIdGet - get the PFC function ID
 *
-* This function enables GPIO functionality of the requested pin using the
-* GPIO/Peripheral Function Select Registers.
+* This function gets the function ID for the named group.
 *
-* RETURNS: OK if pin configured, ERROR if pin controller, pin descriptor or pin
-* register is invalid.
+* RETURNS: Function ID, or FN_NONE if the function name is not valid.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS rzg2PfcGpioEnable
+LOCAL PFC_FUNC_ID rzg2PfcFuncIdGet
     (
-    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
-    PFC_PIN_DESC *          pPin,       /* pin descriptor */
-    char *                  pProp,      /* property (not used) */
-    int                     propLen     /* property length (not used) */
+    char *          funcName
     )
     {
-    if ((pPfc == NULL) || (pPin == NULL) || (pPin->gpsrRegBit == GPSR_NONE))
+    PFC_FUNC_ID     funcId = FN_NONE;
+    UINT32          i;
+
+    if (funcName == NULL)
         {
-        return ERROR;
+        return FN_NONE;
         }
 
-    RZG2_DBG_MSG (PFC_DBG_INFO, "Enabling GPIO on %s, reg: 0x%x, bit: 0x%x\n",
-                  pPin->sipName,
-                  PFC_GPSR (GPSR_REG (pPin->gpsrRegBit)),
-                  GPSR_MASK (pPin->gpsrRegBit));
-
-    /* GPSR register bit is 0 for GPIO */
+    /* search the list of function names */
 
-    rzg2PfcRegBitClr (pPfc, PFC_GPSR (GPSR_REG (pPin->gpsrRegBit)),
-                      GPSR_MASK (pPin->gpsrRegBit));
+    for (i = 0; i < PFC_NUM_FUNCS; i++)
+        {
+        if (strncmp (pfcFuncs[i].funcName, funcName, PFC_NAME_LEN_MAX) == 0)
+            {
+            funcId = pfcFuncs[i].funcId;
+            break;
+            }
+        }
 
-    return OK;
+    return funcId;
     }
 
 /*******************************************************************************
 *
-* rzg2PfcPullDisable - disable PFC pull-up/pull-down function
+* rzg2PfcPinHash - hash a pin name
 *
-* This function disables the pull-up/pull down functionality of the requested pin
-* using the Pull Enable Registers.
+* This function calculates the FNV-1a hash of a pin name, up to
+* PFC_NAME_LEN_MAX characters, and reduces it to a pin name index slot.
 *
-* RETURNS: OK if pin configured, ERROR if pin controller, or pin descriptor is
-* invalid.
+* RETURNS: the first pin name index slot to search for the name.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS rzg2PfcPullDisable
+LOCAL UINT32 rzg2PfcPinHash
     (
-    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
-    PFC_PIN_DESC *          pPin,       /* pin descriptor */
-    char *                  pProp,      /* property (not used) */
-    int                     propLen     /* property length (not used) */
+    const char *    pinName
     )
     {
-    if ((pPfc == NULL) || (pPin == NULL))
+    UINT32 hash = PFC_FNV_OFFSET;
+    UINT32 i;
+
+    for (i = 0; (i < PFC_NAME_LEN_MAX) && (pinName [i] != '\0'); i++)
         {
-        return ERROR;
+        hash = (hash ^ (UINT8) pinName [i]) * PFC_FNV_PRIME;
         }
 
-    RZG2_DBG_MSG (PFC_DBG_INFO, "Disabling pull on %s\n", pPin->sipName);
-
-    /* PUEN register bit is 0 for pull-up/down function disable */
-
-    rzg2PfcRegBitClr (pPfc, PFC_PUEN (PU_REG (pPin->puRegBit)),
-                      PU_MASK (pPin->puRegBit));
-
-    return OK;
+    return hash & (PFC_PIN_HASH_SIZE - 1U);
     }
 
 /*******************************************************************************
 *
-* rzg2PfcPullUpEnable - enable PFC pull-up function
+* rzg2PfcTablesCheck - check the consistency of the PFC tables
 *
-* This function enables the pull up functionality of the requested pin
-* using the Pull Enable, and Pull Up Down Control Registers.
+* This function checks the generated tables: that every register and bit
+* referenced by the pin, group, function and module selection tables is within
+* the PFC register set, that pfcPins entries for the same pad have the same
+* pull and drive fields and pin groups, that the pin name index finds every pin,
+* and that function names are unique.
 *
-* RETURNS: OK if pin configured, ERROR if pin controller, or pin descriptor is
-* invalid.
+* RETURNS: OK if the tables are consistent, otherwise ERROR.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS rzg2PfcPullUpEnable
-    (
-    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
-    PFC_PIN_DESC *          pPin,       /* pin descriptor */
-    char *                  pProp,      /* property (not used) */
-    int                     propLen     /* property length (not used) */
-    )
+LOCAL STATUS rzg2PfcTablesCheck (void)
     {
-    if ((pPfc == NULL) || (pPin == NULL))
+    const PFC_PIN_DESC *    pPin;
+    const PFC_PIN_DESC *    pOther;
+    const PFC_PIN_DESC *    pFirst;
+    const PFC_FUNC_DESC *   pFunc;
+    const PFC_MOD_DESC *    pModSel;
+    STATUS                  status = OK;
+    UINT32                  i;
+    UINT32                  j;
+
+    /* pin groups are kept as 64-bit masks */
+
+    if (GRP_COUNT > 64)
         {
+        RZG2_DBG_MSG (PFC_DBG_ERR, "too many pin groups\n");
         return ERROR;
         }
 
-    RZG2_DBG_MSG (PFC_DBG_INFO, "Enabling pull-up on %s\n", pPin->sipName);
+    for (i = 0; pfcPins [i].sipName != NULL; i++)
+        {
+        pPin = &pfcPins [i];
+
+        if (((pPin->gpsrRegBit != GPSR_NONE) &&
+             (GPSR_REG (pPin->gpsrRegBit) >= NUM_GPSR_REGS)) ||
+            (PU_REG (pPin->puRegBit) >= NUM_PUEN_REGS) ||
+            (DRVCTRL_REG (pPin->drvMask) >= NUM_DRVTRL_REGS) ||
+            (pPin->groupId >= GRP_COUNT) ||
+            ((pfcPinGroups [i] & PFC_GROUP_BIT (pPin->groupId)) == 0U))
+            {
+            RZG2_DBG_MSG (PFC_DBG_ERR, "pin %s: invalid field\n", pPin->sipName);
+            status = ERROR;
+            }
 
-    /* PUD register bit is 1 for pull-up function */
+        /* the index finds the first entry of a name */
 
-    rzg2PfcRegBitSet (pPfc, PFC_PUD (PU_REG (pPin->puRegBit)),
-                      PU_MASK (pPin->puRegBit));
+        pFirst = pPin;
+        for (j = 0; j < i; j++)
+            {
+            if (strncmp (pfcPins [j].sipName, pPin->sipName,
+                         PFC_NAME_LEN_MAX) == 0)
+                {
+                pFirst = &pfcPins [j];
+                break;
+                }
+            }
 
-    /* PUEN register bit is 1 for pull function enable */
+        if (rzg2PfcPinGet ((char *) pPin->sipName) != pFirst)
+            {
+            RZG2_DBG_MSG (PFC_DBG_ERR, "pin %s: not indexed\n", pPin->sipName);
+            status = ERROR;
+            }
 
-    rzg2PfcRegBitSet (pPfc, PFC_PUEN (PU_REG (pPin->puRegBit)),
-                      PU_MASK (pPin->puRegBit));
+        for (j = i + 1; pfcPins [j].sipName != NULL; j++)
+            {
+            pOther = &pfcPins [j];
 
-    return OK;
+            if ((pPin->gpsrRegBit != GPSR_NONE) &&
+                (pOther->gpsrRegBit == pPin->gpsrRegBit) &&
+                ((pOther->puRegBit != pPin->puRegBit) ||
+                 (pOther->drvMask != pPin->drvMask) ||
+                 (pfcPinGroups [j] != pfcPinGroups [i])))
+                {
+                RZG2_DBG_MSG (PFC_DBG_ERR, "pins %s and %s: same pad differs\n",
+                              pPin->sipName, pOther->sipName);
+                status = ERROR;
+                }
+            }
+        }
+
+    for (pFunc = &xPfcFuncSel [0]; pFunc->groupId != GRP_NONE; pFunc++)
+        {
+        if ((pFunc->groupId >= GRP_COUNT) ||
+            (IPSR_REG (pFunc->ipsrMask) >= NUM_IPSR_REGS) ||
+            (pFunc->ipsrVal > 0x0FU))
+            {
+            RZG2_DBG_MSG (PFC_DBG_ERR, "function selection %u: invalid\n",
+                          (UINT32) (pFunc - &xPfcFuncSel [0]));
+            status = ERROR;
+            }
+        }
+
+    for (pModSel = &pfcModuleSel [0]; pModSel->groupId != GRP_NONE; pModSel++)
+        {
+        if ((pModSel->groupId >= GRP_COUNT) ||
+            (MOD_SEL_REG (pModSel->modSelMask) >= NUM_MOD_SEL_REGS) ||
+            (pModSel->modSelVal > MOD_SEL_BITMASK (pModSel->modSelMask)))
+            {
+            RZG2_DBG_MSG (PFC_DBG_ERR, "module selection %u: invalid\n",
+                          (UINT32) (pModSel - &pfcModuleSel [0]));
+            status = ERROR;
+            }
+        }
+
+    for (i = 0; i < PFC_NUM_FUNCS; i++)
+        {
+        for (j = i + 1; j < PFC_NUM_FUNCS; j++)
+            {
+            if (strncmp (pfcFuncs [i].funcName, pfcFuncs [j].funcName,
+                         PFC_NAME_LEN_MAX) == 0)
+                {
+                RZG2_DBG_MSG (PFC_DBG_ERR, "function %s: duplicated\n",
+                              pfcFuncs [i].funcName);
+                status = ERROR;
+                }
+            }
+        }
+
+    return status;
     }
 
 /*******************************************************************************
 *
-* rzg2PfcPullDownEnable - enable PFC pull-down function
+* rzg2PfcPinGet - get the PFC pin descriptor
 *
-* This function enables the pull down functionality of the requested pin
-* using the Pull Enable, and Pull Up Down Control Registers.
+* This function gets the pin descriptor for the named pin, using the generated
+* pin name index.
 *
-* RETURNS: OK if pin configured, ERROR if pin controller, or pin descriptor is
-* invalid.
+* RETURNS: pin descriptor, or NULL if no matching pin found.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS rzg2PfcPullDownEnable
+LOCAL PFC_PIN_DESC * rzg2PfcPinGet
     (
-    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
-    PFC_PIN_DESC *          pPin,       /* pin descriptor */
-    char *                  pProp,      /* property (not used) */
-    int                     propLen     /* property length (not used) */
+    char *  pinName
     )
     {
+    PFC_PIN_DESC *  pPin;
+    UINT32          slot;
+    UINT32          probes;
 
-    if ((pPfc == NULL) || (pPin == NULL))
+    if (pinName == NULL)
         {
-        return ERROR;
+        return NULL;
         }
 
-    RZG2_DBG_MSG (PFC_DBG_INFO, "Enabling pull-down on %s/%s\n", pPin->sipName);
-
-    /* PUD register bit is 0 for pull-down function */
+    slot = rzg2PfcPinHash (pinName);
 
-    rzg2PfcRegBitClr (pPfc, PFC_PUD (PU_REG (pPin->puRegBit)),
-                      PU_MASK (pPin->puRegBit));
+    for (probes = 0; probes < PFC_PIN_HASH_SIZE; probes++)
+        {
+        if (pfcPinHash [slot] == PFC_PIN_HASH_EMPTY)
+            {
+            break;
+            }
 
-    /* PUEN register bit is 1 for pull function enable */
+        pPin = (PFC_PIN_DESC *) &pfcPins [pfcPinHash [slot]];
+        if (strncmp (pPin->sipName, pinName, PFC_NAME_LEN_MAX) == 0)
+            {
+            return pPin;
+            }
 
-    rzg2PfcRegBitSet (pPfc, PFC_PUEN (PU_REG (pPin->puRegBit)),
-                      PU_MASK (pPin->puRegBit));
+        slot = (slot + 1U) & (PFC_PIN_HASH_SIZE - 1U);
+        }
 
-    return OK;
+    return NULL;
     }
 
 /*******************************************************************************
 *
-* rzg2PfcDriveControl - configure PFC drive control function
-*
-* This function configures the driving ability of the requested pin
-* using the DRV Control Registers.
+* rzg2PfcGroupFuncHas - check if a pin group selects a function
 *
-* RETURNS: OK if pin configured, ERROR if pin controller, pin descriptor, or
-* drive control property is invalid.
+* RETURNS: TRUE if the function or module selection tables have an entry for
+* <funcId> in pin group <groupId>, otherwise FALSE.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS rzg2PfcDriveControl
+LOCAL BOOL rzg2PfcGroupFuncHas
     (
     PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
-    PFC_PIN_DESC *          pPin,       /* pin descriptor */
-    char *                  pProp,      /* configuration property */
-    int                     propLen     /* configuration property length */
+    const PFC_FUNC_DESC *   pFuncSel,   /* function selection table */
+    UINT32                  groupId,    /* pin group */
+    PFC_FUNC_ID             funcId      /* function ID */
     )
     {
-    UINT    mask;                       /* DRVCTRL mask */
-    UINT32  drvVal;                     /* drive-control property value */
+    UINT32                  i;
 
-    /* validate parameters and expect <u32> property value */
+    for (i = pPfc->pFuncFirst [groupId]; i < pPfc->pFuncFirst [groupId + 1];
+         i++)
+        {
+        if (pFuncSel [pPfc->pFuncOrder [i]].funcId == funcId)
+            {
+            return TRUE;
+            }
+        }
 
-    if ((pPfc == NULL) || (pPin == NULL) || (pProp == NULL) ||
-        (propLen != sizeof (UINT32)))
+    for (i = pPfc->pModFirst [groupId]; i < pPfc->pModFirst [groupId + 1]; i++)
         {
-        return ERROR;
+        if (pfcModuleSel [pPfc->pModOrder [i]].funcId == funcId)
+            {
+            return TRUE;
+            }
         }
 
-    mask = DRVCTRL_BITMASK (pPin->drvMask);
-    drvVal = vxFdt32ToCpu (*(UINT32 *)pProp);
+    return FALSE;
+    }
 
-    RZG2_DBG_MSG (PFC_DBG_INFO, "Configuring %d/8 DRV control on %s\n",
-                  drvVal, pPin->sipName);
+/*******************************************************************************
+*
+* rzg2PfcPinsGroupGet - validate and get the PFC group ID for a list of pins
+*
+* This function validates the list of pins as all belonging to a common
+* functional group and returns the group ID. A pad can belong to several
+* groups, so the first common group that selects <funcId> is returned, or the
+* first common group if none selects it. Dedicated pins, without a GPSR entry,
+* are only in the group of their pfcPins entry.
+*
+* RETURNS: group ID, or GRP_NONE if the pins have no common group.
+*
+* ERRNO: N/A.
+*/
 
-    /*
-     * The drive-control property value must be in the range 1 to 8. For
-     * F type buffers, which have 2-bit masks, the value must be an even
-     * number of eighths (quarters).
-     */
+LOCAL PFC_GROUP_ID rzg2PfcPinsGroupGet
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    PFC_PIN_DESC **         ppPins,     /* pin descriptors */
+    int                     numPins,    /* number of pins */
+    PFC_FUNC_ID             funcId      /* function ID */
+    )
+    {
+    const PFC_FUNC_DESC *   pFuncSel;
+    UINT64                  groups = ~(UINT64) 0;
+    UINT32                  groupId;
+    int                     i;
 
-    if ((drvVal < PFC_DRVCTRL_VAL_MIN) || (drvVal > PFC_DRVCTRL_VAL_MAX) ||
-        ((mask == DRVCTRL_F_MASK) && ((drvVal % 2U) != 0U)))
+    if ((ppPins == NULL) || (numPins <= 0))
         {
-        return ERROR;
+        return GRP_NONE;
         }
 
-    /* convert F type from eighths to quarters */
+    /* intersect the groups of all pins */
 
-    if (mask == DRVCTRL_F_MASK)
+    for (i = 0; i < numPins; i++)
         {
-        drvVal /= 2;
+        groups &= pfcPinGroups [ppPins [i] - &pfcPins [0]];
         }
 
-    /* DRVCTRL register field is 0-7 or 0-3 */
+    groups &= ~((UINT64) 1 << GRP_NONE);
+    if (groups == 0U)
+        {
+        return GRP_NONE;
+        }
 
-    drvVal--;
+    pFuncSel = pPfc->pFuncSel;
 
-    rzg2PfcRegMaskAndSet (pPfc, PFC_DRVCTRL (DRVCTRL_REG (pPin->drvMask)),
-                          DRVCTRL_MASK (pPin->drvMask),
-                          drvVal << (DRVCTRL_SHIFT (pPin->drvMask)));
+    for (groupId = GRP_NONE + 1; groupId < GRP_COUNT; groupId++)
+        {
+        if (((groups & ((UINT64) 1 << groupId)) != 0U) &&
+            rzg2PfcGroupFuncHas (pPfc, pFuncSel, groupId, funcId))
+            {
+            return (PFC_GROUP_ID) groupId;
+            }
+        }
 
-    return OK;
+    for (groupId = GRP_NONE + 1; (groups & ((UINT64) 1 << groupId)) == 0U;
+         groupId++)
+        {
+        }
+
+    return (PFC_GROUP_ID) groupId;
     }
 
 /*******************************************************************************
 *
-* rzg2PfcPocCtrlFuncSet - set PFC POC Control Register
+* rzg2PfcPeriphEnable - enable PFC Peripheral function
 *
-* This function set PFC POC Control Register.
+* This function enables peripheral functionality of the requested pin using the
+* GPIO/Peripheral Function Select Registers.
 *
-* RETURNS: OK if POC control register configured, ERROR if pin controller is
-* invalid.
+* It is passed as a parameter to, and called from, rzg2PfcPinListHandle so it
+* is of PFC_PIN_HANDLE type. The pProp and propLen properties defined by the
+* PFC_PIN_HANDLE type are not used in this handler.
+*
+* RETURNS: OK if pin configured, ERROR if pin controller, pin descriptor or pin
+* register is invalid.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS rzg2PfcPocCtrlFuncSet
+LOCAL STATUS rzg2PfcPeriphEnable
     (
     PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
-    PFC_FUNC_ID             funcId,     /* function to set */
-    char *                  pProp,      /* property */
-    int                     propLen     /* property length */
+    PFC_PIN_DESC *          pPin,       /* pin descriptor */
+    char *                  pProp,      /* property (not used) */
+    int                     propLen     /* property length (not used) */
     )
     {
-    PFC_POC_DESC *          pPocCtrl;
-    UINT32 mv = 0;
-    UINT32 pocVal = 0;
-
-    if (pPfc == NULL)
+    if ((pPfc == NULL) || (pPin == NULL) || (pPin->gpsrRegBit == GPSR_NONE))
         {
         return ERROR;
         }
 
-    mv = vxFdt32ToCpu(*(UINT32*)pProp);
+    RZG2_DBG_MSG (PFC_DBG_INFO, "Enabling peripheral function on %s\n",
+                  pPin->sipName);
 
-    /* process the functions in the POC table */
+    /* GPSR register bit is 1 for Peripheral function */
 
-    pPocCtrl = (PFC_POC_DESC *) &pfcPocSel [0];
+    rzg2PfcRegBitSet (pPfc, PFC_GPSR (GPSR_REG (pPin->gpsrRegBit)),
+                      GPSR_MASK (pPin->gpsrRegBit));
 
-    while (pPocCtrl->funcId != FN_NONE)
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcGpioEnable - enable PFC GPIO function
+*
+* This function enables GPIO functionality of the requested pin using the
+* GPIO/Peripheral Function Select Registers.
+*
+* RETURNS: OK if pin configured, ERROR if pin controller, pin descriptor or pin
+* register is invalid.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2PfcGpioEnable
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    PFC_PIN_DESC *          pPin,       /* pin descriptor */
+    char *                  pProp,      /* property (not used) */
+    int                     propLen     /* property length (not used) */
+    )
+    {
+    if ((pPfc == NULL) || (pPin == NULL) || (pPin->gpsrRegBit == GPSR_NONE))
         {
-        if (pPocCtrl->funcId == funcId)
-            {
-            if (mv == PFC_MILLIVOLT_3V3)
-                {
-                pocVal = POC_BITMASK (pPocCtrl->pocMask);
-                RZG2_DBG_MSG(PFC_DBG_INFO, "power-source is 3300mv \r\n");
-                }
-            else if (mv == PFC_MILLIVOLT_1V8)
-                {
-                pocVal = 0;
-                RZG2_DBG_MSG(PFC_DBG_INFO, "power-source is 1800mv \r\n");
-                }
-            else
-                {
-                RZG2_DBG_MSG(PFC_DBG_ERR, "invalid power-source \r\n");
-                return ERROR;
-                }
-            rzg2PfcRegMaskAndSet (pPfc,
-                                  PFC_POCCTRL,
-                                  POC_MASK (pPocCtrl->pocMask),
-                                  (UINT32) pocVal <<
-                                  (POC_SHIFT (pPocCtrl->pocMask)));
-            break;
-            }
-        pPocCtrl++;
+        return ERROR;
         }
 
-    RZG2_DBG_MSG (PFC_DBG_INFO, "\nPOC Control Register\n");
-    RZG2_DBG_MSG (PFC_DBG_INFO, "POCCTRL: 0x%08X\n",
-                  rzg2PfcRegRead (pPfc, PFC_POCCTRL));
+    RZG2_DBG_MSG (PFC_DBG_INFO, "Enabling GPIO on %s, reg: 0x%x, bit: 0x%x\n",
+                  pPin->sipName,
+                  PFC_GPSR (GPSR_REG (pPin->gpsrRegBit)),
+                  GPSR_MASK (pPin->gpsrRegBit));
+
+    /* GPSR register bit is 0 for GPIO */
+
+    rzg2PfcRegBitClr (pPfc, PFC_GPSR (GPSR_REG (pPin->gpsrRegBit)),
+                      GPSR_MASK (pPin->gpsrRegBit));
 
     return OK;
     }
 
 /*******************************************************************************
 *
-* rzg2PfcFdtPinListValidate - validate a FDT stringList of pins
+* rzg2PfcPullDisable - disable PFC pull-up/pull-down function
 *
-* This function uses the "pins" stringList from the device table node, and splits
-* the list into individual pins. Every pin in the list must have a valid
-* descriptor for the list to be successfully validated.
+* This function disables the pull-up/pull down functionality of the requested pin
+* using the Pull Enable Registers.
 *
-* RETURNS: OK if all pins are valid, ERROR if pin controller, pin list or any
-* pins are invalid.
+* RETURNS: OK if pin configured, ERROR if pin controller, or pin descriptor is
+* invalid.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS rzg2PfcFdtPinListValidate
+LOCAL STATUS rzg2PfcPullDisable
     (
-    PFC_PINMUX_DRVCTRL *    pPfc,           /* pin mux controller instance */
-    char *                  pPinsProp,      /* pins property */
-    int                     pinsPropLen     /* pins property length */
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    PFC_PIN_DESC *          pPin,       /* pin descriptor */
+    char *                  pProp,      /* property (not used) */
+    int                     propLen     /* property length (not used) */
     )
     {
-    int                     stringLen;
-    PFC_PIN_DESC *          pPin;
-
-    if ((pPfc == NULL) || (pPinsProp == NULL))
+    if ((pPfc == NULL) || (pPin == NULL))
         {
         return ERROR;
         }
 
-    RZG2_DBG_MSG (PFC_DBG_INFO, "pin:");
+    RZG2_DBG_MSG (PFC_DBG_INFO, "Disabling pull on %s\n", pPin->sipName);
 
-    /* validate all pins in pin list */
+    /* PUEN register bit is 0 for pull-up/down function disable */
 
-    while (pinsPropLen >  0)
+    rzg2PfcRegBitClr (pPfc, PFC_PUEN (PU_REG (pPin->puRegBit)),
+                      PU_MASK (pPin->puRegBit));
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcPullUpEnable - enable PFC pull-up function
+*
+* This function enables the pull up functionality of the requested pin
+* using the Pull Enable, and Pull Up Down Control Registers.
+*
+* RETURNS: OK if pin configured, ERROR if pin controller, or pin descriptor is
+* invalid.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2PfcPullUpEnable
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    PFC_PIN_DESC *          pPin,       /* pin descriptor */
+    char *                  pProp,      /* property (not used) */
+    int                     propLen     /* property length (not used) */
+    )
+    {
+    if ((pPfc == NULL) || (pPin == NULL))
         {
-        RZG2_DBG_MSG (PFC_DBG_INFO, "%s, ", pPinsProp);
+        return ERROR;
+        }
 
-        /* retrieve the descriptor for the pin name */
+    RZG2_DBG_MSG (PFC_DBG_INFO, "Enabling pull-up on %s\n", pPin->sipName);
 
-        pPin = rzg2PfcPinGet (pPinsProp);
-        if (pPin == NULL)
-            {
-            RZG2_DBG_MSG (PFC_DBG_ERR, "Invalid pin: %s\n", pPinsProp);
-            return ERROR;
-            }
+    /* PUD register bit is 1 for pull-up function */
 
-        /* potentially move onto the next pin in the "pins" stringList */
+    rzg2PfcRegBitSet (pPfc, PFC_PUD (PU_REG (pPin->puRegBit)),
+                      PU_MASK (pPin->puRegBit));
 
-        stringLen = (int) (strlen (pPinsProp) + 1);
-        pinsPropLen -= stringLen;
-        pPinsProp += stringLen;
-        }
+    /* PUEN register bit is 1 for pull function enable */
 
-    RZG2_DBG_MSG (PFC_DBG_INFO, "\n");
+    rzg2PfcRegBitSet (pPfc, PFC_PUEN (PU_REG (pPin->puRegBit)),
+                      PU_MASK (pPin->puRegBit));
 
     return OK;
     }
 
 /*******************************************************************************
 *
-* rzg2PfcFdtPinListHandle - handle a FDT stringList of pins with supplied function
+* rzg2PfcPullDownEnable - enable PFC pull-down function
 *
-* This function uses the "pins" stringList from the device table node, and splits
-* the list into individual pins. It retrieves the descriptor for the pin and
-* calls the provided function with each pin descriptor.
+* This function enables the pull down functionality of the requested pin
+* using the Pull Enable, and Pull Up Down Control Registers.
 *
-* RETURNS: OK if all pins are handled, ERROR if pin controller, pin list or
-* handler function is invalid, or if the pin handler function fails.
+* RETURNS: OK if pin configured, ERROR if pin controller, or pin descriptor is
+* invalid.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS rzg2PfcFdtPinListHandle
+LOCAL STATUS rzg2PfcPullDownEnable
     (
-    PFC_PINMUX_DRVCTRL *    pPfc,           /* pin mux controller instance */
-    char *                  pPinsProp,      /* pins property */
-    int                     pinsPropLen,    /* pins property length */
-    PFC_PIN_HANDLER *       handler,        /* pin configuration handler */
-    char *                  pProp,          /* configuration property */
-    int                     propLen         /* configuration property length */
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    PFC_PIN_DESC *          pPin,       /* pin descriptor */
+    char *                  pProp,      /* property (not used) */
+    int                     propLen     /* property length (not used) */
     )
     {
-    int                     stringLen;
-    PFC_PIN_DESC *          pPin;
 
-    if ((pPfc == NULL) || (pPinsProp == NULL) || (handler == NULL))
+    if ((pPfc == NULL) || (pPin == NULL))
         {
         return ERROR;
         }
 
-    /* operate on all pins in pin list */
+    RZG2_DBG_MSG (PFC_DBG_INFO, "Enabling pull-down on %s/%s\n", pPin->sipName);
 
-    while (pinsPropLen >  0)
-        {
+    /* PUD register bit is 0 for pull-down function */
 
-        /* retrieve the descriptor for the pin name */
+    rzg2PfcRegBitClr (pPfc, PFC_PUD (PU_REG (pPin->puRegBit)),
+                      PU_MASK (pPin->puRegBit));
 
-        pPin = rzg2PfcPinGet (pPinsProp);
-        if (pPin == NULL)
-            {
-            return ERROR;
-            }
+    /* PUEN register bit is 1 for pull function enable */
+
+    rzg2PfcRegBitSet (pPfc, PFC_PUEN (PU_REG (pPin->puRegBit)),
+                      PU_MASK (pPin->puRegBit));
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcDriveControl - configure PFC drive control function
+*
+* This function configures the driving ability of the requested pin
+* using the DRV Control Registers.
+*
+* RETURNS: OK if pin configured, ERROR if pin controller, pin descriptor, or
+* drive control property is invalid.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2PfcDriveControl
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    PFC_PIN_DESC *          pPin,       /* pin descriptor */
+    char *                  pProp,      /* configuration property */
+    int                     propLen     /* configuration property length */
+    )
+    {
+    UINT    mask;                       /* DRVCTRL mask */
+    UINT32  drvVal;                     /* drive-control property value */
+
+    /* validate parameters and expect <u32> property value */
+
+    if ((pPfc == NULL) || (pPin == NULL) || (pProp == NULL) ||
+        (propLen != sizeof (UINT32)))
+        {
+        return ERROR;
+        }
+
+    mask = DRVCTRL_BITMASK (pPin->drvMask);
+    drvVal = vxFdt32ToCpu (*(UINT32 *)pProp);
+
+    RZG2_DBG_MSG (PFC_DBG_INFO, "Configuring %d/8 DRV control on %s\n",
+                  drvVal, pPin->sipName);
+
+    /*
+     * The drive-control property value must be in the range 1 to 8. For
+     * F type buffers, which have 2-bit masks, the value must be an even
+     * number of eighths (quarters).
+     */
+
+    if ((drvVal < PFC_DRVCTRL_VAL_MIN) || (drvVal > PFC_DRVCTRL_VAL_MAX) ||
+        ((mask == DRVCTRL_F_MASK) && ((drvVal % 2U) != 0U)))
+        {
+        return ERROR;
+        }
+
+    /* convert F type from eighths to quarters */
+
+    if (mask == DRVCTRL_F_MASK)
+        {
+        drvVal /= 2;
+        }
+
+    /* DRVCTRL register field is 0-7 or 0-3 */
+
+    drvVal--;
+
+    rzg2PfcRegMaskAndSet (pPfc, PFC_DRVCTRL (DRVCTRL_REG (pPin->drvMask)),
+                          DRVCTRL_MASK (pPin->drvMask),
+                          drvVal << (DRVCTRL_SHIFT (pPin->drvMask)));
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcPocValGet - get the POCCTRL field value for a voltage
+*
+* This function returns in <pVal> the value of the POCCTRL field <pocSel> that
+* selects <mv> millivolt signalling, shifted to the field position.
+*
+* RETURNS: OK, or ERROR if <mv> is not supported.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2PfcPocValGet
+    (
+    UINT32                  pocSel,     /* POC_SD0 or POC_SD3 */
+    UINT32                  mv,         /* signalling voltage in mv */
+    UINT32 *                pVal        /* returned field value */
+    )
+    {
+    if (mv == PFC_POC_MV_3V3)
+        {
+        *pVal = POC_MASK (pocSel);
+        }
+    else if (mv == PFC_POC_MV_1V8)
+        {
+        *pVal = 0U;
+        }
+    else
+        {
+        return ERROR;
+        }
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcPocCtrlFuncSet - set PFC POC Control Register
+*
+* This function set PFC POC Control Register from the "power-source" property
+* <pProp> of a configuration node.
+*
+* RETURNS: OK if POC control register configured, ERROR if pin controller is
+* invalid or the property is malformed.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2PfcPocCtrlFuncSet
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    PFC_FUNC_ID             funcId,     /* function to set */
+    char *                  pProp,      /* property */
+    int                     propLen     /* property length */
+    )
+    {
+    PFC_POC_DESC *          pPocCtrl;
+    UINT32 mv = 0;
+    UINT32 pocVal = 0;
+
+    if ((pPfc == NULL) || (pProp == NULL) || (propLen < (int)sizeof (UINT32)))
+        {
+        RZG2_DBG_MSG (PFC_DBG_ERR, "invalid power-source \r\n");
+        return ERROR;
+        }
+
+    mv = vxFdt32ToCpu(*(UINT32*)pProp);
+
+    /* process the functions in the POC table */
+
+    pPocCtrl = (PFC_POC_DESC *) &pfcPocSel [0];
+
+    while (pPocCtrl->funcId != FN_NONE)
+        {
+        if (pPocCtrl->funcId == funcId)
+            {
+            if (rzg2PfcPocValGet (pPocCtrl->pocMask, mv, &pocVal) == ERROR)
+                {
+                RZG2_DBG_MSG(PFC_DBG_ERR, "invalid power-source \r\n");
+                return ERROR;
+                }
+
+            RZG2_DBG_MSG(PFC_DBG_INFO, "power-source is %dmv \r\n", mv);
+            rzg2PfcRegMaskAndSet (pPfc,
+                                  PFC_POCCTRL,
+                                  POC_MASK (pPocCtrl->pocMask),
+                                  pocVal);
+            break;
+            }
+        pPocCtrl++;
+        }
+
+    RZG2_DBG_MSG (PFC_DBG_INFO, "\nPOC Control Register\n");
+    RZG2_DBG_MSG (PFC_DBG_INFO, "POCCTRL: 0x%08X\n",
+                  rzg2PfcRegRead (pPfc, PFC_POCCTRL));
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcFdtPinListResolve - resolve a FDT stringList of pins to descriptors
+*
+* This function uses the "pins" stringList from the device table node, and splits
+* the list into individual pins. The descriptor of each pin is stored in
+* <ppPins>, which has room for PFC_NODE_PINS_MAX pins, and the number of pins is
+* returned in <pNumPins>. Every pin in the list must have a valid descriptor for
+* the list to be successfully resolved.
+*
+* RETURNS: OK if all pins are valid, ERROR if pin controller, pin list or any
+* pins are invalid, or if there are too many pins.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2PfcFdtPinListResolve
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,           /* pin mux controller instance */
+    char *                  pPinsProp,      /* pins property */
+    int                     pinsPropLen,    /* pins property length */
+    PFC_PIN_DESC **         ppPins,         /* returned pin descriptors */
+    int *                   pNumPins        /* returned number of pins */
+    )
+    {
+    int                     stringLen;
+    int                     numPins = 0;
+    PFC_PIN_DESC *          pPin;
+
+    if ((pPfc == NULL) || (pPinsProp == NULL))
+        {
+        return ERROR;
+        }
+
+    RZG2_DBG_MSG (PFC_DBG_INFO, "pin:");
+
+    /* resolve all pins in pin list */
+
+    while (pinsPropLen >  0)
+        {
+        RZG2_DBG_MSG (PFC_DBG_INFO, "%s, ", pPinsProp);
+
+        if (numPins >= PFC_NODE_PINS_MAX)
+            {
+            RZG2_DBG_MSG (PFC_DBG_ERR, "Too many pins\n");
+            return ERROR;
+            }
+
+        /* retrieve the descriptor for the pin name */
+
+        pPin = rzg2PfcPinGet (pPinsProp);
+        if (pPin == NULL)
+            {
+            RZG2_DBG_MSG (PFC_DBG_ERR, "Invalid pin: %s\n", pPinsProp);
+            return ERROR;
+            }
+
+        ppPins [numPins++] = pPin;
+
+        /* potentially move onto the next pin in the "pins" stringList */
+
+        stringLen = (int) (strlen (pPinsProp) + 1);
+        pinsPropLen -= stringLen;
+        pPinsProp += stringLen;
+        }
+
+    RZG2_DBG_MSG (PFC_DBG_INFO, "\n");
+
+    *pNumPins = numPins;
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcPinListHandle - handle a list of pins with supplied function
+*
+* This function calls the provided function with each of the <numPins> pin
+* descriptors in <ppPins>.
+*
+* RETURNS: OK if all pins are handled, ERROR if pin controller, pin list or
+* handler function is invalid, or if the pin handler function fails.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2PfcPinListHandle
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,           /* pin mux controller instance */
+    PFC_PIN_DESC **         ppPins,         /* pin descriptors */
+    int                     numPins,        /* number of pins */
+    PFC_PIN_HANDLER *       handler,        /* pin configuration handler */
+    char *                  pProp,          /* configuration property */
+    int                     propLen         /* configuration property length */
+    )
+    {
+    int                     i;
+
+    if ((pPfc == NULL) || (ppPins == NULL) || (handler == NULL))
+        {
+        return ERROR;
+        }
+
+    /* configure all pins in pin list with the handler */
+
+    for (i = 0; i < numPins; i++)
+        {
+        if (handler (pPfc, ppPins [i], pProp, propLen) == ERROR)
+            {
+            return ERROR;
+            }
+        }
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcGroupIndexBuild - index a pin group selection table by group
+*
+* This function builds an index of a table of <numEntries> selections, for
+* example xPfcFuncSel, whose group IDs are at <pGroup> and every <stride> bytes
+* after it. The table indexes are sorted by group into <pOrder>, keeping table
+* order within each group, and the entries of group <g> are at
+* pOrder [pFirst [g]] up to, but not including, pOrder [pFirst [g + 1]].
+* <pFirst> must have GRP_COUNT + 1 entries.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2PfcGroupIndexBuild
+    (
+    const PFC_GROUP_ID *    pGroup,     /* group ID of first table entry */
+    size_t                  stride,     /* size of table entries */
+    UINT32                  numEntries, /* number of table entries */
+    UINT16 *                pFirst,     /* returned group ranges */
+    UINT16 *                pOrder      /* returned sorted table indexes */
+    )
+    {
+    PFC_GROUP_ID            groupId;
+    UINT32                  i;
+
+    (void)memset (pFirst, 0, sizeof (UINT16) * (GRP_COUNT + 1));
+
+    /* count the entries of each group, then find where each group starts */
+
+    for (i = 0; i < numEntries; i++)
+        {
+        groupId = *(const PFC_GROUP_ID *)((const char *) pGroup + (i * stride));
+        pFirst [groupId + 1]++;
+        }
+
+    for (i = 1; i <= GRP_COUNT; i++)
+        {
+        pFirst [i] = (UINT16) (pFirst [i] + pFirst [i - 1]);
+        }
+
+    /* pFirst [g] is now the start of group g, and pFirst [g + 1] its end */
+
+    /*
+     * Place each entry, using pFirst [g] as the insert position of group g.
+     * This leaves pFirst [g] at the start of group g + 1, so move the starts
+     * back up by one group afterwards.
+     */
+
+    for (i = 0; i < numEntries; i++)
+        {
+        groupId = *(const PFC_GROUP_ID *)((const char *) pGroup + (i * stride));
+        pOrder [pFirst [groupId]++] = (UINT16) i;
+        }
+
+    for (i = GRP_COUNT; i > 0; i--)
+        {
+        pFirst [i] = pFirst [i - 1];
+        }
+    pFirst [0] = 0;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcGroupIndexesCreate - index the function and module selection tables
+*
+* This function allocates and builds the per-group indexes of xPfcFuncSel (or
+* the compatible function selection table of the device) and pfcModuleSel, so
+* that the entries for a pin group can be found without scanning the tables.
+*
+* RETURNS: OK if the indexes were built, ERROR if memory cannot be allocated.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2PfcGroupIndexesCreate
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    const PFC_FUNC_DESC *   pFuncSel    /* function selection table */
+    )
+    {
+    UINT32                  numFuncs = 0;
+    UINT32                  numMods = 0;
+
+    while (pFuncSel [numFuncs].groupId != GRP_NONE)
+        {
+        numFuncs++;
+        }
+
+    while (pfcModuleSel [numMods].groupId != GRP_NONE)
+        {
+        numMods++;
+        }
+
+    pPfc->pFuncFirst = (UINT16 *) vxbMemAlloc (sizeof (UINT16) *
+                                               (GRP_COUNT + 1));
+    pPfc->pFuncOrder = (UINT16 *) vxbMemAlloc (sizeof (UINT16) *
+                                               (numFuncs + 1));
+    pPfc->pModFirst = (UINT16 *) vxbMemAlloc (sizeof (UINT16) *
+                                              (GRP_COUNT + 1));
+    pPfc->pModOrder = (UINT16 *) vxbMemAlloc (sizeof (UINT16) *
+                                              (numMods + 1));
+
+    if ((pPfc->pFuncFirst == NULL) || (pPfc->pFuncOrder == NULL) ||
+        (pPfc->pModFirst == NULL) || (pPfc->pModOrder == NULL))
+        {
+        return ERROR;
+        }
+
+    rzg2PfcGroupIndexBuild (&pFuncSel [0].groupId, sizeof (PFC_FUNC_DESC),
+                            numFuncs, pPfc->pFuncFirst, pPfc->pFuncOrder);
+    rzg2PfcGroupIndexBuild (&pfcModuleSel [0].groupId, sizeof (PFC_MOD_DESC),
+                            numMods, pPfc->pModFirst, pPfc->pModOrder);
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcGroupIndexesDelete - free the function and module selection indexes
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2PfcGroupIndexesDelete
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc        /* pin mux controller instance */
+    )
+    {
+    vxbMemFree (pPfc->pFuncFirst);
+    vxbMemFree (pPfc->pFuncOrder);
+    vxbMemFree (pPfc->pModFirst);
+    vxbMemFree (pPfc->pModOrder);
+
+    pPfc->pFuncFirst = NULL;
+    pPfc->pFuncOrder = NULL;
+    pPfc->pModFirst = NULL;
+    pPfc->pModOrder = NULL;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcIpsrGroupFuncSet - set the IPSR for a pin group
+*
+* This function sets the Peripheral Function Select Register (IPSR) to the
+* requested function for all pins in the provided group. The group's entries
+* are found through the group index, and the fields of all entries that share
+* an IPSR register are merged into a single update of that register.
+*
+* RETURNS: OK if set successfully or nothing to do, ERROR if pin controller or
+* group is invalid.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2PfcIpsrGroupFuncSet
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    PFC_GROUP_ID            groupId,    /* pin group */
+    PFC_FUNC_ID             funcId      /* function to set */
+    )
+    {
+    const PFC_FUNC_DESC *   pFuncSel;
+    const PFC_FUNC_DESC *   pFunc;
+    UINT32                  regMask [NUM_IPSR_REGS];
+    UINT32                  regVal [NUM_IPSR_REGS];
+    UINT32                  regIndex;
+    UINT32                  i;
+
+    if ((pPfc == NULL) || (groupId >= GRP_COUNT))
+        {
+        return ERROR;
+        }
+
+    (void)memset (regMask, 0, sizeof (regMask));
+    (void)memset (regVal, 0, sizeof (regVal));
+
+    /* gather the fields of this group/function pair by register */
+
+    pFuncSel = pPfc->pFuncSel;
+
+    for (i = pPfc->pFuncFirst [groupId]; i < pPfc->pFuncFirst [groupId + 1];
+         i++)
+        {
+        pFunc = &pFuncSel [pPfc->pFuncOrder [i]];
+        if (pFunc->funcId != funcId)
+            {
+            continue;
+            }
+
+        regIndex = IPSR_REG (pFunc->ipsrMask);
+        if (regIndex >= NUM_IPSR_REGS)
+            {
+            return ERROR;
+            }
+
+        regMask [regIndex] |= IPSR_MASK (pFunc->ipsrMask);
+        regVal [regIndex] = (regVal [regIndex] &
+                             ~IPSR_MASK (pFunc->ipsrMask)) |
+                            ((UINT32) pFunc->ipsrVal <<
+                             (IPSR_SHIFT (pFunc->ipsrMask)));
+        }
+
+    /* update each IPSR register touched by the group once */
+
+    for (regIndex = 0; regIndex < NUM_IPSR_REGS; regIndex++)
+        {
+        if (regMask [regIndex] != 0U)
+            {
+            rzg2PfcRegMaskAndSet (pPfc, PFC_IPSR (regIndex), regMask [regIndex],
+                                  regVal [regIndex]);
+            }
+        }
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcModSelGroupFuncSet - set the module selection for a pin group
+*
+* This function sets the Module Selection Register (MOD_SEL) to the
+* requested selection for all pins in the provided group. The group's entries
+* are found through the group index.
+*
+* RETURNS: OK if set successfully, or nothing to do, ERROR if pin controller or
+* group is invalid.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2PfcModSelGroupFuncSet
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    PFC_GROUP_ID            groupId,    /* pin group */
+    PFC_FUNC_ID             funcId      /* function to set */
+    )
+    {
+    const PFC_MOD_DESC *    pModSel;
+    UINT32                  i;
+
+    if ((pPfc == NULL) || (groupId >= GRP_COUNT))
+        {
+        return ERROR;
+        }
+
+    /* process the group/function pair in the module selection table */
+
+    for (i = pPfc->pModFirst [groupId]; i < pPfc->pModFirst [groupId + 1]; i++)
+        {
+        pModSel = &pfcModuleSel [pPfc->pModOrder [i]];
+        if (pModSel->funcId == funcId)
+            {
+            rzg2PfcRegMaskAndSet (pPfc,
+                                  PFC_MOD_SEL (MOD_SEL_REG (pModSel->modSelMask)),
+                                  MOD_SEL_MASK (pModSel->modSelMask),
+                                  (UINT32) pModSel->modSelVal <<
+                                  (MOD_SEL_SHIFT (pModSel->modSelMask)));
+            break;
+            }
+        }
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcFdtFunctionHandle - handle a FDT pin mux function property
+*
+* This function handles the pin mux "function" property from the device tree
+* node. The process requires that GPIO mode is selected while changing function.
+* The peripheral function and module selection registers are set while GPIO mode
+* is selected. Dedicated pins have no GPIO mode, and only their group is checked.
+*
+* RETURNS: OK if pin mux function handled successfully, ERROR if pin controller,
+* or pins property is invalid, if pins are not from the same functional
+* group, or if any step in the configuration process fails.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2PfcFdtFunctionHandle
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,           /* pin mux controller instance */
+    PFC_PIN_DESC **         ppPins,         /* pin descriptors */
+    int                     numPins,        /* number of pins */
+    PFC_FUNC_ID             funcId          /* function ID */
+    )
+    {
+    PFC_GROUP_ID            groupId;
+    PFC_PIN_DESC *          muxPins [PFC_NODE_PINS_MAX];
+    int                     numMuxPins = 0;
+    int                     i;
+
+    if ((pPfc == NULL) || (ppPins == NULL) || (numPins <= 0) ||
+        (numPins > PFC_NODE_PINS_MAX))
+        {
+        return ERROR;
+        }
+
+    /* all pins must be in the same defined functional group */
+
+    groupId = rzg2PfcPinsGroupGet (pPfc, ppPins, numPins, funcId);
+    if (groupId == GRP_NONE)
+        {
+        return ERROR;
+        }
+
+    /* only the multiplexed pins have a GPSR mode to switch */
+
+    for (i = 0; i < numPins; i++)
+        {
+        if (ppPins [i]->gpsrRegBit != GPSR_NONE)
+            {
+            muxPins [numMuxPins++] = ppPins [i];
+            }
+        }
+
+    /* select GPSR GPIO mode for all pins specified */
+
+    if ((numMuxPins > 0) &&
+        (rzg2PfcPinListHandle (pPfc, muxPins, numMuxPins, rzg2PfcGpioEnable,
+                               NULL, 0) == ERROR))
+        {
+        return ERROR;
+        }
+
+    /* set Peripheral Function (IPSR) for all functions in group */
+
+    if (rzg2PfcIpsrGroupFuncSet (pPfc, groupId, funcId) == ERROR)
+        {
+        return ERROR;
+        }
+
+    /* set Module Selection (MOD_SEL) for this group function */
+
+    if (rzg2PfcModSelGroupFuncSet (pPfc, groupId, funcId) == ERROR)
+        {
+        return ERROR;
+        }
+
+    /* select GPSR Peripheral Function mode for all pins specified */
+
+    if ((numMuxPins > 0) &&
+        (rzg2PfcPinListHandle (pPfc, muxPins, numMuxPins, rzg2PfcPeriphEnable,
+                               NULL, 0) == ERROR))
+        {
+        return ERROR;
+        }
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcFdtConfigHandle - handle the enabling of a pin mux state
+*
+* This function handles the enabling of a specified pin mux state in the PFC. The
+* state is specified in the FDT configuration node at <offset>.
+*
+* RETURNS: OK if state enabled, ERROR if the "pins" property is empty or
+* missing, if the pin function is invalid, of if the pin configuration fails.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2PfcFdtConfigHandle
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,   /* pin mux controller instance */
+    int                     offset  /* FDT configuration node */
+    )
+    {
+    PFC_PIN_CONF *  pConf;          /* pin configuration descriptor */
+    char *          pProp;          /* function/configuration property */
+    int             propLen;        /* function/configuration property length */
+    char *          pPinsProp;      /* pins property */
+    int             pinsPropLen;    /* pins property length */
+    PFC_PIN_DESC *  pins [PFC_NODE_PINS_MAX];   /* pin descriptors */
+    int             numPins;        /* number of pins */
+    PFC_FUNC_ID     funcId = FN_NONE;   /* function ID */
+
+    RZG2_DBG_MSG (PFC_DBG_INFO, "%s offset %d\n", __FUNCTION__, offset);
+
+    /* pin configuration and multiplexing both require "pins" property */
+
+    pPinsProp = (char *) vxFdtPropGet (offset, PFC_FDT_PINS, &pinsPropLen);
+    if ((pPinsProp == NULL) || (pinsPropLen <= 0))
+        {
+        RZG2_DBG_MSG (PFC_DBG_ERR, "Empty or no " PFC_FDT_PINS " property\n");
+        return ERROR;
+        }
+
+    /*
+     * Ensure all the pins are valid before starting configuration, resolving
+     * each pin name once for all the properties of this node.
+     */
+
+    if (rzg2PfcFdtPinListResolve (pPfc, pPinsProp, pinsPropLen, pins,
+                                  &numPins) == ERROR)
+        {
+        return ERROR;
+        }
+
+    /*
+     * Pin multiplexing is determined by the "function" property. The single
+     * <string> value defines the function to be applied.
+     */
+    pProp = (char *)vxFdtPropGet (offset, PFC_FDT_FUNCTION, &propLen);
+    if (pProp != NULL)
+        {
+        RZG2_DBG_MSG (PFC_DBG_INFO, "pin mux " PFC_FDT_FUNCTION " property: %s\n", pProp);
+
+        /* retrieve, and validate, the function ID for the function name */
+
+        funcId = rzg2PfcFuncIdGet (pProp);
+        if (funcId == FN_NONE)
+            {
+            RZG2_DBG_MSG (PFC_DBG_ERR, "Invalid function %s\n", pProp);
+            return ERROR;
+            }
+
+        if (rzg2PfcFdtFunctionHandle (pPfc, pins, numPins, funcId) == ERROR)
+            {
+            RZG2_DBG_MSG (PFC_DBG_ERR, "pin mux function %s failed\n", pProp);
+            return ERROR;
+            }
+        }
+
+    /*
+     * Pin configuration is determined by a single <string> property. Supported
+     * configuration properties and their handling functions are listed in the
+     * pfcConfs table.
+     */
+
+    pConf = (PFC_PIN_CONF *) &pfcConfs [0];
+    while (pConf->name != NULL)
+        {
+        pProp = (char *)vxFdtPropGet (offset, (char *)pConf->name, &propLen);
+        if ((pProp != NULL) && (pConf->func != NULL))
+            {
+            RZG2_DBG_MSG (PFC_DBG_INFO, "%s found\n", pConf->name);
+
+            if (rzg2PfcPinListHandle (pPfc, pins, numPins, pConf->func,
+                                      pProp, propLen) == ERROR)
+                {
+                RZG2_DBG_MSG (PFC_DBG_ERR, "%s failed\n", pConf->name);
+                return ERROR;
+                }
+            }
+        pConf++;
+        }
+
+    /* POC configuration is determined by "function" and "power-source" */
+
+    pProp = (char *)vxFdtPropGet (offset, (char *)pfcPocConfs, &propLen);
+    if (pProp != NULL)
+        {
+        RZG2_DBG_MSG (PFC_DBG_INFO, "%s found\n", pfcPocConfs);
+
+        if (rzg2PfcPocCtrlFuncSet (pPfc, funcId, pProp, propLen) == ERROR)
+            {
+            RZG2_DBG_MSG (PFC_DBG_ERR, "%s failed\n", pfcPocConfs);
+            return ERROR;
+            }
+        }
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcFdtStateHandle - handle a FDT configuration node and its subnodes
+*
+* This function handles the configuration node at <offset>, if it has a "pins"
+* property, and then each of its subnodes.
+*
+* RETURNS: OK if all the nodes are handled, ERROR if any node fails.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2PfcFdtStateHandle
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    int                     offset      /* FDT configuration node */
+    )
+    {
+    int                     nodeOffset; /* FDT configuration subnodes */
+
+    /* handle this node if it has pins properties and not just subnodes */
+
+    if (vxFdtPropGet (offset, PFC_FDT_PINS, NULL) != NULL)
+        {
+        if (rzg2PfcFdtConfigHandle (pPfc, offset) == ERROR)
+            {
+            return ERROR;
+            }
+        }
+
+    /* handle the device tree subnodes if there are any */
+
+    for (nodeOffset = vxFdtFirstSubnode (offset); nodeOffset > 0;
+         nodeOffset = vxFdtNextSubnode (nodeOffset))
+        {
+        if (rzg2PfcFdtConfigHandle (pPfc, nodeOffset) == ERROR)
+            {
+            return ERROR;
+            }
+        }
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcProgCompile - compile a configuration node into a pin program
+*
+* This function handles the configuration node at <offset> in a transaction
+* that is discarded, and records the register fields changed by the node in a
+* new pin program. The program and its steps are one allocation. No register is
+* written.
+*
+* RETURNS: the pin program, or NULL if the node is invalid or memory cannot be
+* allocated.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL PFC_PIN_PROG * rzg2PfcProgCompile
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    int                     offset      /* FDT configuration node */
+    )
+    {
+    PFC_PIN_PROG *          pProg = NULL;
+    PFC_PIN_STEP *          pStep;
+    UINT32                  word;
+    UINT32                  i;
+
+    rzg2PfcXactBegin (pPfc);
+
+    if (rzg2PfcFdtStateHandle (pPfc, offset) == OK)
+        {
+        pProg = (PFC_PIN_PROG *) vxbMemAlloc (sizeof (PFC_PIN_PROG) +
+                                              (sizeof (PFC_PIN_STEP) *
+                                               pPfc->xactCount));
+        }
+
+    if (pProg != NULL)
+        {
+        pProg->nodeOffset = offset;
+        pProg->numSteps = pPfc->xactCount;
+        pProg->savedValid = FALSE;
+        pProg->isProfile = FALSE;
+        pProg->pSteps = (PFC_PIN_STEP *) (pProg + 1);
+
+        for (i = 0U; i < pPfc->xactCount; i++)
+            {
+            word = pPfc->xactRegs [i];
+            pStep = &pProg->pSteps [i];
+
+            pStep->offset = (UINT16) (word * 4U);
+            pStep->mask = pPfc->xactMask [word];
+            pStep->val = pPfc->xactVal [word] & pStep->mask;
+            pStep->gpio = 0U;
+            pStep->saved = 0U;
+
+            if ((pStep->offset >= PFC_GPSR (0)) &&
+                (pStep->offset < PFC_GPSR (NUM_GPSR_REGS)))
+                {
+                pStep->gpio =
+                    pPfc->xactGpio [(pStep->offset - PFC_GPSR (0)) / 4U];
+                }
+            }
+        }
+
+    rzg2PfcXactEnd (pPfc, FALSE);
+
+    return pProg;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcProgHash - hash a configuration node offset
+*
+* RETURNS: the program cache slot to start searching for the node at <offset>.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL UINT32 rzg2PfcProgHash
+    (
+    int     offset      /* FDT configuration node */
+    )
+    {
+    return ((UINT32) offset * PFC_PROG_HASH_MULT) >>
+           (32U - PFC_PROG_HASH_BITS);
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcProgFind - find the cached pin program of a configuration node
+*
+* The caller must hold the PFC mutex.
+*
+* RETURNS: the pin program of the node at <offset>, or NULL if the node has not
+* been compiled.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL PFC_PIN_PROG * rzg2PfcProgFind
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    int                     offset      /* FDT configuration node */
+    )
+    {
+    PFC_PIN_PROG *          pProg;
+    UINT32                  slot;
+
+    /* the table is never full, so the search ends at an empty slot */
+
+    for (slot = rzg2PfcProgHash (offset);
+         (pProg = pPfc->progHash [slot]) != NULL;
+         slot = (slot + 1U) & (PFC_PROG_HASH_SIZE - 1U))
+        {
+        if (pProg->nodeOffset == offset)
+            {
+            return pProg;
+            }
+        }
+
+    return NULL;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcProgGet - get the pin program of a configuration node
+*
+* This function returns the cached pin program of the node at <offset>. If the
+* node has not been compiled, it is compiled and added to the cache.
+*
+* RETURNS: the pin program, or NULL if the node is invalid, the cache is full,
+* or memory cannot be allocated.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL PFC_PIN_PROG * rzg2PfcProgGet
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    int                     offset      /* FDT configuration node */
+    )
+    {
+    PFC_PIN_PROG *          pProg;
+    UINT32                  slot;
+
+    if (offset <= 0)
+        {
+        return NULL;
+        }
+
+    (void)semTake (pPfc->mutex, WAIT_FOREVER);
+
+    pProg = rzg2PfcProgFind (pPfc, offset);
+    if ((pProg == NULL) && (pPfc->numProgs < PFC_PROG_MAX))
+        {
+        pProg = rzg2PfcProgCompile (pPfc, offset);
+        if (pProg != NULL)
+            {
+            slot = rzg2PfcProgHash (offset);
+            while (pPfc->progHash [slot] != NULL)
+                {
+                slot = (slot + 1U) & (PFC_PROG_HASH_SIZE - 1U);
+                }
+
+            pPfc->progHash [slot] = pProg;
+            pPfc->numProgs++;
+            }
+        }
+
+    (void)semGive (pPfc->mutex);
+
+    return pProg;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcProgsCreate - compile the configuration nodes of the PFC
+*
+* This function compiles each configuration node under the PFC device tree node
+* at <pfcOffset> into the program cache. Nodes that cannot be compiled are
+* reported when they are enabled.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2PfcProgsCreate
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    int                     pfcOffset   /* FDT PFC node */
+    )
+    {
+    int                     nodeOffset;
+
+    for (nodeOffset = vxFdtFirstSubnode (pfcOffset); nodeOffset > 0;
+         nodeOffset = vxFdtNextSubnode (nodeOffset))
+        {
+        if (rzg2PfcProgGet (pPfc, nodeOffset) == NULL)
+            {
+            RZG2_DBG_MSG (PFC_DBG_ERR, "node %d not compiled\n", nodeOffset);
+            }
+        }
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcProgsDelete - free the pin programs
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2PfcProgsDelete
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc        /* pin mux controller instance */
+    )
+    {
+    UINT32                  slot;
+
+    for (slot = 0U; slot < PFC_PROG_HASH_SIZE; slot++)
+        {
+        vxbMemFree (pPfc->progHash [slot]);
+        pPfc->progHash [slot] = NULL;
+        }
+
+    pPfc->numProgs = 0U;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcPinsClaim - claim GPSR pins for a configuration node
+*
+* This function records the configuration node at <owner> as the owner of the
+* <pins> of GPSR register <reg>. Pins owned by another node are recorded as
+* conflicts, and are then claimed by <owner>. The caller must hold the PFC
+* mutex.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2PfcPinsClaim
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    UINT32                  reg,        /* GPSR register */
+    UINT32                  pins,       /* GPSR pins */
+    int                     owner       /* FDT configuration node */
+    )
+    {
+    PFC_PIN_CONFLICT *      pConflict;
+    UINT32                  claimed;
+    UINT32                  pin;
+    UINT32                  bit;
+
+    /* only pins that are already owned need their owner checked */
+
+    claimed = pins & pPfc->pinClaimed [reg];
+
+    for (bit = 0U; claimed != 0U; bit++, claimed >>= 1)
+        {
+        pin = (reg * 32U) + bit;
+        if (((claimed & 1U) == 0U) || (pPfc->pinOwner [pin] == owner))
+            {
+            continue;
+            }
+
+        RZG2_DBG_MSG (PFC_DBG_ERR, "GPSR%u bit %u: node %d overrides node %d\n",
+                      reg, bit, owner, pPfc->pinOwner [pin]);
+
+        pConflict = &pPfc->conflicts [pPfc->numConflicts % PFC_CONFLICTS_MAX];
+        pConflict->pin = GPSR_REG_PIN (reg, bit);
+        pConflict->prevOwner = pPfc->pinOwner [pin];
+        pConflict->newOwner = owner;
+        pPfc->numConflicts++;
+        }
+
+    pPfc->pinClaimed [reg] |= pins;
+
+    for (bit = 0U; pins != 0U; bit++, pins >>= 1)
+        {
+        if ((pins & 1U) != 0U)
+            {
+            pPfc->pinOwner [(reg * 32U) + bit] = owner;
+            }
+        }
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcPinsRelease - release GPSR pins owned by a configuration node
+*
+* This function releases those <pins> of GPSR register <reg> that are owned by
+* the configuration node at <owner>. The caller must hold the PFC mutex.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2PfcPinsRelease
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    UINT32                  reg,        /* GPSR register */
+    UINT32                  pins,       /* GPSR pins */
+    int                     owner       /* FDT configuration node */
+    )
+    {
+    UINT32                  bit;
+
+    pins &= pPfc->pinClaimed [reg];
+
+    for (bit = 0U; pins != 0U; bit++, pins >>= 1)
+        {
+        if (((pins & 1U) != 0U) &&
+            (pPfc->pinOwner [(reg * 32U) + bit] == owner))
+            {
+            pPfc->pinClaimed [reg] &= ~(1U << bit);
+            }
+        }
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcProgApply - apply a pin program in the open transaction
+*
+* This function applies the register changes of <pProg> to the open transaction.
+* If <restore> is FALSE, the program values are applied, and the values they
+* replace are saved in the program unless the program is already enabled. The
+* values replaced by a profile are saved each time it is applied, so that the
+* last application can be undone. If <restore> is TRUE, the saved values are
+* applied instead. In both cases, pins that change function pass through GPIO
+* mode when the transaction is committed. The GPSR pins of the program are
+* claimed for its node when it is applied, and released when it is restored.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2PfcProgApply
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    PFC_PIN_PROG *          pProg,      /* pin program */
+    BOOL                    restore     /* TRUE to restore the saved values */
+    )
+    {
+    PFC_PIN_STEP *          pStep;
+    UINT32                  bootBits;
+    UINT32                  word;
+    UINT32                  i;
+
+    for (i = 0U; i < pProg->numSteps; i++)
+        {
+        pStep = &pProg->pSteps [i];
+
+        if ((pStep->offset >= PFC_GPSR (0)) &&
+            (pStep->offset < PFC_GPSR (NUM_GPSR_REGS)))
+            {
+            if (restore)
+                {
+                rzg2PfcPinsRelease (pPfc, (pStep->offset - PFC_GPSR (0)) / 4U,
+                                    pStep->mask, pProg->nodeOffset);
+                }
+            else
+                {
+                rzg2PfcPinsClaim (pPfc, (pStep->offset - PFC_GPSR (0)) / 4U,
+                                  pStep->mask, pProg->nodeOffset);
+                }
+            }
+
+        if (restore)
+            {
+            rzg2PfcRegMaskAndSet (pPfc, pStep->offset, pStep->mask,
+                                  pStep->saved);
+            }
+        else
+            {
+            if (!pProg->savedValid || pProg->isProfile)
+                {
+                pStep->saved = rzg2PfcXactRegGet (pPfc, pStep->offset) &
+                               pStep->mask;
+
+                /*
+                 * The first program to take over bits set by the boot program
+                 * saves the values they had before it, so that disabling the
+                 * node undoes the boot program.
+                 */
+
+                word = pStep->offset / 4U;
+                bootBits = pStep->mask & pPfc->bootMask [word];
+                if (bootBits != 0U)
+                    {
+                    pStep->saved = (pStep->saved & ~bootBits) |
+                                   (pPfc->bootPrev [word] & bootBits);
+                    pPfc->bootMask [word] &= ~bootBits;
+                    }
+                }
+            rzg2PfcRegMaskAndSet (pPfc, pStep->offset, pStep->mask,
+                                  pStep->val);
+            }
+
+        if (pStep->gpio != 0U)
+            {
+            pPfc->xactGpio [(pStep->offset - PFC_GPSR (0)) / 4U] |=
+                pStep->gpio;
+            }
+        }
+
+    pProg->savedValid = !restore;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcBootProgApply - write the boot program
+*
+* This function writes the boot program set by rzg2PfcBootProgSet() in one
+* transaction. Each entry sets the <mask> bits of the register at <offset> to
+* <val>. The GPSR entries that set pins to GPIO only take effect if a function or
+* module selection changes, and registers whose value does not change are not
+* written. The values of the bits replaced by the boot program are recorded for
+* rzg2PfcProgApply().
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2PfcBootProgApply
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc        /* pin mux controller instance */
+    )
+    {
+    const RZG2_PFC_BOOT_WRITE * pWrite;
+    UINT32                  newBits;
+    UINT32                  word;
+    UINT32                  i;
+
+    rzg2PfcXactBegin (pPfc);
+
+    for (i = 0U; i < rzg2PfcBootWritesNum; i++)
+        {
+        pWrite = &pRzg2PfcBootWrites [i];
+        word = pWrite->offset / 4U;
+
+        /* the registers are not written until the end of the transaction */
+
+        if (word < PFC_REG_WORDS)
+            {
+            newBits = pWrite->mask & ~pPfc->bootMask [word];
+            pPfc->bootPrev [word] = (pPfc->bootPrev [word] & ~newBits) |
+                                    (rzg2PfcRegRead (pPfc, pWrite->offset) &
+                                     newBits);
+            pPfc->bootMask [word] |= pWrite->mask;
+            }
+
+        rzg2PfcRegMaskAndSet (pPfc, pWrite->offset, pWrite->mask,
+                              pWrite->val & pWrite->mask);
+        }
+
+    pPfc->bootApplied = TRUE;
+
+    rzg2PfcXactEnd (pPfc, TRUE);
+    }
+
+#ifdef RZG2_PFC_DBG
+/*******************************************************************************
+*
+* rzg2PfcBootProgVerify - check a pin program against the boot program
+*
+* This function reports the register fields of <pProg> that the boot program
+* did not set to the program values.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2PfcBootProgVerify
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    PFC_PIN_PROG *          pProg       /* pin program */
+    )
+    {
+    PFC_PIN_STEP *          pStep;
+    UINT32                  i;
+
+    for (i = 0U; i < pProg->numSteps; i++)
+        {
+        pStep = &pProg->pSteps [i];
+        if ((rzg2PfcRegRead (pPfc, pStep->offset) & pStep->mask) != pStep->val)
+            {
+            RZG2_DBG_MSG (PFC_DBG_ERR, "node %s: boot program differs at "
+                          "0x%03x\n", vxFdtGetName (pProg->nodeOffset, NULL),
+                          pStep->offset);
+            }
+        }
+    }
+#endif  /* RZG2_PFC_DBG */
+
+/*******************************************************************************
+*
+* vxbFdtRzg2PfcPinMuxEnable - enable pin mux configuration
+*
+* The vxbPinMuxEnable method enables pin mux configuration in the hardware. This
+* method is required for a pin mux controller device driver.
+*
+* The pin program of the configuration node is applied, compiling the node
+* first if it is not in the program cache.
+*
+* RETURNS: OK if state enabled, ERROR if the device or offset is invalid, or the
+* configuration fails.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS vxbFdtRzg2PfcPinMuxEnable
+    (
+    VXB_DEV_ID  pDev,   /* VxBus device instance */
+    INT32       offset  /* FDT configuration node */
+    )
+    {
+    PFC_PINMUX_DRVCTRL *    pPfc;           /* pin mux controller instance */
+    PFC_PIN_PROG *          pProg;          /* compiled configuration node */
+
+    if ((pDev == NULL) || (offset <= 0))
+        {
+        return ERROR;
+        }
+
+    RZG2_DBG_MSG (PFC_DBG_INFO, "%s offset %d\n", __FUNCTION__, offset);
+
+    pPfc = (PFC_PINMUX_DRVCTRL *)vxbDevSoftcGet (pDev);
+
+    /*
+     * The program holds the changes of the node and its subnodes, and is
+     * applied in one transaction, so each register is written at most once.
+     * Nothing is written if the node cannot be compiled.
+     */
+
+    pProg = rzg2PfcProgGet (pPfc, (int)offset);
+    if (pProg == NULL)
+        {
+        return ERROR;
+        }
+
+#ifdef RZG2_PFC_DBG
+    if (pPfc->bootApplied && !pProg->savedValid)
+        {
+        rzg2PfcBootProgVerify (pPfc, pProg);
+        }
+#endif  /* RZG2_PFC_DBG */
+
+    rzg2PfcXactBegin (pPfc);
+    rzg2PfcProgApply (pPfc, pProg, FALSE);
+    rzg2PfcXactEnd (pPfc, TRUE);
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* vxbFdtRzg2PfcPinMuxDisable - disable pin mux configuration
+*
+* The vxbPinMuxDisable method disables pin mux configuration in the hardware.
+* The register fields set when the configuration node at <offset> was last
+* enabled are restored to the values they had before.
+*
+* RETURNS: OK if state disabled, ERROR if the device or offset is invalid, or the
+* node has not been compiled or is not enabled.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS vxbFdtRzg2PfcPinMuxDisable
+    (
+    VXB_DEV_ID  pDev,   /* VxBus device instance */
+    INT32       offset  /* FDT configuration node */
+    )
+    {
+    PFC_PINMUX_DRVCTRL *    pPfc;           /* pin mux controller instance */
+    PFC_PIN_PROG *          pProg;          /* compiled configuration node */
+
+    if ((pDev == NULL) || (offset <= 0))
+        {
+        return ERROR;
+        }
+
+    pPfc = (PFC_PINMUX_DRVCTRL *)vxbDevSoftcGet (pDev);
+
+    /*
+     * The program cache is searched inside the transaction, as another task
+     * may be adding a program to it.
+     */
+
+    rzg2PfcXactBegin (pPfc);
+
+    pProg = rzg2PfcProgFind (pPfc, (int)offset);
+    if ((pProg == NULL) || !pProg->savedValid)
+        {
+        rzg2PfcXactEnd (pPfc, FALSE);
+        return ERROR;
+        }
+
+    rzg2PfcProgApply (pPfc, pProg, TRUE);
+    rzg2PfcXactEnd (pPfc, TRUE);
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcClientPinsRelease - release the pins of all states of a pin mux client
+*
+* This function releases the GPSR pins owned by the compiled configuration nodes
+* of each "pinmux-N" property of the client node at <clientOffset>. The caller
+* must hold the PFC mutex.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2PfcClientPinsRelease
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,           /* pin mux controller instance */
+    int                     clientOffset    /* FDT client node */
+    )
+    {
+    char                    propName [PFC_FDT_PINMUX_LEN];
+    const UINT32 *          pPhandles;
+    PFC_PIN_PROG *          pProg;
+    PFC_PIN_STEP *          pStep;
+    int                     propLen;
+    int                     state;
+    int                     i;
+    UINT32                  j;
+
+    for (state = 0; ; state++)
+        {
+        (void)snprintf (propName, sizeof (propName), "pinmux-%d", state);
+
+        pPhandles = (const UINT32 *) vxFdtPropGet (clientOffset, propName,
+                                                   &propLen);
+        if (pPhandles == NULL)
+            {
+            break;
+            }
+
+        for (i = 0; i < (propLen / (int) sizeof (UINT32)); i++)
+            {
+            pProg = rzg2PfcProgFind (pPfc, vxFdtNodeOffsetByPhandle (
+                                           vxFdt32ToCpu (pPhandles [i])));
+            if (pProg == NULL)
+                {
+                continue;
+                }
+
+            for (j = 0U; j < pProg->numSteps; j++)
+                {
+                pStep = &pProg->pSteps [j];
+                if ((pStep->offset >= PFC_GPSR (0)) &&
+                    (pStep->offset < PFC_GPSR (NUM_GPSR_REGS)))
+                    {
+                    rzg2PfcPinsRelease (pPfc,
+                                        (pStep->offset - PFC_GPSR (0)) / 4U,
+                                        pStep->mask, pProg->nodeOffset);
+                    }
+                }
+            }
+        }
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcPinStateSet - switch a pin mux client to a named pin state
+*
+* This routine switches the pins of the pin mux client <pDev> to the state named
+* <pName>. The Nth name in the client's "pinmux-names" property selects the
+* configuration nodes of its "pinmux-N" property. A client without
+* "pinmux-names" has only the "default" state, "pinmux-0".
+*
+* The pin programs of all the nodes of the state are applied in one transaction,
+* so each PFC register is written at most once. If any node cannot be compiled,
+* no register is written.
+*
+* RETURNS: OK if the state is set, ERROR if the PFC is not attached, or the
+* state is unknown or has too many, or invalid, configuration nodes.
+*
+* ERRNO: N/A.
+*/
+
+STATUS rzg2PfcPinStateSet
+    (
+    VXB_DEV_ID      pDev,       /* pin mux client */
+    const char *    pName       /* pin state name */
+    )
+    {
+    PFC_PINMUX_DRVCTRL *    pPfc = pRzg2Pfc;
+    PFC_PIN_PROG *          progs [PFC_STATE_NODES_MAX];
+    VXB_FDT_DEV *           pFdtDev;
+    char                    propName [PFC_FDT_PINMUX_LEN];
+    const char *            pNames;
+    const UINT32 *          pPhandles;
+    int                     propLen;
+    int                     pos;
+    int                     state = -1;
+    int                     numNodes;
+    int                     i;
+
+    if ((pPfc == NULL) || (pDev == NULL) || (pName == NULL))
+        {
+        return ERROR;
+        }
+
+    pFdtDev = vxbFdtDevGet (pDev);
+    if (pFdtDev == NULL)
+        {
+        return ERROR;
+        }
+
+    /* find the state number from its name */
+
+    pNames = (const char *) vxFdtPropGet (pFdtDev->offset, PFC_FDT_PINMUX_NAMES,
+                                          &propLen);
+    if (pNames == NULL)
+        {
+        if (strcmp (pName, PFC_FDT_STATE_DEFAULT) == 0)
+            {
+            state = 0;
+            }
+        }
+    else
+        {
+        for (pos = 0, i = 0; pos < propLen; i++)
+            {
+            if (strncmp (&pNames [pos], pName, (size_t) (propLen - pos)) == 0)
+                {
+                state = i;
+                break;
+                }
+            pos += (int) (strlen (&pNames [pos]) + 1);
+            }
+        }
+
+    if (state < 0)
+        {
+        RZG2_DBG_MSG (PFC_DBG_ERR, "unknown pin state %s\n", pName);
+        return ERROR;
+        }
+
+    /* find the pin programs of the configuration nodes of the state */
+
+    (void)snprintf (propName, sizeof (propName), "pinmux-%d", state);
+
+    pPhandles = (const UINT32 *) vxFdtPropGet (pFdtDev->offset, propName,
+                                               &propLen);
+    if (pPhandles == NULL)
+        {
+        return ERROR;
+        }
+
+    numNodes = propLen / (int) sizeof (UINT32);
+    if (numNodes > PFC_STATE_NODES_MAX)
+        {
+        return ERROR;
+        }
+
+    for (i = 0; i < numNodes; i++)
+        {
+        progs [i] = rzg2PfcProgGet (pPfc, vxFdtNodeOffsetByPhandle (
+                                          vxFdt32ToCpu (pPhandles [i])));
+        if (progs [i] == NULL)
+            {
+            return ERROR;
+            }
+        }
+
+    /*
+     * Write the state in one transaction. The pins of the client's other
+     * states are released first, as switching between them is not a conflict.
+     */
+
+    rzg2PfcXactBegin (pPfc);
+
+    rzg2PfcClientPinsRelease (pPfc, pFdtDev->offset);
+
+    for (i = 0; i < numNodes; i++)
+        {
+        rzg2PfcProgApply (pPfc, progs [i], FALSE);
+        }
+
+    rzg2PfcXactEnd (pPfc, TRUE);
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcRegSnapTake - read the PFC registers into a snapshot
+*
+* This function reads each PFC register decoded by the show and export routines
+* once, under the PFC mutex, into <pSnap>.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2PfcRegSnapTake
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    PFC_REG_SNAP *          pSnap       /* returned register snapshot */
+    )
+    {
+    UINT32                  i;
+
+    (void)semTake (pPfc->mutex, WAIT_FOREVER);
+
+    for (i = 0U; i < NUM_GPSR_REGS; i++)
+        {
+        pSnap->gpsr [i] = rzg2PfcRegRead (pPfc, PFC_GPSR (i));
+        }
+
+    for (i = 0U; i < NUM_IPSR_REGS; i++)
+        {
+        pSnap->ipsr [i] = rzg2PfcRegRead (pPfc, PFC_IPSR (i));
+        }
+
+    for (i = 0U; i < NUM_MOD_SEL_REGS; i++)
+        {
+        pSnap->modSel [i] = rzg2PfcRegRead (pPfc, PFC_MOD_SEL (i));
+        }
+
+    for (i = 0U; i < NUM_DRVTRL_REGS; i++)
+        {
+        pSnap->drvCtrl [i] = rzg2PfcRegRead (pPfc, PFC_DRVCTRL (i));
+        }
+
+    for (i = 0U; i < NUM_PUEN_REGS; i++)
+        {
+        pSnap->puen [i] = rzg2PfcRegRead (pPfc, PFC_PUEN (i));
+        pSnap->pud [i] = rzg2PfcRegRead (pPfc, PFC_PUD (i));
+        }
+
+    pSnap->pocCtrl = rzg2PfcRegRead (pPfc, PFC_POCCTRL);
+
+    (void)semGive (pPfc->mutex);
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcCtxSave - save the PFC registers for system suspend
+*
+* This function is the PFC system suspend hook. It saves the pin function,
+* module selection, drive, bias and POC registers in the driver data, so that
+* rzg2PfcCtxRestore() can restore them on resume.
+*
+* RETURNS: OK.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2PfcCtxSave
+    (
+    void *  pArg        /* pin mux controller instance */
+    )
+    {
+    PFC_PINMUX_DRVCTRL *    pPfc = (PFC_PINMUX_DRVCTRL *) pArg;
+
+    rzg2PfcRegSnapTake (pPfc, &pPfc->ctxSnap);
+    pPfc->ctxValid = TRUE;
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcCtxRestore - restore the PFC registers on resume from system suspend
+*
+* This function is the PFC system resume hook. It restores the registers saved
+* by rzg2PfcCtxSave() as one transaction, so only the registers that differ
+* from the saved values are written, each with one PMMR unlock, and pins whose
+* function changes are held in GPIO mode while their selections are written.
+* The POC fields are then restored with rzg2PfcPocVoltageSet(), so that the
+* pad supply hook is called as for any other voltage switch.
+*
+* RETURNS: OK, or ERROR if no context is saved or a voltage switch fails.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2PfcCtxRestore
+    (
+    void *  pArg        /* pin mux controller instance */
+    )
+    {
+    PFC_PINMUX_DRVCTRL *    pPfc = (PFC_PINMUX_DRVCTRL *) pArg;
+    const PFC_REG_SNAP *    pSnap = &pPfc->ctxSnap;
+    const PFC_POC_DESC *    pPocCtrl;
+    STATUS                  status = OK;
+    UINT32                  mv;
+    UINT32                  i;
+
+    if (!pPfc->ctxValid)
+        {
+        return ERROR;
+        }
+
+    rzg2PfcXactBegin (pPfc);
+
+    for (i = 0U; i < NUM_GPSR_REGS; i++)
+        {
+        rzg2PfcRegMaskAndSet (pPfc, PFC_GPSR (i), 0xFFFFFFFFU, pSnap->gpsr [i]);
+        }
+
+    for (i = 0U; i < NUM_IPSR_REGS; i++)
+        {
+        rzg2PfcRegMaskAndSet (pPfc, PFC_IPSR (i), 0xFFFFFFFFU, pSnap->ipsr [i]);
+        }
+
+    for (i = 0U; i < NUM_MOD_SEL_REGS; i++)
+        {
+        rzg2PfcRegMaskAndSet (pPfc, PFC_MOD_SEL (i), 0xFFFFFFFFU,
+                              pSnap->modSel [i]);
+        }
+
+    for (i = 0U; i < NUM_DRVTRL_REGS; i++)
+        {
+        rzg2PfcRegMaskAndSet (pPfc, PFC_DRVCTRL (i), 0xFFFFFFFFU,
+                              pSnap->drvCtrl [i]);
+        }
+
+    for (i = 0U; i < NUM_PUEN_REGS; i++)
+        {
+        rzg2PfcRegMaskAndSet (pPfc, PFC_PUEN (i), 0xFFFFFFFFU, pSnap->puen [i]);
+        rzg2PfcRegMaskAndSet (pPfc, PFC_PUD (i), 0xFFFFFFFFU, pSnap->pud [i]);
+        }
+
+    rzg2PfcXactEnd (pPfc, TRUE);
+
+    for (pPocCtrl = &pfcPocSel [0]; pPocCtrl->funcId != FN_NONE; pPocCtrl++)
+        {
+        mv = ((pSnap->pocCtrl & POC_MASK (pPocCtrl->pocMask)) == 0U) ?
+             PFC_POC_MV_1V8 : PFC_POC_MV_3V3;
+
+        if ((rzg2PfcPocVoltageGet (pPocCtrl->pocMask) != mv) &&
+            (rzg2PfcPocVoltageSet (pPocCtrl->pocMask, mv) != OK))
+            {
+            status = ERROR;
+            }
+        }
+
+    return status;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcSnapFuncMatch - check if a snapshot selects a function for a group
+*
+* This function checks that all the IPSR and MOD_SEL fields of pin group
+* <groupId> for function <funcId> hold the function's values in <pSnap>. The
+* MOD_SEL variant of the group, 'A' for value 0, is returned in <pVariant>, or
+* '-' if the group has no module selection.
+*
+* RETURNS: TRUE if the function is selected, otherwise FALSE.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL BOOL rzg2PfcSnapFuncMatch
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    const PFC_FUNC_DESC *   pFuncSel,   /* function selection table */
+    const PFC_REG_SNAP *    pSnap,      /* register snapshot */
+    UINT32                  groupId,    /* pin group */
+    PFC_FUNC_ID             funcId,     /* function ID */
+    char *                  pVariant    /* returned MOD_SEL variant */
+    )
+    {
+    const PFC_FUNC_DESC *   pFunc;
+    const PFC_MOD_DESC *    pMod;
+    UINT32                  field;
+    UINT32                  i;
+
+    *pVariant = '-';
+
+    for (i = pPfc->pFuncFirst [groupId]; i < pPfc->pFuncFirst [groupId + 1];
+         i++)
+        {
+        pFunc = &pFuncSel [pPfc->pFuncOrder [i]];
+        if (pFunc->funcId != funcId)
+            {
+            continue;
+            }
+
+        field = (pSnap->ipsr [IPSR_REG (pFunc->ipsrMask)] >>
+                 IPSR_SHIFT (pFunc->ipsrMask)) & 0x0FU;
+        if (field != pFunc->ipsrVal)
+            {
+            return FALSE;
+            }
+        }
+
+    for (i = pPfc->pModFirst [groupId]; i < pPfc->pModFirst [groupId + 1]; i++)
+        {
+        pMod = &pfcModuleSel [pPfc->pModOrder [i]];
+        if (pMod->funcId != funcId)
+            {
+            continue;
+            }
+
+        field = (pSnap->modSel [MOD_SEL_REG (pMod->modSelMask)] >>
+                 MOD_SEL_SHIFT (pMod->modSelMask)) &
+                MOD_SEL_BITMASK (pMod->modSelMask);
+        if (field != pMod->modSelVal)
+            {
+            return FALSE;
+            }
+
+        *pVariant = (char) ('A' + pMod->modSelVal);
+        }
+
+    return TRUE;
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcPinStateDecode - decode the state of a pin from a snapshot
+*
+* This function decodes into <pState> the state of pin <pPin> in register
+* snapshot <pSnap>. The function of a pin in peripheral mode is the first
+* function of the pin's groups whose IPSR and MOD_SEL fields all match. The POC
+* voltage is decoded for the pins of the POC pad groups.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2PfcPinStateDecode
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    const PFC_FUNC_DESC *   pFuncSel,   /* function selection table */
+    const PFC_REG_SNAP *    pSnap,      /* register snapshot */
+    const PFC_PIN_DESC *    pPin,       /* pin descriptor */
+    PFC_PIN_STATE *         pState      /* returned pin state */
+    )
+    {
+    const PFC_POC_DESC *    pPocCtrl;
+    UINT64                  groups = pfcPinGroups [pPin - &pfcPins [0]];
+    PFC_FUNC_ID             funcId;
+    UINT32                  groupId;
+    UINT32                  field;
+    UINT32                  mask;
+    UINT32                  i;
+
+    pState->funcName = "-";
+    pState->variant = '-';
+    pState->drvEighths = 0U;
+    pState->pocMv = 0U;
+
+    /* GPSR mode; pins without a GPSR bit have a fixed function */
+
+    if (pPin->gpsrRegBit == GPSR_NONE)
+        {
+        pState->mode = "fixed";
+        }
+    else if ((pSnap->gpsr [GPSR_REG (pPin->gpsrRegBit)] &
+              GPSR_MASK (pPin->gpsrRegBit)) == GPSR_GPIO)
+        {
+        pState->mode = "gpio";
+        }
+    else
+        {
+        pState->mode = "periph";
+        }
+
+    /* function and MOD_SEL variant of a pin in peripheral mode */
+
+    for (groupId = 1U; (groupId < GRP_COUNT) && (pState->mode[0] == 'p');
+         groupId++)
+        {
+        if ((groups & ((UINT64) 1 << groupId)) == 0U)
+            {
+            continue;
+            }
+
+        for (i = 0U; i < PFC_NUM_FUNCS; i++)
+            {
+            funcId = pfcFuncs [i].funcId;
+            if (rzg2PfcGroupFuncHas (pPfc, pFuncSel, groupId, funcId) &&
+                rzg2PfcSnapFuncMatch (pPfc, pFuncSel, pSnap, groupId, funcId,
+                                      &pState->variant))
+                {
+                pState->funcName = pfcFuncs [i].funcName;
+                break;
+                }
+            }
+
+        if (i < PFC_NUM_FUNCS)
+            {
+            break;
+            }
+        }
+
+    /* drive strength; 2-bit fields are in quarters */
+
+    if (pPin->drvMask != 0U)
+        {
+        mask = DRVCTRL_BITMASK (pPin->drvMask);
+        field = (pSnap->drvCtrl [DRVCTRL_REG (pPin->drvMask)] >>
+                 DRVCTRL_SHIFT (pPin->drvMask)) & mask;
+        pState->drvEighths = ((field + 1U) * 8U) / (mask + 1U);
+        }
+
+    /* pull */
+
+    if ((pSnap->puen [PU_REG (pPin->puRegBit)] & PU_MASK (pPin->puRegBit)) ==
+        PUEN_DIS)
+        {
+        pState->pull = PIN_PU_DISABLED;
+        }
+    else if ((pSnap->pud [PU_REG (pPin->puRegBit)] &
+              PU_MASK (pPin->puRegBit)) == PUD_DOWN)
+        {
+        pState->pull = PIN_PU_PULL_DOWN;
+        }
+    else
+        {
+        pState->pull = PIN_PU_PULL_UP;
+        }
+
+    /* POC voltage of the POC controlled pads */
+
+    for (pPocCtrl = &pfcPocSel [0]; pPocCtrl->funcId != FN_NONE; pPocCtrl++)
+        {
+        if ((groups & ((UINT64) 1 << pPocCtrl->padGroup)) != 0U)
+            {
+            field = pSnap->pocCtrl & POC_MASK (pPocCtrl->pocMask);
+            pState->pocMv = (field == 0U) ? PFC_POC_MV_1V8 : PFC_POC_MV_3V3;
+            break;
+            }
+        }
+    }
+
+/*******************************************************************************
+*
+* rzg2PfcPinConfShow - print verbose pin configuration information
+*
+* This function prints the decoded state of the supported pins in <pSnap>.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void rzg2PfcPinConfShow
+    (
+    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
+    const PFC_REG_SNAP *    pSnap       /* register snapshot */
+    )
+    {
+    const PFC_FUNC_DESC *   pFuncSel;
+    const PFC_PIN_DESC *    pPin;
+    PFC_PIN_STATE           state;
+
+    pFuncSel = pPfc->pFuncSel;
+
+    printf ("\n  %-15s %-6s %-10s %-3s %-5s %-13s %s\n", "pin", "mode",
+            "function", "sel", "drive", "pull", "POC");
+
+    for (pPin = &pfcPins [0]; !PFC_PIN_DESC_TBL_END (pPin); pPin++)
+        {
+        rzg2PfcPinStateDecode (pPfc, pFuncSel, pSnap, pPin, &state);
+
+        printf ("  %-15s %-6s %-10s %-3c %u/8   %-13s ", pPin->sipName,
+                state.mode, state.funcName, state.variant, state.drvEighths,
+                pfcPinPullStateStr [state.pull]);
+
+        if (state.pocMv != 0U)
+            {
+            printf ("%umV\n", state.pocMv);
+            }
+        else
+            {
+            printf ("-\n");
+            }
+        }
+    }
+
+/*******************************************************************************
+*
+* vxbFdtRzg2PfcPinMuxShow - print pin mux information
+*
+* The vxbPinMuxShow method prints specific information on the console provided
+* by the pin mux controller driver. This method is optional for a pin mux
+* controller device driver.
+*
+* This function prints PFC pin mux information. Basic, non-verbose, output is a
+* dump of PFC registers. In verbose mode additional information is shown for
+* supported pins.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void vxbFdtRzg2PfcPinMuxShow
+    (
+    VXB_DEV_ID  pDev,       /* VxBus device instance */
+    INT32       verbose     /* uses 0 for basic output */
+    )
+    {
+    PFC_PINMUX_DRVCTRL *    pPfc;
+    PFC_REG_SNAP            snap;
+    UINT                    regIndex;
+
+    if (pDev == NULL)
+        {
+        RZG2_DBG_MSG (PFC_DBG_ERR, "Invalid VxBus device instance\n");
+        return;
+        }
+
+    pPfc = (PFC_PINMUX_DRVCTRL *)vxbDevSoftcGet (pDev);
+
+    rzg2PfcRegSnapTake (pPfc, &snap);
+
+    printf ("\nRegister writes: %u, %u skipped as already set\n",
+            pPfc->regWrites, pPfc->regSkips);
+
+    printf ("\nGPIO/Peripheral Function Select Registers\n");
+    for (regIndex = 0; regIndex < NUM_GPSR_REGS; regIndex++)
+        {
+        printf ("GPSR%-2d: 0x%08X\n",
+                regIndex, snap.gpsr [regIndex]);
+        }
+
+    printf ("\nPeripheral Function Select Registers\n");
+    for (regIndex = 0; regIndex < NUM_IPSR_REGS; regIndex++)
+        {
+        printf ("IPSR%-2d: 0x%08X\n",
+                regIndex, snap.ipsr [regIndex]);
+        }
+
+    printf ("\nDRV Control Registers\n");
+    for (regIndex = 0; regIndex < NUM_DRVTRL_REGS; regIndex++)
+        {
+        printf ("DRVCTRL%-2d: 0x%08X\n",
+                regIndex, snap.drvCtrl [regIndex]);
+        }
+
+    printf ("\nPOC Control Register\n");
+    printf ("POCCTRL: 0x%08X\n", snap.pocCtrl);
+    printf ("POC switches: %u, last %llu ticks, max %llu ticks at %u Hz\n",
+            pPfc->pocSwitches, pPfc->pocLastTicks, pPfc->pocMaxTicks,
+            rzg2TimestampFreqGet ());
+
+    printf ("\nTDSEL Control Register\n");
+    printf ("TDSELCTRL: 0x%08X\n", rzg2PfcRegRead (pPfc, PFC_TDSELCTRL));
+
+    printf ("\nIO Cell Control for IICDVFS\n");
+    printf ("IOCTRL: 0x%08X\n", rzg2PfcRegRead (pPfc, PFC_IOCTRL));
+
+    printf ("\nFuse Monitor Register\n");
+    printf ("FUSEMON: 0x%08X\n", rzg2PfcRegRead (pPfc, PFC_FUSEMON));
+
+    printf ("\nLSI Pin Pull-Enable Registers\n");
+    for (regIndex = 0; regIndex < NUM_PUEN_REGS; regIndex++)
+        {
+        printf ("PUEN%d: 0x%08X\n",
+                regIndex, snap.puen [regIndex]);
+        }
+
+    printf ("\nLSI Pin Pull-Up/Down Control Registers\n");
+    for (regIndex = 0; regIndex < NUM_PUD_REGS; regIndex++)
+        {
+        printf ("PUD%d: 0x%08X\n",
+                regIndex, snap.pud [regIndex]);
+        }
+
+    printf ("\nModule Select Registers\n");
+    for (regIndex = 0; regIndex < NUM_MOD_SEL_REGS; regIndex++)
+        {
+        printf ("MOD_SEL%d: 0x%08X\n",
+                regIndex, snap.modSel [regIndex]);
+        }
+
+    if (verbose != 0)
+        {
+        printf ("\nPin programs cached: %u\n", pPfc->numProgs);
+        rzg2PfcPinConfShow (pPfc, &snap);
+        }
+
+    }
+
+/*******************************************************************************
+*
+* vxbFdtRzg2PfcPinMuxProbe - probe to match PFC pin mux driver to a device
+*
+* Check for Renesas RZ/G2 PFC (or compatible) device in the FDT.
+*
+* RETURNS: OK if probe passes and assumed a valid (or compatible) device, ERROR
+* otherwise.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS vxbFdtRzg2PfcPinMuxProbe
+    (
+    VXB_DEV_ID pDev        /* VxBus device instance */
+    )
+    {
+    VXB_FDT_DEV_MATCH_ENTRY * pMatch;
+
+    if (vxbFdtDevMatch (pDev, vxbFdtPfcPinMuxMatch, &pMatch) == ERROR)
+        {
+        return ERROR;
+        }
+
+    vxbDevDrvDataSet (pDev, (void *) pMatch->data);
+    return OK;
+    }
+
+/******************************************************************************
+*
+* vxbFdtRzg2PfcPinMuxAttach - attach PFC device
+*
+* This is the Renesas RZ/G2 Pin Function Controller (PFC) initialisation
+* function.
+*
+* RETURNS: OK if driver attached, ERROR if the device is invalid, or resources
+* cannot be allocated.
+*
+* ERRNO: N/A
+*/
+
+LOCAL STATUS vxbFdtRzg2PfcPinMuxAttach
+    (
+    VXB_DEV_ID pDev                         /* VxBus device instance */
+    )
+    {
+    PFC_PINMUX_DRVCTRL *    pPfc;           /* PFC driver control data */
+    VXB_RESOURCE_ADR *      pResAdr;        /* device registers */
+    VXB_PINMUX_CTRL *       pPinMuxCtrl;    /* vxbPinMuxLib control data */
+    VXB_FDT_DEV *           pFdtDev;        /* FDT device */
+
+    /* check for valid parameter */
+
+    if (pDev == NULL)
+        {
+        return ERROR;
+        }
+
+    /* check the generated tables before any pin configuration is looked up */
+
+    if (rzg2PfcTablesCheck () == ERROR)
+        {
+        return ERROR;
+        }
+
+    /* allocate the memory for the PFC driver control */
+
+    pPfc = (PFC_PINMUX_DRVCTRL *)vxbMemAlloc (sizeof(PFC_PINMUX_DRVCTRL));
+    if (pPfc == NULL)
+        {
+        RZG2_DBG_MSG (PFC_DBG_ERR, "vxbMemAlloc error\n");
+        return ERROR;
+        }
+
+    /* dynamically allocate and initialise mutual-exclusion semaphore */
+
+    pPfc->mutex = semMCreate (SEM_Q_PRIORITY | SEM_DELETE_SAFE |
+                              SEM_INVERSION_SAFE);
+    if (pPfc->mutex == SEM_ID_NULL)
+        {
+        RZG2_DBG_MSG (PFC_DBG_ERR, "semMCreate error\n");
+        goto errOut;
+        }
+
+    SPIN_LOCK_ISR_INIT (&pPfc->regLock, 0);
+
+    /* allocate register memory resource */
+
+    pPfc->memRes = vxbResourceAlloc (pDev, VXB_RES_MEMORY, 0);
+    if (pPfc->memRes == NULL)
+        {
+        RZG2_DBG_MSG (PFC_DBG_ERR, "vxbResourceAlloc(MEMORY) error\n");
+        goto errOut;
+        }
+
+    /* extract register virtual address and resource handle */
+
+    pResAdr = (VXB_RESOURCE_ADR *)pPfc->memRes->pRes;
+    if (pResAdr == NULL)
+        {
+        RZG2_DBG_MSG (PFC_DBG_ERR, "virtual address error\n");
+        goto errOut;
+        }
+    pPfc->regBase = (VIRT_ADDR)pResAdr->virtual;
+    pPfc->pHandle = pResAdr->pHandle;
+
+    /*
+     * Keep the function selection table of this SoC. The configuration nodes
+     * are compiled below, before the pin mux controller is created.
+     */
+
+    pPfc->pFuncSel = (const PFC_FUNC_DESC *) vxbDevDrvDataGet (pDev);
+
+    /* index the function and module selection tables by pin group */
+
+    if (rzg2PfcGroupIndexesCreate (pPfc, pPfc->pFuncSel) == ERROR)
+        {
+        RZG2_DBG_MSG (PFC_DBG_ERR, "group index error\n");
+        goto errOut;
+        }
+
+    /* compile the configuration nodes into pin programs */
+
+    pFdtDev = vxbFdtDevGet (pDev);
+    if (pFdtDev == NULL)
+        {
+        goto errOut;
+        }
+
+    /*
+     * If the BSP provides a boot program, write it, and leave the nodes to be
+     * compiled when they are enabled.
+     */
+
+    if (pRzg2PfcBootWrites != NULL)
+        {
+        rzg2PfcBootProgApply (pPfc);
+        }
+    else
+        {
+        rzg2PfcProgsCreate (pPfc, pFdtDev->offset);
+        }
+
+    /* allocate pin mux library representation of a pin mux controller */
+
+    pPinMuxCtrl = (VXB_PINMUX_CTRL *) vxbMemAlloc (sizeof (VXB_PINMUX_CTRL));
+    if (pPinMuxCtrl == NULL)
+        {
+        goto errOut;
+        }
+
+    /* save references between VxBus device and pin mux controller */
+
+    pPinMuxCtrl->pDev = pDev;
+    pPfc->pPinMuxCtrl = pPinMuxCtrl;
+    vxbDevSoftcSet (pDev, (void *)pPfc);
+
+    /* register the PFC pin mux driver */
+
+    if (vxbPinMuxRegister (pPinMuxCtrl) == ERROR)
+        {
+        goto errOut;
+        }
+
+    /* enable default pin mux configuration if it exists */
+
+    if (vxbPinMuxEnable (pDev) == ERROR)
+        {
+        goto errOut;
+        }
+
+    pRzg2Pfc = pPfc;
+
+    /* save and restore the pin configuration over system suspend */
+
+    if (rzg2SuspendHookAdd (rzg2PfcCtxSave, rzg2PfcCtxRestore,
+                            (void *) pPfc) == ERROR)
+        {
+        RZG2_DBG_MSG (PFC_DBG_ERR, "rzg2SuspendHookAdd error\n");
+        }
+
+    RZG2_DBG_MSG (PFC_DBG_INFO, "vxbFdtRzg2PfcPinMuxAttach OK\n");
+
+    return OK;
+
+errOut:
+
+    RZG2_DBG_MSG (PFC_DBG_ERR, "vxbFdtRzg2PfcPinMuxAttach ERROR\n");
+
+    /* free PFC resources */
+
+    (void)vxbResourceFree (pDev, pPfc->memRes);
+    vxbMemFree (pPfc->pPinMuxCtrl);
+    rzg2PfcGroupIndexesDelete (pPfc);
+    rzg2PfcProgsDelete (pPfc);
+    (void)semDelete (pPfc->mutex);
+    vxbDevSoftcSet (pDev, NULL);
+    vxbMemFree (pPfc);
+
+    return ERROR;
+    }
+
+/*******************************************************************************
+*
+* vxbFdtRzg2PfcPinMuxShutdown - shutdown PFC device
+*
+* Turn off the hardware and put it into a quiescent state.
+*
+* RETURNS: OK.
+
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS vxbFdtRzg2PfcPinMuxShutdown
+    (
+    VXB_DEV_ID pDev     /* VxBus device instance */
+    )
+    {
+    /*
+     * All PFC pin mux states are under the control of their respective
+     * drivers, so there's nothing to do here.
+     */
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* vxbFdtRzg2PfcPinMuxDetach - detach PFC device
+*
+* This function implements the VxBus driver detach method for the PFC pin mux
+* driver. The pin mux controller is unregistered and allocated resources are
+* freed.
+*
+* RETURNS: OK if driver detached, ERROR if device is invalid.
+
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS vxbFdtRzg2PfcPinMuxDetach
+    (
+    VXB_DEV_ID pDev     /* VxBus device instance */
+    )
+    {
+    PFC_PINMUX_DRVCTRL *    pPfc;
+    STATUS                  retVal;
+
+    if (pDev == NULL)
+        {
+        return ERROR;
+        }
 
-        /* configure the pin with the handler */
+    pPfc = (PFC_PINMUX_DRVCTRL *)vxbDevSoftcGet (pDev);
 
-        if (handler (pPfc, pPin, pProp, propLen) == ERROR)
-            {
-            return ERROR;
-            }
+    retVal = vxbPinMuxUnregister (pPfc->pPinMuxCtrl);
 
-        /* potentially move onto the next pin in the "pins" stringList */
+    if (retVal == OK)
+        {
+        /* free PFC resources */
 
-        stringLen = (int) (strlen (pPinsProp) + 1);
-        pinsPropLen  -= stringLen;
-        pPinsProp += stringLen;
+        (void)vxbResourceFree (pDev, pPfc->memRes);
+        vxbMemFree (pPfc->pPinMuxCtrl);
+        rzg2PfcGroupIndexesDelete (pPfc);
+        rzg2PfcProgsDelete (pPfc);
+        (void)semDelete (pPfc->mutex);
+        pRzg2Pfc = NULL;
+        vxbDevSoftcSet (pDev, NULL);
+        vxbMemFree (pPfc);
         }
 
-    return OK;
+    return retVal;
     }
 
 /*******************************************************************************
 *
-* rzg2PfcIpsrGroupFuncSet - set the IPSR for a pin group
+* rzg2PfcLockStatsShow - show the PFC register lock statistics
 *
-* This function sets the Peripheral Function Select Register (IPSR) to the
-* requested function for all pins in the provided group.
+* This routine displays the PFC mutex statistics: for transactions, from
+* rzg2PfcXactBegin() to rzg2PfcXactEnd(), as taken to apply a pin mux state or
+* a profile, and for each class of register changed through
+* rzg2PfcRegMaskAndSet(). For each class it shows the number of times the mutex
+* was taken, how many of those found it held by another task, and the average
+* and maximum wait and hold times in generic timer ticks. A register change
+* inside a transaction takes the mutex again, so it is never contended and its
+* hold time is part of the transaction's. The statistics are only recorded if
+* the driver is built with RZG2_LOCK_STATS defined.
 *
-* RETURNS: OK if set successfully or nothing to do, ERROR if pin controller is
-* invalid.
+* RETURNS: N/A.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS rzg2PfcIpsrGroupFuncSet
-    (
-    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
-    PFC_GROUP_ID            groupId,    /* pin group */
-    PFC_FUNC_ID             funcId      /* function to set */
-    )
+void rzg2PfcLockStatsShow (void)
     {
-    PFC_FUNC_DESC *         pFunc;
+#ifdef RZG2_LOCK_STATS
+    PFC_PINMUX_DRVCTRL *    pPfc = pRzg2Pfc;
+    RZG2_LOCK_STAT          stats [PFC_LOCK_CLASSES];
+    UINT32                  i;
 
     if (pPfc == NULL)
         {
-        return ERROR;
+        printf ("PFC not available\n");
+        return;
         }
 
+    (void)semTake (pPfc->mutex, WAIT_FOREVER);
+    (void)memcpy (stats, pPfc->lockStats, sizeof (stats));
+    (void)semGive (pPfc->mutex);
 
-    /* process all group/function pairs in the function selection table */
-
-    pFunc = (PFC_FUNC_DESC *) vxbDevDrvDataGet(pPfc->pPinMuxCtrl->pDev);
+    printf ("ticks at %u Hz\n", rzg2TimestampFreqGet ());
+    printf ("%-14s %10s %10s %10s %10s %10s %10s\n", "register", "takes",
+            "contended", "wait avg", "wait max", "hold avg", "hold max");
 
-    while (pFunc->groupId != GRP_NONE)
+    for (i = 0U; i < PFC_LOCK_CLASSES; i++)
         {
-        if ((pFunc->groupId == groupId) && (pFunc->funcId == funcId))
-            {
-            rzg2PfcRegMaskAndSet (pPfc, PFC_IPSR (IPSR_REG (pFunc->ipsrMask)),
-                                  IPSR_MASK (pFunc->ipsrMask),
-                                  ((UINT32) pFunc->ipsrVal <<
-                                  (IPSR_SHIFT(pFunc->ipsrMask))));
-            }
-        pFunc++;
+        rzg2LockStatsShow (pfcLockClassName [i], &stats [i]);
         }
-
-    return OK;
+#else
+    printf ("PFC lock statistics not enabled, build with RZG2_LOCK_STATS\n");
+#endif /* RZG2_LOCK_STATS */
     }
 
 /*******************************************************************************
 *
-* rzg2PfcModSelGroupFuncSet - set the module selection for a pin group
+* rzg2PfcPinOwnerShow - show the owners of the PFC pins
 *
-* This function sets the Module Selection Register (MOD_SEL) to the
-* requested selection for all pins in the provided group.
+* This routine lists each GPSR pin that is owned by an enabled configuration
+* node, with the node name, followed by the pin conflicts recorded since the PFC
+* was attached.
 *
-* RETURNS: OK if set successfully, or nothing to do, ERROR if pin controller is
-* invalid.
+* RETURNS: N/A.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS rzg2PfcModSelGroupFuncSet
-    (
-    PFC_PINMUX_DRVCTRL *    pPfc,       /* pin mux controller instance */
-    PFC_GROUP_ID            groupId,    /* pin group */
-    PFC_FUNC_ID             funcId      /* function to set */
-    )
+void rzg2PfcPinOwnerShow (void)
     {
-    PFC_MOD_DESC *          pModSel;
+    PFC_PINMUX_DRVCTRL *    pPfc = pRzg2Pfc;
+    PFC_PIN_CONFLICT *      pConflict;
+    const char *            pinName;
+    UINT32                  first;
+    UINT32                  reg;
+    UINT32                  bit;
+    UINT32                  i;
 
     if (pPfc == NULL)
         {
-        return ERROR;
+        printf ("PFC not attached\n");
+        return;
         }
 
-    /* process the group/function pair in the module selection table */
-
-    pModSel = (PFC_MOD_DESC *) &pfcModuleSel [0];
+    (void)semTake (pPfc->mutex, WAIT_FOREVER);
 
-    while (pModSel->groupId != GRP_NONE)
+    printf ("\nPin        Pad       Owner\n");
+    for (reg = 0U; reg < NUM_GPSR_REGS; reg++)
         {
-        if ((pModSel->groupId == groupId) && (pModSel->funcId == funcId))
+        for (bit = 0U; bit < 32U; bit++)
             {
-            rzg2PfcRegMaskAndSet (pPfc,
-                                  PFC_MOD_SEL (MOD_SEL_REG (pModSel->modSelMask)),
-                                  MOD_SEL_MASK (pModSel->modSelMask),
-                                  (UINT32) pModSel->modSelVal <<
-                                  (MOD_SEL_SHIFT (pModSel->modSelMask)));
-            break;
+            if ((pPfc->pinClaimed [reg] & (1U << bit)) == 0U)
+                {
+                continue;
+                }
+
+            pinName = "-";
+            for (i = 0U; pfcPins [i].sipName != NULL; i++)
+                {
+                if (pfcPins [i].gpsrRegBit == GPSR_REG_PIN (reg, bit))
+                    {
+                    pinName = pfcPins [i].sipName;
+                    break;
+                    }
+                }
+
+            printf ("GPSR%u.%-2u  %-8s  %s\n", reg, bit, pinName,
+                    vxFdtGetName (pPfc->pinOwner [(reg * 32U) + bit], NULL));
             }
-        pModSel++;
         }
 
-    return OK;
+    printf ("\nConflicts: %u\n", pPfc->numConflicts);
+
+    first = (pPfc->numConflicts > PFC_CONFLICTS_MAX) ?
+            (pPfc->numConflicts - PFC_CONFLICTS_MAX) : 0U;
+    for (i = first; i < pPfc->numConflicts; i++)
+        {
+        pConflict = &pPfc->conflicts [i % PFC_CONFLICTS_MAX];
+        printf ("GPSR%u.%-2u  %s -> %s\n", GPSR_REG (pConflict->pin),
+                pConflict->pin & 0x1fU,
+                vxFdtGetName (pConflict->prevOwner, NULL),
+                vxFdtGetName (pConflict->newOwner, NULL));
+        }
+
+    (void)semGive (pPfc->mutex);
     }
 
 /*******************************************************************************
 *
-* rzg2PfcFdtFunctionHandle - handle a FDT pin mux function property
+* rzg2PfcBootProgSet - set the PFC boot program
 *
-* This function handles the pin mux "function" property from the device tree
-* node. The process requires that GPIO mode is selected while changing function.
-* The peripheral function and module selection registers are set while GPIO mode
-* is selected.
+* This routine sets the boot program written when the PFC is attached, instead
+* of compiling the PFC configuration nodes. <pWrites> is usually the array
+* generated by rzg2PfcBootGen from the board device tree, or printed by
+* rzg2PfcBootProgDump() on the same board, and must remain valid while the PFC
+* is attached. This routine must be called before the PFC is attached, for
+* example from the BSP hardware initialisation.
 *
-* RETURNS: OK if pin mux function handled successfully, ERROR if pin controller,
-* or pins property is invalid, if pins are not from the same functional
-* group, or if any step in the configuration process fails.
+* RETURNS: N/A.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS rzg2PfcFdtFunctionHandle
+void rzg2PfcBootProgSet
     (
-    PFC_PINMUX_DRVCTRL *    pPfc,           /* pin mux controller instance */
-    char *                  pPinsProp,      /* pins property */
-    int                     pinsPropLen,    /* pins property length */
-    PFC_FUNC_ID             funcId          /* function ID */
+    const RZG2_PFC_BOOT_WRITE * pWrites,    /* register writes */
+    UINT32                      numWrites   /* number of writes */
     )
     {
-    PFC_GROUP_ID            groupId;
+    pRzg2PfcBootWrites = pWrites;
+    rzg2PfcBootWritesNum = (pWrites == NULL) ? 0U : numWrites;
+    }
 
-    if ((pPfc == NULL) || (pPinsProp == NULL) || (pinsPropLen <= 0))
-        {
-        return ERROR;
-        }
+/*******************************************************************************
+*
+* rzg2PfcBootProgDump - print the enabled pin programs as a boot program
+*
+* This routine prints, as C source, the register writes of the configuration
+* nodes that are currently enabled, except drive and bias profiles, in the order
+* they are committed: the GPSR pins changing function are set to GPIO, then the
+* other registers are written, then the final GPSR values. The array can be
+* built into the image and passed to rzg2PfcBootProgSet(), which writes it in a
+* transaction, so the GPIO entries are left out if the function and module
+* selections are already set.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
 
-    /* all pins must be in the same defined functional group */
+void rzg2PfcBootProgDump (void)
+    {
+    PFC_PINMUX_DRVCTRL *    pPfc = pRzg2Pfc;
+    PFC_PIN_PROG *          pProg;
+    PFC_PIN_STEP *          pStep;
+    UINT32                  numWrites = 0U;
+    UINT32                  offset;
+    UINT32                  word;
+    UINT32                  slot;
+    UINT32                  reg;
+    UINT32                  i;
 
-    groupId = rzg2PfcPinsGroupGet (pPinsProp, pinsPropLen, funcId);
-    if (groupId == GRP_NONE)
+    if (pPfc == NULL)
         {
-        return ERROR;
+        printf ("PFC not attached\n");
+        return;
         }
 
-    /* select GPSR GPIO mode for all pins specified */
+    /* collect the enabled programs in a transaction that is discarded */
 
-    if (rzg2PfcFdtPinListHandle (pPfc, pPinsProp, pinsPropLen, rzg2PfcGpioEnable,
-                                 NULL, 0) == ERROR)
+    rzg2PfcXactBegin (pPfc);
+
+    for (slot = 0U; slot < PFC_PROG_HASH_SIZE; slot++)
         {
-        return ERROR;
+        pProg = pPfc->progHash [slot];
+        if ((pProg == NULL) || !pProg->savedValid || pProg->isProfile)
+            {
+            continue;
+            }
+
+        for (i = 0U; i < pProg->numSteps; i++)
+            {
+            pStep = &pProg->pSteps [i];
+            rzg2PfcRegMaskAndSet (pPfc, pStep->offset, pStep->mask,
+                                  pStep->val);
+            if (pStep->gpio != 0U)
+                {
+                pPfc->xactGpio [(pStep->offset - PFC_GPSR (0)) / 4U] |=
+                    pStep->gpio;
+                }
+            }
         }
 
-    /* set Peripheral Function (IPSR) for all functions in group */
+    printf ("/* PFC boot program, printed by rzg2PfcBootProgDump() */\n\n");
+    printf ("const RZG2_PFC_BOOT_WRITE rzg2PfcBootWrites [] =\n    {\n");
+    printf ("    /* offset  mask         value */\n");
 
-    if (rzg2PfcIpsrGroupFuncSet (pPfc, groupId, funcId) == ERROR)
+    for (reg = 0U; reg < NUM_GPSR_REGS; reg++)
         {
-        return ERROR;
+        if (pPfc->xactGpio [reg] != 0U)
+            {
+            printf ("    { 0x%03xU, 0x%08xU, 0x%08xU },\n", PFC_GPSR (reg),
+                    pPfc->xactGpio [reg], 0U);
+            numWrites++;
+            }
         }
 
-    /* set Module Selection (MOD_SEL) for this group function */
-
-    if (rzg2PfcModSelGroupFuncSet (pPfc, groupId, funcId) == ERROR)
+    for (i = 0U; i < pPfc->xactCount; i++)
         {
-        return ERROR;
-        }
+        word = pPfc->xactRegs [i];
+        offset = word * 4U;
+        if ((offset >= PFC_GPSR (0)) && (offset < PFC_GPSR (NUM_GPSR_REGS)))
+            {
+            continue;
+            }
 
-    /* select GPSR Peripheral Function mode for all pins specified */
+        printf ("    { 0x%03xU, 0x%08xU, 0x%08xU },\n", offset,
+                pPfc->xactMask [word],
+                pPfc->xactVal [word] & pPfc->xactMask [word]);
+        numWrites++;
+        }
 
-    if (rzg2PfcFdtPinListHandle (pPfc, pPinsProp, pinsPropLen, rzg2PfcPeriphEnable,
-                                 NULL, 0) == ERROR)
+    for (reg = 0U; reg < NUM_GPSR_REGS; reg++)
         {
-        return ERROR;
+        word = PFC_GPSR (reg) / 4U;
+        if (pPfc->xactValid [word] != 0U)
+            {
+            printf ("    { 0x%03xU, 0x%08xU, 0x%08xU },\n", PFC_GPSR (reg),
+                    pPfc->xactMask [word],
+                    pPfc->xactVal [word] & pPfc->xactMask [word]);
+            numWrites++;
+            }
         }
 
-    return OK;
+    printf ("    };\n\n/* %u writes */\n", numWrites);
+
+    rzg2PfcXactEnd (pPfc, FALSE);
     }
 
 /*******************************************************************************
 *
-* rzg2PfcFdtConfigHandle - handle the enabling of a pin mux state
+* rzg2PfcPocHookSet - set the POC supply hook
 *
-* This function handles the enabling of a specified pin mux state in the PFC. The
-* state is specified in the FDT configuration node at <offset>.
+* This routine sets the hook called by rzg2PfcPocVoltageSet() before the pads
+* are switched, usually to set the PMIC regulator supplying the SD pads. The
+* hook is called with the POC field, the voltage in millivolts and <pArg>, and
+* returns OK, or ERROR to leave the pads unchanged. It runs in the context of
+* the rzg2PfcPocVoltageSet() caller, and must be interrupt safe if that caller
+* runs in interrupt context. It is also called, with the PFC mutex held, when a
+* pin state with a "power-source" property changes the pad voltage. A NULL
+* <hook> removes the hook.
 *
-* RETURNS: OK if state enabled, ERROR if the "pins" property is empty or
-* missing, if the pin function is invalid, of if the pin configuration fails.
+* RETURNS: N/A.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS rzg2PfcFdtConfigHandle
+void rzg2PfcPocHookSet
     (
-    PFC_PINMUX_DRVCTRL *    pPfc,   /* pin mux controller instance */
-    int                     offset  /* FDT configuration node */
+    RZG2_PFC_POC_HOOK       hook,       /* supply hook, or NULL */
+    void *                  pArg        /* hook argument */
     )
     {
-    PFC_PIN_CONF *  pConf;          /* pin configuration descriptor */
-    char *          pProp;          /* function/configuration property */
-    int             propLen;        /* function/configuration property length */
-    char *          pPinsProp;      /* pins property */
-    int             pinsPropLen;    /* pins property length */
-    PFC_FUNC_ID     funcId = FN_NONE;   /* function ID */
-
-    RZG2_DBG_MSG (PFC_DBG_INFO, "%s offset %d\n", __FUNCTION__, offset);
-
-    /* pin configuration and multiplexing both require "pins" property */
+    rzg2PfcPocHook = hook;
+    pRzg2PfcPocHookArg = pArg;
+    }
 
-    pPinsProp = (char *) vxFdtPropGet (offset, PFC_FDT_PINS, &pinsPropLen);
-    if ((pPinsProp == NULL) || (pinsPropLen <= 0))
-        {
-        RZG2_DBG_MSG (PFC_DBG_ERR, "Empty or no " PFC_FDT_PINS " property\n");
-        return ERROR;
-        }
+/*******************************************************************************
+*
+* rzg2PfcPocVoltageSet - switch the signalling voltage of SD pads
+*
+* This routine switches the pads of POC field <pocSel> (POC_SD0 or POC_SD3) to
+* <mv> millivolt signalling, PFC_POC_MV_3V3 or PFC_POC_MV_1V8. The supply hook,
+* if set, is called first. The POCCTRL register is updated under a spinlock,
+* without taking the PFC mutex, so this routine can be called from interrupt
+* context.
+*
+* RETURNS: OK, or ERROR if the PFC is not attached, the arguments are invalid
+* or the supply hook fails.
+*
+* ERRNO: N/A.
+*/
 
-    /* ensure all the pins are valid before starting configuration */
+STATUS rzg2PfcPocVoltageSet
+    (
+    UINT32                  pocSel,     /* POC_SD0 or POC_SD3 */
+    UINT32                  mv          /* signalling voltage in mv */
+    )
+    {
+    PFC_PINMUX_DRVCTRL *    pPfc = pRzg2Pfc;
+    RZG2_PFC_POC_HOOK       hook = rzg2PfcPocHook;
+    const PFC_POC_DESC *    pPocCtrl;
+    UINT64                  startTicks;
+    UINT64                  ticks;
+    UINT32                  pocVal;
 
-    if (rzg2PfcFdtPinListValidate (pPfc, pPinsProp, pinsPropLen) == ERROR)
+    if (pPfc == NULL)
         {
         return ERROR;
         }
 
-    /*
-     * Pin multiplexing is determined by the "function" property. The single
-     * <string> value defines the function to be applied.
-     */
-    pProp = (char *)vxFdtPropGet (offset, PFC_FDT_FUNCTION, &propLen);
-    if (pProp != NULL)
+    for (pPocCtrl = &pfcPocSel [0]; pPocCtrl->funcId != FN_NONE; pPocCtrl++)
         {
-        RZG2_DBG_MSG (PFC_DBG_INFO, "pin mux " PFC_FDT_FUNCTION " property: %s\n", pProp);
-
-        /* retrieve, and validate, the function ID for the function name */
-
-        funcId = rzg2PfcFuncIdGet (pProp);
-        if (funcId == FN_NONE)
+        if (pPocCtrl->pocMask == pocSel)
             {
-            RZG2_DBG_MSG (PFC_DBG_ERR, "Invalid function %s\n", pProp);
-            return ERROR;
+            break;
             }
+        }
 
-        if (rzg2PfcFdtFunctionHandle (pPfc, pPinsProp,
-                                      pinsPropLen, funcId) == ERROR)
-            {
-            RZG2_DBG_MSG (PFC_DBG_ERR, "pin mux function %s failed\n", pProp);
-            return ERROR;
-            }
+    if ((pPocCtrl->funcId == FN_NONE) ||
+        (rzg2PfcPocValGet (pocSel, mv, &pocVal) == ERROR))
+        {
+        return ERROR;
         }
 
-    /*
-     * Pin configuration is determined by a single <string> property. Supported
-     * configuration properties and their handling functions are listed in the
-     * pfcConfs table.
-     */
+    startTicks = rzg2TimestampGet ();
 
-    pConf = (PFC_PIN_CONF *) &pfcConfs [0];
-    while (pConf->name != NULL)
+    if ((hook != NULL) && (hook (pocSel, mv, pRzg2PfcPocHookArg) != OK))
         {
-        pProp = (char *)vxFdtPropGet (offset, (char *)pConf->name, &propLen);
-        if ((pProp != NULL) && (pConf->func != NULL))
-            {
-            RZG2_DBG_MSG (PFC_DBG_INFO, "%s found\n", pConf->name);
-
-            if (rzg2PfcFdtPinListHandle (pPfc, pPinsProp, pinsPropLen,
-                                         pConf->func, pProp, propLen) == ERROR)
-                {
-                RZG2_DBG_MSG (PFC_DBG_ERR, "%s failed\n", pConf->name);
-                return ERROR;
-                }
-            }
-        pConf++;
+        return ERROR;
         }
 
-    /* POC configuration is determined by "function" and "power-source" */
+    rzg2PfcRegUpdate (pPfc, PFC_POCCTRL, POC_MASK (pocSel), pocVal);
 
-    pProp = (char *)vxFdtPropGet (offset, (char *)pfcPocConfs, &propLen);
-    if (pProp != NULL)
-        {
-        RZG2_DBG_MSG (PFC_DBG_INFO, "%s found\n", pfcPocConfs);
+    ticks = rzg2TimestampGet () - startTicks;
 
-        if (rzg2PfcPocCtrlFuncSet (pPfc, funcId, pProp, propLen) == ERROR)
-            {
-            RZG2_DBG_MSG (PFC_DBG_ERR, "%s failed\n", pfcPocConfs);
-            return ERROR;
-            }
+    /* the statistics are not protected; a concurrent switch may be lost */
+
+    pPfc->pocSwitches++;
+    pPfc->pocLastTicks = ticks;
+    if (ticks > pPfc->pocMaxTicks)
+        {
+        pPfc->pocMaxTicks = ticks;
         }
 
     return OK;
@@ -1842,415 +4460,394 @@ LOCAL STATUS rzg2PfcFdtConfigHandle
 
 /*******************************************************************************
 *
-* vxbFdtRzg2PfcPinMuxEnable - enable pin mux configuration
+* rzg2PfcPocVoltageGet - get the signalling voltage of SD pads
 *
-* The vxbPinMuxEnable method enables pin mux configuration in the hardware. This
-* method is required for a pin mux controller device driver.
+* This routine returns the signalling voltage selected for the pads of POC field
+* <pocSel> (POC_SD0 or POC_SD3), as read from the POCCTRL register.
 *
-* RETURNS: OK if state enabled, ERROR if the device or offset is invalid, or the
-* configuration fails.
+* RETURNS: PFC_POC_MV_3V3 or PFC_POC_MV_1V8, or 0 if the PFC is not attached or
+* <pocSel> is invalid.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS vxbFdtRzg2PfcPinMuxEnable
+UINT32 rzg2PfcPocVoltageGet
     (
-    VXB_DEV_ID  pDev,   /* VxBus device instance */
-    INT32       offset  /* FDT configuration node */
+    UINT32                  pocSel      /* POC_SD0 or POC_SD3 */
     )
     {
-    int                     nodeOffset;     /* FDT configuration subnodes */
-    PFC_PINMUX_DRVCTRL *    pPfc;           /* pin mux controller instance */
+    PFC_PINMUX_DRVCTRL *    pPfc = pRzg2Pfc;
+    const PFC_POC_DESC *    pPocCtrl;
 
-    if ((pDev == NULL) || (offset <= 0))
+    if (pPfc == NULL)
         {
-        return ERROR;
+        return 0U;
         }
 
-    RZG2_DBG_MSG (PFC_DBG_INFO, "%s offset %d\n", __FUNCTION__, offset);
-
-    pPfc = (PFC_PINMUX_DRVCTRL *)vxbDevSoftcGet (pDev);
-
-    /* handle this node if it has pins properties and not just subnodes */
-
-    if (vxFdtPropGet ((int)offset, PFC_FDT_PINS, NULL) != NULL)
+    for (pPocCtrl = &pfcPocSel [0]; pPocCtrl->funcId != FN_NONE; pPocCtrl++)
         {
-        if (rzg2PfcFdtConfigHandle (pPfc, (int)offset) == ERROR)
+        if (pPocCtrl->pocMask == pocSel)
             {
-            return ERROR;
+            break;
             }
         }
 
-    /* handle the device tree subnodes if there are any */
-
-    for (nodeOffset = vxFdtFirstSubnode ((int)offset); nodeOffset > 0;
-         nodeOffset = vxFdtNextSubnode (nodeOffset))
+    if (pPocCtrl->funcId == FN_NONE)
         {
-        if (rzg2PfcFdtConfigHandle (pPfc, nodeOffset) == ERROR)
-            {
-            return ERROR;
-            }
+        return 0U;
         }
 
-    return OK;
+    return ((rzg2PfcRegRead (pPfc, PFC_POCCTRL) & POC_MASK (pocSel)) == 0U) ?
+           PFC_POC_MV_1V8 : PFC_POC_MV_3V3;
     }
 
 /*******************************************************************************
 *
-* rzg2PfcPinConfShow - print verbose pin configuration information
+* rzg2PfcPinHandleGet - get the handle of a PFC pin
 *
-* This function prints PFC pin pull-up/pull-down configuration information for
-* supported pins.
+* This routine returns the handle of the pin named <pName>, as in the "pins"
+* property of the PFC configuration nodes, for rzg2PfcPinGpioSet() and
+* rzg2PfcPinsGpioSet(). The handle is the GPSR register and bit of the pin.
 *
-* RETURNS: N/A.
+* RETURNS: the pin handle, or RZG2_PFC_PIN_NONE if the pin is unknown or is not
+* multiplexed by a GPSR register.
 *
 * ERRNO: N/A.
 */
 
-LOCAL void rzg2PfcPinConfShow
+RZG2_PFC_PIN rzg2PfcPinHandleGet
     (
-    PFC_PINMUX_DRVCTRL *    pPfc
+    const char *            pName       /* pin name */
     )
     {
     PFC_PIN_DESC *          pPin;
-    PFC_PIN_PULL_STATE      pullState;
 
-    pPin = (PFC_PIN_DESC *) &pfcPins [0];
-
-    while (!PFC_PIN_DESC_TBL_END(pPin))
+    pPin = rzg2PfcPinGet ((char *)pName);
+    if ((pPin == NULL) || (pPin->gpsrRegBit == GPSR_NONE))
         {
-        if ((rzg2PfcRegRead (pPfc, PFC_PUEN (PU_REG (pPin->puRegBit))) &
-             PU_MASK (pPin->puRegBit)) == PUEN_DIS)
-            {
-            pullState = PIN_PU_DISABLED;
-            }
-        else if ((rzg2PfcRegRead (pPfc, PFC_PUD (PU_REG (pPin->puRegBit))) &
-                  PU_MASK (pPin->puRegBit)) == PUD_DOWN)
-            {
-            pullState = PIN_PU_PULL_DOWN;
-            }
-        else
-            {
-            pullState = PIN_PU_PULL_UP;
-            }
-
-        if ((pPin->gpsrRegBit != GPSR_NONE) &&
-            ((rzg2PfcRegRead (pPfc, PFC_GPSR (GPSR_REG (pPin->gpsrRegBit))) &
-              GPSR_MASK (pPin->gpsrRegBit)) == GPSR_GPIO ))
-            {
-            printf ("  GPIO");
-            }
-
-        printf ("  %s: %s\n", pPin->sipName, pfcPinPullStateStr [pullState]);
-
-        pPin++;
+        return RZG2_PFC_PIN_NONE;
         }
+
+    return (RZG2_PFC_PIN) pPin->gpsrRegBit;
     }
 
 /*******************************************************************************
 *
-* vxbFdtRzg2PfcPinMuxShow - print pin mux information
-*
-* The vxbPinMuxShow method prints specific information on the console provided
-* by the pin mux controller driver. This method is optional for a pin mux
-* controller device driver.
+* rzg2PfcPinsGpioSet - switch pins of a GPSR register to GPIO or peripheral
 *
-* This function prints PFC pin mux information. Basic, non-verbose, output is a
-* dump of PFC registers. In verbose mode additional information is shown for
-* supported pins.
+* This routine switches the <numPins> pins <pPins> to GPIO mode if <gpio> is
+* TRUE, or back to their peripheral function otherwise. All the pins must be
+* multiplexed by the same GPSR register, which is updated with one write under
+* the register spinlock. This routine can be called from interrupt context.
 *
-* RETURNS: N/A.
+* RETURNS: OK, or ERROR if the PFC is not attached, a pin handle is invalid or
+* the pins are in different GPSR registers.
 *
 * ERRNO: N/A.
 */
 
-LOCAL void vxbFdtRzg2PfcPinMuxShow
+STATUS rzg2PfcPinsGpioSet
     (
-    VXB_DEV_ID  pDev,       /* VxBus device instance */
-    INT32       verbose     /* uses 0 for basic output */
+    const RZG2_PFC_PIN *    pPins,      /* pin handles */
+    UINT32                  numPins,    /* number of pins */
+    BOOL                    gpio        /* TRUE for GPIO, FALSE for peripheral */
     )
     {
-    PFC_PINMUX_DRVCTRL *    pPfc;
-    UINT                    regIndex;
+    PFC_PINMUX_DRVCTRL *    pPfc = pRzg2Pfc;
+    UINT32                  reg;
+    UINT32                  mask = 0U;
+    UINT32                  i;
 
-    if (pDev == NULL)
+    if ((pPfc == NULL) || (pPins == NULL) || (numPins == 0U))
         {
-        RZG2_DBG_MSG (PFC_DBG_ERR, "Invalid VxBus device instance\n");
-        return;
+        return ERROR;
         }
 
-    /* ignore verbose mode and just dump registers for now */
-
-    pPfc = (PFC_PINMUX_DRVCTRL *)vxbDevSoftcGet (pDev);
-
-    printf ("\nGPIO/Peripheral Function Select Registers\n");
-    for (regIndex = 0; regIndex < NUM_GPSR_REGS; regIndex++)
-        {
-        printf ("GPSR%-2d: 0x%08X\n",
-                regIndex, rzg2PfcRegRead (pPfc, PFC_GPSR(regIndex)));
-        }
+    reg = GPSR_REG (pPins [0]);
 
-    printf ("\nPeripheral Function Select Registers\n");
-    for (regIndex = 0; regIndex < NUM_IPSR_REGS; regIndex++)
+    for (i = 0U; i < numPins; i++)
         {
-        printf ("IPSR%-2d: 0x%08X\n",
-                regIndex, rzg2PfcRegRead (pPfc, PFC_IPSR(regIndex)));
-        }
+        if ((pPins [i] == RZG2_PFC_PIN_NONE) ||
+            (GPSR_REG (pPins [i]) != reg) || (reg >= NUM_GPSR_REGS))
+            {
+            return ERROR;
+            }
 
-    printf ("\nDRV Control Registers\n");
-    for (regIndex = 0; regIndex < NUM_DRVTRL_REGS; regIndex++)
-        {
-        printf ("DRVCTRL%-2d: 0x%08X\n",
-                regIndex, rzg2PfcRegRead (pPfc, PFC_DRVCTRL(regIndex)));
+        mask |= GPSR_MASK (pPins [i]);
         }
 
-    printf ("\nPOC Control Register\n");
-    printf ("POCCTRL: 0x%08X\n", rzg2PfcRegRead (pPfc, PFC_POCCTRL));
-
-    printf ("\nTDSEL Control Register\n");
-    printf ("TDSELCTRL: 0x%08X\n", rzg2PfcRegRead (pPfc, PFC_TDSELCTRL));
-
-    printf ("\nIO Cell Control for IICDVFS\n");
-    printf ("IOCTRL: 0x%08X\n", rzg2PfcRegRead (pPfc, PFC_IOCTRL));
-
-    printf ("\nFuse Monitor Register\n");
-    printf ("FUSEMON: 0x%08X\n", rzg2PfcRegRead (pPfc, PFC_FUSEMON));
-
-    printf ("\nLSI Pin Pull-Enable Registers\n");
-    for (regIndex = 0; regIndex < NUM_PUEN_REGS; regIndex++)
-        {
-        printf ("PUEN%d: 0x%08X\n",
-                regIndex, rzg2PfcRegRead (pPfc, PFC_PUEN(regIndex)));
-        }
+    /* GPSR register bit is 0 for GPIO, 1 for peripheral function */
 
-    printf ("\nLSI Pin Pull-Up/Down Control Registers\n");
-    for (regIndex = 0; regIndex < NUM_PUD_REGS; regIndex++)
-        {
-        printf ("PUD%d: 0x%08X\n",
-                regIndex, rzg2PfcRegRead (pPfc, PFC_PUD(regIndex)));
-        }
+    rzg2PfcRegUpdate (pPfc, PFC_GPSR (reg), mask, gpio ? 0U : mask);
 
-    printf ("\nModule Select Registers\n");
-    for (regIndex = 0; regIndex < NUM_MOD_SEL_REGS; regIndex++)
-        {
-        printf ("MOD_SEL%d: 0x%08X\n",
-                regIndex, rzg2PfcRegRead (pPfc, PFC_MOD_SEL(regIndex)));
-        }
+    return OK;
+    }
 
-    if (verbose != 0)
-        {
-        rzg2PfcPinConfShow (pPfc);
-        }
+/*******************************************************************************
+*
+* rzg2PfcPinGpioSet - switch a pin to GPIO or peripheral
+*
+* This routine switches the pin <pin> to GPIO mode if <gpio> is TRUE, or back
+* to its peripheral function otherwise. This routine can be called from
+* interrupt context.
+*
+* RETURNS: OK, or ERROR if the PFC is not attached or the pin handle is
+* invalid.
+*
+* ERRNO: N/A.
+*/
 
+STATUS rzg2PfcPinGpioSet
+    (
+    RZG2_PFC_PIN            pin,        /* pin handle */
+    BOOL                    gpio        /* TRUE for GPIO, FALSE for peripheral */
+    )
+    {
+    return rzg2PfcPinsGpioSet (&pin, 1U, gpio);
     }
 
 /*******************************************************************************
 *
-* vxbFdtRzg2PfcPinMuxProbe - probe to match PFC pin mux driver to a device
+* rzg2PfcPinStateCsvWrite - write the decoded pin state as CSV
 *
-* Check for Renesas RZ/G2 PFC (or compatible) device in the FDT.
+* This routine writes the decoded state of each pin known to the driver to the
+* file descriptor <fd>, as CSV with a header line. The columns are the pin
+* name, the mode (gpio, periph or fixed), the selected function, the MOD_SEL
+* variant, the drive strength in eighths, the pull, and the POC voltage in
+* millivolts or 0. The PFC registers are read once, into a snapshot.
 *
-* RETURNS: OK if probe passes and assumed a valid (or compatible) device, ERROR
-* otherwise.
+* RETURNS: OK, or ERROR if the PFC is not attached.
 *
 * ERRNO: N/A.
 */
 
-LOCAL STATUS vxbFdtRzg2PfcPinMuxProbe
+STATUS rzg2PfcPinStateCsvWrite
     (
-    VXB_DEV_ID pDev        /* VxBus device instance */
+    int                     fd          /* file descriptor to write to */
     )
     {
-    VXB_FDT_DEV_MATCH_ENTRY * pMatch;
+    PFC_PINMUX_DRVCTRL *    pPfc = pRzg2Pfc;
+    const PFC_FUNC_DESC *   pFuncSel;
+    const PFC_PIN_DESC *    pPin;
+    PFC_REG_SNAP            snap;
+    PFC_PIN_STATE           state;
 
-    if (vxbFdtDevMatch (pDev, vxbFdtPfcPinMuxMatch, &pMatch) == ERROR)
+    if (pPfc == NULL)
         {
         return ERROR;
         }
 
-    vxbDevDrvDataSet (pDev, (void *) pMatch->data);
+    pFuncSel = pPfc->pFuncSel;
+
+    rzg2PfcRegSnapTake (pPfc, &snap);
+
+    (void)fdprintf (fd, "pin,mode,function,variant,drive,pull,poc\n");
+
+    for (pPin = &pfcPins [0]; !PFC_PIN_DESC_TBL_END (pPin); pPin++)
+        {
+        rzg2PfcPinStateDecode (pPfc, pFuncSel, &snap, pPin, &state);
+
+        (void)fdprintf (fd, "%s,%s,%s,%c,%u,%s,%u\n", pPin->sipName,
+                        state.mode, state.funcName, state.variant,
+                        state.drvEighths, pfcPinPullStateStr [state.pull],
+                        state.pocMv);
+        }
+
     return OK;
     }
 
-/******************************************************************************
+/*******************************************************************************
 *
-* vxbFdtRzg2PfcPinMuxAttach - attach PFC device
+* rzg2PfcProfileGet - get a drive and bias profile
 *
-* This is the Renesas RZ/G2 Pin Function Controller (PFC) initialisation
-* function.
+* This routine returns the handle of the drive and bias profile <pName>, a
+* configuration node under the PFC device tree node. The node is compiled once,
+* when it is first used, into the DRVCTRL, PUEN and PUD changes it makes. A
+* profile node must not make any other register change.
 *
-* RETURNS: OK if driver attached, ERROR if the device is invalid, or resources
-* cannot be allocated.
+* RETURNS: the profile handle, or NULL if the PFC is not attached, there is no
+* such node, or the node is not a valid profile.
 *
-* ERRNO: N/A
+* ERRNO: N/A.
 */
 
-LOCAL STATUS vxbFdtRzg2PfcPinMuxAttach
+RZG2_PFC_PROFILE rzg2PfcProfileGet
     (
-    VXB_DEV_ID pDev                         /* VxBus device instance */
+    const char *            pName       /* profile node name */
     )
     {
-    PFC_PINMUX_DRVCTRL *    pPfc;           /* PFC driver control data */
-    VXB_RESOURCE_ADR *      pResAdr;        /* device registers */
-    VXB_PINMUX_CTRL *       pPinMuxCtrl;    /* vxbPinMuxLib control data */
-
-    /* check for valid parameter */
-
-    if (pDev == NULL)
+    PFC_PINMUX_DRVCTRL *    pPfc = pRzg2Pfc;
+    VXB_FDT_DEV *           pFdtDev;
+    PFC_PIN_PROG *          pProg;
+    PFC_PIN_STEP *          pStep;
+    const char *            pNodeName;
+    int                     offset;
+    UINT32                  i;
+
+    if ((pPfc == NULL) || (pName == NULL))
         {
-        return ERROR;
+        return NULL;
         }
 
-    /* allocate the memory for the PFC driver control */
-
-    pPfc = (PFC_PINMUX_DRVCTRL *)vxbMemAlloc (sizeof(PFC_PINMUX_DRVCTRL));
-    if (pPfc == NULL)
+    pFdtDev = vxbFdtDevGet (pPfc->pPinMuxCtrl->pDev);
+    if (pFdtDev == NULL)
         {
-        RZG2_DBG_MSG (PFC_DBG_ERR, "vxbMemAlloc error\n");
-        return ERROR;
+        return NULL;
         }
 
-    /* dynamically allocate and initialise mutual-exclusion semaphore */
-
-    pPfc->mutex = semMCreate (SEM_Q_PRIORITY | SEM_DELETE_SAFE |
-                              SEM_INVERSION_SAFE);
-    if (pPfc->mutex == SEM_ID_NULL)
+    for (offset = vxFdtFirstSubnode (pFdtDev->offset); offset > 0;
+         offset = vxFdtNextSubnode (offset))
         {
-        RZG2_DBG_MSG (PFC_DBG_ERR, "semMCreate error\n");
-        goto errOut;
+        pNodeName = vxFdtGetName (offset, NULL);
+        if ((pNodeName != NULL) && (strcmp (pNodeName, pName) == 0))
+            {
+            break;
+            }
         }
 
-    /* allocate register memory resource */
-
-    pPfc->memRes = vxbResourceAlloc (pDev, VXB_RES_MEMORY, 0);
-    if (pPfc->memRes == NULL)
+    pProg = rzg2PfcProgGet (pPfc, offset);
+    if (pProg == NULL)
         {
-        RZG2_DBG_MSG (PFC_DBG_ERR, "vxbResourceAlloc(MEMORY) error\n");
-        goto errOut;
+        return NULL;
         }
 
-    /* extract register virtual address and resource handle */
+    /* a profile only changes drive strength and bias */
 
-    pResAdr = (VXB_RESOURCE_ADR *)pPfc->memRes->pRes;
-    if (pResAdr == NULL)
+    for (i = 0U; i < pProg->numSteps; i++)
         {
-        RZG2_DBG_MSG (PFC_DBG_ERR, "virtual address error\n");
-        goto errOut;
+        pStep = &pProg->pSteps [i];
+        if (!(((pStep->offset >= PFC_DRVCTRL (0)) &&
+               (pStep->offset <= PFC_DRVCTRL (NUM_DRVTRL_REGS - 1))) ||
+              ((pStep->offset >= PFC_PUEN (0)) &&
+               (pStep->offset <= PFC_PUEN (NUM_PUEN_REGS - 1))) ||
+              ((pStep->offset >= PFC_PUD (0)) &&
+               (pStep->offset <= PFC_PUD (NUM_PUD_REGS - 1)))))
+            {
+            RZG2_DBG_MSG (PFC_DBG_ERR, "%s is not a drive and bias profile\n",
+                          pName);
+            return NULL;
+            }
         }
-    pPfc->regBase = (VIRT_ADDR)pResAdr->virtual;
-    pPfc->pHandle = pResAdr->pHandle;
 
-    /* allocate pin mux library representation of a pin mux controller */
+    pProg->isProfile = TRUE;
 
-    pPinMuxCtrl = (VXB_PINMUX_CTRL *) vxbMemAlloc (sizeof (VXB_PINMUX_CTRL));
-    if (pPinMuxCtrl == NULL)
-        {
-        goto errOut;
-        }
+    return (RZG2_PFC_PROFILE) pProg;
+    }
 
-    /* save references between VxBus device and pin mux controller */
+/*******************************************************************************
+*
+* rzg2PfcProfilesApply - apply drive and bias profiles
+*
+* This routine applies the <numProfiles> profiles <pProfiles>, in order, in one
+* transaction: each PFC register changed by the profiles is written once. This
+* routine takes the PFC mutex and must not be called from interrupt context.
+*
+* RETURNS: OK, or ERROR if the PFC is not attached or a profile is NULL.
+*
+* ERRNO: N/A.
+*/
 
-    pPinMuxCtrl->pDev = pDev;
-    pPfc->pPinMuxCtrl = pPinMuxCtrl;
-    vxbDevSoftcSet (pDev, (void *)pPfc);
+STATUS rzg2PfcProfilesApply
+    (
+    const RZG2_PFC_PROFILE *    pProfiles,      /* profile handles */
+    UINT32                      numProfiles     /* number of profiles */
+    )
+    {
+    PFC_PINMUX_DRVCTRL *    pPfc = pRzg2Pfc;
+    UINT32                  i;
 
-    /* register the PFC pin mux driver */
+    if ((pPfc == NULL) || (pProfiles == NULL))
+        {
+        return ERROR;
+        }
 
-    if (vxbPinMuxRegister (pPinMuxCtrl) == ERROR)
+    for (i = 0U; i < numProfiles; i++)
         {
-        goto errOut;
+        if (pProfiles [i] == NULL)
+            {
+            return ERROR;
+            }
         }
 
-    /* enable default pin mux configuration if it exists */
+    rzg2PfcXactBegin (pPfc);
 
-    if (vxbPinMuxEnable (pDev) == ERROR)
+    for (i = 0U; i < numProfiles; i++)
         {
-        goto errOut;
+        rzg2PfcProgApply (pPfc, (PFC_PIN_PROG *) pProfiles [i], FALSE);
         }
 
-    RZG2_DBG_MSG (PFC_DBG_INFO, "vxbFdtRzg2PfcPinMuxAttach OK\n");
+    rzg2PfcXactEnd (pPfc, TRUE);
 
     return OK;
-
-errOut:
-
-    RZG2_DBG_MSG (PFC_DBG_ERR, "vxbFdtRzg2PfcPinMuxAttach ERROR\n");
-
-    /* free PFC resources */
-
-    (void)vxbResourceFree (pDev, pPfc->memRes);
-    vxbMemFree (pPfc->pPinMuxCtrl);
-    (void)semDelete (pPfc->mutex);
-    vxbDevSoftcSet (pDev, NULL);
-    vxbMemFree (pPfc);
-
-    return ERROR;
     }
 
 /*******************************************************************************
 *
-* vxbFdtRzg2PfcPinMuxShutdown - shutdown PFC device
+* rzg2PfcProfileApply - apply a drive and bias profile
 *
-* Turn off the hardware and put it into a quiescent state.
+* This routine applies the profile <profile>. See rzg2PfcProfilesApply().
+*
+* RETURNS: OK, or ERROR if the PFC is not attached or the profile is NULL.
 *
-* RETURNS: OK.
-
 * ERRNO: N/A.
 */
 
-LOCAL STATUS vxbFdtRzg2PfcPinMuxShutdown
+STATUS rzg2PfcProfileApply
     (
-    VXB_DEV_ID pDev     /* VxBus device instance */
+    RZG2_PFC_PROFILE        profile     /* profile handle */
     )
     {
-    /*
-     * All PFC pin mux states are under the control of their respective
-     * drivers, so there's nothing to do here.
-     */
-
-    return OK;
+    return rzg2PfcProfilesApply (&profile, 1U);
     }
 
 /*******************************************************************************
 *
-* vxbFdtRzg2PfcPinMuxDetach - detach PFC device
+* rzg2PfcProfilesRestore - undo the application of drive and bias profiles
 *
-* This function implements the VxBus driver detach method for the PFC pin mux
-* driver. The pin mux controller is unregistered and allocated resources are
-* freed.
+* This routine restores, in one transaction, the register values replaced when
+* the <numProfiles> profiles <pProfiles> were last applied by
+* rzg2PfcProfilesApply() with the same list. The profiles are restored in the
+* reverse order, so profiles that change the same fields are undone correctly.
+* This routine takes the PFC mutex and must not be called from interrupt
+* context.
+*
+* RETURNS: OK, or ERROR if the PFC is not attached, or a profile is NULL or has
+* not been applied since it was last restored.
 *
-* RETURNS: OK if driver detached, ERROR if device is invalid.
-
 * ERRNO: N/A.
 */
 
-LOCAL STATUS vxbFdtRzg2PfcPinMuxDetach
+STATUS rzg2PfcProfilesRestore
     (
-    VXB_DEV_ID pDev     /* VxBus device instance */
+    const RZG2_PFC_PROFILE *    pProfiles,      /* profile handles */
+    UINT32                      numProfiles     /* number of profiles */
     )
     {
-    PFC_PINMUX_DRVCTRL *    pPfc;
-    STATUS                  retVal;
+    PFC_PINMUX_DRVCTRL *    pPfc = pRzg2Pfc;
+    UINT32                  i;
 
-    if (pDev == NULL)
+    if ((pPfc == NULL) || (pProfiles == NULL))
         {
         return ERROR;
         }
 
-    pPfc = (PFC_PINMUX_DRVCTRL *)vxbDevSoftcGet (pDev);
+    for (i = 0U; i < numProfiles; i++)
+        {
+        if ((pProfiles [i] == NULL) ||
+            !((PFC_PIN_PROG *) pProfiles [i])->savedValid)
+            {
+            return ERROR;
+            }
+        }
 
-    retVal = vxbPinMuxUnregister (pPfc->pPinMuxCtrl);
+    rzg2PfcXactBegin (pPfc);
 
-    if (retVal == OK)
+    for (i = numProfiles; i > 0U; i--)
         {
-        /* free PFC resources */
-
-        (void)vxbResourceFree (pDev, pPfc->memRes);
-        vxbMemFree (pPfc->pPinMuxCtrl);
-        (void)semDelete (pPfc->mutex);
-        vxbDevSoftcSet (pDev, NULL);
-        vxbMemFree (pPfc);
+        rzg2PfcProgApply (pPfc, (PFC_PIN_PROG *) pProfiles [i - 1U], TRUE);
         }
 
-    return retVal;
+    rzg2PfcXactEnd (pPfc, TRUE);
+
+    return OK;
     }
@@ -0,0 +1,130 @@
+/* vxbFdtRsRzg2PfcPinMuxIds.h - RZ/G2M PFC pin group and function IDs */
+
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1) Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2) Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3) Neither the name of Wind River Systems nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+DESCRIPTION
+This file is generated by tools/rzg2PfcTblGen.py from the CSV files in
+tools/pfc, and is included by vxbFdtRsRzg2PfcPinMux.c only. Do not edit it:
+change the CSV files and run the script again.
+*/
+
+#ifndef __INCvxbFdtRsRzg2PfcPinMuxIdsh
+#define __INCvxbFdtRsRzg2PfcPinMuxIdsh
+
+/*
+ * size of the pin name index, a power of two at least twice the number of
+ * pins
+ */
+
+#define PFC_PIN_HASH_SIZE     256U
+
+/* pin groups, named after a pin group's primary function */
+
+typedef enum pfcGroupId
+    {
+    GRP_NONE,
+    GRP_CANFD0_A,
+    GRP_CANFD0_B,
+    GRP_SCIF0,
+    GRP_SCIF1_A,
+    GRP_SCIF1_B,
+    GRP_SCIF2_A,
+    GRP_SCIF2_B,
+    GRP_SCIF3_A,
+    GRP_SCIF3_B,
+    GRP_SCIF4_A,
+    GRP_SCIF4_B,
+    GRP_SCIF4_C,
+    GRP_SCIF5_A,
+    GRP_SCIF5_B,
+    GRP_ETHERAVB,
+    GRP_HSCIF0,
+    GRP_HSCIF0_CTRL,
+    GRP_HSCIF1_A,
+    GRP_HSCIF1_B,
+    GRP_MSIOF0,
+    GRP_MSIOF0_SS1,
+    GRP_MSIOF0_SS2,
+    GRP_RPC,
+    GRP_SDHI0,
+    GRP_SDHI1,
+    GRP_SDHI2,
+    GRP_SDHI3,
+    GRP_I2C0,
+    GRP_I2C1_A,
+    GRP_I2C1_B,
+    GRP_I2C2_A,
+    GRP_I2C2_B,
+    GRP_I2C3,
+    GRP_I2C5,
+    GRP_I2C6_A,
+    GRP_I2C6_B,
+    GRP_I2C6_C,
+    GRP_USB0,
+    GRP_USB1,
+    GRP_USB3,
+    GRP_COUNT                           /* number of groups */
+    } PFC_GROUP_ID;
+
+/* functions */
+
+typedef enum pfcFuncId
+    {
+    FN_NONE,
+    FN_SCIF0,
+    FN_SCIF1,
+    FN_SCIF2,
+    FN_SCIF3,
+    FN_SCIF4,
+    FN_SCIF5,
+    FN_HSCIF0,
+    FN_HSCIF1,
+    FN_MSIOF0,
+    FN_CANFD0,
+    FN_RPC,
+    FN_ETHERAVB,
+    FN_SDHI0,
+    FN_SDHI3,
+    FN_MMC0,
+    FN_MMC1,
+    FN_I2C0,
+    FN_I2C1,
+    FN_I2C2,
+    FN_I2C3,
+    FN_I2C4,
+    FN_I2C5,
+    FN_I2C6,
+    FN_USB0,
+    FN_USB1,
+    FN_USB3
+    } PFC_FUNC_ID;
+
+#endif /* __INCvxbFdtRsRzg2PfcPinMuxIdsh */
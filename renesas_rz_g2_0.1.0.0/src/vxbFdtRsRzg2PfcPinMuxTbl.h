@@ -0,0 +1,653 @@
+/* vxbFdtRsRzg2PfcPinMuxTbl.h - RZ/G2M PFC pin, group and function tables */
+
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1) Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2) Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3) Neither the name of Wind River Systems nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+DESCRIPTION
+This file is generated by tools/rzg2PfcTblGen.py from the CSV files in
+tools/pfc, and is included by vxbFdtRsRzg2PfcPinMux.c only. Do not edit it:
+change the CSV files and run the script again.
+*/
+
+/*
+ * supported PFC pin configuration definitions
+ *
+ * The names in this table are the pin names that can be referenced in the
+ * device tree when setting pin configurations.
+ */
+
+LOCAL const PFC_PIN_DESC pfcPins [] =
+    {
+    /* SCIF0 */
+
+    {"sipF37", GPSR_REG_PIN (5U, 3U), PU_CTS0, DRVCTRL_CTS0, GRP_SCIF0},
+
+    /* SCIF1 */
+
+    {"sipE39", GPSR_REG_PIN (5U, 5U), PU_RX1,  DRVCTRL_RX1,  GRP_SCIF1_A},
+    {"sipE38", GPSR_REG_PIN (5U, 6U), PU_TX1,  DRVCTRL_TX1,  GRP_SCIF1_A},
+    {"sipH38", GPSR_REG_PIN (5U, 7U), PU_CTS1, DRVCTRL_CTS1, GRP_SCIF1_A},
+    {"sipH39", GPSR_REG_PIN (5U, 8U), PU_RTS1, DRVCTRL_RTS1, GRP_SCIF1_A},
+
+    /* SCIF2 */
+
+    {"sipL39", GPSR_REG_PIN (5U, 9U),  PU_SCK2, DRVCTRL_SCK2, GRP_SCIF2_A},
+    {"sipF38", GPSR_REG_PIN (5U, 10U), PU_TX2,  DRVCTRL_TX2,  GRP_SCIF2_A},
+    {"sipF39", GPSR_REG_PIN (5U, 11U), PU_RX2,  DRVCTRL_RX2,  GRP_SCIF2_A},
+
+    /* etheravb */
+
+    {"sipA16", GPSR_NONE,              PU_AVB_RX_CTL,    DRVCTRL_AVB_RX_CTL,    GRP_ETHERAVB},
+    {"sipB19", GPSR_NONE,              PU_AVB_RXC,       DRVCTRL_AVB_RXC,       GRP_ETHERAVB},
+    {"sipA13", GPSR_NONE,              PU_AVB_RD0,       DRVCTRL_AVB_RD0,       GRP_ETHERAVB},
+    {"sipB13", GPSR_NONE,              PU_AVB_RD1,       DRVCTRL_AVB_RD1,       GRP_ETHERAVB},
+    {"sipA14", GPSR_NONE,              PU_AVB_RD2,       DRVCTRL_AVB_RD2,       GRP_ETHERAVB},
+    {"sipB14", GPSR_NONE,              PU_AVB_RD3,       DRVCTRL_AVB_RD3,       GRP_ETHERAVB},
+    {"sipA8",  GPSR_NONE,              PU_AVB_TX_CTL,    DRVCTRL_AVB_TX_CTL,    GRP_ETHERAVB},
+    {"sipA19", GPSR_NONE,              PU_AVB_TXC,       DRVCTRL_AVB_TXC,       GRP_ETHERAVB},
+    {"sipA18", GPSR_NONE,              PU_AVB_TD0,       DRVCTRL_AVB_TD0,       GRP_ETHERAVB},
+    {"sipB18", GPSR_NONE,              PU_AVB_TD1,       DRVCTRL_AVB_TD1,       GRP_ETHERAVB},
+    {"sipA17", GPSR_NONE,              PU_AVB_TD2,       DRVCTRL_AVB_TD2,       GRP_ETHERAVB},
+    {"sipB17", GPSR_NONE,              PU_AVB_TD3,       DRVCTRL_AVB_TD3,       GRP_ETHERAVB},
+    {"sipA12", GPSR_NONE,              PU_AVB_TXCREFCLK, DRVCTRL_AVB_TXCREFCLK, GRP_ETHERAVB},
+    {"sipA9",  GPSR_NONE,              PU_AVB_MDIO,      DRVCTRL_AVB_MDIO,      GRP_ETHERAVB},
+    {"sipA15", GPSR_REG_PIN (2U, 9U),  PU_AVB_MDC,       DRVCTRL_AVB_MDC,       GRP_ETHERAVB},
+    {"sipB15", GPSR_REG_PIN (2U, 10U), PU_AVB_MAGIC,     DRVCTRL_AVB_MAGIC,     GRP_ETHERAVB},
+    {"sipB16", GPSR_REG_PIN (2U, 11U), PU_AVB_PHY_INT,   DRVCTRL_AVB_PHY_INT,   GRP_ETHERAVB},
+    {"sipB9",  GPSR_REG_PIN (2U, 12U), PU_AVB_LINK,      DRVCTRL_AVB_LINK,      GRP_ETHERAVB},
+
+    /* SD0 */
+
+    {"sipT35", GPSR_REG_PIN (3U, 0U), PU_SD0_CLK,  DRVCTRL_SD0_CLK,  GRP_SDHI0},
+    {"sipU33", GPSR_REG_PIN (3U, 1U), PU_SD0_CMD,  DRVCTRL_SD0_CMD,  GRP_SDHI0},
+    {"sipT33", GPSR_REG_PIN (3U, 2U), PU_SD0_DAT0, DRVCTRL_SD0_DAT0, GRP_SDHI0},
+    {"sipT32", GPSR_REG_PIN (3U, 3U), PU_SD0_DAT1, DRVCTRL_SD0_DAT1, GRP_SDHI0},
+    {"sipU35", GPSR_REG_PIN (3U, 4U), PU_SD0_DAT2, DRVCTRL_SD0_DAT2, GRP_SDHI0},
+    {"sipU34", GPSR_REG_PIN (3U, 5U), PU_SD0_DAT3, DRVCTRL_SD0_DAT3, GRP_SDHI0},
+
+    /* SD1 */
+
+    {"sipA27", GPSR_REG_PIN (3U, 8U),  PU_SD1_DAT0, DRVCTRL_SD1_DAT0, GRP_SDHI1},
+    {"sipB27", GPSR_REG_PIN (3U, 9U),  PU_SD1_DAT1, DRVCTRL_SD1_DAT1, GRP_SDHI1},
+    {"sipC27", GPSR_REG_PIN (3U, 10U), PU_SD1_DAT2, DRVCTRL_SD1_DAT2, GRP_SDHI1},
+    {"sipD27", GPSR_REG_PIN (3U, 11U), PU_SD1_DAT3, DRVCTRL_SD1_DAT3, GRP_SDHI1},
+
+    /* SD2 */
+
+    {"sipA26", GPSR_REG_PIN (4U, 0U), PU_SD2_CLK,  DRVCTRL_SD2_CLK,  GRP_SDHI2},
+    {"sipA25", GPSR_REG_PIN (4U, 1U), PU_SD2_CMD,  DRVCTRL_SD2_CMD,  GRP_SDHI2},
+    {"sipD26", GPSR_REG_PIN (4U, 2U), PU_SD2_DAT0, DRVCTRL_SD2_DAT0, GRP_SDHI2},
+    {"sipC25", GPSR_REG_PIN (4U, 3U), PU_SD2_DAT1, DRVCTRL_SD2_DAT1, GRP_SDHI2},
+    {"sipD24", GPSR_REG_PIN (4U, 4U), PU_SD2_DAT2, DRVCTRL_SD2_DAT2, GRP_SDHI2},
+    {"sipD23", GPSR_REG_PIN (4U, 5U), PU_SD2_DAT3, DRVCTRL_SD2_DAT3, GRP_SDHI2},
+    {"sipB25", GPSR_REG_PIN (4U, 6U), PU_SD2_DS,   DRVCTRL_SD2_DAT3, GRP_SDHI2},
+
+    /* SD3 */
+
+    {"sipM35", GPSR_REG_PIN (4U, 7U),  PU_SD3_CLK,  DRVCTRL_SD3_CLK,  GRP_SDHI3},
+    {"sipM31", GPSR_REG_PIN (4U, 8U),  PU_SD3_CMD,  DRVCTRL_SD3_CMD,  GRP_SDHI3},
+    {"sipL33", GPSR_REG_PIN (4U, 9U),  PU_SD3_DAT0, DRVCTRL_SD3_DAT0, GRP_SDHI3},
+    {"sipM30", GPSR_REG_PIN (4U, 10U), PU_SD3_DAT1, DRVCTRL_SD3_DAT1, GRP_SDHI3},
+    {"sipM32", GPSR_REG_PIN (4U, 11U), PU_SD3_DAT2, DRVCTRL_SD3_DAT2, GRP_SDHI3},
+    {"sipL34", GPSR_REG_PIN (4U, 12U), PU_SD3_DAT3, DRVCTRL_SD3_DAT3, GRP_SDHI3},
+    {"sipM33", GPSR_REG_PIN (4U, 13U), PU_SD3_DAT4, DRVCTRL_SD3_DAT4, GRP_SDHI3},
+    {"sipN33", GPSR_REG_PIN (4U, 14U), PU_SD3_DAT5, DRVCTRL_SD3_DAT5, GRP_SDHI3},
+    {"sipN32", GPSR_REG_PIN (4U, 15U), PU_SD3_DAT6, DRVCTRL_SD3_DAT6, GRP_SDHI3},
+    {"sipN31", GPSR_REG_PIN (4U, 16U), PU_SD3_DAT7, DRVCTRL_SD3_DAT7, GRP_SDHI3},
+    {"sipN30", GPSR_REG_PIN (4U, 17U), PU_SD3_DS,   DRVCTRL_SD3_DAT7, GRP_SDHI3},
+
+    /* I2C0 */
+
+    {"sipC29", GPSR_REG_PIN (3U, 14U), PU_SD1_CD, DRVCTRL_SD1_CD, GRP_I2C0},
+    {"sipB29", GPSR_REG_PIN (3U, 15U), PU_SD1_WP, DRVCTRL_SD1_WP, GRP_I2C0},
+
+    /* I2C1_A */
+
+    {"sipAB34", GPSR_REG_PIN (5U, 10U), PU_TX2, DRVCTRL_TX2, GRP_I2C1_A},
+    {"sipAB33", GPSR_REG_PIN (5U, 11U), PU_RX2, DRVCTRL_RX2, GRP_I2C1_A},
+
+    /* I2C1_B */
+
+    {"sipAA39", GPSR_REG_PIN (5U, 23U), PU_MLB_CLK, DRVCTRL_MLB_CLK, GRP_I2C1_B},
+    {"sipJ39",  GPSR_REG_PIN (5U, 24U), PU_MLB_SIG, DRVCTRL_MLB_SIG, GRP_I2C1_B},
+
+    /* I2C2_A */
+
+    {"sipG39", GPSR_REG_PIN (5U, 4U), PU_RTS0, DRVCTRL_RTS0, GRP_I2C2_A},
+    {"sipK39", GPSR_REG_PIN (5U, 0U), PU_SCK0, DRVCTRL_SCK0, GRP_I2C2_A},
+
+    /* I2C2_B */
+
+    {"sipV31", GPSR_REG_PIN (3U, 12U), PU_SD0_CD, DRVCTRL_SD0_CD, GRP_I2C2_B},
+    {"sipV30", GPSR_REG_PIN (3U, 13U), PU_SD0_WP, DRVCTRL_SCK0,   GRP_I2C2_B},
+
+    /* I2C3 */
+
+    {"sipB6", GPSR_REG_PIN (2U, 7U), PU_PWM1, DRVCTRL_PWM1, GRP_I2C3},
+    {"sipA6", GPSR_REG_PIN (2U, 8U), PU_PWM2, DRVCTRL_PWM2, GRP_I2C3},
+
+    /* I2C5 */
+
+    {"sipB11", GPSR_REG_PIN (2U, 13U), PU_AVB_MATCH,   DRVCTRL_AVB_MATCH,   GRP_I2C5},
+    {"sipA11", GPSR_REG_PIN (2U, 14U), PU_AVB_CAPTURE, DRVCTRL_AVB_CAPTURE, GRP_I2C5},
+
+    /* I2C6_A */
+
+    {"sipJ1", GPSR_REG_PIN (1U, 11U), PU_A11, DRVCTRL_A11, GRP_I2C6_A},
+    {"sipK2", GPSR_REG_PIN (1U, 8U),  PU_A8,  DRVCTRL_A8,  GRP_I2C6_A},
+
+    /* I2C6_B */
+
+    {"sipB1", GPSR_REG_PIN (1U, 25U), PU_WE0, DRVCTRL_WE0, GRP_I2C6_B},
+    {"sipD2", GPSR_REG_PIN (1U, 26U), PU_WE1, DRVCTRL_WE1, GRP_I2C6_B},
+
+    /* I2C6_C */
+
+    {"sipR2", GPSR_REG_PIN (0U, 14U), PU_D14, DRVCTRL_D14, GRP_I2C6_C},
+    {"sipR1", GPSR_REG_PIN (0U, 15U), PU_D15, DRVCTRL_D15, GRP_I2C6_C},
+
+    /* USB 3.0 */
+
+    {"sipAJ33", GPSR_REG_PIN (6U, 28U), PU_USB3_PWEN, DRVCTRL_USB3_PWEN, GRP_USB3},
+    {"sipAH30", GPSR_REG_PIN (6U, 29U), PU_USB3_OVC,  DRVCTRL_USB3_OVC,  GRP_USB3},
+
+    /* USB2 ch1 */
+
+    {"sipAH34", GPSR_REG_PIN (6U, 26U), PU_USB1_PWEN, DRVCTRL_USB1_PWEN, GRP_USB1},
+    {"sipAH33", GPSR_REG_PIN (6U, 27U), PU_USB1_OVC,  DRVCTRL_USB1_OVC,  GRP_USB1},
+
+    /* USB2 ch0 */
+
+    {"sipAH31", GPSR_REG_PIN (6U, 24U), PU_USB0_PWEN, DRVCTRL_USB0_PWEN, GRP_USB0},
+    {"sipAH32", GPSR_REG_PIN (6U, 25U), PU_USB0_OVC,  DRVCTRL_USB0_OVC,  GRP_USB0},
+
+    /* SCIF1_B (MLB_SIG/MLB_DAT), MLB_SIG is also SDA1_B */
+
+    {"GP5_25", GPSR_REG_PIN (5U, 25U), PU_MLB_DAT, DRVCTRL_MLB_DAT, GRP_SCIF1_B},
+
+    /* SCIF3_A (RD/RD_WR), SCIF3_B shares the I2C6_A pads */
+
+    {"GP1_23", GPSR_REG_PIN (1U, 23U), PU_RD,    DRVCTRL_RD,    GRP_SCIF3_A},
+    {"GP1_24", GPSR_REG_PIN (1U, 24U), PU_RD_WR, DRVCTRL_RD_WR, GRP_SCIF3_A},
+
+    /* SCIF4_B (A6/A7) and SCIF4_C (D12/D13), SCIF4_A shares AVB pads */
+
+    {"GP1_6",  GPSR_REG_PIN (1U, 6U),  PU_A6,  DRVCTRL_A6,  GRP_SCIF4_B},
+    {"GP1_7",  GPSR_REG_PIN (1U, 7U),  PU_A7,  DRVCTRL_A7,  GRP_SCIF4_B},
+    {"GP0_12", GPSR_REG_PIN (0U, 12U), PU_D12, DRVCTRL_D12, GRP_SCIF4_C},
+    {"GP0_13", GPSR_REG_PIN (0U, 13U), PU_D13, DRVCTRL_D13, GRP_SCIF4_C},
+
+    /* SCIF5_A (MSIOF0_SS1/SS2) and SCIF5_B (HSCK0/MSIOF0_SYNC) */
+
+    {"GP5_19", GPSR_REG_PIN (5U, 19U), PU_MSIOF0_SS1,  DRVCTRL_MSIOF0_SS1,  GRP_SCIF5_A},
+    {"GP5_21", GPSR_REG_PIN (5U, 21U), PU_MSIOF0_SS2,  DRVCTRL_MSIOF0_SS2,  GRP_SCIF5_A},
+    {"GP5_12", GPSR_REG_PIN (5U, 12U), PU_HSCK0,       DRVCTRL_HSCK0,       GRP_SCIF5_B},
+    {"GP5_18", GPSR_REG_PIN (5U, 18U), PU_MSIOF0_SYNC, DRVCTRL_MSIOF0_SYNC, GRP_SCIF5_B},
+
+    /* SCIF0 RX0/TX0, also HSCIF1_B */
+
+    {"GP5_1", GPSR_REG_PIN (5U, 1U), PU_RX0, DRVCTRL_RX0, GRP_SCIF0},
+    {"GP5_2", GPSR_REG_PIN (5U, 2U), PU_TX0, DRVCTRL_TX0, GRP_SCIF0},
+
+    /* HSCIF0, HCTS0#/HRTS0# are also RX2_B/TX2_B */
+
+    {"GP5_13", GPSR_REG_PIN (5U, 13U), PU_HRX0,  DRVCTRL_HRX0,  GRP_HSCIF0},
+    {"GP5_14", GPSR_REG_PIN (5U, 14U), PU_HTX0,  DRVCTRL_HTX0,  GRP_HSCIF0},
+    {"GP5_15", GPSR_REG_PIN (5U, 15U), PU_HCTS0, DRVCTRL_HCTS0, GRP_HSCIF0_CTRL},
+    {"GP5_16", GPSR_REG_PIN (5U, 16U), PU_HRTS0, DRVCTRL_HRTS0, GRP_HSCIF0_CTRL},
+
+    /* MSIOF0, SYNC/SS1/SS2 are the SCIF5 pads above */
+
+    {"GP5_17", GPSR_REG_PIN (5U, 17U), PU_MSIOF0_SCK, DRVCTRL_MSIOF0_SCK, GRP_MSIOF0},
+    {"GP5_20", GPSR_REG_PIN (5U, 20U), PU_MSIOF0_TXD, DRVCTRL_MSIOF0_TXD, GRP_MSIOF0},
+    {"GP5_22", GPSR_REG_PIN (5U, 22U), PU_MSIOF0_RXD, DRVCTRL_MSIOF0_RXD, GRP_MSIOF0},
+
+    /* CAN-FD0_B (IRQ0/IRQ1), CAN-FD0_A shares the SCIF3_A pads */
+
+    {"GP2_0", GPSR_REG_PIN (2U, 0U), PU_IRQ0, DRVCTRL_IRQ0, GRP_CANFD0_B},
+    {"GP2_1", GPSR_REG_PIN (2U, 1U), PU_IRQ1, DRVCTRL_IRQ1, GRP_CANFD0_B},
+
+    /* RPC-IF dedicated pins, named by signal */
+
+    {"QSPI0_SPCLK",    GPSR_NONE, PU_QSPI0_SPCLK,    DRVCTRL_QSPI0_SPCLK,    GRP_RPC},
+    {"QSPI0_MOSI_IO0", GPSR_NONE, PU_QSPI0_MOSI_IO0, DRVCTRL_QSPI0_MOSI_IO0, GRP_RPC},
+    {"QSPI0_MISO_IO1", GPSR_NONE, PU_QSPI0_MISO_IO1, DRVCTRL_QSPI0_MISO_IO1, GRP_RPC},
+    {"QSPI0_IO2",      GPSR_NONE, PU_QSPI0_IO2,      DRVCTRL_QSPI0_IO2,      GRP_RPC},
+    {"QSPI0_IO3",      GPSR_NONE, PU_QSPI0_IO3,      DRVCTRL_QSPI0_IO3,      GRP_RPC},
+    {"QSPI0_SSL",      GPSR_NONE, PU_QSPI0_SSL,      DRVCTRL_QSPI0_SSL,      GRP_RPC},
+    {"QSPI1_SPCLK",    GPSR_NONE, PU_QSPI1_SPCLK,    DRVCTRL_QSPI1_SPCLK,    GRP_RPC},
+    {"QSPI1_MOSI_IO0", GPSR_NONE, PU_QSPI1_MOSI_IO0, DRVCTRL_QSPI1_MOSI_IO0, GRP_RPC},
+    {"QSPI1_MISO_IO1", GPSR_NONE, PU_QSPI1_MISO_IO1, DRVCTRL_QSPI1_MISO_IO1, GRP_RPC},
+    {"QSPI1_IO2",      GPSR_NONE, PU_QSPI1_IO2,      DRVCTRL_QSPI1_IO2,      GRP_RPC},
+    {"QSPI1_IO3",      GPSR_NONE, PU_QSPI1_IO3,      DRVCTRL_QSPI1_IO3,      GRP_RPC},
+    {"QSPI1_SSL",      GPSR_NONE, PU_QSPI1_SSL,      DRVCTRL_QSPI1_SSL,      GRP_RPC},
+    {"RPC_INT#",       GPSR_NONE, PU_RPC_INT,        DRVCTRL_RPC_INT,        GRP_RPC},
+    {"RPC_WP#",        GPSR_NONE, PU_RPC_WP,         DRVCTRL_RPC_WP,         GRP_RPC},
+    {"RPC_RESET#",     GPSR_NONE, PU_RPC_RESET,      DRVCTRL_RPC_RESET,      GRP_RPC},
+
+    {NULL, GPSR_NONE, 0U, 0U, GRP_NONE}                     /* list terminator */
+    };
+
+/*
+ * pin groups of each pfcPins entry
+ *
+ * A pin is in the groups of all the pfcPins entries for its pad, and in the
+ * other groups listed for the pad in pins.csv.
+ */
+
+LOCAL const UINT64 pfcPinGroups [NELEMENTS (pfcPins)] =
+    {
+    PFC_GROUP_BIT (GRP_SCIF0),                              /* sipF37 */
+    PFC_GROUP_BIT (GRP_SCIF1_A) |
+        PFC_GROUP_BIT (GRP_HSCIF1_A),                       /* sipE39 */
+    PFC_GROUP_BIT (GRP_SCIF1_A) |
+        PFC_GROUP_BIT (GRP_HSCIF1_A),                       /* sipE38 */
+    PFC_GROUP_BIT (GRP_SCIF1_A),                            /* sipH38 */
+    PFC_GROUP_BIT (GRP_SCIF1_A),                            /* sipH39 */
+    PFC_GROUP_BIT (GRP_SCIF2_A),                            /* sipL39 */
+    PFC_GROUP_BIT (GRP_SCIF2_A) |
+        PFC_GROUP_BIT (GRP_I2C1_A),                         /* sipF38 */
+    PFC_GROUP_BIT (GRP_SCIF2_A) |
+        PFC_GROUP_BIT (GRP_I2C1_A),                         /* sipF39 */
+    PFC_GROUP_BIT (GRP_ETHERAVB),                           /* sipA16 */
+    PFC_GROUP_BIT (GRP_ETHERAVB),                           /* sipB19 */
+    PFC_GROUP_BIT (GRP_ETHERAVB),                           /* sipA13 */
+    PFC_GROUP_BIT (GRP_ETHERAVB),                           /* sipB13 */
+    PFC_GROUP_BIT (GRP_ETHERAVB),                           /* sipA14 */
+    PFC_GROUP_BIT (GRP_ETHERAVB),                           /* sipB14 */
+    PFC_GROUP_BIT (GRP_ETHERAVB),                           /* sipA8 */
+    PFC_GROUP_BIT (GRP_ETHERAVB),                           /* sipA19 */
+    PFC_GROUP_BIT (GRP_ETHERAVB),                           /* sipA18 */
+    PFC_GROUP_BIT (GRP_ETHERAVB),                           /* sipB18 */
+    PFC_GROUP_BIT (GRP_ETHERAVB),                           /* sipA17 */
+    PFC_GROUP_BIT (GRP_ETHERAVB),                           /* sipB17 */
+    PFC_GROUP_BIT (GRP_ETHERAVB),                           /* sipA12 */
+    PFC_GROUP_BIT (GRP_ETHERAVB),                           /* sipA9 */
+    PFC_GROUP_BIT (GRP_ETHERAVB),                           /* sipA15 */
+    PFC_GROUP_BIT (GRP_ETHERAVB),                           /* sipB15 */
+    PFC_GROUP_BIT (GRP_SCIF4_A) |
+        PFC_GROUP_BIT (GRP_ETHERAVB),                       /* sipB16 */
+    PFC_GROUP_BIT (GRP_SCIF4_A) |
+        PFC_GROUP_BIT (GRP_ETHERAVB),                       /* sipB9 */
+    PFC_GROUP_BIT (GRP_SDHI0),                              /* sipT35 */
+    PFC_GROUP_BIT (GRP_SDHI0),                              /* sipU33 */
+    PFC_GROUP_BIT (GRP_SDHI0),                              /* sipT33 */
+    PFC_GROUP_BIT (GRP_SDHI0),                              /* sipT32 */
+    PFC_GROUP_BIT (GRP_SDHI0),                              /* sipU35 */
+    PFC_GROUP_BIT (GRP_SDHI0),                              /* sipU34 */
+    PFC_GROUP_BIT (GRP_SDHI1),                              /* sipA27 */
+    PFC_GROUP_BIT (GRP_SDHI1),                              /* sipB27 */
+    PFC_GROUP_BIT (GRP_SDHI1),                              /* sipC27 */
+    PFC_GROUP_BIT (GRP_SDHI1),                              /* sipD27 */
+    PFC_GROUP_BIT (GRP_SDHI2),                              /* sipA26 */
+    PFC_GROUP_BIT (GRP_SDHI2),                              /* sipA25 */
+    PFC_GROUP_BIT (GRP_SDHI2),                              /* sipD26 */
+    PFC_GROUP_BIT (GRP_SDHI2),                              /* sipC25 */
+    PFC_GROUP_BIT (GRP_SDHI2),                              /* sipD24 */
+    PFC_GROUP_BIT (GRP_SDHI2),                              /* sipD23 */
+    PFC_GROUP_BIT (GRP_SDHI2),                              /* sipB25 */
+    PFC_GROUP_BIT (GRP_SDHI3),                              /* sipM35 */
+    PFC_GROUP_BIT (GRP_SDHI3),                              /* sipM31 */
+    PFC_GROUP_BIT (GRP_SDHI3),                              /* sipL33 */
+    PFC_GROUP_BIT (GRP_SDHI3),                              /* sipM30 */
+    PFC_GROUP_BIT (GRP_SDHI3),                              /* sipM32 */
+    PFC_GROUP_BIT (GRP_SDHI3),                              /* sipL34 */
+    PFC_GROUP_BIT (GRP_SDHI3),                              /* sipM33 */
+    PFC_GROUP_BIT (GRP_SDHI3),                              /* sipN33 */
+    PFC_GROUP_BIT (GRP_SDHI3),                              /* sipN32 */
+    PFC_GROUP_BIT (GRP_SDHI3),                              /* sipN31 */
+    PFC_GROUP_BIT (GRP_SDHI3),                              /* sipN30 */
+    PFC_GROUP_BIT (GRP_I2C0),                               /* sipC29 */
+    PFC_GROUP_BIT (GRP_I2C0),                               /* sipB29 */
+    PFC_GROUP_BIT (GRP_SCIF2_A) |
+        PFC_GROUP_BIT (GRP_I2C1_A),                         /* sipAB34 */
+    PFC_GROUP_BIT (GRP_SCIF2_A) |
+        PFC_GROUP_BIT (GRP_I2C1_A),                         /* sipAB33 */
+    PFC_GROUP_BIT (GRP_I2C1_B),                             /* sipAA39 */
+    PFC_GROUP_BIT (GRP_SCIF1_B) |
+        PFC_GROUP_BIT (GRP_I2C1_B),                         /* sipJ39 */
+    PFC_GROUP_BIT (GRP_I2C2_A),                             /* sipG39 */
+    PFC_GROUP_BIT (GRP_I2C2_A),                             /* sipK39 */
+    PFC_GROUP_BIT (GRP_I2C2_B),                             /* sipV31 */
+    PFC_GROUP_BIT (GRP_I2C2_B),                             /* sipV30 */
+    PFC_GROUP_BIT (GRP_I2C3),                               /* sipB6 */
+    PFC_GROUP_BIT (GRP_I2C3),                               /* sipA6 */
+    PFC_GROUP_BIT (GRP_I2C5),                               /* sipB11 */
+    PFC_GROUP_BIT (GRP_I2C5),                               /* sipA11 */
+    PFC_GROUP_BIT (GRP_SCIF3_B) |
+        PFC_GROUP_BIT (GRP_I2C6_A),                         /* sipJ1 */
+    PFC_GROUP_BIT (GRP_SCIF3_B) |
+        PFC_GROUP_BIT (GRP_I2C6_A),                         /* sipK2 */
+    PFC_GROUP_BIT (GRP_I2C6_B),                             /* sipB1 */
+    PFC_GROUP_BIT (GRP_I2C6_B),                             /* sipD2 */
+    PFC_GROUP_BIT (GRP_I2C6_C),                             /* sipR2 */
+    PFC_GROUP_BIT (GRP_I2C6_C),                             /* sipR1 */
+    PFC_GROUP_BIT (GRP_USB3),                               /* sipAJ33 */
+    PFC_GROUP_BIT (GRP_USB3),                               /* sipAH30 */
+    PFC_GROUP_BIT (GRP_USB1),                               /* sipAH34 */
+    PFC_GROUP_BIT (GRP_USB1),                               /* sipAH33 */
+    PFC_GROUP_BIT (GRP_USB0),                               /* sipAH31 */
+    PFC_GROUP_BIT (GRP_USB0),                               /* sipAH32 */
+    PFC_GROUP_BIT (GRP_SCIF1_B),                            /* GP5_25 */
+    PFC_GROUP_BIT (GRP_CANFD0_A) |
+        PFC_GROUP_BIT (GRP_SCIF3_A),                        /* GP1_23 */
+    PFC_GROUP_BIT (GRP_CANFD0_A) |
+        PFC_GROUP_BIT (GRP_SCIF3_A),                        /* GP1_24 */
+    PFC_GROUP_BIT (GRP_SCIF4_B),                            /* GP1_6 */
+    PFC_GROUP_BIT (GRP_SCIF4_B),                            /* GP1_7 */
+    PFC_GROUP_BIT (GRP_SCIF4_C),                            /* GP0_12 */
+    PFC_GROUP_BIT (GRP_SCIF4_C),                            /* GP0_13 */
+    PFC_GROUP_BIT (GRP_SCIF5_A) |
+        PFC_GROUP_BIT (GRP_MSIOF0_SS1),                     /* GP5_19 */
+    PFC_GROUP_BIT (GRP_SCIF5_A) |
+        PFC_GROUP_BIT (GRP_MSIOF0_SS2),                     /* GP5_21 */
+    PFC_GROUP_BIT (GRP_SCIF5_B),                            /* GP5_12 */
+    PFC_GROUP_BIT (GRP_SCIF5_B) |
+        PFC_GROUP_BIT (GRP_MSIOF0),                         /* GP5_18 */
+    PFC_GROUP_BIT (GRP_SCIF0) |
+        PFC_GROUP_BIT (GRP_HSCIF1_B),                       /* GP5_1 */
+    PFC_GROUP_BIT (GRP_SCIF0) |
+        PFC_GROUP_BIT (GRP_HSCIF1_B),                       /* GP5_2 */
+    PFC_GROUP_BIT (GRP_HSCIF0),                             /* GP5_13 */
+    PFC_GROUP_BIT (GRP_HSCIF0),                             /* GP5_14 */
+    PFC_GROUP_BIT (GRP_SCIF2_B) |
+        PFC_GROUP_BIT (GRP_HSCIF0_CTRL),                    /* GP5_15 */
+    PFC_GROUP_BIT (GRP_SCIF2_B) |
+        PFC_GROUP_BIT (GRP_HSCIF0_CTRL),                    /* GP5_16 */
+    PFC_GROUP_BIT (GRP_MSIOF0),                             /* GP5_17 */
+    PFC_GROUP_BIT (GRP_MSIOF0),                             /* GP5_20 */
+    PFC_GROUP_BIT (GRP_MSIOF0),                             /* GP5_22 */
+    PFC_GROUP_BIT (GRP_CANFD0_B),                           /* GP2_0 */
+    PFC_GROUP_BIT (GRP_CANFD0_B),                           /* GP2_1 */
+    PFC_GROUP_BIT (GRP_RPC),                                /* QSPI0_SPCLK */
+    PFC_GROUP_BIT (GRP_RPC),                                /* QSPI0_MOSI_IO0 */
+    PFC_GROUP_BIT (GRP_RPC),                                /* QSPI0_MISO_IO1 */
+    PFC_GROUP_BIT (GRP_RPC),                                /* QSPI0_IO2 */
+    PFC_GROUP_BIT (GRP_RPC),                                /* QSPI0_IO3 */
+    PFC_GROUP_BIT (GRP_RPC),                                /* QSPI0_SSL */
+    PFC_GROUP_BIT (GRP_RPC),                                /* QSPI1_SPCLK */
+    PFC_GROUP_BIT (GRP_RPC),                                /* QSPI1_MOSI_IO0 */
+    PFC_GROUP_BIT (GRP_RPC),                                /* QSPI1_MISO_IO1 */
+    PFC_GROUP_BIT (GRP_RPC),                                /* QSPI1_IO2 */
+    PFC_GROUP_BIT (GRP_RPC),                                /* QSPI1_IO3 */
+    PFC_GROUP_BIT (GRP_RPC),                                /* QSPI1_SSL */
+    PFC_GROUP_BIT (GRP_RPC),                                /* RPC_INT# */
+    PFC_GROUP_BIT (GRP_RPC),                                /* RPC_WP# */
+    PFC_GROUP_BIT (GRP_RPC),                                /* RPC_RESET# */
+    0U                                                      /* list terminator */
+    };
+
+/* function names referenced in the device tree, mapped to enumeration */
+
+LOCAL const PFC_FUNCTION pfcFuncs [] =
+    {
+    { FN_SCIF0,    "scif0" },
+    { FN_SCIF1,    "scif1" },
+    { FN_SCIF2,    "scif2" },
+    { FN_SCIF3,    "scif3" },
+    { FN_SCIF4,    "scif4" },
+    { FN_SCIF5,    "scif5" },
+    { FN_HSCIF0,   "hscif0" },
+    { FN_HSCIF1,   "hscif1" },
+    { FN_MSIOF0,   "msiof0" },
+    { FN_CANFD0,   "canfd0" },
+    { FN_RPC,      "rpc" },
+    { FN_ETHERAVB, "etheravb" },
+    { FN_SDHI0,    "sdhi0" },
+    { FN_SDHI3,    "sdhi3" },
+    { FN_MMC0,     "mmc0" },
+    { FN_MMC1,     "mmc1" },
+    { FN_I2C0,     "i2c0" },
+    { FN_I2C1,     "i2c1" },
+    { FN_I2C2,     "i2c2" },
+    { FN_I2C3,     "i2c3" },
+    { FN_I2C4,     "i2c4" },
+    { FN_I2C5,     "i2c5" },
+    { FN_I2C6,     "i2c6" },
+    { FN_USB0,     "usb0" },
+    { FN_USB1,     "usb1" },
+    { FN_USB3,     "usb3" }
+    };
+#define PFC_NUM_FUNCS   (NELEMENTS (pfcFuncs))
+
+/*
+ * supported PFC peripheral function selections, with the setting of the IPSR
+ * field of each pin
+ */
+
+LOCAL const PFC_FUNC_DESC xPfcFuncSel [] =
+    {
+    { GRP_SCIF0,       FN_SCIF0,    IPSR_RX0,         0U }, /* RX0 */
+    { GRP_SCIF0,       FN_SCIF0,    IPSR_TX0,         0U }, /* TX0 */
+
+    { GRP_SCIF1_A,     FN_SCIF1,    IPSR_RX1_A,       0U }, /* RX1_A */
+    { GRP_SCIF1_A,     FN_SCIF1,    IPSR_TX1_A,       0U }, /* TX1_A */
+    { GRP_SCIF1_A,     FN_SCIF1,    IPSR_CTS1,        0U }, /* CTS1# */
+    { GRP_SCIF1_A,     FN_SCIF1,    IPSR_RTS1,        0U }, /* RTS1# */
+    { GRP_SCIF1_B,     FN_SCIF1,    IPSR_RX1_B,       1U }, /* RX1_B */
+    { GRP_SCIF1_B,     FN_SCIF1,    IPSR_TX1_B,       1U }, /* TX1_B */
+    { GRP_SCIF1_B,     FN_SCIF1,    IPSR_CTS1,        0U }, /* CTS1# */
+    { GRP_SCIF1_B,     FN_SCIF1,    IPSR_RTS1,        0U }, /* RTS1# */
+
+    { GRP_SCIF2_A,     FN_SCIF2,    IPSR_TX2_A,       0U }, /* TX2_A */
+    { GRP_SCIF2_A,     FN_SCIF2,    IPSR_RX2_A,       0U }, /* RX2_A */
+    { GRP_SCIF2_B,     FN_SCIF2,    IPSR_TX2_B,       1U }, /* TX2_B */
+    { GRP_SCIF2_B,     FN_SCIF2,    IPSR_RX2_B,       1U }, /* RX2_B */
+
+    { GRP_SCIF3_A,     FN_SCIF3,    IPSR_TX3_A,       3U }, /* TX3_A */
+    { GRP_SCIF3_A,     FN_SCIF3,    IPSR_RX3_A,       3U }, /* RX3_A */
+    { GRP_SCIF3_B,     FN_SCIF3,    IPSR_TX3_B,       1U }, /* TX3_B */
+    { GRP_SCIF3_B,     FN_SCIF3,    IPSR_RX3_B,       1U }, /* RX3_B */
+
+    { GRP_SCIF4_A,     FN_SCIF4,    IPSR_TX4_A,       3U }, /* TX4_A */
+    { GRP_SCIF4_A,     FN_SCIF4,    IPSR_RX4_A,       3U }, /* RX4_A */
+    { GRP_SCIF4_B,     FN_SCIF4,    IPSR_TX4_B,       3U }, /* TX4_B */
+    { GRP_SCIF4_B,     FN_SCIF4,    IPSR_RX4_B,       3U }, /* RX4_B */
+    { GRP_SCIF4_C,     FN_SCIF4,    IPSR_TX4_C,       3U }, /* TX4_C */
+    { GRP_SCIF4_C,     FN_SCIF4,    IPSR_RX4_C,       3U }, /* RX4_C */
+
+    { GRP_SCIF5_A,     FN_SCIF5,    IPSR_TX5_A,       1U }, /* TX5_A */
+    { GRP_SCIF5_A,     FN_SCIF5,    IPSR_RX5_A,       1U }, /* RX5_A */
+    { GRP_SCIF5_B,     FN_SCIF5,    IPSR_TX5_B,       0xaU }, /* TX5_B */
+    { GRP_SCIF5_B,     FN_SCIF5,    IPSR_RX5_B,       0xaU }, /* RX5_B */
+
+    { GRP_HSCIF0,      FN_HSCIF0,   IPSR_HRX0,        0U }, /* HRX0 */
+    { GRP_HSCIF0,      FN_HSCIF0,   IPSR_HTX0,        0U }, /* HTX0 */
+    { GRP_HSCIF0_CTRL, FN_HSCIF0,   IPSR_HCTS0,       0U }, /* HCTS0# */
+    { GRP_HSCIF0_CTRL, FN_HSCIF0,   IPSR_HRTS0,       0U }, /* HRTS0# */
+
+    { GRP_HSCIF1_A,    FN_HSCIF1,   IPSR_HRX1_A,      1U }, /* HRX1_A */
+    { GRP_HSCIF1_A,    FN_HSCIF1,   IPSR_HTX1_A,      1U }, /* HTX1_A */
+    { GRP_HSCIF1_B,    FN_HSCIF1,   IPSR_HRX1_B,      1U }, /* HRX1_B */
+    { GRP_HSCIF1_B,    FN_HSCIF1,   IPSR_HTX1_B,      1U }, /* HTX1_B */
+
+    { GRP_MSIOF0,      FN_MSIOF0,   IPSR_MSIOF0_SYNC, 0U }, /* MSIOF0_SYNC */
+    { GRP_MSIOF0_SS1,  FN_MSIOF0,   IPSR_MSIOF0_SS1,  0U }, /* MSIOF0_SS1 */
+    { GRP_MSIOF0_SS2,  FN_MSIOF0,   IPSR_MSIOF0_SS2,  0U }, /* MSIOF0_SS2 */
+
+    { GRP_CANFD0_A,    FN_CANFD0,   IPSR_CANFD0_TX_A, 6U }, /* CANFD0_TX_A */
+    { GRP_CANFD0_A,    FN_CANFD0,   IPSR_CANFD0_RX_A, 6U }, /* CANFD0_RX_A */
+    { GRP_CANFD0_B,    FN_CANFD0,   IPSR_CANFD0_TX_B, 6U }, /* CANFD0_TX_B */
+    { GRP_CANFD0_B,    FN_CANFD0,   IPSR_CANFD0_RX_B, 6U }, /* CANFD0_RX_B */
+
+    { GRP_ETHERAVB,    FN_ETHERAVB, IPSR_AVB_MDC,     0U }, /* AVB_MDC */
+    { GRP_ETHERAVB,    FN_ETHERAVB, IPSR_AVB_PHY_INT, 0U }, /* AVB_PHY_INT */
+    { GRP_ETHERAVB,    FN_ETHERAVB, IPSR_AVB_LINK,    0U }, /* AVB_AVB_LINK */
+
+    { GRP_SDHI0,       FN_SDHI0,    IPSR_SD0_DAT0,    0U }, /* SD0 DAT0 */
+    { GRP_SDHI0,       FN_SDHI0,    IPSR_SD0_DAT1,    0U }, /* SD0 DAT1 */
+    { GRP_SDHI0,       FN_SDHI0,    IPSR_SD0_DAT2,    0U }, /* SD0 DAT2 */
+    { GRP_SDHI0,       FN_SDHI0,    IPSR_SD0_DAT3,    0U }, /* SD0 DAT3 */
+    { GRP_SDHI0,       FN_SDHI0,    IPSR_SD0_CLK,     0U }, /* SD0 CLK */
+    { GRP_SDHI0,       FN_SDHI0,    IPSR_SD0_CMD,     0U }, /* SD0 CMD */
+
+    { GRP_SDHI1,       FN_MMC0,     IPSR_SD1_DAT0,    1U }, /* MMC0_DAT4 */
+    { GRP_SDHI1,       FN_MMC0,     IPSR_SD1_DAT1,    1U }, /* MMC0_DAT5 */
+    { GRP_SDHI1,       FN_MMC0,     IPSR_SD1_DAT2,    1U }, /* MMC0_DAT6 */
+    { GRP_SDHI1,       FN_MMC0,     IPSR_SD1_DAT3,    1U }, /* MMC0_DAT7 */
+    { GRP_SDHI2,       FN_MMC0,     IPSR_SD2_CLK,     0U }, /* MMC0_CLK */
+    { GRP_SDHI2,       FN_MMC0,     IPSR_SD2_CMD,     0U }, /* MMC0_CMD */
+    { GRP_SDHI2,       FN_MMC0,     IPSR_SD2_DAT0,    0U }, /* MMC0_DAT0 */
+    { GRP_SDHI2,       FN_MMC0,     IPSR_SD2_DAT1,    0U }, /* MMC0_DAT1 */
+    { GRP_SDHI2,       FN_MMC0,     IPSR_SD2_DAT2,    0U }, /* MMC0_DAT2 */
+    { GRP_SDHI2,       FN_MMC0,     IPSR_SD2_DAT3,    0U }, /* MMC0_DAT3 */
+    { GRP_SDHI2,       FN_MMC0,     IPSR_SD2_DS,      0U }, /* MMC0_DS */
+
+    { GRP_SDHI3,       FN_MMC1,     IPSR_SD3_CMD,     0U }, /* MMC1 CMD */
+    { GRP_SDHI3,       FN_MMC1,     IPSR_SD3_CLK,     0U }, /* MMC1_CLK */
+    { GRP_SDHI3,       FN_MMC1,     IPSR_SD3_DAT0,    0U }, /* MMC1_DAT0 */
+    { GRP_SDHI3,       FN_MMC1,     IPSR_SD3_DAT1,    0U }, /* MMC1_DAT1 */
+    { GRP_SDHI3,       FN_MMC1,     IPSR_SD3_DAT2,    0U }, /* MMC1_DAT2 */
+    { GRP_SDHI3,       FN_MMC1,     IPSR_SD3_DAT3,    0U }, /* MMC1_DAT3 */
+    { GRP_SDHI3,       FN_MMC1,     IPSR_SD3_DAT4,    0U }, /* MMC1_DAT4 */
+    { GRP_SDHI3,       FN_MMC1,     IPSR_SD3_DAT5,    0U }, /* MMC1_DAT5 */
+    { GRP_SDHI3,       FN_MMC1,     IPSR_SD3_DAT6,    0U }, /* MMC1_DAT6 */
+    { GRP_SDHI3,       FN_MMC1,     IPSR_SD3_DAT7,    0U }, /* MMC1_DAT7 */
+    { GRP_SDHI3,       FN_MMC1,     IPSR_SD3_DS,      0U }, /* MMC1_DS */
+
+    /* no function select for I2C 0,3,4,5 */
+
+    { GRP_I2C1_A,      FN_I2C1,     IPSR_SCL1_A,      4U }, /* SCL1_A */
+    { GRP_I2C1_A,      FN_I2C1,     IPSR_SDA1_A,      4U }, /* SDA1_A */
+    { GRP_I2C1_B,      FN_I2C1,     IPSR_SCL1_B,      4U }, /* SCL1_B */
+    { GRP_I2C1_B,      FN_I2C1,     IPSR_SDA1_B,      4U }, /* SDA1_B */
+
+    { GRP_I2C2_A,      FN_I2C2,     IPSR_SCL2_A,      4U }, /* SCL2_A */
+    { GRP_I2C2_A,      FN_I2C2,     IPSR_SDA2_A,      4U }, /* SDA2_A */
+    { GRP_I2C2_B,      FN_I2C2,     IPSR_SCL2_B,      4U }, /* SCL2_A */
+    { GRP_I2C2_B,      FN_I2C2,     IPSR_SDA2_B,      4U }, /* SDA2_A */
+
+    { GRP_I2C6_A,      FN_I2C6,     IPSR_SCL6_A,      7U }, /* SCL6_A */
+    { GRP_I2C6_A,      FN_I2C6,     IPSR_SDA6_A,      7U }, /* SDA6_A */
+    { GRP_I2C6_B,      FN_I2C6,     IPSR_SCL6_B,      7U }, /* SCL6_B */
+    { GRP_I2C6_B,      FN_I2C6,     IPSR_SDA6_B,      7U }, /* SDA6_B */
+    { GRP_I2C6_C,      FN_I2C6,     IPSR_SCL6_C,      7U }, /* SCL6_C */
+    { GRP_I2C6_C,      FN_I2C6,     IPSR_SDA6_C,      7U }, /* SDA6_C */
+
+    { GRP_USB0,        FN_USB0,     IPSR_USB0_PWEN,   0U }, /* USB0_PWEN */
+    { GRP_USB0,        FN_USB0,     IPSR_USB0_OVC,    0U }, /* USB0_OVC */
+
+    { GRP_USB1,        FN_USB1,     IPSR_USB1_PWEN,   0U }, /* USB1_PWEN */
+    { GRP_USB1,        FN_USB1,     IPSR_USB1_OVC,    0U }, /* USB1_OVC */
+
+    { GRP_USB3,        FN_USB3,     IPSR_USB30_PWEN,  0U }, /* USB30_PWEN */
+    { GRP_USB3,        FN_USB3,     IPSR_USB30_OVC,   0U }, /* USB30_OVC */
+    { GRP_NONE,        FN_NONE,     0U,               0U }  /* list terminator */
+    };
+
+/*
+ * supported PFC module selections, with the setting of the MOD_SEL field
+ */
+
+LOCAL const PFC_MOD_DESC pfcModuleSel [] =
+    {
+    { GRP_SCIF1_A,  FN_SCIF1,  MOD_SEL_SCIF1,  0U },        /* RX1_A/TX1_A */
+    { GRP_SCIF1_B,  FN_SCIF1,  MOD_SEL_SCIF1,  1U },        /* RX1_B/TX1_B */
+
+    { GRP_SCIF2_A,  FN_SCIF2,  MOD_SEL_SCIF2,  0U },        /* RX2_A/TX2_A */
+    { GRP_SCIF2_B,  FN_SCIF2,  MOD_SEL_SCIF2,  1U },        /* RX2_B/TX2_B */
+
+    { GRP_SCIF3_A,  FN_SCIF3,  MOD_SEL_SCIF3,  0U },        /* RX3_A/TX3_A */
+    { GRP_SCIF3_B,  FN_SCIF3,  MOD_SEL_SCIF3,  1U },        /* RX3_B/TX3_B */
+
+    { GRP_SCIF4_A,  FN_SCIF4,  MOD_SEL_SCIF4,  0U },        /* RX4_A/TX4_A */
+    { GRP_SCIF4_B,  FN_SCIF4,  MOD_SEL_SCIF4,  1U },        /* RX4_B/TX4_B */
+    { GRP_SCIF4_C,  FN_SCIF4,  MOD_SEL_SCIF4,  2U },        /* RX4_C/TX4_C */
+
+    { GRP_SCIF5_A,  FN_SCIF5,  MOD_SEL_SCIF5,  0U },        /* RX5_A/TX5_A */
+    { GRP_SCIF5_B,  FN_SCIF5,  MOD_SEL_SCIF5,  1U },        /* RX5_B/TX5_B */
+
+    { GRP_HSCIF1_A, FN_HSCIF1, MOD_SEL_HSCIF1, 0U },        /* HRX1_A/HTX1_A */
+    { GRP_HSCIF1_B, FN_HSCIF1, MOD_SEL_HSCIF1, 1U },        /* HRX1_B/HTX1_B */
+
+    { GRP_CANFD0_A, FN_CANFD0, MOD_SEL_CANFD0, 0U },        /* CANFD0_A */
+    { GRP_CANFD0_B, FN_CANFD0, MOD_SEL_CANFD0, 1U },        /* CANFD0_B */
+
+    { GRP_I2C0,     FN_I2C0,   MOD_SEL_I2C0,   1U },        /* SCL0/SDA0 */
+
+    { GRP_I2C1_A,   FN_I2C1,   MOD_SEL_I2C1,   0U },        /* SCL1/SDA1_A */
+    { GRP_I2C1_B,   FN_I2C1,   MOD_SEL_I2C1,   1U },        /* SCL1/SDA1_B */
+
+    { GRP_I2C2_A,   FN_I2C2,   MOD_SEL_I2C2,   0U },        /* SCL2/SDA2_A */
+    { GRP_I2C2_B,   FN_I2C2,   MOD_SEL_I2C2,   1U },        /* SCL2/SDA2_B */
+
+    { GRP_I2C3,     FN_I2C3,   MOD_SEL_I2C3,   1U },        /* SCL3/SDA3 */
+
+    { GRP_I2C5,     FN_I2C5,   MOD_SEL_I2C5,   1U },        /* SCL5/SDA5 */
+
+    { GRP_I2C6_A,   FN_I2C6,   MOD_SEL_I2C6,   0U },        /* SCL6/SDA6_A */
+    { GRP_I2C6_B,   FN_I2C6,   MOD_SEL_I2C6,   1U },        /* SCL6/SDA6_B */
+    { GRP_I2C6_C,   FN_I2C6,   MOD_SEL_I2C6,   2U },        /* SCL6/SDA6_C */
+    { GRP_NONE,     FN_NONE,   0U,             0U }         /* list terminator */
+    };
+
+/*
+ * pin name index
+ *
+ * Each slot holds the pfcPins index of a pin name, or PFC_PIN_HASH_EMPTY.
+ * A name is looked up from slot rzg2PfcPinHash (name), probing the next
+ * slots until the name or an empty slot is found.
+ */
+
+LOCAL const UINT16 pfcPinHash [PFC_PIN_HASH_SIZE] =
+    {
+    /*   0 */     24,     32,    113,    114, 0xffff,     66, 0xffff, 0xffff,
+    /*   8 */ 0xffff,     38,     17,     51,     56, 0xffff, 0xffff, 0xffff,
+    /*  16 */    111, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff,     18, 0xffff,
+    /*  24 */ 0xffff,      5, 0xffff,     47,     63,     79,     68,     91,
+    /*  32 */     97,    107,     42,     74,    115, 0xffff,     13, 0xffff,
+    /*  40 */ 0xffff, 0xffff, 0xffff, 0xffff,     60, 0xffff, 0xffff, 0xffff,
+    /*  48 */ 0xffff, 0xffff, 0xffff,    105, 0xffff, 0xffff,     70,    110,
+    /*  56 */ 0xffff,      0, 0xffff, 0xffff,     67,     83,     98,     90,
+    /*  64 */ 0xffff,     46,     75, 0xffff, 0xffff,     71,     73,     86,
+    /*  72 */ 0xffff, 0xffff, 0xffff, 0xffff, 0xffff,    116, 0xffff, 0xffff,
+    /*  80 */     29, 0xffff,     30, 0xffff, 0xffff,     26, 0xffff,    100,
+    /*  88 */ 0xffff, 0xffff, 0xffff, 0xffff, 0xffff,      4, 0xffff, 0xffff,
+    /*  96 */     65,      2,     10,     99,      6,     92, 0xffff,     16,
+    /* 104 */ 0xffff, 0xffff,     14,     48,     93, 0xffff,     36,     55,
+    /* 112 */ 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff,     35,     52,
+    /* 120 */ 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff,
+    /* 128 */ 0xffff, 0xffff, 0xffff,     12,     34,     80, 0xffff, 0xffff,
+    /* 136 */     49,     61,     77,     45,     82,     54,     76,     94,
+    /* 144 */    103, 0xffff, 0xffff,     19, 0xffff, 0xffff, 0xffff, 0xffff,
+    /* 152 */ 0xffff, 0xffff, 0xffff, 0xffff,    102,      9,     50, 0xffff,
+    /* 160 */    106, 0xffff, 0xffff,    112, 0xffff, 0xffff, 0xffff, 0xffff,
+    /* 168 */ 0xffff,      8,     39, 0xffff,     87, 0xffff,     44,     62,
+    /* 176 */     78,     96, 0xffff,     72,     85, 0xffff, 0xffff, 0xffff,
+    /* 184 */ 0xffff,     23, 0xffff,    104, 0xffff, 0xffff, 0xffff, 0xffff,
+    /* 192 */ 0xffff, 0xffff,     41, 0xffff,    101,    109, 0xffff, 0xffff,
+    /* 200 */ 0xffff, 0xffff,      3, 0xffff, 0xffff, 0xffff,      1,     25,
+    /* 208 */     69,     58,     84,     59,     15,     88, 0xffff, 0xffff,
+    /* 216 */ 0xffff, 0xffff, 0xffff,     37, 0xffff, 0xffff, 0xffff,     11,
+    /* 224 */     27, 0xffff, 0xffff,     28,     40,     31,     53, 0xffff,
+    /* 232 */ 0xffff, 0xffff,     57, 0xffff, 0xffff, 0xffff, 0xffff,     64,
+    /* 240 */     22, 0xffff, 0xffff, 0xffff, 0xffff,     20, 0xffff,      7,
+    /* 248 */     95,     81,     43, 0xffff,     33,     21,     89,    108
+    };
@@ -0,0 +1,409 @@
+#!/usr/bin/env python3
+#
+# rzg2Dtc.py - compile a preprocessed device tree source for the host tests
+#
+# Copyright (c) 2026 Wind River Systems, Inc.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1) Redistributions of source code must retain the above copyright notice,
+# this list of conditions and the following disclaimer.
+#
+# 2) Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+# 3) Neither the name of Wind River Systems nor the names of its contributors
+# may be used to endorse or promote products derived from this software without
+# specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+# modification history
+# --------------------
+# 19oct26,agt  written
+#
+# DESCRIPTION
+# This script compiles a device tree source, already run through the C
+# preprocessor, into a flattened device tree blob (version 17), for the host
+# tests of the CPG and PFC drivers. It takes the dtc options used by the test
+# Makefile, so that dtc can be used instead where it is installed:
+#
+#   python3 rzg2Dtc.py -I dts -O dtb -o board.dtb board.pp.dts
+#
+# Only the source syntax of the BSP device trees is accepted: the /dts-v1/
+# tag, nodes and labels, node references (&label { ... }) merged into the
+# labelled node, and properties that are empty or hold strings, cells, byte
+# strings or references. A reference in cells is replaced by the phandle of
+# the node, and a reference outside cells by the path of the node. Cell
+# expressions, /include/, /delete-node/ and /memreserve/ are not accepted.
+#
+# Phandles are given to the referenced nodes in the order of the source, in a
+# "phandle" property.
+#
+
+import argparse
+import re
+import struct
+import sys
+
+FDT_MAGIC = 0xd00dfeed
+FDT_VERSION = 17
+FDT_LAST_COMP_VERSION = 16
+FDT_HEADER_SIZE = 40
+
+FDT_BEGIN_NODE = 1
+FDT_END_NODE = 2
+FDT_PROP = 3
+FDT_END = 9
+
+TOKEN = re.compile(r'''
+      (?P<space>\s+)
+    | (?P<comment>//[^\n]*|/\*.*?\*/)
+    | (?P<string>"(?:[^"\\]|\\.)*")
+    | (?P<dir>/[a-z][a-z0-9-]*/)
+    | (?P<ref>&[A-Za-z_][A-Za-z0-9_]*)
+    | (?P<word>[A-Za-z0-9,._+#?@-]+)
+    | (?P<punct>[{}<>\[\]=;,:/])
+    ''', re.VERBOSE | re.DOTALL)
+
+WORD_LABEL = re.compile(r'^[A-Za-z_][A-Za-z0-9_]*$')
+
+
+class DtcError(Exception):
+    pass
+
+
+class Node(object):
+    def __init__(self, name, parent):
+        self.name = name
+        self.parent = parent
+        self.props = []         # [name, value], value a list of parts
+        self.children = []
+        self.labels = []
+        self.phandle = 0
+
+    def path(self):
+        if self.parent is None:
+            return '/'
+        parent = self.parent.path()
+        return (parent if parent != '/' else '') + '/' + self.name
+
+    def child(self, name):
+        for c in self.children:
+            if c.name == name:
+                return c
+        node = Node(name, self)
+        self.children.append(node)
+        return node
+
+    def propSet(self, name, value):
+        for p in self.props:
+            if p[0] == name:
+                p[1] = value
+                return
+        self.props.append([name, value])
+
+
+def tokenize(text):
+    tokens = []
+    pos = 0
+    line = 1
+    while pos < len(text):
+        m = TOKEN.match(text, pos)
+        if m is None:
+            raise DtcError('line %d: unexpected %r' % (line, text[pos]))
+        kind = m.lastgroup
+        if kind not in ('space', 'comment'):
+            tokens.append((kind, m.group(kind), line))
+        line += m.group(0).count('\n')
+        pos = m.end()
+    tokens.append(('eof', '', line))
+    return tokens
+
+
+class Parser(object):
+    def __init__(self, tokens):
+        self.tokens = tokens
+        self.pos = 0
+        self.root = Node('', None)
+
+    def peek(self):
+        return self.tokens[self.pos]
+
+    def next(self):
+        tok = self.tokens[self.pos]
+        self.pos += 1
+        return tok
+
+    def expect(self, value):
+        kind, text, line = self.next()
+        if text != value:
+            raise DtcError('line %d: expected %r, found %r' %
+                           (line, value, text))
+
+    def error(self, what):
+        kind, text, line = self.peek()
+        raise DtcError('line %d: %s, found %r' % (line, what, text))
+
+    def parse(self):
+        if self.peek()[1] != '/dts-v1/':
+            self.error('expected /dts-v1/')
+        self.next()
+        self.expect(';')
+
+        while self.peek()[0] != 'eof':
+            kind, text, line = self.peek()
+            if text == '/':
+                self.next()
+                self.nodeBody(self.root)
+            elif kind == 'ref':
+                self.next()
+                self.nodeBody(self.labelled(text[1:], line))
+            else:
+                self.error('expected / or a node reference')
+            self.expect(';')
+
+        return self.root
+
+    def labelled(self, label, line):
+        node = self.findLabel(self.root, label)
+        if node is None:
+            raise DtcError('line %d: no node labelled %s' % (line, label))
+        return node
+
+    def findLabel(self, node, label):
+        if label in node.labels:
+            return node
+        for c in node.children:
+            found = self.findLabel(c, label)
+            if found is not None:
+                return found
+        return None
+
+    def nodeBody(self, node):
+        self.expect('{')
+        while self.peek()[1] != '}':
+            labels = []
+            kind, text, line = self.next()
+            while kind == 'word' and self.peek()[1] == ':':
+                if not WORD_LABEL.match(text):
+                    raise DtcError('line %d: bad label %s' % (line, text))
+                self.next()
+                labels.append(text)
+                kind, text, line = self.next()
+            if kind != 'word':
+                raise DtcError('line %d: expected a node or property name, '
+                               'found %r' % (line, text))
+
+            if self.peek()[1] == '{':
+                child = node.child(text)
+                for label in labels:
+                    if label not in child.labels:
+                        child.labels.append(label)
+                self.nodeBody(child)
+                self.expect(';')
+            elif labels:
+                raise DtcError('line %d: label on property %s' % (line, text))
+            elif self.peek()[1] == ';':
+                self.next()
+                node.propSet(text, [])
+            else:
+                self.expect('=')
+                node.propSet(text, self.propValue())
+        self.next()
+
+    def propValue(self):
+        parts = []
+        while True:
+            kind, text, line = self.next()
+            if kind == 'string':
+                parts.append(('string', self.unescape(text[1:-1], line)))
+            elif kind == 'ref':
+                parts.append(('path', text[1:], line))
+            elif text == '<':
+                cells = []
+                while self.peek()[1] != '>':
+                    kind, text, line = self.next()
+                    if kind == 'ref':
+                        cells.append(('phandle', text[1:], line))
+                    elif kind == 'word':
+                        cells.append(('cell', self.number(text, line)))
+                    else:
+                        raise DtcError('line %d: unexpected %r in cells' %
+                                       (line, text))
+                self.next()
+                parts.append(('cells', cells))
+            elif text == '[':
+                data = ''
+                while self.peek()[1] != ']':
+                    kind, text, line = self.next()
+                    if kind != 'word':
+                        raise DtcError('line %d: unexpected %r in bytes' %
+                                       (line, text))
+                    data += text
+                self.next()
+                if len(data) % 2 != 0:
+                    raise DtcError('line %d: odd number of hex digits' % line)
+                try:
+                    parts.append(('bytes', bytes.fromhex(data)))
+                except ValueError:
+                    raise DtcError('line %d: bad byte string' % line)
+            else:
+                raise DtcError('line %d: unexpected %r in property value' %
+                               (line, text))
+
+            kind, text, line = self.next()
+            if text == ';':
+                return parts
+            if text != ',':
+                raise DtcError('line %d: expected , or ;, found %r' %
+                               (line, text))
+
+    def number(self, text, line):
+        try:
+            value = int(text.rstrip('ULul'), 0)
+        except ValueError:
+            raise DtcError('line %d: bad cell %s' % (line, text))
+        if value < 0 or value > 0xffffffff:
+            raise DtcError('line %d: cell %s out of range' % (line, text))
+        return value
+
+    def unescape(self, text, line):
+        try:
+            return (text.encode('latin-1').decode('unicode_escape')
+                    .encode('latin-1'))
+        except (UnicodeError, ValueError):
+            raise DtcError('line %d: bad string' % line)
+
+
+def phandlesAssign(root, parser):
+    nodes = []
+
+    def walk(node):
+        nodes.append(node)
+        for c in node.children:
+            walk(c)
+
+    walk(root)
+
+    nextPhandle = 1
+    for node in nodes:
+        for name, value in node.props:
+            for part in value:
+                if part[0] != 'cells':
+                    continue
+                for cell in part[1]:
+                    if cell[0] != 'phandle':
+                        continue
+                    target = parser.labelled(cell[1], cell[2])
+                    if target.phandle == 0:
+                        target.phandle = nextPhandle
+                        nextPhandle += 1
+
+    for node in nodes:
+        if node.phandle != 0:
+            node.propSet('phandle', [('cells', [('cell', node.phandle)])])
+
+
+def propEncode(value, parser):
+    data = b''
+    for part in value:
+        if part[0] == 'string':
+            data += part[1] + b'\0'
+        elif part[0] == 'path':
+            data += parser.labelled(part[1], part[2]).path().encode() + b'\0'
+        elif part[0] == 'bytes':
+            data += part[1]
+        else:
+            for cell in part[1]:
+                if cell[0] == 'phandle':
+                    val = parser.labelled(cell[1], cell[2]).phandle
+                else:
+                    val = cell[1]
+                data += struct.pack('>I', val)
+    return data
+
+
+def align4(data):
+    return data + b'\0' * (-len(data) % 4)
+
+
+def flatten(root, parser):
+    strings = b''
+    offsets = {}
+
+    def stringOffset(name):
+        nonlocal strings
+        if name not in offsets:
+            offsets[name] = len(strings)
+            strings += name.encode() + b'\0'
+        return offsets[name]
+
+    def node(n):
+        out = struct.pack('>I', FDT_BEGIN_NODE) + align4(n.name.encode() +
+                                                         b'\0')
+        for name, value in n.props:
+            data = propEncode(value, parser)
+            out += struct.pack('>III', FDT_PROP, len(data), stringOffset(name))
+            out += align4(data)
+        for c in n.children:
+            out += node(c)
+        return out + struct.pack('>I', FDT_END_NODE)
+
+    structBlock = node(root) + struct.pack('>I', FDT_END)
+
+    memRsvOff = FDT_HEADER_SIZE
+    memRsv = struct.pack('>QQ', 0, 0)
+    structOff = memRsvOff + len(memRsv)
+    stringsOff = structOff + len(structBlock)
+    total = stringsOff + len(strings)
+
+    header = struct.pack('>10I', FDT_MAGIC, total, structOff, stringsOff,
+                         memRsvOff, FDT_VERSION, FDT_LAST_COMP_VERSION, 0,
+                         len(strings), len(structBlock))
+
+    return header + memRsv + structBlock + strings
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='compile a preprocessed device tree source')
+    parser.add_argument('-I', dest='inFormat', default='dts',
+                        choices=['dts'], help='input format')
+    parser.add_argument('-O', dest='outFormat', default='dtb',
+                        choices=['dtb'], help='output format')
+    parser.add_argument('-o', dest='output', required=True,
+                        help='output file')
+    parser.add_argument('input', help='preprocessed device tree source')
+    args = parser.parse_args()
+
+    try:
+        with open(args.input) as f:
+            text = f.read()
+        dts = Parser(tokenize(text))
+        root = dts.parse()
+        phandlesAssign(root, dts)
+        blob = flatten(root, dts)
+    except (DtcError, IOError) as e:
+        sys.stderr.write('rzg2Dtc: %s: %s\n' % (args.input, e))
+        return 1
+
+    with open(args.output, 'wb') as f:
+        f.write(blob)
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
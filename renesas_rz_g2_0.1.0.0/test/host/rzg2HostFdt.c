@@ -0,0 +1,770 @@
+/* rzg2HostFdt.c - flattened device tree routines for the RZ/G2 host tests */
+
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1) Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2) Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3) Neither the name of Wind River Systems nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+modification history
+--------------------
+19oct26,agt  written
+*/
+
+/*
+DESCRIPTION
+This file implements the vxFdtLib routines called by the CPG and PFC drivers
+in the host build, over a device tree blob read by rzg2HostFdtLoad(). The blob
+is the board device tree compiled by the test Makefile, so the drivers attach
+to the same nodes and properties as on the target.
+
+The routines follow the libfdt routines they wrap in VxWorks: a node is known
+by the offset of its FDT_BEGIN_NODE tag in the structure block, the root node
+is at offset 0, and a failed search returns -FDT_ERR_NOTFOUND. Only the
+read-only routines used by the drivers are provided, and the blob is assumed to
+be well formed once its header has been checked.
+
+INCLUDE FILES: vxFdtLib.h
+*/
+
+/* includes */
+
+#include <vxWorks.h>
+#include <vxFdtLib.h>
+#include <stdlib.h>
+
+/* defines */
+
+#define FDT_MAGIC               0xd00dfeedU
+#define FDT_HEADER_WORDS        10U
+#define FDT_BEGIN_NODE          1U
+#define FDT_END_NODE            2U
+#define FDT_PROP                3U
+#define FDT_NOP                 4U
+#define FDT_END                 9U
+
+#define FDT_TAG_SIZE            4
+#define FDT_ALIGN(len)          (((len) + 3) & ~3)
+
+/* header words */
+
+#define FDT_HDR_MAGIC           0U
+#define FDT_HDR_TOTAL_SIZE      1U
+#define FDT_HDR_OFF_STRUCT      2U
+#define FDT_HDR_OFF_STRINGS     3U
+
+#define FDT_ADDR_CELLS_DEFAULT  2U
+#define FDT_SIZE_CELLS_DEFAULT  1U
+
+/* locals */
+
+LOCAL UINT8 *   pRzg2Fdt = NULL;    /* device tree blob */
+LOCAL UINT8 *   pRzg2FdtStruct;     /* structure block */
+LOCAL char *    pRzg2FdtStrings;    /* strings block */
+
+/*******************************************************************************
+*
+* rzg2HostFdtWord - get a big-endian word of the blob
+*
+* RETURNS: the word at byte <offset> of <pBase>, in host byte order.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL UINT32 rzg2HostFdtWord
+    (
+    const UINT8 *       pBase,      /* block */
+    int                 offset      /* byte offset in the block */
+    )
+    {
+    UINT32              val;
+
+    (void)memcpy (&val, pBase + offset, sizeof (val));
+
+    return vxFdt32ToCpu (val);
+    }
+
+/*******************************************************************************
+*
+* rzg2HostFdtLoad - read the device tree blob of the tests
+*
+* This routine reads the blob in the file at <pPath>, and makes it the device
+* tree of the vxFdtLib routines. A blob already loaded is freed.
+*
+* RETURNS: OK, or ERROR if the file cannot be read or is not a device tree
+* blob.
+*
+* ERRNO: N/A.
+*/
+
+STATUS rzg2HostFdtLoad
+    (
+    const char *        pPath       /* blob file */
+    )
+    {
+    FILE *              pFile;
+    UINT8               header [FDT_HEADER_WORDS * 4U];
+    UINT32              size;
+
+    pFile = fopen (pPath, "rb");
+    if (pFile == NULL)
+        {
+        (void)fprintf (stderr, "host FDT: cannot open %s\n", pPath);
+        return ERROR;
+        }
+
+    if ((fread (header, sizeof (header), 1, pFile) != 1) ||
+        (rzg2HostFdtWord (header, FDT_HDR_MAGIC * 4U) != FDT_MAGIC))
+        {
+        (void)fprintf (stderr, "host FDT: %s is not a device tree blob\n",
+                       pPath);
+        (void)fclose (pFile);
+        return ERROR;
+        }
+
+    size = rzg2HostFdtWord (header, FDT_HDR_TOTAL_SIZE * 4U);
+
+    free (pRzg2Fdt);
+    pRzg2Fdt = malloc (size);
+    if ((pRzg2Fdt == NULL) || (fseek (pFile, 0L, SEEK_SET) != 0) ||
+        (fread (pRzg2Fdt, size, 1, pFile) != 1))
+        {
+        (void)fprintf (stderr, "host FDT: cannot read %s\n", pPath);
+        (void)fclose (pFile);
+        free (pRzg2Fdt);
+        pRzg2Fdt = NULL;
+        return ERROR;
+        }
+
+    (void)fclose (pFile);
+
+    pRzg2FdtStruct = pRzg2Fdt +
+                     rzg2HostFdtWord (header, FDT_HDR_OFF_STRUCT * 4U);
+    pRzg2FdtStrings = (char *) pRzg2Fdt +
+                      rzg2HostFdtWord (header, FDT_HDR_OFF_STRINGS * 4U);
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2HostFdtTagNext - get a tag and the offset of the tag after it
+*
+* RETURNS: the tag at <offset>, with the offset of the next tag in <pNext>.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL UINT32 rzg2HostFdtTagNext
+    (
+    int                 offset,     /* tag offset */
+    int *               pNext       /* returned next tag offset */
+    )
+    {
+    UINT32              tag = rzg2HostFdtWord (pRzg2FdtStruct, offset);
+    int                 next = offset + FDT_TAG_SIZE;
+
+    switch (tag)
+        {
+        case FDT_BEGIN_NODE:
+            next += FDT_ALIGN ((int) strlen ((char *) pRzg2FdtStruct + next) +
+                               1);
+            break;
+
+        case FDT_PROP:
+            next += 8 + FDT_ALIGN ((int) rzg2HostFdtWord (pRzg2FdtStruct,
+                                                          next));
+            break;
+
+        default:
+            break;
+        }
+
+    *pNext = next;
+
+    return tag;
+    }
+
+/*******************************************************************************
+*
+* vxFdt32ToCpu - convert a device tree cell to host byte order
+*
+* RETURNS: <val> in host byte order.
+*
+* ERRNO: N/A.
+*/
+
+UINT32 vxFdt32ToCpu
+    (
+    UINT32              val         /* big-endian cell */
+    )
+    {
+    return __builtin_bswap32 (val);
+    }
+
+/*******************************************************************************
+*
+* vxFdtNextNode - get the next node in depth-first order
+*
+* The depth at <pDepth>, if it is not NULL, is incremented for a child and
+* decremented for each level left.
+*
+* RETURNS: the offset of the node after <offset>, or -FDT_ERR_NOTFOUND at the
+* end of the tree or of the subtree the depth started in.
+*
+* ERRNO: N/A.
+*/
+
+int vxFdtNextNode
+    (
+    int                 offset,     /* node, or -1 for the root node */
+    int *               pDepth      /* node depth, or NULL */
+    )
+    {
+    int                 next = 0;
+    UINT32              tag;
+
+    if (pRzg2Fdt == NULL)
+        {
+        return -FDT_ERR_NOTFOUND;
+        }
+
+    if (offset >= 0)
+        {
+        (void)rzg2HostFdtTagNext (offset, &next);
+        }
+
+    for (;;)
+        {
+        offset = next;
+        tag = rzg2HostFdtTagNext (offset, &next);
+
+        switch (tag)
+            {
+            case FDT_BEGIN_NODE:
+                if (pDepth != NULL)
+                    {
+                    (*pDepth)++;
+                    }
+                return offset;
+
+            case FDT_END_NODE:
+                if ((pDepth != NULL) && (--(*pDepth) < 0))
+                    {
+                    return -FDT_ERR_NOTFOUND;
+                    }
+                break;
+
+            case FDT_END:
+                return -FDT_ERR_NOTFOUND;
+
+            default:
+                break;
+            }
+        }
+    }
+
+/*******************************************************************************
+*
+* vxFdtFirstSubnode - get the first child of a node
+*
+* RETURNS: the offset of the first child of the node at <offset>, or
+* -FDT_ERR_NOTFOUND if it has none.
+*
+* ERRNO: N/A.
+*/
+
+int vxFdtFirstSubnode
+    (
+    int                 offset      /* parent node */
+    )
+    {
+    int                 depth = 0;
+
+    offset = vxFdtNextNode (offset, &depth);
+    if ((offset < 0) || (depth != 1))
+        {
+        return -FDT_ERR_NOTFOUND;
+        }
+
+    return offset;
+    }
+
+/*******************************************************************************
+*
+* vxFdtNextSubnode - get the next sibling of a node
+*
+* RETURNS: the offset of the next sibling of the node at <offset>, or
+* -FDT_ERR_NOTFOUND if it is the last child of its parent.
+*
+* ERRNO: N/A.
+*/
+
+int vxFdtNextSubnode
+    (
+    int                 offset      /* node */
+    )
+    {
+    int                 depth = 1;
+
+    /* skip the children of the node, and stop at a sibling or the parent end */
+
+    do
+        {
+        offset = vxFdtNextNode (offset, &depth);
+        if ((offset < 0) || (depth < 1))
+            {
+            return -FDT_ERR_NOTFOUND;
+            }
+        } while (depth > 1);
+
+    return offset;
+    }
+
+/*******************************************************************************
+*
+* vxFdtGetName - get the name of a node
+*
+* RETURNS: the name of the node at <offset>, with its unit address, and its
+* length in <pLen> if it is not NULL.
+*
+* ERRNO: N/A.
+*/
+
+const char * vxFdtGetName
+    (
+    int                 offset,     /* node */
+    int *               pLen        /* returned name length, or NULL */
+    )
+    {
+    const char *        pName = "";
+
+    if ((pRzg2Fdt != NULL) && (offset >= 0))
+        {
+        pName = (const char *) pRzg2FdtStruct + offset + FDT_TAG_SIZE;
+        }
+
+    if (pLen != NULL)
+        {
+        *pLen = (int) strlen (pName);
+        }
+
+    return pName;
+    }
+
+/*******************************************************************************
+*
+* vxFdtPropGet - get a property of a node
+*
+* RETURNS: the value of the property <name> of the node at <offset>, with its
+* length in <pLen> if it is not NULL, or NULL if the node does not have it.
+*
+* ERRNO: N/A.
+*/
+
+const void * vxFdtPropGet
+    (
+    int                 offset,     /* node */
+    const char *        name,       /* property name */
+    int *               pLen        /* returned value length, or NULL */
+    )
+    {
+    int                 next;
+    UINT32              tag;
+
+    if ((pRzg2Fdt == NULL) || (offset < 0))
+        {
+        if (pLen != NULL)
+            {
+            *pLen = -FDT_ERR_NOTFOUND;
+            }
+        return NULL;
+        }
+
+    (void)rzg2HostFdtTagNext (offset, &next);
+
+    /* the properties of a node come before its children */
+
+    do
+        {
+        offset = next;
+        tag = rzg2HostFdtTagNext (offset, &next);
+
+        if ((tag == FDT_PROP) &&
+            (strcmp (pRzg2FdtStrings +
+                     rzg2HostFdtWord (pRzg2FdtStruct, offset + 8), name) == 0))
+            {
+            if (pLen != NULL)
+                {
+                *pLen = (int) rzg2HostFdtWord (pRzg2FdtStruct, offset + 4);
+                }
+            return pRzg2FdtStruct + offset + 12;
+            }
+        } while ((tag == FDT_PROP) || (tag == FDT_NOP));
+
+    if (pLen != NULL)
+        {
+        *pLen = -FDT_ERR_NOTFOUND;
+        }
+
+    return NULL;
+    }
+
+/*******************************************************************************
+*
+* rzg2HostFdtStringListHas - check a string list property for a string
+*
+* RETURNS: TRUE if the property <name> of the node at <offset> holds <pStr>.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL BOOL rzg2HostFdtStringListHas
+    (
+    int                 offset,     /* node */
+    const char *        name,       /* property name */
+    const char *        pStr        /* string to find */
+    )
+    {
+    const char *        pList;
+    int                 len;
+    int                 pos = 0;
+
+    pList = (const char *) vxFdtPropGet (offset, name, &len);
+    if (pList == NULL)
+        {
+        return FALSE;
+        }
+
+    while (pos < len)
+        {
+        if (strcmp (pList + pos, pStr) == 0)
+            {
+            return TRUE;
+            }
+        pos += (int) strlen (pList + pos) + 1;
+        }
+
+    return FALSE;
+    }
+
+/*******************************************************************************
+*
+* vxFdtNodeCheckCompatible - check a node for a compatible string
+*
+* RETURNS: 0 if the compatible property of the node at <offset> holds
+* <compatible>, 1 otherwise.
+*
+* ERRNO: N/A.
+*/
+
+int vxFdtNodeCheckCompatible
+    (
+    int                 offset,     /* node */
+    const char *        compatible  /* compatible string */
+    )
+    {
+    return rzg2HostFdtStringListHas (offset, "compatible", compatible) ? 0 : 1;
+    }
+
+/*******************************************************************************
+*
+* vxFdtNodeOffsetByCompatible - find the next node with a compatible string
+*
+* RETURNS: the offset of the first node after <startOffset> whose compatible
+* property holds <compatible>, or -FDT_ERR_NOTFOUND.
+*
+* ERRNO: N/A.
+*/
+
+int vxFdtNodeOffsetByCompatible
+    (
+    int                 startOffset,    /* node to search after, or -1 */
+    const char *        compatible      /* compatible string */
+    )
+    {
+    int                 offset;
+
+    for (offset = vxFdtNextNode (startOffset, NULL); offset >= 0;
+         offset = vxFdtNextNode (offset, NULL))
+        {
+        if (rzg2HostFdtStringListHas (offset, "compatible", compatible))
+            {
+            return offset;
+            }
+        }
+
+    return -FDT_ERR_NOTFOUND;
+    }
+
+/*******************************************************************************
+*
+* vxFdtNodeOffsetByPhandle - find the node with a phandle
+*
+* RETURNS: the offset of the node whose phandle is <phandle>, or
+* -FDT_ERR_NOTFOUND.
+*
+* ERRNO: N/A.
+*/
+
+int vxFdtNodeOffsetByPhandle
+    (
+    UINT32              phandle     /* phandle */
+    )
+    {
+    const UINT32 *      pProp;
+    int                 offset;
+
+    if ((phandle == 0U) || (phandle == 0xffffffffU))
+        {
+        return -FDT_ERR_NOTFOUND;
+        }
+
+    for (offset = vxFdtNextNode (-1, NULL); offset >= 0;
+         offset = vxFdtNextNode (offset, NULL))
+        {
+        pProp = (const UINT32 *) vxFdtPropGet (offset, "phandle", NULL);
+        if ((pProp != NULL) && (vxFdt32ToCpu (*pProp) == phandle))
+            {
+            return offset;
+            }
+        }
+
+    return -FDT_ERR_NOTFOUND;
+    }
+
+/*******************************************************************************
+*
+* vxFdtPathOffset - find a node by its path
+*
+* RETURNS: the offset of the node at the absolute path <pPath>, whose
+* components are full node names, or -FDT_ERR_NOTFOUND.
+*
+* ERRNO: N/A.
+*/
+
+int vxFdtPathOffset
+    (
+    const char *        pPath       /* node path */
+    )
+    {
+    const char *        pEnd;
+    size_t              len;
+    int                 offset = 0;
+    int                 node;
+
+    if ((pRzg2Fdt == NULL) || (*pPath != '/'))
+        {
+        return -FDT_ERR_NOTFOUND;
+        }
+
+    while (*pPath != '\0')
+        {
+        while (*pPath == '/')
+            {
+            pPath++;
+            }
+        if (*pPath == '\0')
+            {
+            break;
+            }
+
+        pEnd = strchr (pPath, '/');
+        len = (pEnd == NULL) ? strlen (pPath) : (size_t) (pEnd - pPath);
+
+        for (node = vxFdtFirstSubnode (offset); node >= 0;
+             node = vxFdtNextSubnode (node))
+            {
+            if ((strncmp (vxFdtGetName (node, NULL), pPath, len) == 0) &&
+                (vxFdtGetName (node, NULL) [len] == '\0'))
+                {
+                break;
+                }
+            }
+
+        if (node < 0)
+            {
+            return -FDT_ERR_NOTFOUND;
+            }
+
+        offset = node;
+        pPath += len;
+        }
+
+    return offset;
+    }
+
+/*******************************************************************************
+*
+* vxFdtIsEnabled - check the status of a node
+*
+* RETURNS: TRUE if the node at <offset> has no status property, or its status
+* is "okay" or "ok".
+*
+* ERRNO: N/A.
+*/
+
+BOOL vxFdtIsEnabled
+    (
+    int                 offset      /* node */
+    )
+    {
+    const char *        pStatus;
+
+    pStatus = (const char *) vxFdtPropGet (offset, "status", NULL);
+
+    return (pStatus == NULL) || (strcmp (pStatus, "okay") == 0) ||
+           (strcmp (pStatus, "ok") == 0);
+    }
+
+/*******************************************************************************
+*
+* rzg2HostFdtParent - find the parent of a node
+*
+* RETURNS: the offset of the parent of the node at <offset>, or
+* -FDT_ERR_NOTFOUND for the root node.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL int rzg2HostFdtParent
+    (
+    int                 offset      /* node */
+    )
+    {
+    int                 parents [32];
+    int                 depth = 0;
+    int                 node;
+
+    parents [0] = 0;
+
+    for (node = vxFdtNextNode (0, &depth); node >= 0;
+         node = vxFdtNextNode (node, &depth))
+        {
+        if (depth >= (int) NELEMENTS (parents))
+            {
+            break;
+            }
+
+        parents [depth] = node;
+        if (node == offset)
+            {
+            return parents [depth - 1];
+            }
+        }
+
+    return -FDT_ERR_NOTFOUND;
+    }
+
+/*******************************************************************************
+*
+* rzg2HostFdtCells - get a cell count property of a node
+*
+* RETURNS: the value of the property <name> of the node at <offset>, or
+* <defVal> if it has none.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL UINT32 rzg2HostFdtCells
+    (
+    int                 offset,     /* node */
+    const char *        name,       /* #address-cells or #size-cells */
+    UINT32              defVal      /* default cell count */
+    )
+    {
+    const UINT32 *      pProp = (const UINT32 *) vxFdtPropGet (offset, name,
+                                                           NULL);
+
+    return (pProp == NULL) ? defVal : vxFdt32ToCpu (*pProp);
+    }
+
+/*******************************************************************************
+*
+* vxFdtDefRegGet - get a register range of a node
+*
+* The address and size of entry <index> of the reg property of the node at
+* <offset> are read with the cell counts of its parent. Bus ranges are not
+* translated, as the BSP device trees have none.
+*
+* RETURNS: OK, or ERROR if the node has no such entry.
+*
+* ERRNO: N/A.
+*/
+
+STATUS vxFdtDefRegGet
+    (
+    int                 offset,     /* node */
+    int                 index,      /* reg entry */
+    PHYS_ADDR *         pAddr,      /* returned address */
+    size_t *            pLen        /* returned size */
+    )
+    {
+    const UINT32 *      pReg;
+    int                 len;
+    int                 parent;
+    UINT32              addrCells;
+    UINT32              sizeCells;
+    UINT32              entry;
+    UINT64              val;
+    UINT32              i;
+
+    parent = rzg2HostFdtParent (offset);
+    pReg = (const UINT32 *) vxFdtPropGet (offset, "reg", &len);
+    if ((parent < 0) || (pReg == NULL) || (index < 0))
+        {
+        return ERROR;
+        }
+
+    addrCells = rzg2HostFdtCells (parent, "#address-cells",
+                                  FDT_ADDR_CELLS_DEFAULT);
+    sizeCells = rzg2HostFdtCells (parent, "#size-cells",
+                                  FDT_SIZE_CELLS_DEFAULT);
+    entry = addrCells + sizeCells;
+
+    if ((entry == 0U) ||
+        (((UINT32) index + 1U) * entry * 4U > (UINT32) len))
+        {
+        return ERROR;
+        }
+
+    pReg += (UINT32) index * entry;
+
+    for (val = 0U, i = 0U; i < addrCells; i++)
+        {
+        val = (val << 32) | vxFdt32ToCpu (pReg [i]);
+        }
+    *pAddr = val;
+
+    for (val = 0U, i = 0U; i < sizeCells; i++)
+        {
+        val = (val << 32) | vxFdt32ToCpu (pReg [addrCells + i]);
+        }
+    *pLen = (size_t) val;
+
+    return OK;
+    }
@@ -0,0 +1,873 @@
+/* rzg2HostShim.c - VxWorks routines for the host build of the RZ/G2 drivers */
+
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1) Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2) Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3) Neither the name of Wind River Systems nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+modification history
+--------------------
+19oct26,agt  written
+*/
+
+/*
+DESCRIPTION
+This file implements the VxWorks and RZ/G2 library routines called by the CPG
+and PFC drivers in the host build. The host tests are single threaded, so the
+semaphores and spinlocks only count their nesting, to catch an unbalanced give.
+The timestamp is the host monotonic clock in nanoseconds.
+
+The VxBus routines work on the devices created by rzg2HostDevCreate() for the
+nodes of the board device tree, whose register resources are the blocks of the
+register model mapped at their addresses. The clock library keeps the clocks
+given to vxbClksInit() with their cached status and rate, and the pin mux
+library has one controller, whose methods are called for the pinmux-0 property
+of a client device.
+*/
+
+/* includes */
+
+#include <vxWorks.h>
+#include <semLib.h>
+#include <spinLockLib.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <rzg2Lib.h>
+
+/* defines */
+
+#define RZG2_HOST_CLK_DOMAINS   4U
+
+/* globals */
+
+KPRINTF_FUNC _func_kprintf = NULL;
+
+/* semLib */
+
+SEM_ID semMCreate
+    (
+    int                 options
+    )
+    {
+    (void)options;
+
+    return calloc (1, sizeof (struct semaphore));
+    }
+
+SEM_ID semBCreate
+    (
+    int                 options,
+    int                 initialState
+    )
+    {
+    SEM_ID              semId = semMCreate (options);
+
+    if ((semId != NULL) && (initialState == SEM_EMPTY))
+        {
+        semId->count = 1;
+        }
+
+    return semId;
+    }
+
+STATUS semTake
+    (
+    SEM_ID              semId,
+    int                 timeout
+    )
+    {
+    (void)timeout;
+
+    if (semId == NULL)
+        {
+        return ERROR;
+        }
+
+    semId->count++;
+
+    return OK;
+    }
+
+STATUS semGive
+    (
+    SEM_ID              semId
+    )
+    {
+    if ((semId == NULL) || (semId->count == 0))
+        {
+        (void)fprintf (stderr, "host shim: semGive of a free semaphore\n");
+        abort ();
+        }
+
+    semId->count--;
+
+    return OK;
+    }
+
+STATUS semDelete
+    (
+    SEM_ID              semId
+    )
+    {
+    free (semId);
+
+    return OK;
+    }
+
+/* spinLockLib */
+
+void spinLockIsrInit
+    (
+    spinlockIsr_t *     pLock,
+    int                 flags
+    )
+    {
+    (void)flags;
+
+    pLock->held = 0;
+    }
+
+void spinLockIsrTake
+    (
+    spinlockIsr_t *     pLock
+    )
+    {
+    if (pLock->held != 0)
+        {
+        (void)fprintf (stderr, "host shim: spinlock taken twice\n");
+        abort ();
+        }
+
+    pLock->held = 1;
+    }
+
+void spinLockIsrGive
+    (
+    spinlockIsr_t *     pLock
+    )
+    {
+    pLock->held = 0;
+    }
+
+/* intLib, taskLib, sysLib, vxCpuLib */
+
+int intCpuLock (void)
+    {
+    return 0;
+    }
+
+void intCpuUnlock
+    (
+    int                 key
+    )
+    {
+    (void)key;
+    }
+
+BOOL intContext (void)
+    {
+    return FALSE;
+    }
+
+int vxCpuIndexGet (void)
+    {
+    return 0;
+    }
+
+int sysClkRateGet (void)
+    {
+    return 60;
+    }
+
+STATUS taskDelay
+    (
+    int                 ticks
+    )
+    {
+    (void)ticks;
+
+    return OK;
+    }
+
+/* fioLib */
+
+int fdprintf
+    (
+    int                 fd,
+    const char *        fmt,
+    ...
+    )
+    {
+    va_list             args;
+    int                 len;
+
+    (void)fd;
+
+    va_start (args, fmt);
+    len = vprintf (fmt, args);
+    va_end (args);
+
+    return len;
+    }
+
+int kprintf
+    (
+    const char *        fmt,
+    ...
+    )
+    {
+    va_list             args;
+    int                 len;
+
+    va_start (args, fmt);
+    len = vprintf (fmt, args);
+    va_end (args);
+
+    return len;
+    }
+
+/* VxBus */
+
+/*******************************************************************************
+*
+* rzg2HostDevMethodGet - find a method of the driver of a device
+*
+* RETURNS: the routine of the method named <pName> of the driver of <pDev>, or
+* NULL if the device has no driver or the driver no such method.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void * rzg2HostDevMethodGet
+    (
+    VXB_DEV_ID          pDev,       /* device */
+    const char *        pName       /* method name */
+    )
+    {
+    VXB_DRV_METHOD *    pMethod;
+
+    if ((pDev == NULL) || (pDev->pDriver == NULL))
+        {
+        return NULL;
+        }
+
+    for (pMethod = pDev->pDriver->pMethods; pMethod->id != NULL; pMethod++)
+        {
+        if (strcmp ((const char *) pMethod->id, pName) == 0)
+            {
+            return pMethod->func;
+            }
+        }
+
+    return NULL;
+    }
+
+/*******************************************************************************
+*
+* rzg2HostDevCreate - create a device for a device tree node
+*
+* This routine creates a device for the node at <pPath> of the device tree
+* loaded by rzg2HostFdtLoad(). A device with a NULL <pDriver> stands for a
+* client of the CPG or PFC, such as a serial port whose pin mux configuration
+* is enabled.
+*
+* RETURNS: the device, or NULL if there is no such node.
+*
+* ERRNO: N/A.
+*/
+
+VXB_DEV_ID rzg2HostDevCreate
+    (
+    const char *        pPath,      /* device tree node path */
+    VXB_DRV *           pDriver     /* driver, or NULL */
+    )
+    {
+    VXB_DEV_ID          pDev;
+    int                 offset;
+
+    offset = vxFdtPathOffset (pPath);
+    if (offset < 0)
+        {
+        (void)fprintf (stderr, "host shim: no device tree node %s\n", pPath);
+        return NULL;
+        }
+
+    pDev = calloc (1, sizeof (struct vxbDev));
+    if (pDev != NULL)
+        {
+        pDev->fdtDev.offset = offset;
+        pDev->pDriver = pDriver;
+        }
+
+    return pDev;
+    }
+
+/*******************************************************************************
+*
+* rzg2HostDevAttach - probe and attach a device
+*
+* This routine calls the vxbDevProbe and vxbDevAttach methods of the driver of
+* <pDev>, as VxBus does for an enabled device tree node.
+*
+* RETURNS: OK, or ERROR if the node is disabled, or the probe or the attach
+* fails.
+*
+* ERRNO: N/A.
+*/
+
+STATUS rzg2HostDevAttach
+    (
+    VXB_DEV_ID          pDev        /* device */
+    )
+    {
+    STATUS              (*probeRtn) (VXB_DEV_ID);
+    STATUS              (*attachRtn) (VXB_DEV_ID);
+
+    probeRtn = rzg2HostDevMethodGet (pDev, "vxbDevProbe");
+    attachRtn = rzg2HostDevMethodGet (pDev, "vxbDevAttach");
+
+    if ((probeRtn == NULL) || (attachRtn == NULL) ||
+        !vxFdtIsEnabled (pDev->fdtDev.offset) || (probeRtn (pDev) == ERROR))
+        {
+        return ERROR;
+        }
+
+    return attachRtn (pDev);
+    }
+
+/*******************************************************************************
+*
+* rzg2HostDevDetach - detach a device
+*
+* RETURNS: the status of the vxbDevDetach method, or ERROR if the driver has
+* none.
+*
+* ERRNO: N/A.
+*/
+
+STATUS rzg2HostDevDetach
+    (
+    VXB_DEV_ID          pDev        /* device */
+    )
+    {
+    STATUS              (*detachRtn) (VXB_DEV_ID);
+
+    detachRtn = rzg2HostDevMethodGet (pDev, "vxbDevDetach");
+    if (detachRtn == NULL)
+        {
+        return ERROR;
+        }
+
+    return detachRtn (pDev);
+    }
+
+/*******************************************************************************
+*
+* rzg2HostDevDelete - delete a device
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+void rzg2HostDevDelete
+    (
+    VXB_DEV_ID          pDev        /* device, or NULL */
+    )
+    {
+    free (pDev);
+    }
+
+STATUS vxbFdtDevMatch
+    (
+    VXB_DEV_ID                      pDev,
+    const VXB_FDT_DEV_MATCH_ENTRY * pMatchTbl,
+    VXB_FDT_DEV_MATCH_ENTRY **      pMatchedEntry
+    )
+    {
+    for (; pMatchTbl->compat != NULL; pMatchTbl++)
+        {
+        if (vxFdtNodeCheckCompatible (pDev->fdtDev.offset,
+                                      pMatchTbl->compat) == 0)
+            {
+            if (pMatchedEntry != NULL)
+                {
+                *pMatchedEntry = (VXB_FDT_DEV_MATCH_ENTRY *) pMatchTbl;
+                }
+            return OK;
+            }
+        }
+
+    return ERROR;
+    }
+
+VXB_FDT_DEV * vxbFdtDevGet
+    (
+    VXB_DEV_ID          pDev
+    )
+    {
+    return (pDev == NULL) ? NULL : &pDev->fdtDev;
+    }
+
+void * vxbDevSoftcGet
+    (
+    VXB_DEV_ID          pDev
+    )
+    {
+    return pDev->pSoftc;
+    }
+
+void vxbDevSoftcSet
+    (
+    VXB_DEV_ID          pDev,
+    void *              pSoftc
+    )
+    {
+    pDev->pSoftc = pSoftc;
+    }
+
+void * vxbDevDrvDataGet
+    (
+    VXB_DEV_ID          pDev
+    )
+    {
+    return pDev->pDrvData;
+    }
+
+void vxbDevDrvDataSet
+    (
+    VXB_DEV_ID          pDev,
+    void *              pData
+    )
+    {
+    pDev->pDrvData = pData;
+    }
+
+/*
+ * The register resources are the blocks of the register model mapped at the
+ * addresses of the reg property of the device tree node.
+ */
+
+VXB_RESOURCE * vxbResourceAlloc
+    (
+    VXB_DEV_ID          pDev,
+    UINT32              type,
+    UINT16              index
+    )
+    {
+    VXB_RESOURCE *      pRes;
+    VXB_RESOURCE_ADR *  pResAdr;
+    PHYS_ADDR           addr;
+    size_t              len;
+
+    if ((type != VXB_RES_MEMORY) ||
+        (vxFdtDefRegGet (pDev->fdtDev.offset, (int) index, &addr,
+                         &len) == ERROR))
+        {
+        return NULL;
+        }
+
+    pRes = calloc (1, sizeof (VXB_RESOURCE) + sizeof (VXB_RESOURCE_ADR));
+    if (pRes == NULL)
+        {
+        return NULL;
+        }
+
+    pResAdr = (VXB_RESOURCE_ADR *) (pRes + 1);
+    pResAdr->start = addr;
+    pResAdr->size = len;
+
+    pRes->id = VXB_RES_ID_CREATE (type, index);
+    pRes->pRes = pResAdr;
+
+    if (vxbRegMap (pRes) == ERROR)
+        {
+        free (pRes);
+        return NULL;
+        }
+
+    return pRes;
+    }
+
+STATUS vxbResourceFree
+    (
+    VXB_DEV_ID          pDev,
+    VXB_RESOURCE *      pRes
+    )
+    {
+    (void)pDev;
+
+    if (pRes == NULL)
+        {
+        return ERROR;
+        }
+
+    free (pRes);
+
+    return OK;
+    }
+
+STATUS vxbRegMap
+    (
+    VXB_RESOURCE *      pRes
+    )
+    {
+    VXB_RESOURCE_ADR *  pResAdr = (VXB_RESOURCE_ADR *) pRes->pRes;
+    RZG2_MODEL_BLOCK *  pBlk;
+
+    pBlk = rzg2ModelBlockAt (pResAdr->start);
+    if (pBlk == NULL)
+        {
+        (void)fprintf (stderr, "host shim: no register block at 0x%llx\n",
+                       (unsigned long long) pResAdr->start);
+        return ERROR;
+        }
+
+    pResAdr->virtAddr = rzg2ModelBaseGet (pBlk);
+    pResAdr->virtual = pResAdr->virtAddr;
+    pResAdr->pHandle = pBlk;
+
+    return OK;
+    }
+
+STATUS vxbRegUnmap
+    (
+    VXB_RESOURCE *      pRes
+    )
+    {
+    (void)pRes;
+
+    return OK;
+    }
+
+UINT32 vxbRead32
+    (
+    void *              handle,
+    UINT32 *            pReg
+    )
+    {
+    (void)handle;
+
+    return *pReg;
+    }
+
+void vxbWrite32
+    (
+    void *              handle,
+    UINT32 *            pReg,
+    UINT32              val
+    )
+    {
+    (void)handle;
+
+    *pReg = val;
+    }
+
+void * vxbMemAlloc
+    (
+    size_t              size
+    )
+    {
+    return calloc (1, size);
+    }
+
+void vxbMemFree
+    (
+    void *              pMem
+    )
+    {
+    free (pMem);
+    }
+
+/* vxbClkLib */
+
+struct vxbClkDomain
+    {
+    VXB_CLK_DOMAIN_REG * pReg;      /* registration of the domain */
+    };
+
+LOCAL struct vxbClkDomain rzg2HostClkDomains [RZG2_HOST_CLK_DOMAINS];
+
+VXB_CLK_DOMAIN * vxbClkDomainRegister
+    (
+    VXB_CLK_DOMAIN_REG * pReg
+    )
+    {
+    UINT32              i;
+
+    /* an attach after a detach registers its domains again */
+
+    for (i = 0U; i < RZG2_HOST_CLK_DOMAINS; i++)
+        {
+        if ((rzg2HostClkDomains [i].pReg == pReg) ||
+            (rzg2HostClkDomains [i].pReg == NULL))
+            {
+            rzg2HostClkDomains [i].pReg = pReg;
+            return &rzg2HostClkDomains [i];
+            }
+        }
+
+    return NULL;
+    }
+
+/*
+ * Each clock of the list is initialised by its clkInit routine, then its
+ * status and rate are read and cached, as vxbClkLib does. The list gives each
+ * parent before its children.
+ */
+
+STATUS vxbClksInit
+    (
+    VXB_DEV_ID          pDev,
+    VXB_CLK_ID *        pClkList,
+    void *              pArg
+    )
+    {
+    VXB_CLK_ID          pClk;
+    UINT64              parentRate;
+
+    (void)pDev;
+    (void)pArg;
+
+    for (; (pClk = *pClkList) != NULL; pClkList++)
+        {
+        if ((pClk->clkFuncs->clkInit != NULL) &&
+            (pClk->clkFuncs->clkInit (pClk) == ERROR))
+            {
+            return ERROR;
+            }
+
+        pClk->clkStatus = vxbClkStatusGet (pClk);
+
+        if (pClk->clkFuncs->clkRateGet != NULL)
+            {
+            parentRate = (pClk->parentClock == NULL) ? 0U :
+                         pClk->parentClock->clkRate;
+            pClk->clkRate = pClk->clkFuncs->clkRateGet (pClk, parentRate);
+            }
+        }
+
+    return OK;
+    }
+
+UINT32 vxbClkStatusGet
+    (
+    VXB_CLK_ID          pClk
+    )
+    {
+    if ((pClk->clkFuncs == NULL) || (pClk->clkFuncs->clkStatusGet == NULL))
+        {
+        return pClk->clkStatus;
+        }
+
+    return pClk->clkFuncs->clkStatusGet (pClk);
+    }
+
+UINT64 vxbClkRateGet
+    (
+    VXB_CLK_ID          pClk
+    )
+    {
+    return (pClk == NULL) ? CLOCK_RATE_INVALID : pClk->clkRate;
+    }
+
+/* vxbPinMuxLib */
+
+LOCAL VXB_PINMUX_CTRL * pRzg2HostPinMuxCtrl = NULL;
+
+STATUS vxbPinMuxRegister
+    (
+    VXB_PINMUX_CTRL *   pCtrl
+    )
+    {
+    if (pRzg2HostPinMuxCtrl != NULL)
+        {
+        return ERROR;
+        }
+
+    pRzg2HostPinMuxCtrl = pCtrl;
+
+    return OK;
+    }
+
+STATUS vxbPinMuxUnregister
+    (
+    VXB_PINMUX_CTRL *   pCtrl
+    )
+    {
+    if (pRzg2HostPinMuxCtrl != pCtrl)
+        {
+        return ERROR;
+        }
+
+    pRzg2HostPinMuxCtrl = NULL;
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* rzg2HostPinMuxCall - call a pin mux method for the default state of a device
+*
+* This routine calls the method <pName> of the registered pin mux controller
+* for each configuration node of the pinmux-0 property of <pDev>, in order.
+*
+* RETURNS: OK, or ERROR if there is no controller or a call fails.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS rzg2HostPinMuxCall
+    (
+    VXB_DEV_ID          pDev,       /* client device */
+    const char *        pName       /* vxbPinMuxEnable or vxbPinMuxDisable */
+    )
+    {
+    STATUS              (*methodRtn) (VXB_DEV_ID, INT32);
+    const UINT32 *      pPhandles;
+    int                 len;
+    int                 i;
+
+    pPhandles = vxFdtPropGet (pDev->fdtDev.offset, "pinmux-0", &len);
+    if ((pPhandles == NULL) || (len <= 0))
+        {
+        return OK;
+        }
+
+    if (pRzg2HostPinMuxCtrl == NULL)
+        {
+        return ERROR;
+        }
+
+    methodRtn = rzg2HostDevMethodGet (pRzg2HostPinMuxCtrl->pDev, pName);
+    if (methodRtn == NULL)
+        {
+        return ERROR;
+        }
+
+    for (i = 0; i < (len / (int) sizeof (UINT32)); i++)
+        {
+        if (methodRtn (pRzg2HostPinMuxCtrl->pDev,
+                       vxFdtNodeOffsetByPhandle (vxFdt32ToCpu (pPhandles [i])))
+            == ERROR)
+            {
+            return ERROR;
+            }
+        }
+
+    return OK;
+    }
+
+STATUS vxbPinMuxEnable
+    (
+    VXB_DEV_ID          pDev
+    )
+    {
+    return rzg2HostPinMuxCall (pDev, "vxbPinMuxEnable");
+    }
+
+STATUS vxbPinMuxDisable
+    (
+    VXB_DEV_ID          pDev
+    )
+    {
+    return rzg2HostPinMuxCall (pDev, "vxbPinMuxDisable");
+    }
+
+/* rzg2Lib */
+
+UINT64 rzg2TimestampGet (void)
+    {
+    struct timespec     ts;
+
+    (void)clock_gettime (CLOCK_MONOTONIC, &ts);
+
+    return ((UINT64) ts.tv_sec * 1000000000ULL) + (UINT64) ts.tv_nsec;
+    }
+
+UINT32 rzg2TimestampFreqGet (void)
+    {
+    return 1000000000U;
+    }
+
+STATUS rzg2SuspendHookAdd
+    (
+    RZG2_SUSPEND_HOOK   saveRtn,
+    RZG2_SUSPEND_HOOK   restoreRtn,
+    void *              pArg
+    )
+    {
+    (void)saveRtn;
+    (void)restoreRtn;
+    (void)pArg;
+
+    return OK;
+    }
+
+UINT64 rzg2LockStatsTake
+    (
+    SEM_ID              semId,
+    RZG2_LOCK_STAT *    pStats
+    )
+    {
+    (void)semTake (semId, WAIT_FOREVER);
+
+    pStats->acquires++;
+
+    return rzg2TimestampGet ();
+    }
+
+void rzg2LockStatsGive
+    (
+    SEM_ID              semId,
+    RZG2_LOCK_STAT *    pStats,
+    UINT64              takeTime
+    )
+    {
+    UINT64              hold = rzg2TimestampGet () - takeTime;
+
+    pStats->holdTotal += hold;
+    if (hold > pStats->holdMax)
+        {
+        pStats->holdMax = hold;
+        }
+
+    (void)semGive (semId);
+    }
+
+void rzg2LockStatsShow
+    (
+    const char *            pName,
+    const RZG2_LOCK_STAT *  pStats
+    )
+    {
+    (void)printf ("%-12s %10u acquires, hold total %llu max %llu\n", pName,
+                  pStats->acquires, pStats->holdTotal, pStats->holdMax);
+    }
@@ -0,0 +1,197 @@
+/* rzg2PfcBootGen.c - generate the PFC boot program of a board device tree */
+
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1) Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2) Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3) Neither the name of Wind River Systems nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+modification history
+--------------------
+19oct26,agt  written
+*/
+
+/*
+DESCRIPTION
+This program generates, on the build host, the PFC boot program of a board
+from its compiled device tree, for rzg2PfcBootProgSet(). It is built like the
+host tests, with the PFC driver compiled against the register model, and is run
+by the BSP build rules on the device tree blob of the image:
+
+\cs
+    rzg2PfcBootGen <board>.dtb rzg2PfcBootProg.c
+\ce
+
+The driver is attached to the PFC node of the blob, and the default pin mux
+state, the <pinmux-0> property, of every enabled node is enabled, as when the
+devices of the board attach. rzg2PfcBootProgDump() then writes the register
+writes of the enabled configuration nodes, as the C array rzg2PfcBootWrites,
+to the output file. A default state that cannot be enabled, for example because
+its pins are already owned by another node, is reported, and no file is
+written.
+*/
+
+/* includes */
+
+#include <vxWorks.h>
+#include <stdlib.h>
+
+#include "../../src/vxbFdtRsRzg2PfcPinMux.c"
+
+/* locals */
+
+LOCAL RZG2_MODEL_BLOCK      bootGenPfcBlk;
+
+/*******************************************************************************
+*
+* bootGenPfcAttach - attach the driver to the PFC node of the device tree
+*
+* This routine attaches the driver to the first node compatible with the
+* driver, over a cleared register block mapped at the node address.
+*
+* RETURNS: the PFC device, or NULL if there is no PFC node or the attach fails.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL VXB_DEV_ID bootGenPfcAttach (void)
+    {
+    VXB_DEV_ID          pDev;
+    PHYS_ADDR           addr;
+    size_t              len;
+    int                 node;
+
+    node = vxFdtNodeOffsetByCompatible (-1, vxbFdtPfcPinMuxMatch [0].compat);
+    if ((node < 0) || (vxFdtDefRegGet (node, 0, &addr, &len) == ERROR))
+        {
+        (void)fprintf (stderr, "rzg2PfcBootGen: no %s node\n",
+                       vxbFdtPfcPinMuxMatch [0].compat);
+        return NULL;
+        }
+
+    rzg2ModelBlockInit (&bootGenPfcBlk, "PFC", PFC_PMMR, NULL);
+    rzg2ModelBlockMap (&bootGenPfcBlk, addr);
+
+    pDev = calloc (1, sizeof (struct vxbDev));
+    if (pDev == NULL)
+        {
+        return NULL;
+        }
+
+    pDev->fdtDev.offset = node;
+    pDev->pDriver = &vxbFdtRsRzg2PfcPinMuxDrv;
+
+    if (rzg2HostDevAttach (pDev) == ERROR)
+        {
+        (void)fprintf (stderr, "rzg2PfcBootGen: PFC attach failed\n");
+        free (pDev);
+        return NULL;
+        }
+
+    return pDev;
+    }
+
+/*******************************************************************************
+*
+* bootGenClientsEnable - enable the default pin mux state of the enabled nodes
+*
+* RETURNS: OK, or ERROR if a default state cannot be enabled.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS bootGenClientsEnable (void)
+    {
+    struct vxbDev       client;
+    int                 node;
+
+    for (node = vxFdtNextNode (-1, NULL); node >= 0;
+         node = vxFdtNextNode (node, NULL))
+        {
+        if ((vxFdtPropGet (node, "pinmux-0", NULL) == NULL) ||
+            !vxFdtIsEnabled (node))
+            {
+            continue;
+            }
+
+        memset (&client, 0, sizeof (client));
+        client.fdtDev.offset = node;
+
+        if (vxbPinMuxEnable (&client) == ERROR)
+            {
+            (void)fprintf (stderr, "rzg2PfcBootGen: cannot enable the default "
+                           "pin mux state of %s\n", vxFdtGetName (node, NULL));
+            return ERROR;
+            }
+        }
+
+    return OK;
+    }
+
+/*******************************************************************************
+*
+* main - generate the PFC boot program of a device tree blob
+*
+* RETURNS: EXIT_SUCCESS, or EXIT_FAILURE if the boot program cannot be
+* generated.
+*
+* ERRNO: N/A.
+*/
+
+int main
+    (
+    int                 argc,
+    char **             argv
+    )
+    {
+    if (argc != 3)
+        {
+        (void)fprintf (stderr, "usage: rzg2PfcBootGen <dtb> <output>\n");
+        return EXIT_FAILURE;
+        }
+
+    if ((rzg2HostFdtLoad (argv [1]) == ERROR) ||
+        (bootGenPfcAttach () == NULL) ||
+        (bootGenClientsEnable () == ERROR))
+        {
+        return EXIT_FAILURE;
+        }
+
+    if (freopen (argv [2], "w", stdout) == NULL)
+        {
+        (void)fprintf (stderr, "rzg2PfcBootGen: cannot write %s\n", argv [2]);
+        return EXIT_FAILURE;
+        }
+
+    (void)printf ("/* rzg2PfcBootProg.c - PFC boot program of %s */\n\n",
+                  argv [1]);
+    (void)printf ("/* generated by rzg2PfcBootGen, do not edit */\n\n");
+
+    rzg2PfcBootProgDump ();
+
+    return (fclose (stdout) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
@@ -0,0 +1,474 @@
+/* rzg2RegModel.c - register file model for the host build of the RZ/G2 drivers */
+
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1) Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2) Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3) Neither the name of Wind River Systems nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+modification history
+--------------------
+19oct26,agt  written
+*/
+
+/*
+DESCRIPTION
+This library models the register files of the RZ/G2 CPG and PFC for the host
+build of their drivers. Each block is a 4 KB array of 32-bit registers, and
+rzg2ModelBaseGet() returns the address that the driver uses as its register
+base. The driver register accessors, RZG2_REG_READ32() and RZG2_REG_WRITE32(),
+are defined by rzg2RegModel.h to rzg2ModelRead32() and rzg2ModelWrite32().
+
+The write protection of both blocks is modelled: a write to a register for
+which the block protection routine returns TRUE only takes effect if the
+previous write to the block wrote the inverted value to its unlock register,
+PMMR for the PFC or CPGWPR for the CPG. Other writes are dropped and counted as
+violations. Side effects of a register, such as a status bit cleared by the
+hardware, are modelled by the block hook.
+
+A block can be mapped at the address of its device tree node, so that the
+register resources of a driver attached to the board device tree are the
+registers of the block.
+
+Every write, including the unlock writes, is recorded in the write log, which
+the tests compare with the sequences the drivers must produce.
+
+INCLUDE FILES: rzg2RegModel.h
+*/
+
+/* includes */
+
+#include <vxWorks.h>
+
+#include "rzg2RegModel.h"
+
+/* defines */
+
+#define RZG2_MODEL_BLOCKS_MAX   4U
+
+/* locals */
+
+LOCAL RZG2_MODEL_BLOCK *    rzg2ModelBlocks [RZG2_MODEL_BLOCKS_MAX];
+LOCAL UINT32                rzg2ModelNumBlocks = 0U;
+LOCAL RZG2_MODEL_WRITE      rzg2ModelLog [RZG2_MODEL_LOG_MAX];
+LOCAL UINT32                rzg2ModelLogNum = 0U;
+LOCAL BOOL                  rzg2ModelLogOn = TRUE;
+
+/*******************************************************************************
+*
+* rzg2ModelBlockInit - initialise a register block
+*
+* This routine clears the registers of <pBlk> and registers the block with the
+* model, if it is not yet registered. Writes to the registers for which
+* <protFunc> returns TRUE must be unlocked through the register at
+* <unlockOffset>. A NULL <protFunc> leaves all registers unprotected.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+void rzg2ModelBlockInit
+    (
+    RZG2_MODEL_BLOCK *      pBlk,           /* block to initialise */
+    const char *            name,           /* block name */
+    UINT32                  unlockOffset,   /* unlock register offset */
+    RZG2_MODEL_PROT_FUNC    protFunc        /* protected registers, or NULL */
+    )
+    {
+    UINT32 i;
+
+    (void)memset (pBlk, 0, sizeof (RZG2_MODEL_BLOCK));
+    pBlk->name = name;
+    pBlk->unlockOffset = unlockOffset;
+    pBlk->protFunc = protFunc;
+
+    for (i = 0U; i < rzg2ModelNumBlocks; i++)
+        {
+        if (rzg2ModelBlocks [i] == pBlk)
+            {
+            return;
+            }
+        }
+
+    if (rzg2ModelNumBlocks < RZG2_MODEL_BLOCKS_MAX)
+        {
+        rzg2ModelBlocks [rzg2ModelNumBlocks++] = pBlk;
+        }
+    }
+
+/*******************************************************************************
+*
+* rzg2ModelBaseGet - get the register base of a block
+*
+* RETURNS: the address to use as the register base of <pBlk>.
+*
+* ERRNO: N/A.
+*/
+
+VIRT_ADDR rzg2ModelBaseGet
+    (
+    RZG2_MODEL_BLOCK *      pBlk            /* register block */
+    )
+    {
+    return (VIRT_ADDR) &pBlk->regs [0];
+    }
+
+/*******************************************************************************
+*
+* rzg2ModelBlockMap - map a register block at a physical address
+*
+* This routine makes <pBlk> the registers found at <physAddr> by the register
+* resources of the host build. It must be called after rzg2ModelBlockInit(),
+* which clears the address.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+void rzg2ModelBlockMap
+    (
+    RZG2_MODEL_BLOCK *      pBlk,           /* register block */
+    PHYS_ADDR               physAddr        /* device tree register address */
+    )
+    {
+    pBlk->physAddr = physAddr;
+    }
+
+/*******************************************************************************
+*
+* rzg2ModelBlockAt - find the register block mapped at a physical address
+*
+* RETURNS: the block mapped at <physAddr>, or NULL if there is none.
+*
+* ERRNO: N/A.
+*/
+
+RZG2_MODEL_BLOCK * rzg2ModelBlockAt
+    (
+    PHYS_ADDR               physAddr        /* device tree register address */
+    )
+    {
+    UINT32                  i;
+
+    for (i = 0U; i < rzg2ModelNumBlocks; i++)
+        {
+        if ((physAddr != 0U) && (rzg2ModelBlocks [i]->physAddr == physAddr))
+            {
+            return rzg2ModelBlocks [i];
+            }
+        }
+
+    return NULL;
+    }
+
+/*******************************************************************************
+*
+* rzg2ModelFind - find the block and offset of a register address
+*
+* RETURNS: the block holding <pReg>, or NULL if no block does.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL RZG2_MODEL_BLOCK * rzg2ModelFind
+    (
+    UINT32 *                pReg,           /* register address */
+    UINT32 *                pOffset         /* returned register offset */
+    )
+    {
+    RZG2_MODEL_BLOCK *      pBlk;
+    UINT32                  i;
+
+    for (i = 0U; i < rzg2ModelNumBlocks; i++)
+        {
+        pBlk = rzg2ModelBlocks [i];
+        if ((pReg >= &pBlk->regs [0]) && (pReg < &pBlk->regs [RZG2_MODEL_REGS]))
+            {
+            *pOffset = (UINT32)(pReg - &pBlk->regs [0]) * 4U;
+            return pBlk;
+            }
+        }
+
+    (void)fprintf (stderr, "register model: access outside the blocks at %p\n",
+                   (void *) pReg);
+
+    return NULL;
+    }
+
+/*******************************************************************************
+*
+* rzg2ModelRead32 - read a modelled register
+*
+* RETURNS: the register value, or 0 if <pReg> is not in a block.
+*
+* ERRNO: N/A.
+*/
+
+UINT32 rzg2ModelRead32
+    (
+    void *                  handle,         /* register access handle */
+    UINT32 *                pReg            /* register address */
+    )
+    {
+    RZG2_MODEL_BLOCK *      pBlk;
+    UINT32                  offset;
+    UINT32                  val;
+
+    (void)handle;
+
+    pBlk = rzg2ModelFind (pReg, &offset);
+    if (pBlk == NULL)
+        {
+        return 0U;
+        }
+
+    pBlk->reads++;
+    val = *pReg;
+
+    if (pBlk->hook != NULL)
+        {
+        pBlk->hook (pBlk, offset, FALSE);
+        }
+
+    return val;
+    }
+
+/*******************************************************************************
+*
+* rzg2ModelWrite32 - write a modelled register
+*
+* This routine logs the write of <val> to <pReg>, then applies it unless the
+* register is protected and the write was not unlocked.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+void rzg2ModelWrite32
+    (
+    void *                  handle,         /* register access handle */
+    UINT32 *                pReg,           /* register address */
+    UINT32                  val             /* value to write */
+    )
+    {
+    RZG2_MODEL_BLOCK *      pBlk;
+    UINT32                  offset;
+    BOOL                    unlocked;
+
+    (void)handle;
+
+    pBlk = rzg2ModelFind (pReg, &offset);
+    if (pBlk == NULL)
+        {
+        return;
+        }
+
+    if (rzg2ModelLogOn && (rzg2ModelLogNum < RZG2_MODEL_LOG_MAX))
+        {
+        rzg2ModelLog [rzg2ModelLogNum].pBlk = pBlk;
+        rzg2ModelLog [rzg2ModelLogNum].offset = offset;
+        rzg2ModelLog [rzg2ModelLogNum].val = val;
+        rzg2ModelLogNum++;
+        }
+
+    /* the unlock only applies to the next write to the block */
+
+    unlocked = pBlk->unlocked && (pBlk->unlockVal == ~val);
+    pBlk->unlocked = FALSE;
+
+    if ((pBlk->protFunc != NULL) && (offset == pBlk->unlockOffset))
+        {
+        pBlk->unlocked = TRUE;
+        pBlk->unlockVal = val;
+        pBlk->unlocks++;
+        return;
+        }
+
+    if ((pBlk->protFunc != NULL) && pBlk->protFunc (pBlk, offset) &&
+        !unlocked)
+        {
+        (void)fprintf (stderr,
+                       "register model: %s 0x%03x write of 0x%08x not unlocked\n",
+                       pBlk->name, offset, val);
+        pBlk->violations++;
+        return;
+        }
+
+    *pReg = val;
+    pBlk->writes++;
+
+    if (pBlk->hook != NULL)
+        {
+        pBlk->hook (pBlk, offset, TRUE);
+        }
+    }
+
+/*******************************************************************************
+*
+* rzg2ModelLogReset - clear the write log
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+void rzg2ModelLogReset (void)
+    {
+    rzg2ModelLogNum = 0U;
+    }
+
+/*******************************************************************************
+*
+* rzg2ModelLogEnable - enable or disable the write log
+*
+* The log is disabled by the benchmarks, which write more than it holds.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+void rzg2ModelLogEnable
+    (
+    BOOL                    enable          /* TRUE to log the writes */
+    )
+    {
+    rzg2ModelLogOn = enable;
+    }
+
+/*******************************************************************************
+*
+* rzg2ModelLogCount - get the number of logged writes
+*
+* RETURNS: the number of writes logged since rzg2ModelLogReset().
+*
+* ERRNO: N/A.
+*/
+
+UINT32 rzg2ModelLogCount (void)
+    {
+    return rzg2ModelLogNum;
+    }
+
+/*******************************************************************************
+*
+* rzg2ModelLogGet - get a logged write
+*
+* RETURNS: the write at <index> of the log, or NULL if there is none.
+*
+* ERRNO: N/A.
+*/
+
+const RZG2_MODEL_WRITE * rzg2ModelLogGet
+    (
+    UINT32                  index           /* log index */
+    )
+    {
+    if (index >= rzg2ModelLogNum)
+        {
+        return NULL;
+        }
+
+    return &rzg2ModelLog [index];
+    }
+
+/*******************************************************************************
+*
+* rzg2ModelLogExpect - compare the write log with a sequence
+*
+* This routine compares the writes logged since rzg2ModelLogReset() with the
+* <numWrites> writes of <pSeq>, which holds an offset and a value for each
+* write, all to block <pBlk>. The log is printed if they differ.
+*
+* RETURNS: OK if the log holds exactly the sequence, ERROR otherwise.
+*
+* ERRNO: N/A.
+*/
+
+STATUS rzg2ModelLogExpect
+    (
+    RZG2_MODEL_BLOCK *      pBlk,           /* block of the writes */
+    const UINT32 *          pSeq,           /* offset and value pairs */
+    UINT32                  numWrites       /* number of writes */
+    )
+    {
+    UINT32                  i;
+
+    if (rzg2ModelLogNum == numWrites)
+        {
+        for (i = 0U; i < numWrites; i++)
+            {
+            if ((rzg2ModelLog [i].pBlk != pBlk) ||
+                (rzg2ModelLog [i].offset != pSeq [2U * i]) ||
+                (rzg2ModelLog [i].val != pSeq [(2U * i) + 1U]))
+                {
+                break;
+                }
+            }
+
+        if (i == numWrites)
+            {
+            return OK;
+            }
+        }
+
+    (void)printf ("    expected %u writes:\n", numWrites);
+    for (i = 0U; i < numWrites; i++)
+        {
+        (void)printf ("      %s 0x%03x <- 0x%08x\n", pBlk->name, pSeq [2U * i],
+                      pSeq [(2U * i) + 1U]);
+        }
+
+    rzg2ModelLogShow ();
+
+    return ERROR;
+    }
+
+/*******************************************************************************
+*
+* rzg2ModelLogShow - print the write log
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+void rzg2ModelLogShow (void)
+    {
+    UINT32                  i;
+
+    (void)printf ("    logged %u writes:\n", rzg2ModelLogNum);
+    for (i = 0U; i < rzg2ModelLogNum; i++)
+        {
+        (void)printf ("      %s 0x%03x <- 0x%08x\n",
+                      rzg2ModelLog [i].pBlk->name, rzg2ModelLog [i].offset,
+                      rzg2ModelLog [i].val);
+        }
+    }
@@ -0,0 +1,116 @@
+/* rzg2RegModel.h - register file model for the host build of the RZ/G2 drivers */
+
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1) Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2) Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3) Neither the name of Wind River Systems nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+modification history
+--------------------
+19oct26,agt  written
+*/
+
+#ifndef __INCrzg2RegModelh
+#define __INCrzg2RegModelh
+
+#include <vxWorks.h>
+
+/*
+ * The drivers access their registers through RZG2_REG_READ32() and
+ * RZG2_REG_WRITE32(). This file is included before rzg2Lib.h, on the compiler
+ * command line, so that the accessors go to the model.
+ */
+
+#define RZG2_REG_READ32(handle, pReg)       rzg2ModelRead32 ((handle), (pReg))
+#define RZG2_REG_WRITE32(handle, pReg, val) \
+    rzg2ModelWrite32 ((handle), (pReg), (val))
+
+/* defines */
+
+#define RZG2_MODEL_REGS         1024U   /* 32-bit registers in a 4 KB window */
+#define RZG2_MODEL_LOG_MAX      4096U   /* writes kept in the write log */
+
+/* typedefs */
+
+typedef struct rzg2ModelBlock RZG2_MODEL_BLOCK;
+
+/* returns TRUE if the register at <offset> is write protected */
+
+typedef BOOL (*RZG2_MODEL_PROT_FUNC) (RZG2_MODEL_BLOCK * pBlk, UINT32 offset);
+
+/* called after a register is read or written, to model its side effects */
+
+typedef void (*RZG2_MODEL_HOOK) (RZG2_MODEL_BLOCK * pBlk, UINT32 offset,
+                                 BOOL write);
+
+/* one modelled register block */
+
+struct rzg2ModelBlock
+    {
+    const char *            name;       /* block name, for messages */
+    UINT32                  regs [RZG2_MODEL_REGS];     /* register values */
+    UINT32                  unlockOffset;   /* PMMR or CPGWPR */
+    RZG2_MODEL_PROT_FUNC    protFunc;   /* write protected registers */
+    RZG2_MODEL_HOOK         hook;       /* register side effects, or NULL */
+    PHYS_ADDR               physAddr;   /* device tree address, or 0 */
+    BOOL                    unlocked;   /* last write was to unlockOffset */
+    UINT32                  unlockVal;  /* value written to unlockOffset */
+    UINT32                  reads;      /* register reads */
+    UINT32                  writes;     /* register writes accepted */
+    UINT32                  unlocks;    /* writes to unlockOffset */
+    UINT32                  violations; /* protected writes not unlocked */
+    };
+
+/* one entry of the write log */
+
+typedef struct rzg2ModelWrite
+    {
+    RZG2_MODEL_BLOCK *      pBlk;       /* block written */
+    UINT32                  offset;     /* register offset */
+    UINT32                  val;        /* value written */
+    } RZG2_MODEL_WRITE;
+
+/* function declarations */
+
+IMPORT void     rzg2ModelBlockInit (RZG2_MODEL_BLOCK * pBlk, const char * name,
+                                    UINT32 unlockOffset,
+                                    RZG2_MODEL_PROT_FUNC protFunc);
+IMPORT VIRT_ADDR rzg2ModelBaseGet (RZG2_MODEL_BLOCK * pBlk);
+IMPORT void     rzg2ModelBlockMap (RZG2_MODEL_BLOCK * pBlk, PHYS_ADDR physAddr);
+IMPORT RZG2_MODEL_BLOCK * rzg2ModelBlockAt (PHYS_ADDR physAddr);
+IMPORT UINT32   rzg2ModelRead32 (void * handle, UINT32 * pReg);
+IMPORT void     rzg2ModelWrite32 (void * handle, UINT32 * pReg, UINT32 val);
+IMPORT void     rzg2ModelLogReset (void);
+IMPORT void     rzg2ModelLogEnable (BOOL enable);
+IMPORT UINT32   rzg2ModelLogCount (void);
+IMPORT const RZG2_MODEL_WRITE * rzg2ModelLogGet (UINT32 index);
+IMPORT STATUS   rzg2ModelLogExpect (RZG2_MODEL_BLOCK * pBlk,
+                                    const UINT32 * pSeq, UINT32 numWrites);
+IMPORT void     rzg2ModelLogShow (void);
+
+#endif /* __INCrzg2RegModelh */
@@ -0,0 +1,3 @@
+/* vxbFdtLib.h - host build stand-in for the VxWorks header */
+
+#include <vxHost.h>
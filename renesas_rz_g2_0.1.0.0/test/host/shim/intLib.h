@@ -0,0 +1,3 @@
+/* intLib.h - host build stand-in for the VxWorks header */
+
+#include <vxHost.h>
@@ -0,0 +1,3 @@
+/* vxbClkLib.h - host build stand-in for the VxWorks header */
+
+#include <vxHost.h>
@@ -0,0 +1,3 @@
+/* sysLib.h - host build stand-in for the VxWorks header */
+
+#include <vxHost.h>
@@ -0,0 +1,3 @@
+/* vsbConfig.h - host build stand-in for the VxWorks header */
+
+#include <vxHost.h>
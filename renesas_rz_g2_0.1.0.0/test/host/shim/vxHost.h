@@ -0,0 +1,373 @@
+/* vxHost.h - VxWorks definitions for the host build of the RZ/G2 drivers */
+
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1) Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2) Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3) Neither the name of Wind River Systems nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+modification history
+--------------------
+19oct26,agt  written
+*/
+
+/*
+DESCRIPTION
+This file holds the VxWorks types, macros and routine declarations used by the
+RZ/G2 CPG and PFC drivers, so that they can be compiled for the host against
+the register model. Each VxWorks header the drivers include is a file in this
+directory that includes this one. Only what the drivers use is defined. The
+VxBus, clock and pin mux library routines are in rzg2HostShim.c, and the FDT
+routines, over the compiled board device tree, in rzg2HostFdt.c.
+*/
+
+#ifndef __INCvxHosth
+#define __INCvxHosth
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+/* defines */
+
+#define OK                      0
+#define ERROR                   (-1)
+#define TRUE                    1
+#define FALSE                   0
+#define LOCAL                   static
+#define IMPORT                  extern
+#define NELEMENTS(array)        (sizeof (array) / sizeof ((array) [0]))
+#define WAIT_FOREVER            (-1)
+#define NO_WAIT                 0
+#define _WRS_INLINE             static inline
+#define WRS_ASM(x)              __asm__ volatile ("" ::: "memory")
+#define VX_MEM_BARRIER_RW()     __sync_synchronize ()
+#define VX_MEM_BARRIER_R()      __sync_synchronize ()
+#define VX_MEM_BARRIER_W()      __sync_synchronize ()
+
+#define _WRS_CONFIG_LP64        1
+#define _WRS_CONFIG_FDT         1
+
+/* typedefs */
+
+typedef int                     STATUS;
+typedef int                     BOOL;
+typedef unsigned int            UINT;
+typedef uint8_t                 UINT8;
+typedef uint16_t                UINT16;
+typedef uint32_t                UINT32;
+typedef unsigned long long      UINT64;
+typedef int8_t                  INT8;
+typedef int16_t                 INT16;
+typedef int32_t                 INT32;
+typedef int64_t                 INT64;
+typedef unsigned char           UCHAR;
+typedef unsigned short          USHORT;
+typedef unsigned long           ULONG;
+typedef uintptr_t               VIRT_ADDR;
+typedef uint64_t                PHYS_ADDR;
+typedef int                     (*FUNCPTR) ();
+typedef void                    (*VOIDFUNCPTR) ();
+typedef long                    TASK_ID;
+
+#define TASK_ID_ERROR           ((TASK_ID) -1)
+
+/* semLib */
+
+/* the host tests are single threaded: a semaphore only counts its takes */
+
+typedef struct semaphore
+    {
+    int             count;          /* takes not yet given */
+    } * SEM_ID;
+
+#define SEM_ID_NULL             ((SEM_ID) 0)
+#define SEM_Q_FIFO              0x00
+#define SEM_Q_PRIORITY          0x01
+#define SEM_DELETE_SAFE         0x04
+#define SEM_INVERSION_SAFE      0x08
+#define SEM_EMPTY               0
+#define SEM_FULL                1
+
+/* spinLockLib */
+
+typedef struct spinlockIsr
+    {
+    volatile int    held;
+    } spinlockIsr_t;
+
+#define SPIN_LOCK_ISR_INIT(pLock, flags)    spinLockIsrInit ((pLock), (flags))
+#define SPIN_LOCK_ISR_TAKE(pLock)           spinLockIsrTake ((pLock))
+#define SPIN_LOCK_ISR_GIVE(pLock)           spinLockIsrGive ((pLock))
+
+/* dllLib */
+
+typedef struct dlnode
+    {
+    struct dlnode * next;
+    struct dlnode * previous;
+    } DL_NODE;
+
+typedef struct
+    {
+    DL_NODE *       head;
+    DL_NODE *       tail;
+    } DL_LIST;
+
+#define DLL_INIT(pList)         ((pList)->head = (pList)->tail = NULL)
+
+/* VxBus */
+
+typedef struct vxbDev *         VXB_DEV_ID;
+
+typedef struct vxbDrvMethod
+    {
+    void *          id;
+    void *          func;
+    } VXB_DRV_METHOD;
+
+/* a method is known by its name, so the shim can call a driver method */
+
+#define VXB_DEVMETHOD_CALL(method)  ((void *) #method)
+#define VXB_DEVMETHOD_END           { NULL, NULL }
+
+typedef struct vxbDrv
+    {
+    struct
+        {
+        void *      pNext;
+        } node;
+    char *          drvName;
+    char *          drvDesc;
+    int             drvBusId;
+    UINT32          drvFlags;
+    int             drvRefs;
+    VXB_DRV_METHOD * pMethods;
+    } VXB_DRV;
+
+#define VXB_DRV_DEF(drv)
+#define VXB_BUSID_FDT           1
+
+typedef struct vxbFdtDevMatchEntry
+    {
+    const char *    compat;
+    const void *    data;
+    } VXB_FDT_DEV_MATCH_ENTRY;
+
+typedef struct vxbFdtDev
+    {
+    int             offset;
+    } VXB_FDT_DEV;
+
+/* a device of the host build, created by rzg2HostDevCreate() */
+
+struct vxbDev
+    {
+    VXB_FDT_DEV     fdtDev;         /* device tree node */
+    VXB_DRV *       pDriver;        /* driver, or NULL for a client device */
+    void *          pSoftc;         /* driver instance */
+    void *          pDrvData;       /* match table data */
+    };
+
+typedef struct vxbResourceAdr
+    {
+    PHYS_ADDR       start;
+    size_t          size;
+    VIRT_ADDR       virtAddr;
+    VIRT_ADDR       virtual;
+    void *          pHandle;
+    } VXB_RESOURCE_ADR;
+
+typedef struct vxbResource
+    {
+    UINT32          id;
+    void *          pRes;
+    } VXB_RESOURCE;
+
+#define VXB_RES_MEMORY          1
+#define VXB_RES_IRQ             2
+#define VXB_RES_ID_CREATE(type, index)  (((type) << 16) | (index))
+
+/* vxFdtLib */
+
+#define FDT_ERR_NOTFOUND        1
+
+/* vxbClkLib */
+
+typedef enum
+    {
+    VXB_CLK_FIX_RATE,
+    VXB_CLK_FIX_FACTOR,
+    VXB_CLK_PLL,
+    VXB_CLK_DIVIDER,
+    VXB_CLK_GATE,
+    VXB_CLK_MUX
+    } VXB_CLK_TYPE;
+
+struct vxb_clk;
+
+typedef struct vxbClkFunc
+    {
+    STATUS  (*clkEnable) (struct vxb_clk * pClk);
+    STATUS  (*clkDisable) (struct vxb_clk * pClk);
+    STATUS  (*clkRateSet) (struct vxb_clk * pClk, UINT64 parentRate,
+                           UINT64 rate);
+    UINT64  (*clkRateGet) (struct vxb_clk * pClk, UINT64 parentRate);
+    UINT32  (*clkStatusGet) (struct vxb_clk * pClk);
+    STATUS  (*clkParentSet) (struct vxb_clk * pClk, UINT32 index);
+    STATUS  (*clkInit) (struct vxb_clk * pClk);
+    STATUS  (*clkExtCtrl) (struct vxb_clk * pClk, UINT32 cmd, void * pArg);
+    } VXB_CLK_FUNC;
+
+typedef struct vxbClkDomainReg
+    {
+    char *          domainName;
+    void *          clkInit;
+    void *          clkFree;
+    } VXB_CLK_DOMAIN_REG;
+
+typedef struct vxbClkDomain VXB_CLK_DOMAIN;
+
+typedef struct vxb_clk
+    {
+    VXB_DEV_ID          pDev;
+    VXB_CLK_DOMAIN *    clkDomain;
+    VXB_CLK_FUNC *      clkFuncs;
+    char *              clkName;
+    VXB_CLK_TYPE        clkType;
+    UINT64              clkRate;
+    void *              clkContext;
+    struct vxb_clk *    parentClock;
+    DL_LIST             clkNode;
+    DL_LIST             rootClkNode;
+    UINT32              clkStatus;
+    UINT32              clkRefs;
+    char *              parentName;
+    char **             parentNames;
+    struct vxb_clk **   parentClocks;
+    UINT32              parentNum;
+    UINT32              parentIdx;
+    DL_LIST             parentNode;
+    DL_LIST             childClkList;
+    } VXB_CLK;
+
+typedef VXB_CLK *               VXB_CLK_ID;
+
+#define CLOCK_RATE_INVALID      ((UINT64) -1)
+#define CLOCK_STATUS_GATED      0
+#define CLOCK_STATUS_ENABLED    1
+#define CLOCK_STATUS_UNKNOWN    2
+
+/* vxbPinMuxLib */
+
+typedef struct vxbPinMuxCtrl
+    {
+    VXB_DEV_ID      pDev;
+    void *          pFuncs;
+    } VXB_PINMUX_CTRL;
+
+/* kwriteLibP */
+
+typedef int (*KPRINTF_FUNC) (const char * fmt, ...);
+
+/* function declarations */
+
+IMPORT SEM_ID       semMCreate (int options);
+IMPORT SEM_ID       semBCreate (int options, int initialState);
+IMPORT STATUS       semTake (SEM_ID semId, int timeout);
+IMPORT STATUS       semGive (SEM_ID semId);
+IMPORT STATUS       semDelete (SEM_ID semId);
+
+IMPORT void         spinLockIsrInit (spinlockIsr_t * pLock, int flags);
+IMPORT void         spinLockIsrTake (spinlockIsr_t * pLock);
+IMPORT void         spinLockIsrGive (spinlockIsr_t * pLock);
+
+IMPORT int          intCpuLock (void);
+IMPORT void         intCpuUnlock (int key);
+IMPORT BOOL         intContext (void);
+IMPORT int          vxCpuIndexGet (void);
+IMPORT int          sysClkRateGet (void);
+IMPORT STATUS       taskDelay (int ticks);
+IMPORT int          fdprintf (int fd, const char * fmt, ...);
+IMPORT int          kprintf (const char * fmt, ...);
+IMPORT KPRINTF_FUNC _func_kprintf;
+
+IMPORT STATUS       vxbFdtDevMatch (VXB_DEV_ID pDev,
+                                    const VXB_FDT_DEV_MATCH_ENTRY * pMatchTbl,
+                                    VXB_FDT_DEV_MATCH_ENTRY ** pMatchedEntry);
+IMPORT VXB_FDT_DEV * vxbFdtDevGet (VXB_DEV_ID pDev);
+IMPORT void *       vxbDevSoftcGet (VXB_DEV_ID pDev);
+IMPORT void         vxbDevSoftcSet (VXB_DEV_ID pDev, void * pSoftc);
+IMPORT void *       vxbDevDrvDataGet (VXB_DEV_ID pDev);
+IMPORT void         vxbDevDrvDataSet (VXB_DEV_ID pDev, void * pData);
+IMPORT VXB_RESOURCE * vxbResourceAlloc (VXB_DEV_ID pDev, UINT32 type,
+                                        UINT16 index);
+IMPORT STATUS       vxbResourceFree (VXB_DEV_ID pDev, VXB_RESOURCE * pRes);
+IMPORT STATUS       vxbRegMap (VXB_RESOURCE * pRes);
+IMPORT STATUS       vxbRegUnmap (VXB_RESOURCE * pRes);
+IMPORT UINT32       vxbRead32 (void * handle, UINT32 * pReg);
+IMPORT void         vxbWrite32 (void * handle, UINT32 * pReg, UINT32 val);
+IMPORT void *       vxbMemAlloc (size_t size);
+IMPORT void         vxbMemFree (void * pMem);
+
+IMPORT const void * vxFdtPropGet (int offset, const char * name, int * pLen);
+IMPORT UINT32       vxFdt32ToCpu (UINT32 val);
+IMPORT int          vxFdtFirstSubnode (int offset);
+IMPORT int          vxFdtNextSubnode (int offset);
+IMPORT int          vxFdtNextNode (int offset, int * pDepth);
+IMPORT const char * vxFdtGetName (int offset, int * pLen);
+IMPORT int          vxFdtNodeOffsetByCompatible (int startOffset,
+                                                 const char * compatible);
+IMPORT int          vxFdtNodeOffsetByPhandle (UINT32 phandle);
+IMPORT BOOL         vxFdtIsEnabled (int offset);
+IMPORT int          vxFdtPathOffset (const char * pPath);
+IMPORT int          vxFdtNodeCheckCompatible (int offset,
+                                              const char * compatible);
+IMPORT STATUS       vxFdtDefRegGet (int offset, int index, PHYS_ADDR * pAddr,
+                                    size_t * pLen);
+
+IMPORT VXB_CLK_DOMAIN * vxbClkDomainRegister (VXB_CLK_DOMAIN_REG * pReg);
+IMPORT STATUS       vxbClksInit (VXB_DEV_ID pDev, VXB_CLK_ID * pClkList,
+                                 void * pArg);
+IMPORT UINT32       vxbClkStatusGet (VXB_CLK_ID pClk);
+IMPORT UINT64       vxbClkRateGet (VXB_CLK_ID pClk);
+
+IMPORT STATUS       vxbPinMuxRegister (VXB_PINMUX_CTRL * pCtrl);
+IMPORT STATUS       vxbPinMuxUnregister (VXB_PINMUX_CTRL * pCtrl);
+IMPORT STATUS       vxbPinMuxEnable (VXB_DEV_ID pDev);
+IMPORT STATUS       vxbPinMuxDisable (VXB_DEV_ID pDev);
+
+/* host build support */
+
+IMPORT STATUS       rzg2HostFdtLoad (const char * pPath);
+IMPORT VXB_DEV_ID   rzg2HostDevCreate (const char * pPath, VXB_DRV * pDriver);
+IMPORT STATUS       rzg2HostDevAttach (VXB_DEV_ID pDev);
+IMPORT STATUS       rzg2HostDevDetach (VXB_DEV_ID pDev);
+IMPORT void         rzg2HostDevDelete (VXB_DEV_ID pDev);
+
+#endif /* __INCvxHosth */
@@ -0,0 +1,104 @@
+/* tstRzg2.h - checks of the RZ/G2 driver host tests */
+
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1) Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2) Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3) Neither the name of Wind River Systems nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+modification history
+--------------------
+19oct26,agt  written
+*/
+
+#ifndef __INCtstRzg2h
+#define __INCtstRzg2h
+
+#include <vxWorks.h>
+#include <stdlib.h>
+
+#include "rzg2RegModel.h"
+
+/* defines */
+
+/* record a failed check, with the file and line of the check */
+
+#define TST_CHECK(cond)                                                 \
+    do                                                                  \
+        {                                                               \
+        tstChecks++;                                                    \
+        if (!(cond))                                                    \
+            {                                                           \
+            tstFailures++;                                              \
+            (void)printf ("    FAIL %s:%d: %s\n", __FILE__, __LINE__,   \
+                          #cond);                                       \
+            }                                                           \
+        } while (FALSE)
+
+/* check that the write log holds exactly the writes of <seq> to <pBlk> */
+
+#define TST_WRITES(pBlk, seq)                                           \
+    TST_CHECK (rzg2ModelLogExpect ((pBlk), (seq),                       \
+                                   (UINT32) NELEMENTS (seq) / 2U) == OK)
+
+/* check that nothing was written */
+
+#define TST_NO_WRITES()     TST_CHECK (rzg2ModelLogCount () == 0U)
+
+/* run one test routine */
+
+#define TST_RUN(test)                                                   \
+    do                                                                  \
+        {                                                               \
+        UINT32 failures = tstFailures;                                  \
+        test ();                                                        \
+        (void)printf ("%-40s %s\n", #test,                              \
+                      (tstFailures == failures) ? "ok" : "FAILED");     \
+        } while (FALSE)
+
+/* locals */
+
+LOCAL UINT32 tstChecks = 0U;
+LOCAL UINT32 tstFailures = 0U;
+
+/*******************************************************************************
+*
+* tstSummary - print the check summary
+*
+* RETURNS: the exit status of the test program, 0 if all checks passed.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL int tstSummary (void)
+    {
+    (void)printf ("%u checks, %u failed\n", tstChecks, tstFailures);
+
+    return (tstFailures == 0U) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+#endif /* __INCtstRzg2h */
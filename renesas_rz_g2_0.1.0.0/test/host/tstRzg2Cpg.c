@@ -0,0 +1,1130 @@
+/* tstRzg2Cpg.c - host tests of the RZ/G2 CPG register writes */
+
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1) Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2) Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3) Neither the name of Wind River Systems nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+modification history
+--------------------
+19oct26,agt  written
+*/
+
+/*
+DESCRIPTION
+This program builds the CPG driver against the register model and checks the
+register writes of the divider and module clock changes: the CPGWPR unlock of
+each write while write protection is enabled, the stop, program and restart
+order of a divider change, the writes merged per register and left out when a
+register already holds its value, the SDnH stop bit, the rpc and rpcd2 shared
+fields, and the Z clock FRQCRB.KICK sequence. The driver source is included, so
+that its local routines can be called.
+
+The driver is then attached to the CPG node of tstRzg2Cpg.dts, the HiHope
+RZ/G2M board device tree with a boot clock plan, lazy clocks and pre-enabled
+clocks, as compiled by the Makefile. The register writes of the attach, the
+clock rates, the lazy and pre-enabled clocks, and the restore of the context
+saved for system suspend are checked.
+
+With -b, it also times a divider change, an unchanged divider, a Z clock
+change and the attach to the test device tree, and prints the time and the
+register writes of each.
+*/
+
+/* includes */
+
+#include "tstRzg2.h"
+
+#include "../../src/vxbFdtRsRzg2CpgMssr.c"
+
+/* defines */
+
+#define TST_MHZ(mhz)        ((UINT64)(mhz) * 1000000ULL)
+#define TST_SD_PARENT       TST_MHZ (800)   /* sd0h at SRCFC 0 */
+#define TST_PLL1            TST_MHZ (3200)  /* pll1, the rpc parent */
+#define TST_PLL0            TST_MHZ (1600)  /* z parent */
+#define TST_KICK_READS      2U      /* FRQCRB reads until KICK clears */
+#define TST_KICK_STUCK      0xffffffffU
+#define TST_MSTP_BIT        (1U << 14)
+#define TST_BENCH_LOOPS     100000U
+#define TST_ATTACH_LOOPS    1000U       /* board attaches timed */
+
+/* CPG and RST of the test device tree, as the boot firmware leaves them */
+
+#define TST_CPG_DTB         "tstRzg2Cpg.dtb"
+#define TST_CPG_NODE        "/soc/clock-controller@e6150000"
+#define TST_CPG_ADDR        0xe6150000U
+#define TST_RST_ADDR        0xe6160000U
+#define TST_MODEMR          0U          /* MD14 and MD13 low */
+#define TST_EXTAL           16666666ULL /* EXTAL of those mode pins */
+#define TST_PLLECR          (PLLECR_PLLnST (0) | PLLECR_PLLnST (1) |      \
+                             PLLECR_PLLnST (2) | PLLECR_PLLnST (3) |      \
+                             PLLECR_PLLnST (4))
+#define TST_PLL0CR          (44U << PLLnCR_STC_SHIFT)   /* x90, 1.5 GHz */
+#define TST_PLL2CR          (35U << PLLnCR_STC_SHIFT)   /* x72, 1.2 GHz */
+#define TST_PLL4CR          (95U << PLLnCR_STC_SHIFT)   /* x192, 3.2 GHz */
+
+/* indexes of the clocks checked, as in the clock specifiers of the nodes */
+
+#define TST_CLK_EXTAL       0U
+#define TST_CLK_PLL1        3U
+#define TST_CLK_PLL1DIV4    8U
+#define TST_CLK_S3D4        36U
+#define TST_CLK_SD0         39U
+#define TST_CLK_HDMI        51U
+#define TST_CLK_MSO         52U
+#define TST_CLK_CANFD       53U
+#define TST_CLK_TMU0        67U
+
+/* locals */
+
+LOCAL RZG2_MODEL_BLOCK      tstCpgBlk;
+LOCAL RZG2_MODEL_BLOCK      tstRstBlk;
+LOCAL VXB_FDT_CPG_INSTANCE  tstCpg;
+LOCAL UINT32                tstKickReads;
+LOCAL UINT32                tstKickDelay;
+
+/*******************************************************************************
+*
+* tstCpgProt - get the write protection of a CPG register
+*
+* While CPGWPCR.WPE is set, all the CPG registers except CPGWPR and CPGWPCR
+* are unlocked through CPGWPR.
+*
+* RETURNS: TRUE if the register at <offset> is write protected.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL BOOL tstCpgProt
+    (
+    RZG2_MODEL_BLOCK *  pBlk,       /* register block */
+    UINT32              offset      /* register offset */
+    )
+    {
+    return ((pBlk->regs [CPGWPCR / 4U] & CPGWPCR_WPE) != 0U) &&
+           (offset != CPGWPCR);
+    }
+
+/*******************************************************************************
+*
+* tstCpgHook - model FRQCRB.KICK and the module stop status
+*
+* Setting FRQCRB.KICK starts a frequency change, which the CPG completes, and
+* clears KICK, after tstKickDelay reads of FRQCRB, or never if the delay is
+* TST_KICK_STUCK. A module clock started or stopped through SMSTPCRn shows the
+* new state in MSTPSRn at once.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgHook
+    (
+    RZG2_MODEL_BLOCK *  pBlk,       /* register block */
+    UINT32              offset,     /* register offset */
+    BOOL                write       /* TRUE for a write, FALSE for a read */
+    )
+    {
+    UINT32              i;
+
+    for (i = 0U; write && (i < CPG_MSTP_REGS); i++)
+        {
+        if (offset == mstpcrOffset [i])
+            {
+            pBlk->regs [mstpsrOffset [i] / 4U] = pBlk->regs [offset / 4U];
+            }
+        }
+
+    if (offset != FRQCRB)
+        {
+        return;
+        }
+
+    if (write)
+        {
+        tstKickReads = tstKickDelay;
+        return;
+        }
+
+    if ((tstKickReads != TST_KICK_STUCK) && (tstKickReads > 0U) &&
+        (--tstKickReads == 0U))
+        {
+        pBlk->regs [FRQCRB / 4U] &= ~FRQCRB_KICK;
+        }
+    }
+
+/*******************************************************************************
+*
+* tstCpgReg - get a CPG register of the model
+*
+* RETURNS: the value of the register at <offset>.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL UINT32 tstCpgReg
+    (
+    UINT32              offset      /* register offset */
+    )
+    {
+    return tstCpgBlk.regs [offset / 4U];
+    }
+
+/*******************************************************************************
+*
+* tstCpgSetup - set up the CPG instance and its registers
+*
+* This routine sets up the CPG instance over a cleared register block, with
+* write protection enabled if <protect> is TRUE, and clears the write log.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgSetup
+    (
+    BOOL                protect     /* TRUE to enable write protection */
+    )
+    {
+    rzg2ModelBlockInit (&tstCpgBlk, "CPG", CPGWPR, tstCpgProt);
+    tstCpgBlk.hook = tstCpgHook;
+    tstCpgBlk.regs [CPGWPCR / 4U] = protect ? CPGWPCR_WPE : 0U;
+    tstKickReads = 0U;
+    tstKickDelay = TST_KICK_READS;
+
+    (void)memset (&tstCpg, 0, sizeof (tstCpg));
+    tstCpg.regBase = rzg2ModelBaseGet (&tstCpgBlk);
+    tstCpg.semMutex = semMCreate (SEM_Q_PRIORITY);
+    pRzg2Cpg = &tstCpg;
+
+    rzg2ModelLogReset ();
+    }
+
+/*******************************************************************************
+*
+* tstCpgTeardown - check and release the CPG instance
+*
+* This routine checks that the CPG mutex is free and that no write protected
+* register was written without the CPGWPR unlock.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgTeardown (void)
+    {
+    TST_CHECK (tstCpg.semMutex->count == 0);
+    TST_CHECK (tstCpgBlk.violations == 0U);
+
+    (void)semDelete (tstCpg.semMutex);
+    pRzg2Cpg = NULL;
+    }
+
+/*******************************************************************************
+*
+* tstCpgClk - set up a divider clock
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgClk
+    (
+    VXB_CLK *           pClk,       /* clock to set up */
+    CPG_CLK_DATA *      pData,      /* its CPG clock context */
+    CPG_DIV_TYPE        type,       /* divider type */
+    UINT32              index,      /* divider index */
+    UINT32              refs        /* references to the clock */
+    )
+    {
+    (void)memset (pClk, 0, sizeof (VXB_CLK));
+    (void)memset (pData, 0, sizeof (CPG_CLK_DATA));
+
+    pData->variable.type = type;
+    pData->variable.index = index;
+
+    pClk->clkType = VXB_CLK_DIVIDER;
+    pClk->clkContext = pData;
+    pClk->clkRefs = refs;
+    }
+
+/*******************************************************************************
+*
+* tstCpgRateSet - set a divider clock rate
+*
+* This routine sets the rate of <pClk>, as rzg2CpgMssrClkRateSet() does.
+*
+* RETURNS: OK, or ERROR if the rate cannot be set.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS tstCpgRateSet
+    (
+    VXB_CLK *           pClk,       /* divider clock */
+    UINT64              parentRate, /* frequency of parent clock */
+    UINT64              rate        /* requested frequency */
+    )
+    {
+    CPG_DIV_SETTING     setting;
+
+    if (rzg2CpgDivSettingGet (pClk, parentRate, rate, &setting) == ERROR)
+        {
+        return ERROR;
+        }
+
+    return rzg2CpgDividersApply (&tstCpg, &setting, 1U);
+    }
+
+/*******************************************************************************
+*
+* tstCpgSdDivider - a running divider is stopped, programmed and restarted
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgSdDivider (void)
+    {
+    VXB_CLK             clk;
+    CPG_CLK_DATA        data;
+    const UINT32 seq [] =
+        {
+        CPGWPR,         ~SDnCKCR_STPnCK,
+        SD0CKCR,        SDnCKCR_STPnCK,
+        CPGWPR,         ~(SDnCKCR_STPnCK | 1U),
+        SD0CKCR,        SDnCKCR_STPnCK | 1U,
+        CPGWPR,         ~1U,
+        SD0CKCR,        1U
+        };
+
+    tstCpgSetup (TRUE);
+    tstCpgClk (&clk, &data, DIV_SD, 0U, 1U);
+
+    TST_CHECK (tstCpgRateSet (&clk, TST_SD_PARENT, TST_MHZ (200)) == OK);
+    TST_WRITES (&tstCpgBlk, seq);
+    TST_CHECK (rzg2CpgDividerRateGet (&tstCpg, &data, TST_SD_PARENT) ==
+               TST_MHZ (200));
+    TST_CHECK (tstCpg.regWrites == 3U);
+
+    /* the divider already has the rate */
+
+    rzg2ModelLogReset ();
+    TST_CHECK (tstCpgRateSet (&clk, TST_SD_PARENT, TST_MHZ (200)) == OK);
+    TST_NO_WRITES ();
+    TST_CHECK (tstCpg.regSkips == 1U);
+
+    tstCpgTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstCpgStopped - a stopped divider is only programmed
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgStopped (void)
+    {
+    VXB_CLK             clk;
+    CPG_CLK_DATA        data;
+    const UINT32 seq [] =
+        {
+        CPGWPR,         ~(SDnCKCR_STPnCK | 1U),
+        SD0CKCR,        SDnCKCR_STPnCK | 1U
+        };
+
+    tstCpgSetup (TRUE);
+    tstCpgBlk.regs [SD0CKCR / 4U] = SDnCKCR_STPnCK;
+    tstCpgClk (&clk, &data, DIV_SD, 0U, 0U);
+
+    TST_CHECK (tstCpgRateSet (&clk, TST_SD_PARENT, TST_MHZ (200)) == OK);
+    TST_WRITES (&tstCpgBlk, seq);
+
+    tstCpgTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstCpgMerge - settings of one register are written together
+*
+* The sd0h and sd0 dividers share SD0CKCR: changing both stops the register
+* once, programs both fields in one write, and restarts it once. sd0h is in
+* use, so SDnH, stopped by its earlier /4 setting, is restarted.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgMerge (void)
+    {
+    VXB_CLK             clkH;
+    VXB_CLK             clk;
+    CPG_CLK_DATA        dataH;
+    CPG_CLK_DATA        data;
+    CPG_DIV_SETTING     setting [2];
+    const UINT32        init = SDnCKCR_STPnHCK |
+                               (2U << SDnCKCR_SDnSRCFC_SHIFT) | 1U;
+    const UINT32 seq [] =
+        {
+        CPGWPR,         ~(init | SDnCKCR_STPnCK),
+        SD0CKCR,        init | SDnCKCR_STPnCK,
+        CPGWPR,         ~SDnCKCR_STPnCK,
+        SD0CKCR,        SDnCKCR_STPnCK,
+        CPGWPR,         ~0U,
+        SD0CKCR,        0U
+        };
+
+    tstCpgSetup (TRUE);
+    tstCpgBlk.regs [SD0CKCR / 4U] = init;
+    tstCpgClk (&clkH, &dataH, DIV_SDH, 0U, 1U);
+    tstCpgClk (&clk, &data, DIV_SD, 0U, 1U);
+
+    TST_CHECK (rzg2CpgDivSettingGet (&clkH, TST_SD_PARENT, TST_SD_PARENT,
+                                     &setting [0]) == OK);
+    TST_CHECK (rzg2CpgDivSettingGet (&clk, TST_SD_PARENT, TST_MHZ (400),
+                                     &setting [1]) == OK);
+    TST_CHECK (rzg2CpgDividersApply (&tstCpg, setting, 2U) == OK);
+
+    TST_WRITES (&tstCpgBlk, seq);
+
+    tstCpgTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstCpgSdhStop - SDnH is stopped at the rates that need it stopped
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgSdhStop (void)
+    {
+    VXB_CLK             clk;
+    CPG_CLK_DATA        data;
+    CPG_DIV_SETTING     setting;
+
+    tstCpgSetup (TRUE);
+
+    /* an unused sd0h can run at /4, with SDnH stopped */
+
+    tstCpgClk (&clk, &data, DIV_SDH, 0U, 0U);
+    TST_CHECK (tstCpgRateSet (&clk, TST_SD_PARENT, TST_MHZ (200)) == OK);
+    TST_CHECK ((tstCpgReg (SD0CKCR) & SDnCKCR_STPnHCK) != 0U);
+    TST_CHECK (SDnCKCR_SDnSRCFC (tstCpgReg (SD0CKCR)) == 2U);
+    TST_CHECK (rzg2CpgDividerRateGet (&tstCpg, &data, TST_SD_PARENT) ==
+               TST_MHZ (200));
+
+    /* an unused sd0h leaves SDnH as it is at /2 */
+
+    TST_CHECK (tstCpgRateSet (&clk, TST_SD_PARENT, TST_MHZ (400)) == OK);
+    TST_CHECK ((tstCpgReg (SD0CKCR) & SDnCKCR_STPnHCK) != 0U);
+
+    /* a sd0h in use cannot run at /4, and restarts SDnH at /2 */
+
+    clk.clkRefs = 1U;
+    TST_CHECK (rzg2CpgDivSettingGet (&clk, TST_SD_PARENT, TST_MHZ (200),
+                                     &setting) == ERROR);
+    rzg2ModelLogReset ();
+    TST_CHECK (tstCpgRateSet (&clk, TST_SD_PARENT, TST_MHZ (400)) == OK);
+    TST_CHECK ((tstCpgReg (SD0CKCR) & SDnCKCR_STPnHCK) == 0U);
+    TST_CHECK (rzg2ModelLogCount () == 6U);
+
+    tstCpgTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstCpgRpc - rpc and rpcd2 share their divider fields
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgRpc (void)
+    {
+    VXB_CLK             clkRpc;
+    VXB_CLK             clkRpcd2;
+    CPG_CLK_DATA        dataRpc;
+    CPG_CLK_DATA        dataRpcd2;
+    CPG_DIV_SETTING     setting;
+
+    tstCpgSetup (TRUE);
+    tstCpgBlk.regs [RPCCKCR / 4U] = (3U << RPCCKCR_RPC_DIV_SHIFT) | 7U;
+    tstCpgClk (&clkRpc, &dataRpc, DIV_RPCSRC, 0U, 1U);
+    tstCpgClk (&clkRpcd2, &dataRpcd2, DIV_RPCSRC, 1U, 1U);
+
+    TST_CHECK (rzg2CpgSiblingGet (CPG_RPC_CLK_INDEX) ==
+               (int) CPG_RPCD2_CLK_INDEX);
+    TST_CHECK (rzg2CpgSiblingGet (CPG_RPCD2_CLK_INDEX) ==
+               (int) CPG_RPC_CLK_INDEX);
+    TST_CHECK (rzg2CpgSiblingGet (CPG_RPC_CLK_INDEX - 1U) == -1);
+    TST_CHECK (rzg2CpgDividerRateGet (&tstCpg, &dataRpc, TST_PLL1) ==
+               TST_PLL1 / 48U);
+
+    /* rpc at 160 MHz divides pll1 by 5 and 4, and makes rpcd2 80 MHz */
+
+    TST_CHECK (rzg2CpgDivSettingGet (&clkRpc, TST_PLL1, TST_MHZ (160),
+                                     &setting) == OK);
+    TST_CHECK (setting.rate == TST_MHZ (160));
+    TST_CHECK (rzg2CpgDividersApply (&tstCpg, &setting, 1U) == OK);
+    TST_CHECK (rzg2ModelLogCount () == 6U);
+    TST_CHECK ((tstCpgReg (RPCCKCR) &
+                (RPCCKCR_CKSTP | RPCCKCR_CKSTP2)) == 0U);
+    TST_CHECK (rzg2CpgDividerRateGet (&tstCpg, &dataRpc, TST_PLL1) ==
+               TST_MHZ (160));
+    TST_CHECK (rzg2CpgDividerRateGet (&tstCpg, &dataRpcd2, TST_PLL1) ==
+               TST_MHZ (80));
+
+    /* rpcd2 at no more than 50 MHz divides pll1 by 6 and 6, and by 2 */
+
+    TST_CHECK (rzg2CpgDivSettingGet (&clkRpcd2, TST_PLL1, TST_MHZ (50),
+                                     &setting) == OK);
+    TST_CHECK (setting.rate == TST_PLL1 / 72U);
+    TST_CHECK (rzg2CpgDividersApply (&tstCpg, &setting, 1U) == OK);
+    TST_CHECK (rzg2CpgDividerRateGet (&tstCpg, &dataRpcd2, TST_PLL1) ==
+               TST_PLL1 / 72U);
+    TST_CHECK (rzg2CpgDividerRateGet (&tstCpg, &dataRpc, TST_PLL1) ==
+               TST_PLL1 / 36U);
+
+    tstCpgTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstCpgZClock - a Z clock change is staged in FRQCRC and kicked
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgZClock (void)
+    {
+    VXB_CLK             clk;
+    CPG_CLK_DATA        data;
+    const UINT32 seq [] =
+        {
+        CPGWPR,         ~(8U << FRQCRC_ZFC_SHIFT),
+        FRQCRC,         8U << FRQCRC_ZFC_SHIFT,
+        CPGWPR,         ~FRQCRB_KICK,
+        FRQCRB,         FRQCRB_KICK
+        };
+
+    tstCpgSetup (TRUE);
+    tstCpgClk (&clk, &data, DIV_SYSCPU, 1U, 1U);
+
+    TST_CHECK (tstCpgRateSet (&clk, TST_PLL0, TST_MHZ (1200)) == OK);
+    TST_WRITES (&tstCpgBlk, seq);
+    TST_CHECK ((tstCpgReg (FRQCRB) & FRQCRB_KICK) == 0U);
+    TST_CHECK (rzg2CpgDividerRateGet (&tstCpg, &data, TST_PLL0) ==
+               TST_MHZ (1200));
+    TST_CHECK (tstCpg.dvfsCount == 1U);
+
+    /* unchanged, nothing is kicked */
+
+    rzg2ModelLogReset ();
+    TST_CHECK (tstCpgRateSet (&clk, TST_PLL0, TST_MHZ (1200)) == OK);
+    TST_NO_WRITES ();
+    TST_CHECK (tstCpg.dvfsCount == 1U);
+
+    /* a change the CPG never completes times out */
+
+    tstKickDelay = TST_KICK_STUCK;
+    TST_CHECK (tstCpgRateSet (&clk, TST_PLL0, TST_MHZ (800)) == ERROR);
+    TST_CHECK (tstCpg.dvfsTimeouts == 1U);
+
+    /* and no further change is staged while KICK is set */
+
+    rzg2ModelLogReset ();
+    TST_CHECK (tstCpgRateSet (&clk, TST_PLL0, TST_MHZ (1600)) == ERROR);
+    TST_NO_WRITES ();
+    TST_CHECK (tstCpg.dvfsTimeouts == 2U);
+
+    tstCpgTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstCpgGates - module clock gates are only written when they change
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgGates (void)
+    {
+    const UINT32 seq [] =
+        {
+        CPGWPR,         TST_MSTP_BIT,
+        SMSTPCR3,       ~TST_MSTP_BIT,
+        CPGWPR,         0U,
+        SMSTPCR3,       0xffffffffU
+        };
+
+    tstCpgSetup (TRUE);
+    tstCpgBlk.regs [SMSTPCR3 / 4U] = 0xffffffffU;
+
+    rzg2CpgClrBit32 (&tstCpg, SMSTPCR3, TST_MSTP_BIT);
+    rzg2CpgClrBit32 (&tstCpg, SMSTPCR3, TST_MSTP_BIT);
+    rzg2CpgSetBit32 (&tstCpg, SMSTPCR3, TST_MSTP_BIT);
+    rzg2CpgSetBit32 (&tstCpg, SMSTPCR3, TST_MSTP_BIT);
+
+    TST_WRITES (&tstCpgBlk, seq);
+    TST_CHECK (tstCpg.regSkips == 2U);
+
+    tstCpgTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstCpgNoProtect - without write protection nothing is unlocked
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgNoProtect (void)
+    {
+    VXB_CLK             clk;
+    CPG_CLK_DATA        data;
+    const UINT32 seq [] =
+        {
+        SD0CKCR,        SDnCKCR_STPnCK,
+        SD0CKCR,        SDnCKCR_STPnCK | 1U,
+        SD0CKCR,        1U
+        };
+
+    tstCpgSetup (FALSE);
+    tstCpgClk (&clk, &data, DIV_SD, 0U, 1U);
+
+    TST_CHECK (tstCpgRateSet (&clk, TST_SD_PARENT, TST_MHZ (200)) == OK);
+    TST_WRITES (&tstCpgBlk, seq);
+    TST_CHECK (tstCpgBlk.unlocks == 0U);
+
+    tstCpgTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstCpgBatchMax - a batch larger than the maximum is refused
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgBatchMax (void)
+    {
+    CPG_DIV_SETTING     setting [CPG_DIV_BATCH_MAX + 1U];
+
+    tstCpgSetup (TRUE);
+    (void)memset (setting, 0, sizeof (setting));
+
+    TST_CHECK (rzg2CpgDividersApply (&tstCpg, setting,
+                                     CPG_DIV_BATCH_MAX + 1U) == ERROR);
+    TST_NO_WRITES ();
+
+    tstCpgTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstCpgBoardAttach - attach the driver to the CPG node of the board
+*
+* This routine maps a CPG register block at the CPG address of the test device
+* tree, as the boot firmware leaves it with write protection enabled, the
+* PLLs running and every module clock stopped, and an RST block giving the
+* mode pins. It then attaches the driver to the CPG node.
+*
+* RETURNS: the CPG device, or NULL if the attach fails.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL VXB_DEV_ID tstCpgBoardAttach (void)
+    {
+    VXB_DEV_ID          pDev;
+    UINT32              i;
+
+    rzg2ModelBlockInit (&tstCpgBlk, "CPG", CPGWPR, tstCpgProt);
+    rzg2ModelBlockMap (&tstCpgBlk, TST_CPG_ADDR);
+    tstCpgBlk.hook = tstCpgHook;
+    tstCpgBlk.regs [CPGWPCR / 4U] = CPGWPCR_WPE;
+    tstCpgBlk.regs [PLLECR / 4U] = TST_PLLECR;
+    tstCpgBlk.regs [PLL0CR / 4U] = TST_PLL0CR;
+    tstCpgBlk.regs [PLL2CR / 4U] = TST_PLL2CR;
+    tstCpgBlk.regs [PLL4CR / 4U] = TST_PLL4CR;
+
+    for (i = 0U; i < CPG_MSTP_REGS; i++)
+        {
+        tstCpgBlk.regs [mstpcrOffset [i] / 4U] = 0xffffffffU;
+        tstCpgBlk.regs [mstpsrOffset [i] / 4U] = 0xffffffffU;
+        }
+
+    rzg2ModelBlockInit (&tstRstBlk, "RST", 0U, NULL);
+    rzg2ModelBlockMap (&tstRstBlk, TST_RST_ADDR);
+    tstRstBlk.regs [MODEMR / 4U] = TST_MODEMR;
+
+    tstKickReads = 0U;
+    tstKickDelay = TST_KICK_READS;
+    rzg2ModelLogReset ();
+
+    pDev = rzg2HostDevCreate (TST_CPG_NODE, &vxbFdtRsRzg2CpgMssrDrv);
+    if ((pDev != NULL) && (rzg2HostDevAttach (pDev) == ERROR))
+        {
+        rzg2HostDevDelete (pDev);
+        pDev = NULL;
+        }
+
+    return pDev;
+    }
+
+/*******************************************************************************
+*
+* tstCpgBoardRelease - release the CPG instance attached to the board
+*
+* The driver has no detach method, so this routine frees what the attach
+* allocated, after checking that the CPG mutex is free and that no write
+* protected register was written without the CPGWPR unlock.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgBoardRelease
+    (
+    VXB_DEV_ID          pDev        /* CPG device */
+    )
+    {
+    VXB_FDT_CPG_INSTANCE * pCpg;
+
+    pCpg = (VXB_FDT_CPG_INSTANCE *) vxbDevSoftcGet (pDev);
+
+    TST_CHECK (pCpg->semMutex->count == 0);
+    TST_CHECK (tstCpgBlk.violations == 0U);
+
+    vxbMemFree (pCpg->pClkReady);
+    vxbMemFree (pCpg->pMssrClkData);
+    vxbMemFree (pCpg->pCpgClkData);
+    vxbMemFree (pCpg->pClkPool);
+    vxbMemFree (pCpg->pCpgClkList);
+    (void)vxbResourceFree (pDev, pCpg->memRes);
+    (void)semDelete (pCpg->semMutex);
+    vxbMemFree (pCpg);
+
+    pRzg2Cpg = NULL;
+    rzg2HostDevDelete (pDev);
+    }
+
+/*******************************************************************************
+*
+* tstCpgBoardPlan - the attach applies the clock plan and pre-enables clocks
+*
+* The test device tree assigns sd0, mso and canfd rates in the CPG node, and
+* sd0 again in the SDHI0 node, whose rate wins. The three dividers are
+* stopped, programmed and restarted in one pass each. The module clocks of the
+* enabled nodes are then started with one write per SMSTPCR register. The rates
+* follow from the EXTAL frequency of the mode pins and the PLL multipliers.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgBoardPlan (void)
+    {
+    VXB_FDT_CPG_INSTANCE * pCpg;
+    VXB_DEV_ID          pDev;
+    VXB_CLK *           pPool;
+    const UINT32 seq [] =
+        {
+        /* stop the running outputs */
+
+        CPGWPR,         ~SDnCKCR_STPnCK,
+        SD0CKCR,        SDnCKCR_STPnCK,
+        CPGWPR,         ~CKCR_CKSTP,
+        MSOCKCR,        CKCR_CKSTP,
+        CPGWPR,         ~CKCR_CKSTP,
+        CANFDCKCR,      CKCR_CKSTP,
+
+        /* sd0 800 MHz / 4, mso 800 MHz / 12, canfd 800 MHz / 20 */
+
+        CPGWPR,         ~(SDnCKCR_STPnCK | 1U),
+        SD0CKCR,        SDnCKCR_STPnCK | 1U,
+        CPGWPR,         ~(CKCR_CKSTP | 11U),
+        MSOCKCR,        CKCR_CKSTP | 11U,
+        CPGWPR,         ~(CKCR_CKSTP | 19U),
+        CANFDCKCR,      CKCR_CKSTP | 19U,
+
+        /* restart them */
+
+        CPGWPR,         ~1U,
+        SD0CKCR,        1U,
+        CPGWPR,         ~11U,
+        MSOCKCR,        11U,
+        CPGWPR,         ~19U,
+        CANFDCKCR,      19U,
+
+        /* the module clocks of the enabled nodes, one write per register */
+
+        CPGWPR,         0x03c00000U,
+        SMSTPCR1,       0xfc3fffffU,
+        CPGWPR,         0x100c4800U,
+        SMSTPCR3,       0xeff3b7ffU,
+        CPGWPR,         0x00000004U,
+        SMSTPCR4,       0xfffffffbU,
+        CPGWPR,         0x00000004U,
+        SMSTPCR7,       0xfffffffbU,
+        CPGWPR,         0x00001000U,
+        SMSTPCR8,       0xffffefffU,
+        CPGWPR,         0x88000040U,
+        SMSTPCR9,       0x77ffffbfU
+        };
+
+    pDev = tstCpgBoardAttach ();
+    TST_CHECK (pDev != NULL);
+    if (pDev == NULL)
+        {
+        return;
+        }
+
+    pCpg = (VXB_FDT_CPG_INSTANCE *) vxbDevSoftcGet (pDev);
+    pPool = pCpg->pClkPool;
+
+    TST_WRITES (&tstCpgBlk, seq);
+    TST_CHECK (pRzg2Cpg == pCpg);
+    TST_CHECK (pCpg->lazyInit && pCpg->preEnable);
+    TST_CHECK (pCpg->planClocks == 3U);
+    TST_CHECK (pCpg->preEnableGates == 15U);
+
+    TST_CHECK (pPool [TST_CLK_EXTAL].clkRate == TST_EXTAL);
+    TST_CHECK (pPool [TST_CLK_PLL1].clkRate == TST_EXTAL * 192U);
+    TST_CHECK (pPool [TST_CLK_S3D4].clkRate == TST_EXTAL * 192U / 48U);
+    TST_CHECK (pPool [TST_CLK_SD0].clkRate == TST_EXTAL * 192U / 16U);
+    TST_CHECK (pPool [TST_CLK_MSO].clkRate == TST_EXTAL * 192U / 4U / 12U);
+    TST_CHECK (pPool [TST_CLK_CANFD].clkRate == TST_EXTAL * 192U / 4U / 20U);
+
+    /* the pre-enabled clocks run with no reference */
+
+    TST_CHECK (pPool [TST_CLK_TMU0].clkStatus == CLOCK_STATUS_ENABLED);
+    TST_CHECK (pPool [TST_CLK_TMU0].clkRefs == 0U);
+
+    tstCpgBoardRelease (pDev);
+    }
+
+/*******************************************************************************
+*
+* tstCpgBoardClocks - lazy and pre-enabled clocks after the attach
+*
+* A clock referenced by no enabled node is only initialised when it is first
+* used. The first enable of a pre-enabled module clock writes nothing, and its
+* matching disable stops it.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgBoardClocks (void)
+    {
+    VXB_FDT_CPG_INSTANCE * pCpg;
+    VXB_DEV_ID          pDev;
+    VXB_CLK *           pClk;
+    UINT32              initCount;
+    const UINT32 seq [] =
+        {
+        CPGWPR,         ~0xfe3fffffU,
+        SMSTPCR1,       0xfe3fffffU
+        };
+
+    pDev = tstCpgBoardAttach ();
+    TST_CHECK (pDev != NULL);
+    if (pDev == NULL)
+        {
+        return;
+        }
+
+    pCpg = (VXB_FDT_CPG_INSTANCE *) vxbDevSoftcGet (pDev);
+
+    /* hdmi, and its parent pll1div4, are referenced by no node */
+
+    pClk = &pCpg->pClkPool [TST_CLK_HDMI];
+    initCount = pCpg->clkInitCount;
+    TST_CHECK (initCount < RZG2_CPG_TOTAL_CLOCKS + RZG2_MSSR_TOTAL_CLOCKS);
+    TST_CHECK (pCpg->pClkReady [TST_CLK_HDMI] == 0U);
+    TST_CHECK (pCpg->pClkReady [TST_CLK_PLL1DIV4] == 0U);
+    TST_CHECK (pCpg->pClkReady [TST_CLK_SD0] != 0U);
+
+    TST_CHECK (pClk->clkFuncs->clkEnable (pClk) == OK);
+    TST_CHECK (pCpg->pClkReady [TST_CLK_HDMI] != 0U);
+    TST_CHECK (pCpg->pClkReady [TST_CLK_PLL1DIV4] != 0U);
+    TST_CHECK (pCpg->clkInitCount == initCount + 2U);
+
+    /* TMU0 was started at attach */
+
+    pClk = &pCpg->pClkPool [TST_CLK_TMU0];
+    rzg2ModelLogReset ();
+
+    TST_CHECK (pClk->clkFuncs->clkEnable (pClk) == OK);
+    TST_NO_WRITES ();
+
+    TST_CHECK (pClk->clkFuncs->clkDisable (pClk) == OK);
+    TST_WRITES (&tstCpgBlk, seq);
+
+    tstCpgBoardRelease (pDev);
+    }
+
+/*******************************************************************************
+*
+* tstCpgBoardResume - the context saved at suspend is restored on resume
+*
+* The registers are returned to their boot state, as after a suspend that
+* powered the CPG down, and the restore returns them to the values saved.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgBoardResume (void)
+    {
+    VXB_FDT_CPG_INSTANCE * pCpg;
+    VXB_DEV_ID          pDev;
+    UINT32              mstpcr [CPG_MSTP_REGS];
+    UINT32              i;
+
+    pDev = tstCpgBoardAttach ();
+    TST_CHECK (pDev != NULL);
+    if (pDev == NULL)
+        {
+        return;
+        }
+
+    pCpg = (VXB_FDT_CPG_INSTANCE *) vxbDevSoftcGet (pDev);
+
+    TST_CHECK (rzg2CpgCtxSave (pCpg) == OK);
+
+    for (i = 0U; i < CPG_MSTP_REGS; i++)
+        {
+        mstpcr [i] = tstCpgReg (mstpcrOffset [i]);
+        tstCpgBlk.regs [mstpcrOffset [i] / 4U] = 0xffffffffU;
+        tstCpgBlk.regs [mstpsrOffset [i] / 4U] = 0xffffffffU;
+        }
+
+    tstCpgBlk.regs [SD0CKCR / 4U] = 0U;
+    tstCpgBlk.regs [MSOCKCR / 4U] = 0U;
+    tstCpgBlk.regs [CANFDCKCR / 4U] = 0U;
+    rzg2ModelLogReset ();
+
+    TST_CHECK (rzg2CpgCtxRestore (pCpg) == OK);
+
+    TST_CHECK (tstCpgReg (SD0CKCR) == 1U);
+    TST_CHECK (tstCpgReg (MSOCKCR) == 11U);
+    TST_CHECK (tstCpgReg (CANFDCKCR) == 19U);
+
+    for (i = 0U; i < CPG_MSTP_REGS; i++)
+        {
+        TST_CHECK (tstCpgReg (mstpcrOffset [i]) == mstpcr [i]);
+        }
+
+    tstCpgBoardRelease (pDev);
+    }
+
+/*******************************************************************************
+*
+* tstCpgBenchShow - print the cost of one benchmark operation
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgBenchShow
+    (
+    const char *        pName,      /* operation name */
+    UINT64              ticks,      /* duration of all the loops */
+    UINT32              loops,      /* number of operations */
+    const RZG2_MODEL_BLOCK * pPrev  /* block counts before the loops */
+    )
+    {
+    (void)printf ("%-22s %6llu ns, %2u writes, %2u unlocks, %2u reads\n", pName,
+                  ticks / loops, (tstCpgBlk.writes - pPrev->writes) / loops,
+                  (tstCpgBlk.unlocks - pPrev->unlocks) / loops,
+                  (tstCpgBlk.reads - pPrev->reads) / loops);
+    }
+
+/*******************************************************************************
+*
+* tstCpgBench - time the CPG divider changes
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstCpgBench
+    (
+    UINT32              loops       /* changes of each kind */
+    )
+    {
+    RZG2_MODEL_BLOCK    prev;
+    VXB_CLK             clk;
+    CPG_CLK_DATA        data;
+    VXB_DEV_ID          pDev;
+    UINT64              start;
+    UINT64              ticks;
+    UINT32              writes;
+    UINT32              reads;
+    UINT32              i;
+
+    tstCpgSetup (TRUE);
+    rzg2ModelLogEnable (FALSE);
+
+    /* switch sd0 between 200 and 400 MHz */
+
+    tstCpgClk (&clk, &data, DIV_SD, 0U, 1U);
+    prev = tstCpgBlk;
+    start = rzg2TimestampGet ();
+    for (i = 0U; i < loops; i++)
+        {
+        (void)tstCpgRateSet (&clk, TST_SD_PARENT,
+                             ((i & 1U) == 0U) ? TST_MHZ (200) : TST_MHZ (400));
+        }
+    tstCpgBenchShow ("CPG divider change:", rzg2TimestampGet () - start, loops,
+                     &prev);
+
+    /* set sd0 to the rate it has */
+
+    prev = tstCpgBlk;
+    start = rzg2TimestampGet ();
+    for (i = 0U; i < loops; i++)
+        {
+        (void)tstCpgRateSet (&clk, TST_SD_PARENT, TST_MHZ (200));
+        }
+    tstCpgBenchShow ("CPG unchanged divider:", rzg2TimestampGet () - start,
+                     loops, &prev);
+
+    /* switch z between 1200 and 1600 MHz */
+
+    tstCpgClk (&clk, &data, DIV_SYSCPU, 1U, 1U);
+    prev = tstCpgBlk;
+    start = rzg2TimestampGet ();
+    for (i = 0U; i < loops; i++)
+        {
+        (void)tstCpgRateSet (&clk, TST_PLL0,
+                             ((i & 1U) == 0U) ? TST_MHZ (1200) : TST_PLL0);
+        }
+    tstCpgBenchShow ("CPG Z clock change:", rzg2TimestampGet () - start, loops,
+                     &prev);
+
+    rzg2ModelLogEnable (TRUE);
+    tstCpgTeardown ();
+
+    /* attach to the test device tree, with its clock plan */
+
+    ticks = 0U;
+    writes = 0U;
+    reads = 0U;
+    for (i = 0U; i < TST_ATTACH_LOOPS; i++)
+        {
+        start = rzg2TimestampGet ();
+        pDev = tstCpgBoardAttach ();
+        ticks += rzg2TimestampGet () - start;
+
+        if (pDev == NULL)
+            {
+            break;
+            }
+
+        writes += tstCpgBlk.writes;
+        reads += tstCpgBlk.reads;
+        tstCpgBoardRelease (pDev);
+        }
+
+    (void)printf ("%-22s %6llu ns, %2u writes, %2u reads\n", "CPG board attach:",
+                  ticks / TST_ATTACH_LOOPS, writes / TST_ATTACH_LOOPS,
+                  reads / TST_ATTACH_LOOPS);
+    }
+
+/*******************************************************************************
+*
+* main - run the CPG host tests
+*
+* RETURNS: 0 if all checks pass, 1 otherwise.
+*
+* ERRNO: N/A.
+*/
+
+int main
+    (
+    int                 argc,
+    char **             argv
+    )
+    {
+    TST_RUN (tstCpgSdDivider);
+    TST_RUN (tstCpgStopped);
+    TST_RUN (tstCpgMerge);
+    TST_RUN (tstCpgSdhStop);
+    TST_RUN (tstCpgRpc);
+    TST_RUN (tstCpgZClock);
+    TST_RUN (tstCpgGates);
+    TST_RUN (tstCpgNoProtect);
+    TST_RUN (tstCpgBatchMax);
+
+    if (rzg2HostFdtLoad (TST_CPG_DTB) == ERROR)
+        {
+        return EXIT_FAILURE;
+        }
+
+    TST_RUN (tstCpgBoardPlan);
+    TST_RUN (tstCpgBoardClocks);
+    TST_RUN (tstCpgBoardResume);
+
+    if ((argc > 1) && (strcmp (argv [1], "-b") == 0))
+        {
+        tstCpgBench ((argc > 2) ? (UINT32) atoi (argv [2]) : TST_BENCH_LOOPS);
+        }
+
+    return tstSummary ();
+    }
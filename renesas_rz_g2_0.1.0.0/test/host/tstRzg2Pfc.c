@@ -0,0 +1,1307 @@
+/* tstRzg2Pfc.c - host tests of the RZ/G2 PFC register writes */
+
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1) Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2) Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3) Neither the name of Wind River Systems nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+modification history
+--------------------
+19oct26,agt  written
+*/
+
+/*
+DESCRIPTION
+This program builds the PFC driver against the register model and checks the
+register writes of the PFC transactions: the PMMR unlock of each protected
+write, the order of the GPIO pass, the selections and the final GPSR values,
+the writes left out when a register already holds its value, the POC supply
+hook, and the boot program. The driver source is included, so that its local
+routines can be called.
+
+The driver is then attached to the PFC node of the HiHope RZ/G2M board device
+tree, as compiled by the Makefile, which compiles every configuration node of
+the board without writing a register. The default pin mux states of the
+serial, I2C, SD and Ethernet nodes are enabled and disabled, and their register
+writes checked against the sequences expected from the pin tables. The board
+is then attached again with the boot program rzg2PfcBootGen generated from the
+device tree, after which the default states write nothing.
+
+The pin name index of the driver is checked against a linear search of the
+pin table, for every pin of the table and of the board configuration nodes.
+
+With -b, it also times a pin function switch, an unchanged transaction and
+the attach to the board device tree, and prints the time and the register
+writes of each. It then times the lookup of the board pin names through the
+index and through a linear search of the pin table.
+*/
+
+/* includes */
+
+#include "tstRzg2.h"
+
+#include "../../src/vxbFdtRsRzg2PfcPinMux.c"
+
+/* boot program generated by rzg2PfcBootGen from the board device tree */
+
+#include "rzg2PfcBootProg.c"
+
+/* defines */
+
+#define TST_NODE_A          100         /* configuration node of program A */
+#define TST_NODE_B          200         /* configuration node of program B */
+#define TST_PIN             (1U << 5)   /* GPSR1 bit 5 */
+#define TST_IPSR_MASK       0x0000000fU /* IPSR2 field of the pin */
+#define TST_FUNC_A          0x1U        /* function of program A */
+#define TST_FUNC_B          0x3U        /* function of program B */
+#define TST_BENCH_LOOPS     100000U
+#define TST_ATTACH_LOOPS    1000U       /* board attaches timed */
+#define TST_LOOKUP_LOOPS    1000U       /* passes over the board pin names */
+#define TST_BOARD_PINS_MAX  512U        /* pin names of the board nodes */
+
+/* HiHope RZ/G2M board device tree */
+
+#define TST_BOARD_DTB       "r8a774a1-hihope-rzg2m.dtb"
+#define TST_PFC_NODE        "/soc/pin-controller@e6060000"
+#define TST_PFC_ADDR        0xe6060000U
+#define TST_SCIF2_NODE      "/soc/serial@e6e88000"
+#define TST_I2C0_NODE       "/soc/i2c@e6500000"
+#define TST_SDHI0_NODE      "/soc/sd@ee100000"
+#define TST_AVB_NODE        "/soc/ethernet@e6800000"
+
+/* locals */
+
+LOCAL RZG2_MODEL_BLOCK      tstPfcBlk;
+LOCAL PFC_PINMUX_DRVCTRL    tstPfc;
+
+/* pin names of the "pins" properties of the board configuration nodes */
+
+LOCAL char *                tstBoardPins [TST_BOARD_PINS_MAX];
+LOCAL UINT32                tstBoardPinsNum;
+
+/* program A selects function A of the pin, program B function B */
+
+LOCAL PFC_PIN_STEP          tstStepsA [] =
+    {
+    { PFC_GPSR (1), TST_PIN, TST_PIN, TST_PIN, 0U },
+    { PFC_IPSR (2), TST_IPSR_MASK, TST_FUNC_A, 0U, 0U }
+    };
+
+LOCAL PFC_PIN_STEP          tstStepsB [] =
+    {
+    { PFC_GPSR (1), TST_PIN, TST_PIN, TST_PIN, 0U },
+    { PFC_IPSR (2), TST_IPSR_MASK, TST_FUNC_B, 0U, 0U }
+    };
+
+LOCAL PFC_PIN_PROG          tstProgA =
+    {
+    TST_NODE_A, NELEMENTS (tstStepsA), FALSE, FALSE, tstStepsA
+    };
+
+LOCAL PFC_PIN_PROG          tstProgB =
+    {
+    TST_NODE_B, NELEMENTS (tstStepsB), FALSE, FALSE, tstStepsB
+    };
+
+/* POC supply hook calls */
+
+LOCAL UINT32                tstHookCalls;
+LOCAL UINT32                tstHookPocSel;
+LOCAL UINT32                tstHookMv;
+LOCAL UINT32                tstHookLogCount;
+LOCAL STATUS                tstHookStatus;
+
+/*******************************************************************************
+*
+* tstPfcProt - get the write protection of a PFC register
+*
+* All the PFC registers except PUENn and PUDn are unlocked through PMMR.
+*
+* RETURNS: TRUE if the register at <offset> is write protected.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL BOOL tstPfcProt
+    (
+    RZG2_MODEL_BLOCK *  pBlk,       /* register block */
+    UINT32              offset      /* register offset */
+    )
+    {
+    (void)pBlk;
+
+    return (offset < PFC_PUEN (0)) || (offset > PFC_PUD (NUM_PUD_REGS - 1));
+    }
+
+/*******************************************************************************
+*
+* tstPfcReg - get a PFC register of the model
+*
+* RETURNS: the value of the register at <offset>.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL UINT32 tstPfcReg
+    (
+    UINT32              offset      /* register offset */
+    )
+    {
+    return tstPfcBlk.regs [offset / 4U];
+    }
+
+/*******************************************************************************
+*
+* tstPfcSetup - set up the PFC instance and its registers
+*
+* This routine sets up the PFC instance over a cleared register block, with the
+* pin of the test programs in function <func>, or in GPIO mode if <gpio> is
+* TRUE, and clears the write log.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcSetup
+    (
+    UINT32              func,       /* IPSR2 field of the pin */
+    BOOL                gpio        /* TRUE if the pin is in GPIO mode */
+    )
+    {
+    rzg2ModelBlockInit (&tstPfcBlk, "PFC", PFC_PMMR, tstPfcProt);
+
+    (void)memset (&tstPfc, 0, sizeof (tstPfc));
+    tstPfc.regBase = rzg2ModelBaseGet (&tstPfcBlk);
+    tstPfc.mutex = semMCreate (SEM_Q_PRIORITY);
+    SPIN_LOCK_ISR_INIT (&tstPfc.regLock, 0);
+    pRzg2Pfc = &tstPfc;
+
+    tstProgA.savedValid = FALSE;
+    tstProgB.savedValid = FALSE;
+
+    rzg2PfcPocHookSet (NULL, NULL);
+    rzg2PfcBootProgSet (NULL, 0U);
+
+    tstPfcBlk.regs [PFC_IPSR (2) / 4U] = func;
+    tstPfcBlk.regs [PFC_GPSR (1) / 4U] = gpio ? 0U : TST_PIN;
+
+    rzg2ModelLogReset ();
+    }
+
+/*******************************************************************************
+*
+* tstPfcTeardown - check and release the PFC instance
+*
+* This routine checks that the PFC mutex is free, the transaction is closed
+* and no write protected register was written without the PMMR unlock.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcTeardown (void)
+    {
+    UINT32              word;
+
+    TST_CHECK (tstPfc.mutex->count == 0);
+    TST_CHECK (!tstPfc.xactActive);
+    TST_CHECK (tstPfcBlk.violations == 0U);
+
+    for (word = 0U; word < PFC_REG_WORDS; word++)
+        {
+        if ((tstPfc.xactValid [word] != 0U) || (tstPfc.xactMask [word] != 0U))
+            {
+            break;
+            }
+        }
+
+    TST_CHECK (word == PFC_REG_WORDS);
+
+    (void)semDelete (tstPfc.mutex);
+    pRzg2Pfc = NULL;
+    }
+
+/*******************************************************************************
+*
+* tstPfcProgApply - apply a pin program in one transaction
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcProgApply
+    (
+    PFC_PIN_PROG *      pProg,      /* pin program */
+    BOOL                restore     /* TRUE to restore the saved values */
+    )
+    {
+    rzg2PfcXactBegin (&tstPfc);
+    rzg2PfcProgApply (&tstPfc, pProg, restore);
+    rzg2PfcXactEnd (&tstPfc, TRUE);
+    }
+
+/*******************************************************************************
+*
+* tstPfcPocHook - POC supply hook of the tests
+*
+* This hook records its arguments and the writes logged before the call.
+*
+* RETURNS: the status set by the test.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS tstPfcPocHook
+    (
+    UINT32              pocSel,     /* POC_SD0 or POC_SD3 */
+    UINT32              mv,         /* signalling voltage in mv */
+    void *              pArg        /* hook argument */
+    )
+    {
+    (void)pArg;
+
+    tstHookCalls++;
+    tstHookPocSel = pocSel;
+    tstHookMv = mv;
+    tstHookLogCount = rzg2ModelLogCount ();
+
+    return tstHookStatus;
+    }
+
+/*******************************************************************************
+*
+* tstPfcFuncSwitch - a pin changing function passes through GPIO mode
+*
+* The pin is switched to GPIO, the new function is selected, and the pin is
+* switched back to the peripheral, each write unlocked through PMMR.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcFuncSwitch (void)
+    {
+    const UINT32 seq [] =
+        {
+        PFC_PMMR,       ~0U,
+        PFC_GPSR (1),   0U,
+        PFC_PMMR,       ~TST_FUNC_B,
+        PFC_IPSR (2),   TST_FUNC_B,
+        PFC_PMMR,       ~TST_PIN,
+        PFC_GPSR (1),   TST_PIN
+        };
+
+    tstPfcSetup (TST_FUNC_A, FALSE);
+
+    tstPfcProgApply (&tstProgB, FALSE);
+
+    TST_WRITES (&tstPfcBlk, seq);
+    TST_CHECK (tstPfcReg (PFC_IPSR (2)) == TST_FUNC_B);
+    TST_CHECK (tstPfcReg (PFC_GPSR (1)) == TST_PIN);
+    TST_CHECK (tstStepsB [1].saved == TST_FUNC_A);
+    TST_CHECK (tstPfc.pinClaimed [1] == TST_PIN);
+    TST_CHECK (tstPfc.pinOwner [32U + 5U] == TST_NODE_B);
+
+    tstPfcTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstPfcNoChange - a program already in effect writes nothing
+*
+* This is the case of the pins set up by the boot firmware, such as the
+* console, which must not glitch through GPIO mode.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcNoChange (void)
+    {
+    tstPfcSetup (TST_FUNC_B, FALSE);
+
+    tstPfcProgApply (&tstProgB, FALSE);
+
+    TST_NO_WRITES ();
+    TST_CHECK (tstPfc.regWrites == 0U);
+    TST_CHECK (tstPfc.regSkips == 2U);
+
+    tstPfcTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstPfcGpsrOnly - no GPIO pass if the function selection does not change
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcGpsrOnly (void)
+    {
+    const UINT32 seq [] =
+        {
+        PFC_PMMR,       ~TST_PIN,
+        PFC_GPSR (1),   TST_PIN
+        };
+
+    tstPfcSetup (TST_FUNC_B, TRUE);
+
+    tstPfcProgApply (&tstProgB, FALSE);
+
+    TST_WRITES (&tstPfcBlk, seq);
+
+    tstPfcTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstPfcRestore - disabling a program restores the replaced values
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcRestore (void)
+    {
+    const UINT32 seq [] =
+        {
+        PFC_PMMR,       ~0U,
+        PFC_GPSR (1),   0U
+        };
+
+    tstPfcSetup (TST_FUNC_A, TRUE);
+
+    tstPfcProgApply (&tstProgB, FALSE);
+    rzg2ModelLogReset ();
+
+    tstPfcProgApply (&tstProgB, TRUE);
+
+    /* the pin passes through GPIO, which is also its restored state */
+
+    TST_CHECK (rzg2ModelLogCount () == 4U);
+    TST_CHECK (tstPfcReg (PFC_IPSR (2)) == TST_FUNC_A);
+    TST_CHECK (tstPfcReg (PFC_GPSR (1)) == 0U);
+    TST_CHECK (tstPfc.pinClaimed [1] == 0U);
+
+    /* restoring again changes nothing but the GPSR pin, already in GPIO */
+
+    rzg2ModelLogReset ();
+    tstPfcBlk.regs [PFC_GPSR (1) / 4U] = TST_PIN;
+    tstPfcProgApply (&tstProgB, TRUE);
+    TST_WRITES (&tstPfcBlk, seq);
+
+    tstPfcTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstPfcDiscard - a transaction that is not committed writes nothing
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcDiscard (void)
+    {
+    tstPfcSetup (TST_FUNC_A, FALSE);
+
+    rzg2PfcXactBegin (&tstPfc);
+    rzg2PfcProgApply (&tstPfc, &tstProgB, FALSE);
+    TST_CHECK (rzg2PfcXactRegGet (&tstPfc, PFC_IPSR (2)) == TST_FUNC_B);
+    rzg2PfcXactEnd (&tstPfc, FALSE);
+
+    TST_NO_WRITES ();
+    TST_CHECK (tstPfcReg (PFC_IPSR (2)) == TST_FUNC_A);
+
+    tstPfcTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstPfcPullNoUnlock - the pull registers are written without PMMR
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcPullNoUnlock (void)
+    {
+    const UINT32 seq [] =
+        {
+        PFC_PUEN (3),   0x10U,
+        PFC_PMMR,       ~0x4U,
+        PFC_DRVCTRL (4), 0x4U
+        };
+
+    tstPfcSetup (TST_FUNC_A, FALSE);
+
+    rzg2PfcRegBitSet (&tstPfc, PFC_PUEN (3), 0x10U);
+    rzg2PfcRegMaskAndSet (&tstPfc, PFC_DRVCTRL (4), 0x7U, 0x4U);
+
+    /* already set, so not written again */
+
+    rzg2PfcRegBitSet (&tstPfc, PFC_PUEN (3), 0x10U);
+
+    TST_WRITES (&tstPfcBlk, seq);
+    TST_CHECK (tstPfc.regSkips == 1U);
+
+    tstPfcTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstPfcPocXact - a POC change in a transaction calls the supply hook first
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcPocXact (void)
+    {
+    const UINT32 seq [] =
+        {
+        PFC_PMMR,       ~POC_MASK (POC_SD3),
+        PFC_POCCTRL,    POC_MASK (POC_SD3)
+        };
+
+    tstPfcSetup (TST_FUNC_A, FALSE);
+    tstPfcBlk.regs [PFC_POCCTRL / 4U] = POC_MASK (POC_SD0) |
+                                        POC_MASK (POC_SD3);
+    rzg2PfcPocHookSet (tstPfcPocHook, NULL);
+
+    /* switch SD0 to 1.8 V */
+
+    tstHookCalls = 0U;
+    tstHookStatus = OK;
+    rzg2PfcXactBegin (&tstPfc);
+    rzg2PfcRegMaskAndSet (&tstPfc, PFC_POCCTRL, POC_MASK (POC_SD0), 0U);
+    rzg2PfcXactEnd (&tstPfc, TRUE);
+
+    TST_CHECK (tstHookCalls == 1U);
+    TST_CHECK (tstHookPocSel == POC_SD0);
+    TST_CHECK (tstHookMv == PFC_POC_MV_1V8);
+    TST_CHECK (tstHookLogCount == 0U);
+    TST_CHECK (tstPfcReg (PFC_POCCTRL) == POC_MASK (POC_SD3));
+
+    /* a failing hook leaves its field as it was */
+
+    rzg2ModelLogReset ();
+    tstHookCalls = 0U;
+    tstHookStatus = ERROR;
+    rzg2PfcXactBegin (&tstPfc);
+    rzg2PfcRegMaskAndSet (&tstPfc, PFC_POCCTRL, 0U, POC_MASK (POC_SD0));
+    rzg2PfcXactEnd (&tstPfc, TRUE);
+
+    TST_CHECK (tstHookCalls == 1U);
+    TST_NO_WRITES ();
+    TST_CHECK (tstPfcReg (PFC_POCCTRL) == POC_MASK (POC_SD3));
+
+    /* both fields change, each with its own hook call */
+
+    tstPfcBlk.regs [PFC_POCCTRL / 4U] = 0U;
+    rzg2ModelLogReset ();
+    tstHookCalls = 0U;
+    tstHookStatus = OK;
+    rzg2PfcXactBegin (&tstPfc);
+    rzg2PfcRegMaskAndSet (&tstPfc, PFC_POCCTRL, 0U, POC_MASK (POC_SD0));
+    rzg2PfcRegMaskAndSet (&tstPfc, PFC_POCCTRL, 0U, POC_MASK (POC_SD3));
+    rzg2PfcXactEnd (&tstPfc, TRUE);
+
+    TST_CHECK (tstHookCalls == 2U);
+    TST_CHECK (tstPfcReg (PFC_POCCTRL) ==
+               (POC_MASK (POC_SD0) | POC_MASK (POC_SD3)));
+
+    /* both hooks fail, so nothing is written */
+
+    tstPfcBlk.regs [PFC_POCCTRL / 4U] = POC_MASK (POC_SD0);
+    rzg2ModelLogReset ();
+    rzg2PfcXactBegin (&tstPfc);
+    rzg2PfcRegMaskAndSet (&tstPfc, PFC_POCCTRL, POC_MASK (POC_SD0), 0U);
+    rzg2PfcRegMaskAndSet (&tstPfc, PFC_POCCTRL, 0U, POC_MASK (POC_SD3));
+    tstHookStatus = ERROR;
+    rzg2PfcXactEnd (&tstPfc, TRUE);
+
+    TST_NO_WRITES ();
+    TST_CHECK (tstPfcReg (PFC_POCCTRL) == POC_MASK (POC_SD0));
+
+    /* a field switched to 3.3 V is unlocked and written once */
+
+    tstHookStatus = OK;
+    tstPfcBlk.regs [PFC_POCCTRL / 4U] = 0U;
+    rzg2ModelLogReset ();
+    rzg2PfcXactBegin (&tstPfc);
+    rzg2PfcRegMaskAndSet (&tstPfc, PFC_POCCTRL, 0U, POC_MASK (POC_SD3));
+    rzg2PfcXactEnd (&tstPfc, TRUE);
+
+    TST_WRITES (&tstPfcBlk, seq);
+
+    tstPfcTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstPfcPocVoltage - rzg2PfcPocVoltageSet() writes POCCTRL once
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcPocVoltage (void)
+    {
+    const UINT32 seq [] =
+        {
+        PFC_PMMR,       ~POC_MASK (POC_SD0),
+        PFC_POCCTRL,    POC_MASK (POC_SD0)
+        };
+
+    tstPfcSetup (TST_FUNC_A, FALSE);
+    rzg2PfcPocHookSet (tstPfcPocHook, NULL);
+    tstHookCalls = 0U;
+    tstHookStatus = OK;
+
+    TST_CHECK (rzg2PfcPocVoltageSet (POC_SD0, PFC_POC_MV_3V3) == OK);
+    TST_CHECK (rzg2PfcPocVoltageSet (POC_SD0, PFC_POC_MV_3V3) == OK);
+    TST_CHECK (rzg2PfcPocVoltageSet (POC_SD0, 2500U) == ERROR);
+
+    TST_WRITES (&tstPfcBlk, seq);
+    TST_CHECK (tstHookCalls == 2U);
+    TST_CHECK (rzg2PfcPocVoltageGet (POC_SD0) == PFC_POC_MV_3V3);
+    TST_CHECK (tstPfc.pocSwitches == 2U);
+
+    tstPfcTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstPfcBootProg - the boot program is written in one transaction
+*
+* A boot program that matches the state set by the boot firmware writes
+* nothing. One that changes a function selection passes the pin through GPIO
+* mode, and the values it replaces are restored when the first program taking
+* over its bits is disabled.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcBootProg (void)
+    {
+    const RZG2_PFC_BOOT_WRITE boot [] =
+        {
+        { PFC_GPSR (1), TST_PIN, 0U },
+        { PFC_IPSR (2), TST_IPSR_MASK, TST_FUNC_A },
+        { PFC_GPSR (1), TST_PIN, TST_PIN }
+        };
+    const UINT32 seq [] =
+        {
+        PFC_PMMR,       ~0U,
+        PFC_GPSR (1),   0U,
+        PFC_PMMR,       ~TST_FUNC_A,
+        PFC_IPSR (2),   TST_FUNC_A,
+        PFC_PMMR,       ~TST_PIN,
+        PFC_GPSR (1),   TST_PIN
+        };
+
+    /* the firmware has already set the pins */
+
+    tstPfcSetup (TST_FUNC_A, FALSE);
+    rzg2PfcBootProgSet (boot, NELEMENTS (boot));
+
+    rzg2PfcBootProgApply (&tstPfc);
+
+    TST_NO_WRITES ();
+    TST_CHECK (tstPfc.bootApplied);
+    TST_CHECK (tstPfc.mutex->count == 0);
+
+    tstPfcTeardown ();
+
+    /* the firmware left the pin in another function */
+
+    tstPfcSetup (TST_FUNC_B, FALSE);
+    rzg2PfcBootProgSet (boot, NELEMENTS (boot));
+
+    rzg2PfcBootProgApply (&tstPfc);
+
+    TST_WRITES (&tstPfcBlk, seq);
+    TST_CHECK (tstPfc.bootPrev [PFC_IPSR (2) / 4U] == TST_FUNC_B);
+    TST_CHECK (tstPfc.bootMask [PFC_IPSR (2) / 4U] == TST_IPSR_MASK);
+
+    /* program A takes over the boot bits, and restores the firmware state */
+
+    tstPfcProgApply (&tstProgA, FALSE);
+    TST_CHECK (tstStepsA [1].saved == TST_FUNC_B);
+    TST_CHECK (tstPfc.bootMask [PFC_IPSR (2) / 4U] == 0U);
+
+    tstPfcProgApply (&tstProgA, TRUE);
+    TST_CHECK (tstPfcReg (PFC_IPSR (2)) == TST_FUNC_B);
+
+    tstPfcTeardown ();
+    }
+
+/*******************************************************************************
+*
+* tstPfcBoardAttach - attach the driver to the PFC node of the board
+*
+* This routine attaches the driver to the PFC node of the board device tree,
+* over a cleared register block mapped at the PFC address, with the boot
+* program <pWrites>, or none if it is NULL. The write log is cleared first.
+*
+* RETURNS: the PFC device, or NULL if the attach fails.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL VXB_DEV_ID tstPfcBoardAttach
+    (
+    const RZG2_PFC_BOOT_WRITE * pWrites,    /* boot program, or NULL */
+    UINT32              numWrites   /* number of boot program writes */
+    )
+    {
+    VXB_DEV_ID          pDev;
+
+    rzg2ModelBlockInit (&tstPfcBlk, "PFC", PFC_PMMR, tstPfcProt);
+    rzg2ModelBlockMap (&tstPfcBlk, TST_PFC_ADDR);
+    rzg2PfcPocHookSet (NULL, NULL);
+    rzg2PfcBootProgSet (pWrites, numWrites);
+    rzg2ModelLogReset ();
+
+    pDev = rzg2HostDevCreate (TST_PFC_NODE, &vxbFdtRsRzg2PfcPinMuxDrv);
+    if ((pDev != NULL) && (rzg2HostDevAttach (pDev) == ERROR))
+        {
+        rzg2HostDevDelete (pDev);
+        pDev = NULL;
+        }
+
+    return pDev;
+    }
+
+/*******************************************************************************
+*
+* tstPfcBoardDetach - detach the driver from the PFC node of the board
+*
+* This routine checks that the PFC mutex is free, the transaction is closed and
+* no write protected register was written without the PMMR unlock, then
+* detaches and deletes the device.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcBoardDetach
+    (
+    VXB_DEV_ID          pDev        /* PFC device */
+    )
+    {
+    PFC_PINMUX_DRVCTRL * pPfc = (PFC_PINMUX_DRVCTRL *) vxbDevSoftcGet (pDev);
+
+    TST_CHECK (pPfc->mutex->count == 0);
+    TST_CHECK (!pPfc->xactActive);
+    TST_CHECK (tstPfcBlk.violations == 0U);
+
+    TST_CHECK (rzg2HostDevDetach (pDev) == OK);
+    TST_CHECK (pRzg2Pfc == NULL);
+    TST_CHECK (vxbDevSoftcGet (pDev) == NULL);
+
+    rzg2HostDevDelete (pDev);
+    }
+
+/*******************************************************************************
+*
+* tstPfcClientEnable - enable or disable the default pin mux state of a node
+*
+* RETURNS: OK, or ERROR if there is no such node or the pin mux call fails.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL STATUS tstPfcClientEnable
+    (
+    const char *        pPath,      /* client device tree node */
+    BOOL                enable      /* TRUE to enable, FALSE to disable */
+    )
+    {
+    VXB_DEV_ID          pClient;
+    STATUS              status;
+
+    pClient = rzg2HostDevCreate (pPath, NULL);
+    if (pClient == NULL)
+        {
+        return ERROR;
+        }
+
+    rzg2ModelLogReset ();
+    status = enable ? vxbPinMuxEnable (pClient) : vxbPinMuxDisable (pClient);
+    rzg2HostDevDelete (pClient);
+
+    return status;
+    }
+
+/*******************************************************************************
+*
+* tstPfcBoardProgs - the attach compiles every configuration node
+*
+* The configuration nodes of the board are compiled into pin programs in
+* discarded transactions, so the attach writes no register, and a detach
+* followed by a new attach gives the same programs.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcBoardProgs (void)
+    {
+    PFC_PINMUX_DRVCTRL * pPfc;
+    VXB_DEV_ID          pDev;
+    UINT32              nodes = 0U;
+    UINT32              progs = 0U;
+    int                 node;
+
+    pDev = tstPfcBoardAttach (NULL, 0U);
+    TST_CHECK (pDev != NULL);
+    if (pDev == NULL)
+        {
+        return;
+        }
+
+    pPfc = (PFC_PINMUX_DRVCTRL *) vxbDevSoftcGet (pDev);
+
+    TST_NO_WRITES ();
+    TST_CHECK (pRzg2Pfc == pPfc);
+    TST_CHECK (pPfc->regBase == rzg2ModelBaseGet (&tstPfcBlk));
+    TST_CHECK (pPfc->pFuncSel == xPfcFuncSel);
+
+    for (node = vxFdtFirstSubnode (vxFdtPathOffset (TST_PFC_NODE));
+         node >= 0; node = vxFdtNextSubnode (node))
+        {
+        nodes++;
+        if (rzg2PfcProgFind (pPfc, node) != NULL)
+            {
+            progs++;
+            }
+        }
+
+    TST_CHECK (nodes > 0U);
+    TST_CHECK (progs == nodes);
+    TST_CHECK (pPfc->numProgs == nodes);
+
+    tstPfcBoardDetach (pDev);
+
+    /* the controller was unregistered, so the driver attaches again */
+
+    pDev = tstPfcBoardAttach (NULL, 0U);
+    TST_CHECK (pDev != NULL);
+    if (pDev != NULL)
+        {
+        TST_CHECK (((PFC_PINMUX_DRVCTRL *) vxbDevSoftcGet (pDev))->numProgs ==
+                   nodes);
+        tstPfcBoardDetach (pDev);
+        }
+    }
+
+/*******************************************************************************
+*
+* tstPfcBoardClients - the default pin mux states of the board
+*
+* The pin programs of the board configuration nodes are applied to a register
+* block in its reset state: each protected register is unlocked and written
+* once, the drive strengths and module selections before the GPSR bits that
+* hand the pins to the peripherals. The GPIO card detect pin of SDHI0 stays in
+* GPIO mode. Enabling a state already in effect writes nothing, and disabling
+* a state restores the reset values.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcBoardClients (void)
+    {
+    VXB_DEV_ID          pDev;
+
+    /* scif2: TX2_A and RX2_A on GP5_10 and GP5_11, drive-control 8 */
+
+    const UINT32 scif2Seq [] =
+        {
+        PFC_PMMR,           ~0x00000077U,
+        PFC_DRVCTRL (18),   0x00000077U,
+        PFC_PMMR,           ~0x00000c00U,
+        PFC_GPSR (5),       0x00000c00U
+        };
+    const UINT32 scif2Restore [] =
+        {
+        PFC_PMMR,           ~0U,
+        PFC_DRVCTRL (18),   0U,
+        PFC_PMMR,           ~0U,
+        PFC_GPSR (5),       0U
+        };
+
+    /* i2c0: SCL0 and SDA0 on GP3_14 and GP3_15, with I2C_SEL_0_1 */
+
+    const UINT32 i2c0Seq [] =
+        {
+        PFC_PMMR,           ~0x20000000U,
+        PFC_MOD_SEL (2),    0x20000000U,
+        PFC_PMMR,           ~0x0000c000U,
+        PFC_GPSR (3),       0x0000c000U
+        };
+
+    /*
+     * sdhi0: CLK, CMD and DATA0-3 on GP3_0-5, card detect GPIO GP3_12, after
+     * i2c0, so GPSR3 keeps the I2C0 pins
+     */
+
+    const UINT32 sdhi0Seq [] =
+        {
+        PFC_PMMR,           ~0xc0000000U,
+        PFC_DRVCTRL (17),   0xc0000000U,
+        PFC_PMMR,           ~0x0000c03fU,
+        PFC_GPSR (3),       0x0000c03fU
+        };
+
+    /* avb: the mux, conf and drive subnodes in one transaction */
+
+    const UINT32 avbSeq [] =
+        {
+        PFC_PMMR,           ~0x33307700U,
+        PFC_DRVCTRL (3),    0x33307700U,
+        PFC_PMMR,           ~0x00000333U,
+        PFC_DRVCTRL (2),    0x00000333U,
+        PFC_PMMR,           ~0x00001a00U,
+        PFC_GPSR (2),       0x00001a00U
+        };
+
+    pDev = tstPfcBoardAttach (NULL, 0U);
+    TST_CHECK (pDev != NULL);
+    if (pDev == NULL)
+        {
+        return;
+        }
+
+    TST_CHECK (tstPfcClientEnable (TST_SCIF2_NODE, TRUE) == OK);
+    TST_WRITES (&tstPfcBlk, scif2Seq);
+
+    TST_CHECK (tstPfcClientEnable (TST_SCIF2_NODE, TRUE) == OK);
+    TST_NO_WRITES ();
+
+    TST_CHECK (tstPfcClientEnable (TST_SCIF2_NODE, FALSE) == OK);
+    TST_WRITES (&tstPfcBlk, scif2Restore);
+
+    TST_CHECK (tstPfcClientEnable (TST_I2C0_NODE, TRUE) == OK);
+    TST_WRITES (&tstPfcBlk, i2c0Seq);
+
+    TST_CHECK (tstPfcClientEnable (TST_SDHI0_NODE, TRUE) == OK);
+    TST_WRITES (&tstPfcBlk, sdhi0Seq);
+    TST_CHECK (tstPfcReg (PFC_GPSR (3)) == 0x0000c03fU);
+    TST_CHECK ((tstPfcReg (PFC_GPSR (3)) & (1U << 12)) == 0U);
+
+    TST_CHECK (tstPfcClientEnable (TST_AVB_NODE, TRUE) == OK);
+    TST_WRITES (&tstPfcBlk, avbSeq);
+
+    /* disabling SDHI0 leaves the I2C0 pins of GPSR3 */
+
+    TST_CHECK (tstPfcClientEnable (TST_SDHI0_NODE, FALSE) == OK);
+    TST_CHECK (tstPfcReg (PFC_GPSR (3)) == 0x0000c000U);
+    TST_CHECK (tstPfcReg (PFC_DRVCTRL (17)) == 0U);
+
+    tstPfcBoardDetach (pDev);
+    }
+
+/*******************************************************************************
+*
+* tstPfcBoardBootProg - the boot program generated for the board
+*
+* The attach writes the boot program generated by rzg2PfcBootGen from the
+* board device tree, which sets the pins of the serial, I2C, SD and Ethernet
+* nodes, so enabling their default pin mux states writes nothing.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcBoardBootProg (void)
+    {
+    PFC_PINMUX_DRVCTRL * pPfc;
+    VXB_DEV_ID          pDev;
+
+    pDev = tstPfcBoardAttach (rzg2PfcBootWrites,
+                              NELEMENTS (rzg2PfcBootWrites));
+    TST_CHECK (pDev != NULL);
+    if (pDev == NULL)
+        {
+        return;
+        }
+
+    pPfc = (PFC_PINMUX_DRVCTRL *) vxbDevSoftcGet (pDev);
+
+    TST_CHECK (pPfc->bootApplied);
+    TST_CHECK (pPfc->numProgs == 0U);
+    TST_CHECK (rzg2ModelLogCount () > 0U);
+    TST_CHECK (tstPfcReg (PFC_GPSR (5)) == 0x00000c00U);
+    TST_CHECK (tstPfcReg (PFC_GPSR (3)) == 0x0000c03fU);
+
+    TST_CHECK (tstPfcClientEnable (TST_SCIF2_NODE, TRUE) == OK);
+    TST_NO_WRITES ();
+    TST_CHECK (tstPfcClientEnable (TST_I2C0_NODE, TRUE) == OK);
+    TST_NO_WRITES ();
+    TST_CHECK (tstPfcClientEnable (TST_SDHI0_NODE, TRUE) == OK);
+    TST_NO_WRITES ();
+    TST_CHECK (tstPfcClientEnable (TST_AVB_NODE, TRUE) == OK);
+    TST_NO_WRITES ();
+
+    tstPfcBoardDetach (pDev);
+    }
+
+/*******************************************************************************
+*
+* tstPfcPinLinearGet - get a pin descriptor by a linear search
+*
+* This routine searches the pin table as rzg2PfcPinGet() did before the pin
+* name index, for the index test and benchmark. <pCompares>, if not NULL, is
+* incremented by the number of names compared.
+*
+* RETURNS: the first pin descriptor named <pinName>, or NULL.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL const PFC_PIN_DESC * tstPfcPinLinearGet
+    (
+    const char *        pinName,    /* pin name */
+    UINT32 *            pCompares   /* names compared, or NULL */
+    )
+    {
+    const PFC_PIN_DESC * pPin;
+
+    for (pPin = pfcPins; !PFC_PIN_DESC_TBL_END (pPin); pPin++)
+        {
+        if (pCompares != NULL)
+            {
+            (*pCompares)++;
+            }
+
+        if (strncmp (pPin->sipName, pinName, PFC_NAME_LEN_MAX) == 0)
+            {
+            return pPin;
+            }
+        }
+
+    return NULL;
+    }
+
+/*******************************************************************************
+*
+* tstPfcBoardPinsGet - collect the pin names of the board configuration nodes
+*
+* This routine fills tstBoardPins with the names of the "pins" properties of
+* the configuration nodes, and their subnodes, of the board PFC node, the names
+* rzg2PfcPinGet() looks up when the board pin programs are compiled.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcBoardPinsGet (void)
+    {
+    const char *        pName;
+    int                 len;
+    int                 pfcNode;
+    int                 node;
+    int                 depth = 0;
+
+    tstBoardPinsNum = 0U;
+    pfcNode = vxFdtPathOffset (TST_PFC_NODE);
+    if (pfcNode < 0)
+        {
+        return;
+        }
+
+    for (node = vxFdtNextNode (pfcNode, &depth); (node >= 0) && (depth > 0);
+         node = vxFdtNextNode (node, &depth))
+        {
+        pName = (const char *) vxFdtPropGet (node, PFC_FDT_PINS, &len);
+        if (pName == NULL)
+            {
+            continue;
+            }
+
+        while ((len > 0) && (tstBoardPinsNum < TST_BOARD_PINS_MAX))
+            {
+            tstBoardPins [tstBoardPinsNum++] = (char *) pName;
+            len -= (int) strlen (pName) + 1;
+            pName += strlen (pName) + 1;
+            }
+        }
+    }
+
+/*******************************************************************************
+*
+* tstPfcPinIndex - the pin name index finds the pins of the linear search
+*
+* Every name of the pin table, and every pin name of the board configuration
+* nodes, gives the same descriptor through the generated index as through a
+* linear search of the table, which is the first entry of the name. An unknown
+* name is not found.
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcPinIndex (void)
+    {
+    const PFC_PIN_DESC * pPin;
+    UINT32              mismatches = 0U;
+    UINT32              i;
+
+    for (pPin = pfcPins; !PFC_PIN_DESC_TBL_END (pPin); pPin++)
+        {
+        if (rzg2PfcPinGet ((char *) pPin->sipName) !=
+            tstPfcPinLinearGet (pPin->sipName, NULL))
+            {
+            mismatches++;
+            }
+        }
+
+    TST_CHECK (mismatches == 0U);
+
+    tstPfcBoardPinsGet ();
+    TST_CHECK (tstBoardPinsNum > 0U);
+    TST_CHECK (tstBoardPinsNum < TST_BOARD_PINS_MAX);
+
+    for (i = 0U; i < tstBoardPinsNum; i++)
+        {
+        pPin = rzg2PfcPinGet (tstBoardPins [i]);
+        if ((pPin == NULL) ||
+            (pPin != tstPfcPinLinearGet (tstBoardPins [i], NULL)))
+            {
+            mismatches++;
+            }
+        }
+
+    TST_CHECK (mismatches == 0U);
+    TST_CHECK (rzg2PfcPinGet ("GP9_99") == NULL);
+    TST_CHECK (rzg2PfcPinGet (NULL) == NULL);
+    }
+
+/*******************************************************************************
+*
+* tstPfcBench - time the PFC transactions
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void tstPfcBench
+    (
+    UINT32              loops       /* transactions of each kind */
+    )
+    {
+    UINT64              start;
+    UINT64              ticks;
+    UINT32              writes;
+    UINT32              unlocks;
+    UINT32              reads;
+    UINT32              found;
+    UINT32              compares;
+    UINT32              i;
+    VXB_DEV_ID          pDev;
+
+    tstPfcSetup (TST_FUNC_A, FALSE);
+    rzg2ModelLogEnable (FALSE);
+
+    /* switch the pin between the functions of programs A and B */
+
+    writes = tstPfcBlk.writes;
+    unlocks = tstPfcBlk.unlocks;
+    reads = tstPfcBlk.reads;
+    start = rzg2TimestampGet ();
+    for (i = 0U; i < loops; i++)
+        {
+        tstPfcProgApply (((i & 1U) == 0U) ? &tstProgB : &tstProgA, FALSE);
+        }
+    ticks = rzg2TimestampGet () - start;
+
+    (void)printf ("PFC function switch:   %6llu ns, %2u writes, %2u unlocks, "
+                  "%2u reads\n", ticks / loops,
+                  (tstPfcBlk.writes - writes) / loops,
+                  (tstPfcBlk.unlocks - unlocks) / loops,
+                  (tstPfcBlk.reads - reads) / loops);
+
+    /* apply the program already in effect */
+
+    writes = tstPfcBlk.writes;
+    unlocks = tstPfcBlk.unlocks;
+    reads = tstPfcBlk.reads;
+    start = rzg2TimestampGet ();
+    for (i = 0U; i < loops; i++)
+        {
+        tstPfcProgApply (&tstProgA, FALSE);
+        }
+    ticks = rzg2TimestampGet () - start;
+
+    (void)printf ("PFC unchanged program: %6llu ns, %2u writes, %2u unlocks, "
+                  "%2u reads\n", ticks / loops,
+                  (tstPfcBlk.writes - writes) / loops,
+                  (tstPfcBlk.unlocks - unlocks) / loops,
+                  (tstPfcBlk.reads - reads) / loops);
+
+    rzg2ModelLogEnable (TRUE);
+    tstPfcTeardown ();
+
+    /* attach to the board device tree, compiling its configuration nodes */
+
+    rzg2ModelLogEnable (FALSE);
+    ticks = 0U;
+    writes = 0U;
+    reads = 0U;
+    for (i = 0U; i < TST_ATTACH_LOOPS; i++)
+        {
+        start = rzg2TimestampGet ();
+        pDev = tstPfcBoardAttach (NULL, 0U);
+        ticks += rzg2TimestampGet () - start;
+
+        if (pDev == NULL)
+            {
+            break;
+            }
+
+        writes += tstPfcBlk.writes;
+        reads += tstPfcBlk.reads;
+        (void)rzg2HostDevDetach (pDev);
+        rzg2HostDevDelete (pDev);
+        }
+
+    (void)printf ("PFC board attach:      %6llu ns, %2u writes, %2u reads\n",
+                  ticks / TST_ATTACH_LOOPS, writes / TST_ATTACH_LOOPS,
+                  reads / TST_ATTACH_LOOPS);
+
+    rzg2ModelLogEnable (TRUE);
+
+    /* look up the pin names of the board, through the index and linearly */
+
+    tstPfcBoardPinsGet ();
+    if (tstBoardPinsNum == 0U)
+        {
+        return;
+        }
+
+    found = 0U;
+    start = rzg2TimestampGet ();
+    for (i = 0U; i < TST_LOOKUP_LOOPS * tstBoardPinsNum; i++)
+        {
+        if (rzg2PfcPinGet (tstBoardPins [i % tstBoardPinsNum]) != NULL)
+            {
+            found++;
+            }
+        }
+    ticks = rzg2TimestampGet () - start;
+
+    (void)printf ("PFC pin index lookup:  %6llu ns, %u pins found\n",
+                  ticks / (TST_LOOKUP_LOOPS * tstBoardPinsNum),
+                  found / TST_LOOKUP_LOOPS);
+
+    compares = 0U;
+    found = 0U;
+    start = rzg2TimestampGet ();
+    for (i = 0U; i < TST_LOOKUP_LOOPS * tstBoardPinsNum; i++)
+        {
+        if (tstPfcPinLinearGet (tstBoardPins [i % tstBoardPinsNum], &compares)
+            != NULL)
+            {
+            found++;
+            }
+        }
+    ticks = rzg2TimestampGet () - start;
+
+    (void)printf ("PFC pin linear lookup: %6llu ns, %u pins found, "
+                  "%u compares each\n",
+                  ticks / (TST_LOOKUP_LOOPS * tstBoardPinsNum),
+                  found / TST_LOOKUP_LOOPS,
+                  compares / (TST_LOOKUP_LOOPS * tstBoardPinsNum));
+    }
+
+/*******************************************************************************
+*
+* main - run the PFC host tests
+*
+* RETURNS: 0 if all checks pass, 1 otherwise.
+*
+* ERRNO: N/A.
+*/
+
+int main
+    (
+    int                 argc,
+    char **             argv
+    )
+    {
+    TST_RUN (tstPfcFuncSwitch);
+    TST_RUN (tstPfcNoChange);
+    TST_RUN (tstPfcGpsrOnly);
+    TST_RUN (tstPfcRestore);
+    TST_RUN (tstPfcDiscard);
+    TST_RUN (tstPfcPullNoUnlock);
+    TST_RUN (tstPfcPocXact);
+    TST_RUN (tstPfcPocVoltage);
+    TST_RUN (tstPfcBootProg);
+
+    if (rzg2HostFdtLoad (TST_BOARD_DTB) == ERROR)
+        {
+        return EXIT_FAILURE;
+        }
+
+    TST_RUN (tstPfcPinIndex);
+    TST_RUN (tstPfcBoardProgs);
+    TST_RUN (tstPfcBoardClients);
+    TST_RUN (tstPfcBoardBootProg);
+
+    if ((argc > 1) && (strcmp (argv [1], "-b") == 0))
+        {
+        tstPfcBench ((argc > 2) ? (UINT32) atoi (argv [2]) : TST_BENCH_LOOPS);
+        }
+
+    return tstSummary ();
+    }
@@ -0,0 +1,635 @@
+#!/usr/bin/env python3
+#
+# rzg2PfcTblGen.py - generate the RZ/G2M PFC pin, group and function tables
+#
+# Copyright (c) 2026 Wind River Systems, Inc.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1) Redistributions of source code must retain the above copyright notice,
+# this list of conditions and the following disclaimer.
+#
+# 2) Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+# 3) Neither the name of Wind River Systems nor the names of its contributors
+# may be used to endorse or promote products derived from this software without
+# specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+# modification history
+# --------------------
+# 19oct26,agt  written
+#
+# DESCRIPTION
+# This script generates the pin, pin group and function tables of the PFC pin
+# mux driver, vxbFdtRsRzg2PfcPinMux.c, from the pin description in the pfc
+# directory next to it:
+#
+#   groups.csv      pin groups, in the order the driver tries them
+#   functions.csv   functions, and the names used in the device tree
+#   pins.csv        pins: GPSR bit (GPn_m, or - for a dedicated pin), PUEN/PUD
+#                   and DRVCTRL fields, and pin groups
+#   funcsel.csv     IPSR function selections of the pin groups
+#   modsel.csv      MOD_SEL module selections of the pin groups
+#
+# Register fields are named without their PU_, DRVCTRL_, IPSR_ or MOD_SEL_
+# prefix, and must be defined in vxbFdtRsRzg2PfcPinMux.h. The first group of a
+# pin is the group of its pfcPins entry. A pin is also in its other listed
+# groups, and in the groups of the other pins on the same pad.
+#
+# Lines starting with '#' are comments. A comment in pins.csv or funcsel.csv is
+# copied to the table as a section heading.
+#
+# It writes two files to the driver source directory:
+#
+#   vxbFdtRsRzg2PfcPinMuxIds.h  the group and function IDs and the size of the
+#                               pin name index
+#   vxbFdtRsRzg2PfcPinMuxTbl.h  the const pin, pin group, function, function
+#                               selection and module selection tables, and the
+#                               pin name index
+#
+# Both files are committed, so the layer build does not run this script. Run it
+# after changing a CSV file:
+#
+#   python3 rzg2PfcTblGen.py            regenerate the tables
+#   python3 rzg2PfcTblGen.py --check    fail if the tables are out of date
+#
+# The script fails without writing anything if the description is not
+# consistent: an unknown group, function or register field, a pad with two
+# different pull or drive fields, a duplicated name, a group with no pins, or a
+# name longer than the driver compares.
+#
+
+import argparse
+import csv
+import os
+import re
+import sys
+
+TOOLS_DIR = os.path.dirname(os.path.abspath(__file__))
+CSV_DIR = os.path.join(TOOLS_DIR, 'pfc')
+SRC_DIR = os.path.join(TOOLS_DIR, '..', 'src')
+HDR_FILE = os.path.join(TOOLS_DIR, '..', 'h', 'vxbFdtRsRzg2PfcPinMux.h')
+
+IDS_FILE = 'vxbFdtRsRzg2PfcPinMuxIds.h'
+TBL_FILE = 'vxbFdtRsRzg2PfcPinMuxTbl.h'
+
+# driver limits, from vxbFdtRsRzg2PfcPinMux.c and its header
+
+NAME_LEN_MAX = 20           # PFC_NAME_LEN_MAX
+NUM_GPSR_REGS = 8           # NUM_GPSR_REGS
+GROUPS_MAX = 64             # pin groups are kept in a UINT64 mask
+IPSR_VAL_MAX = 0xf          # IPSR fields are 4 bits
+HASH_EMPTY = 0xffff         # PFC_PIN_HASH_EMPTY
+HASH_SIZE_MIN = 64
+
+# FNV-1a, as rzg2PfcPinHash()
+
+FNV_OFFSET = 2166136261
+FNV_PRIME = 16777619
+
+IDENT = re.compile(r'^[A-Z][A-Z0-9_]*$')
+GPSR = re.compile(r'^GP(\d+)_(\d+)$')
+
+LICENSE = """\
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1) Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2) Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ * 3) Neither the name of Wind River Systems nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+"""
+
+GENERATED = """\
+/*
+DESCRIPTION
+This file is generated by tools/rzg2PfcTblGen.py from the CSV files in
+tools/pfc, and is included by vxbFdtRsRzg2PfcPinMux.c only. Do not edit it:
+change the CSV files and run the script again.
+*/
+"""
+
+
+class TblError(Exception):
+    pass
+
+
+def csvRead(name):
+    """Read a CSV file, returning (line, comment, fields) tuples."""
+
+    path = os.path.join(CSV_DIR, name)
+    rows = []
+
+    with open(path, newline='') as f:
+        lines = f.read().splitlines()
+
+    header = None
+    for lineNo, line in enumerate(lines, 1):
+        where = '%s:%d' % (name, lineNo)
+        if line.strip() == '':
+            continue
+        if line.startswith('#'):
+            rows.append((where, line[1:].strip(), None))
+            continue
+        fields = [x.strip() for x in next(csv.reader([line]))]
+        if header is None:
+            header = fields
+            continue
+        if len(fields) != len(header):
+            raise TblError('%s: %d fields, expected %d' %
+                           (where, len(fields), len(header)))
+        rows.append((where, None, dict(zip(header, fields))))
+
+    return rows
+
+
+def hdrMacros():
+    """Return the names of the macros defined in the driver header."""
+
+    with open(HDR_FILE) as f:
+        return set(re.findall(r'^#define\s+([A-Z0-9_]+)', f.read(), re.M))
+
+
+def pinHash(name, size):
+    """Hash a pin name as rzg2PfcPinHash() does."""
+
+    h = FNV_OFFSET
+    for c in name.encode('ascii')[:NAME_LEN_MAX]:
+        h = ((h ^ c) * FNV_PRIME) & 0xffffffff
+    return h & (size - 1)
+
+
+def load():
+    """Load and check the pin description."""
+
+    macros = hdrMacros()
+
+    def ident(where, value, what):
+        if not IDENT.match(value):
+            raise TblError('%s: bad %s "%s"' % (where, what, value))
+        return value
+
+    def field(where, prefix, value):
+        if ('%s_%s' % (prefix, value)) not in macros:
+            raise TblError('%s: %s_%s is not defined in %s' %
+                           (where, prefix, value, os.path.basename(HDR_FILE)))
+        return '%s_%s' % (prefix, value)
+
+    def unique(where, seen, value, what):
+        if value in seen:
+            raise TblError('%s: %s %s duplicated' % (where, what, value))
+        seen.add(value)
+
+    # groups
+
+    groups = []
+    for where, _, row in csvRead('groups.csv'):
+        if row is None:
+            continue
+        g = ident(where, row['group'], 'group')
+        unique(where, set(groups), g, 'group')
+        groups.append(g)
+
+    if len(groups) + 1 > GROUPS_MAX:
+        raise TblError('groups.csv: %d groups, at most %d' %
+                       (len(groups), GROUPS_MAX - 1))
+
+    def group(where, value):
+        if value not in groups:
+            raise TblError('%s: unknown group %s' % (where, value))
+        return value
+
+    # functions
+
+    funcs = []
+    names = set()
+    for where, _, row in csvRead('functions.csv'):
+        if row is None:
+            continue
+        fn = ident(where, row['function'], 'function')
+        unique(where, set(f for f, _ in funcs), fn, 'function')
+        name = row['name']
+        if not re.match(r'^[a-z][a-z0-9_-]*$', name) or \
+           len(name) >= NAME_LEN_MAX:
+            raise TblError('%s: bad function name "%s"' % (where, name))
+        unique(where, names, name, 'function name')
+        funcs.append((fn, name))
+
+    def func(where, value):
+        if value not in [f for f, _ in funcs]:
+            raise TblError('%s: unknown function %s' % (where, value))
+        return value
+
+    # pins
+
+    pins = []
+    pads = {}
+    pinNames = set()
+    usedGroups = set()
+    for where, comment, row in csvRead('pins.csv'):
+        if row is None:
+            pins.append((comment, None))
+            continue
+        name = row['name']
+        if not re.match(r'^[A-Za-z0-9_#]+$', name) or \
+           len(name) >= NAME_LEN_MAX:
+            raise TblError('%s: bad pin name "%s"' % (where, name))
+        unique(where, pinNames, name, 'pin')
+
+        gpsr = row['gpsr']
+        if gpsr != '-':
+            m = GPSR.match(gpsr)
+            if m is None or int(m.group(1)) >= NUM_GPSR_REGS or \
+               int(m.group(2)) > 31:
+                raise TblError('%s: bad GPSR bit "%s"' % (where, gpsr))
+            gpsr = (int(m.group(1)), int(m.group(2)))
+        else:
+            gpsr = None
+
+        pin = {
+            'where':  where,
+            'name':   name,
+            'gpsr':   gpsr,
+            'pull':   field(where, 'PU', row['pull']),
+            'drive':  field(where, 'DRVCTRL', row['drive']),
+            'groups': [group(where, g) for g in row['groups'].split()],
+            }
+        if not pin['groups']:
+            raise TblError('%s: pin %s has no group' % (where, name))
+        usedGroups.update(pin['groups'])
+
+        # entries for the same pad share its fields and its groups
+
+        if gpsr is not None:
+            if gpsr in pads:
+                first = pads[gpsr][0]
+                if first['pull'] != pin['pull'] or \
+                   first['drive'] != pin['drive']:
+                    raise TblError('%s: pad GP%d_%d of %s differs from %s' %
+                                   (where, gpsr[0], gpsr[1], name,
+                                    first['name']))
+                pads[gpsr].append(pin)
+            else:
+                pads[gpsr] = [pin]
+        pins.append((None, pin))
+
+    for g in groups:
+        if g not in usedGroups:
+            raise TblError('groups.csv: group %s has no pins' % g)
+
+    for pin in [p for _, p in pins if p is not None]:
+        mask = set(pin['groups'])
+        if pin['gpsr'] is not None:
+            for other in pads[pin['gpsr']]:
+                mask.update(other['groups'])
+        pin['mask'] = [g for g in groups if g in mask]
+
+    # function and module selections
+
+    def sels(name, prefix, column, valueMax):
+        rows = []
+        for where, comment, row in csvRead(name):
+            if row is None:
+                rows.append((comment, None))
+                continue
+            value = int(row['value'], 0)
+            if value < 0 or value > valueMax:
+                raise TblError('%s: bad value %s' % (where, row['value']))
+            rows.append((None, {
+                'group':  group(where, row['group']),
+                'func':   func(where, row['function']),
+                'field':  field(where, prefix, row[column]),
+                'value':  value,
+                'signal': row['signals'],
+                }))
+        return rows
+
+    funcSel = sels('funcsel.csv', 'IPSR', 'ipsr', IPSR_VAL_MAX)
+    modSel = sels('modsel.csv', 'MOD_SEL', 'modsel', 0xff)
+
+    return groups, funcs, pins, funcSel, modSel
+
+
+def hashBuild(pins):
+    """Build the pin name index, as rzg2PfcPinGet() searches it."""
+
+    names = [p['name'] for _, p in pins if p is not None]
+    size = HASH_SIZE_MIN
+    while size < 2 * len(names):
+        size *= 2
+
+    table = [HASH_EMPTY] * size
+    for index, name in enumerate(names):
+        slot = pinHash(name, size)
+        while table[slot] != HASH_EMPTY:
+            slot = (slot + 1) & (size - 1)
+        table[slot] = index
+
+    return size, table
+
+
+def columns(rows, indent='    '):
+    """Format rows of C initialiser fields in aligned columns."""
+
+    widths = []
+    for fields, _ in rows:
+        for i, f in enumerate(fields[:-1]):
+            if i >= len(widths):
+                widths.append(0)
+            widths[i] = max(widths[i], len(f))
+
+    out = []
+    for fields, comment in rows:
+        line = ''.join(f.ljust(widths[i]) + ' '
+                       for i, f in enumerate(fields[:-1])) + fields[-1]
+        if comment:
+            line = line + ' ' * max(1, 60 - len(indent + line)) + \
+                   '/* %s */' % comment
+        out.append(indent + line.rstrip())
+    return out
+
+
+def genIds(groups, funcs, hashSize):
+    out = []
+    out.append('/* %s - RZ/G2M PFC pin group and function IDs */' % IDS_FILE)
+    out.append('')
+    out.append(LICENSE)
+    out.append(GENERATED)
+    out.append('#ifndef __INC%sh' % IDS_FILE[:-2])
+    out.append('#define __INC%sh' % IDS_FILE[:-2])
+    out.append('')
+    out.append('/*')
+    out.append(' * size of the pin name index, a power of two at least twice '
+               'the number of')
+    out.append(' * pins')
+    out.append(' */')
+    out.append('')
+    out.append('#define PFC_PIN_HASH_SIZE     %dU' % hashSize)
+    out.append('')
+    out.append('/* pin groups, named after a pin group\'s primary function */')
+    out.append('')
+    out.append('typedef enum pfcGroupId')
+    out.append('    {')
+    out.append('    GRP_NONE,')
+    for g in groups:
+        out.append('    GRP_%s,' % g)
+    out.append('    GRP_COUNT                           /* number of groups */')
+    out.append('    } PFC_GROUP_ID;')
+    out.append('')
+    out.append('/* functions */')
+    out.append('')
+    out.append('typedef enum pfcFuncId')
+    out.append('    {')
+    out.append('    FN_NONE,')
+    for i, (f, _) in enumerate(funcs):
+        out.append('    FN_%s%s' % (f, ',' if i + 1 < len(funcs) else ''))
+    out.append('    } PFC_FUNC_ID;')
+    out.append('')
+    out.append('#endif /* __INC%sh */' % IDS_FILE[:-2])
+    return out
+
+
+def genTbl(groups, funcs, pins, funcSel, modSel, hashSize, hashTable):
+    out = []
+    out.append('/* %s - RZ/G2M PFC pin, group and function tables */' %
+               TBL_FILE)
+    out.append('')
+    out.append(LICENSE)
+    out.append(GENERATED)
+
+    # pins
+
+    out.append('/*')
+    out.append(' * supported PFC pin configuration definitions')
+    out.append(' *')
+    out.append(' * The names in this table are the pin names that can be '
+               'referenced in the')
+    out.append(' * device tree when setting pin configurations.')
+    out.append(' */')
+    out.append('')
+    out.append('LOCAL const PFC_PIN_DESC pfcPins [] =')
+    out.append('    {')
+
+    # each section of the table is aligned on its own
+
+    sections = [[]]
+    for comment, pin in pins:
+        if pin is None:
+            sections.append([comment])
+            continue
+        gpsr = 'GPSR_NONE' if pin['gpsr'] is None else \
+               'GPSR_REG_PIN (%dU, %dU)' % pin['gpsr']
+        sections[-1].append(((('{"%s",' % pin['name']), gpsr + ',',
+                              pin['pull'] + ',', pin['drive'] + ',',
+                              'GRP_%s},' % pin['groups'][0]), None))
+    sections.append([(('{NULL,', 'GPSR_NONE,', '0U,', '0U,', 'GRP_NONE}'),
+                      'list terminator')])
+
+    for section in sections:
+        if section and isinstance(section[0], str):
+            if out[-1] != '    {':
+                out.append('')
+            out.append('    /* %s */' % section[0])
+            out.append('')
+            section = section[1:]
+        elif section and out[-1] != '    {':
+            out.append('')
+        out.extend(columns(section))
+    out.append('    };')
+    out.append('')
+
+    # pin groups
+
+    out.append('/*')
+    out.append(' * pin groups of each pfcPins entry')
+    out.append(' *')
+    out.append(' * A pin is in the groups of all the pfcPins entries for its '
+               'pad, and in the')
+    out.append(' * other groups listed for the pad in pins.csv.')
+    out.append(' */')
+    out.append('')
+    out.append('LOCAL const UINT64 pfcPinGroups [NELEMENTS (pfcPins)] =')
+    out.append('    {')
+    for _, pin in pins:
+        if pin is None:
+            continue
+        bits = ['PFC_GROUP_BIT (GRP_%s)' % g for g in pin['mask']]
+        line = '    '
+        for j, b in enumerate(bits):
+            sep = ' |' if j + 1 < len(bits) else ','
+            if len(line) + len(b) + len(sep) > 58 and line.strip():
+                out.append(line.rstrip())
+                line = '        '
+            line += b + sep + ' '
+        out.append(line.rstrip() + ' ' * max(1, 60 - len(line.rstrip())) +
+                   '/* %s */' % pin['name'])
+    out.append('    0U                                                      '
+               '/* list terminator */')
+    out.append('    };')
+    out.append('')
+
+    # function names
+
+    out.append('/* function names referenced in the device tree, mapped to '
+               'enumeration */')
+    out.append('')
+    out.append('LOCAL const PFC_FUNCTION pfcFuncs [] =')
+    out.append('    {')
+    rows = [(('{ FN_%s,' % f, '"%s" }%s' % (n, ',' if i + 1 < len(funcs)
+                                             else '')), None)
+            for i, (f, n) in enumerate(funcs)]
+    out.extend(columns(rows))
+    out.append('    };')
+    out.append('#define PFC_NUM_FUNCS   (NELEMENTS (pfcFuncs))')
+    out.append('')
+
+    # selections
+
+    def sels(table, ctype, title, prefix, rows, valName):
+        out.append('/*')
+        out.append(' * %s' % title)
+        out.append(' */')
+        out.append('')
+        out.append('LOCAL const %s %s [] =' % (ctype, table))
+        out.append('    {')
+        body = []
+        prev = None
+        for comment, s in rows:
+            if s is None:
+                body.append(comment)
+                prev = None
+                continue
+            if prev is not None and s['func'] != prev:
+                body.append('')
+            prev = s['func']
+            value = ('0x%xU' % s['value']) if s['value'] > 9 else \
+                    ('%dU' % s['value'])
+            body.append((('{ GRP_%s,' % s['group'], 'FN_%s,' % s['func'],
+                          s['field'] + ',', value + ' },'), s['signal']))
+        body.append((('{ GRP_NONE,', 'FN_NONE,', '0U,', '0U }'),
+                     'list terminator'))
+        formatted = columns([r for r in body if isinstance(r, tuple)])
+        i = 0
+        for r in body:
+            if r == '':
+                out.append('')
+            elif isinstance(r, str):
+                out.append('')
+                out.append('    /* %s */' % r)
+                out.append('')
+            else:
+                out.append(formatted[i])
+                i += 1
+        out.append('    };')
+        out.append('')
+
+    sels('xPfcFuncSel', 'PFC_FUNC_DESC',
+         'supported PFC peripheral function selections, with the setting of '
+         'the IPSR\n * field of each pin', 'IPSR', funcSel, 'ipsrVal')
+    sels('pfcModuleSel', 'PFC_MOD_DESC',
+         'supported PFC module selections, with the setting of the MOD_SEL '
+         'field', 'MOD_SEL', modSel, 'modSelVal')
+
+    # pin name index
+
+    out.append('/*')
+    out.append(' * pin name index')
+    out.append(' *')
+    out.append(' * Each slot holds the pfcPins index of a pin name, or '
+               'PFC_PIN_HASH_EMPTY.')
+    out.append(' * A name is looked up from slot rzg2PfcPinHash (name), '
+               'probing the next')
+    out.append(' * slots until the name or an empty slot is found.')
+    out.append(' */')
+    out.append('')
+    out.append('LOCAL const UINT16 pfcPinHash [PFC_PIN_HASH_SIZE] =')
+    out.append('    {')
+    for base in range(0, hashSize, 8):
+        vals = ['0x%04x' % v if v == HASH_EMPTY else '%6d' % v
+                for v in hashTable[base:base + 8]]
+        last = base + 8 >= hashSize
+        out.append('    /* %3d */ %s%s' % (base, ', '.join(vals),
+                                            '' if last else ','))
+    out.append('    };')
+
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='generate the RZ/G2M PFC pin, group and function tables')
+    parser.add_argument('--check', action='store_true',
+                        help='fail if the generated files are out of date')
+    args = parser.parse_args()
+
+    try:
+        groups, funcs, pins, funcSel, modSel = load()
+    except (TblError, ValueError, KeyError) as e:
+        sys.stderr.write('rzg2PfcTblGen: %s\n' % e)
+        return 1
+
+    hashSize, hashTable = hashBuild(pins)
+
+    files = {
+        IDS_FILE: genIds(groups, funcs, hashSize),
+        TBL_FILE: genTbl(groups, funcs, pins, funcSel, modSel, hashSize,
+                         hashTable),
+        }
+
+    status = 0
+    for name, lines in sorted(files.items()):
+        path = os.path.join(SRC_DIR, name)
+        text = '\n'.join(lines) + '\n'
+        if args.check:
+            try:
+                with open(path) as f:
+                    current = f.read()
+            except IOError:
+                current = None
+            if current != text:
+                sys.stderr.write('rzg2PfcTblGen: %s is out of date\n' % name)
+                status = 1
+        else:
+            with open(path, 'w') as f:
+                f.write(text)
+
+    return status
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -29,11 +29,17 @@
 #
 # modification history
 # --------------------
+# 19oct26,agt  generate the PFC boot program from the compiled device tree
 # 17sep19,hli  created (VXWPG-394)
 #
 # DESCRIPTION
 # This file contains definitions for building VxWorks for the RZ/G2 family boards.
 #
+# The PFC boot program rzg2PfcBootProg.c, included by sysLib.c when
+# RZG2_PFC_BOOT_PROG is TRUE, is generated from the compiled device tree by
+# rzg2PfcBootGen, a host program built from the PFC driver source of the RZ/G2
+# layer. The file is only replaced when the generated program changes.
+#
 # INTERNAL
 # This file should only contain rules specific to the BSP.  Definitions
 # specific to this BSP should be placed in the defs file (defs.bsp.mk)
@@ -49,3 +55,18 @@ __WRVX_BSP_POST_BUILD_RULE += $(CP) $@ $@_swap ;    \
 	$(OBJCPY) --adjust-start -0x$(LOCAL_MEM_LOCAL_ADRS) --no-change-warnings $@ > /dev/null 2>&1; \
 	$(ENV_BIN)image-tag -tag $@;
 endif
+
+# PFC boot program
+
+RZG2_PSL_DIR      ?= $(BSP_DIR)/../renesas_rz_g2_0.1.0.0
+RZG2_PFC_BOOT_DIR  = $(RZG2_PSL_DIR)/test/host
+RZG2_PFC_BOOT_DTB ?= $(DTS_FILE:.dts=.dtb)
+
+rzg2PfcBootProg.c: $(RZG2_PFC_BOOT_DTB) FORCE
+	$(MAKE) -C $(RZG2_PFC_BOOT_DIR) rzg2PfcBootGen
+	$(RZG2_PFC_BOOT_DIR)/rzg2PfcBootGen $(RZG2_PFC_BOOT_DTB) $@.new
+	if cmp -s $@.new $@; then $(RM) $@.new; else mv -f $@.new $@; fi
+
+sysLib.o: rzg2PfcBootProg.c
+
+FORCE:
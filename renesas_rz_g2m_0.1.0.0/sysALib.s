@@ -32,6 +32,7 @@
 /*
 modification history
 --------------------
+19oct26,agt added the system suspend CPU context save and resume entry
 17sep19,hli created (VXWPG-394)
 */
 
@@ -49,6 +50,12 @@ sysInit() masks interrupts in the processor and the interrupt
 controller and sets the initial stack pointer.  Other hardware and
 device initialization is performed later in the sysHwInit function in
 sysLib.c.
+
+For 64-bit VxWorks, this module also contains the CPU side of system
+suspend to RAM: sysCpuCtxSave(), which saves the CPU context before the
+PSCI SYSTEM_SUSPEND call, and sysResume(), the entry point at which the
+firmware resumes the boot core.  sysSuspend() in sysLib.c passes both to
+rzg2SystemSuspend().
 */
 
 #define _ASMLANGUAGE
@@ -130,6 +137,33 @@ sysLib.c.
 
 #define CPACR_EL1_FPEN_NO_INST_TRAPPED  (0x3 << 20)
 
+/* CPU context saved for system suspend, byte offsets in sysCpuCtx */
+
+#define CTX_X19                         0x00    /* X19 to X30 */
+#define CTX_SP                          0x60
+#define CTX_D8                          0x68    /* D8 to D15 */
+#define CTX_SP_EL1                      0xA8
+#define CTX_SCTLR_EL1                   0xB0
+#define CTX_TCR_EL1                     0xB8
+#define CTX_TTBR0_EL1                   0xC0
+#define CTX_TTBR1_EL1                   0xC8
+#define CTX_MAIR_EL1                    0xD0
+#define CTX_VBAR_EL1                    0xD8
+#define CTX_CPACR_EL1                   0xE0
+#define CTX_CONTEXTIDR_EL1              0xE8
+#define CTX_TPIDR_EL1                   0xF0
+#define CTX_TPIDR_EL0                   0xF8
+#define CTX_TPIDRRO_EL0                 0x100
+#define CTX_CNTKCTL_EL1                 0x108
+#define CTX_CNTV_CTL_EL0                0x110
+#define CTX_CNTV_CVAL_EL0               0x118
+#define CTX_CNTP_CTL_EL0                0x120
+#define CTX_CNTP_CVAL_EL0               0x128
+#define CTX_FPCR                        0x130
+#define CTX_FPSR                        0x138
+#define CTX_SIZE                        0x140   /* five cache lines */
+#define CTX_CACHE_LINE                  64
+
 #define SCR_EL3_DEFAULT                 (SCR_EL3_RIQ  |             \
                                          SCR_EL3_RES1 |             \
                                          SCR_EL3_SMD  |             \
@@ -223,6 +257,10 @@ sysLib.c.
         FUNC_EXPORT (armWarmReboot)
 #endif /* _WRS_CONFIG_LP64 */
         FUNC_EXPORT (sysInitSecondary)
+#ifdef _WRS_CONFIG_LP64
+        FUNC_EXPORT (sysCpuCtxSave)
+        FUNC_EXPORT (sysResume)
+#endif /* _WRS_CONFIG_LP64 */
 
 #ifdef DEBUG
         FUNC_EXPORT (sysInitConsolePrint)
@@ -803,3 +841,262 @@ L$_GIC_CPU_PriMask:
         .word   0
 
 FUNC_END (sysInit)
+
+#ifdef _WRS_CONFIG_LP64
+
+/*******************************************************************************
+*
+* sysCpuCtxSave - save the CPU context for system suspend
+*
+* This function saves, in sysCpuCtx, the registers that a C function must
+* preserve, the stack pointers, and the EL1 system, thread ID and generic timer
+* registers, and cleans the saved context to the point of coherency, so that
+* sysResume() can read it with the caches off. It is passed to
+* rzg2SystemSuspend() by sysSuspend(), and is called with interrupts locked,
+* just before the PSCI SYSTEM_SUSPEND call. <contextId> is not used.
+*
+* SYNOPSIS
+* \ss
+* int sysCpuCtxSave
+*     (
+*     ULONG contextId   /@ argument passed to the resume code @/
+*     )
+* \se
+*
+* RETURNS: 0 when the context is saved, and 1 when sysResume() restores it.
+*
+* ERRNO: N/A
+*/
+
+FUNC_LABEL (sysCpuCtxSave)
+        LDR     X1, =sysCpuCtx
+
+        STP     X19, X20, [X1, #CTX_X19]
+        STP     X21, X22, [X1, #CTX_X19 + 0x10]
+        STP     X23, X24, [X1, #CTX_X19 + 0x20]
+        STP     X25, X26, [X1, #CTX_X19 + 0x30]
+        STP     X27, X28, [X1, #CTX_X19 + 0x40]
+        STP     X29, X30, [X1, #CTX_X19 + 0x50]
+        MOV     X2, SP
+        STR     X2, [X1, #CTX_SP]
+        STP     D8, D9, [X1, #CTX_D8]
+        STP     D10, D11, [X1, #CTX_D8 + 0x10]
+        STP     D12, D13, [X1, #CTX_D8 + 0x20]
+        STP     D14, D15, [X1, #CTX_D8 + 0x30]
+
+        /* the kernel runs on SP_EL0, SP_EL1 is the exception stack */
+
+        MSR     SPSel, #1
+        MOV     X2, SP
+        MSR     SPSel, #0
+        STR     X2, [X1, #CTX_SP_EL1]
+
+        MRS     X2, SCTLR_EL1
+        STR     X2, [X1, #CTX_SCTLR_EL1]
+        MRS     X2, TCR_EL1
+        STR     X2, [X1, #CTX_TCR_EL1]
+        MRS     X2, TTBR0_EL1
+        STR     X2, [X1, #CTX_TTBR0_EL1]
+        MRS     X2, TTBR1_EL1
+        STR     X2, [X1, #CTX_TTBR1_EL1]
+        MRS     X2, MAIR_EL1
+        STR     X2, [X1, #CTX_MAIR_EL1]
+        MRS     X2, VBAR_EL1
+        STR     X2, [X1, #CTX_VBAR_EL1]
+        MRS     X2, CPACR_EL1
+        STR     X2, [X1, #CTX_CPACR_EL1]
+        MRS     X2, CONTEXTIDR_EL1
+        STR     X2, [X1, #CTX_CONTEXTIDR_EL1]
+        MRS     X2, TPIDR_EL1
+        STR     X2, [X1, #CTX_TPIDR_EL1]
+        MRS     X2, TPIDR_EL0
+        STR     X2, [X1, #CTX_TPIDR_EL0]
+        MRS     X2, TPIDRRO_EL0
+        STR     X2, [X1, #CTX_TPIDRRO_EL0]
+        MRS     X2, CNTKCTL_EL1
+        STR     X2, [X1, #CTX_CNTKCTL_EL1]
+        MRS     X2, CNTV_CTL_EL0
+        STR     X2, [X1, #CTX_CNTV_CTL_EL0]
+        MRS     X2, CNTV_CVAL_EL0
+        STR     X2, [X1, #CTX_CNTV_CVAL_EL0]
+        MRS     X2, CNTP_CTL_EL0
+        STR     X2, [X1, #CTX_CNTP_CTL_EL0]
+        MRS     X2, CNTP_CVAL_EL0
+        STR     X2, [X1, #CTX_CNTP_CVAL_EL0]
+        MRS     X2, FPCR
+        STR     X2, [X1, #CTX_FPCR]
+        MRS     X2, FPSR
+        STR     X2, [X1, #CTX_FPSR]
+
+        /* clean the context to the point of coherency */
+
+        ADD     X2, X1, #CTX_SIZE
+1:
+        DC      CVAC, X1
+        ADD     X1, X1, #CTX_CACHE_LINE
+        CMP     X1, X2
+        B.LO    1b
+        DSB     SY
+
+        MOV     X0, #0
+        RET
+
+FUNC_END (sysCpuCtxSave)
+
+/*******************************************************************************
+*
+* sysResume - resume from system suspend
+*
+* This function is the entry point, at its physical address, at which the
+* firmware resumes the boot core after a PSCI SYSTEM_SUSPEND call, with the MMU
+* and caches off, in EL2 or EL1. It drops to EL1 as sysInit() does, runs the
+* early CPU and MMU initialization of sysInit() on the boot stack to map the
+* kernel image again, then switches to the kernel translation tables and
+* restores the context saved by sysCpuCtxSave(), which returns 1.
+*
+* NOTE: This function should not be called by the user.
+*
+* RETURNS: N/A
+*
+* sysResume ()              /@ THIS IS NOT A CALLABLE ROUTINE @/
+*
+*/
+
+FUNC_LABEL (sysResume)
+        MRS     X0, CurrentEL
+        CMP     X0, #2<<2               /* is this exception level EL2? */
+        BNE     1f
+
+        MRS     X1, CNTHCTL_EL2
+        ORR     X1, X1, #(CNTHCTL_EL2_EL1PCTEN | CNTHCTL_EL2_EL1PCEN)
+        MSR     CNTHCTL_EL2, X1         /* CNTHCTL_EL2 */
+        MSR     CNTVOFF_EL2, XZR        /* CNTVOFF_EL2 */
+
+        MRS     X1, MIDR_EL1
+        MRS     X2, MPIDR_EL1
+        MSR     VPIDR_EL2, X1           /* VPIDR_EL2 */
+        MSR     VMPIDR_EL2, X2          /* VMPIDR_EL2 */
+
+        MOV     X1, #(CPTR_EL2_RES1)
+        MSR     CPTR_EL2, X1            /* CPTR_EL2 */
+        MSR     HSTR_EL2, XZR           /* HSTR_EL2 */
+
+        MOV     X1, #(HCR_EL2_RW)
+        ORR     X1, X1, #(HCR_EL2_HCD)
+        MSR     HCR_EL2, X1             /* HCR_EL2 */
+
+        MOV     X1, #(SCTLR_EL1_RES1&0xffff)
+        MOVK    X1, #((SCTLR_EL1_RES1>>16)&0xffff), lsl #16
+        MSR     SCTLR_EL1, X1           /* SCTLR_EL1 */
+
+        MOV     X1, #(SPSR_EL2_DEFAULT)
+        MSR     SPSR_EL2, X1            /* SPSR_EL2 */
+
+        ADR     X7, 1f
+        MSR     ELR_EL2, X7
+        ERET                            /* to EL1 */
+
+1:
+        /* EL1, reuse the boot stack below sysInit() */
+
+        ADR     X1, sysInit
+        MSR     SPSel, #0
+        MOV     SP, X1
+        MOV     X29, #0
+
+        MOV     X1, #(CPACR_EL1_FPEN_NO_INST_TRAPPED)
+        MSR     CPACR_EL1, X1
+
+        BL      vxCpuInit
+
+        LDR     X0, =STATIC_MMU_TABLE_BASE
+        LDR     X1, =LOCAL_MEM_LOCAL_ADRS
+        LDR     X2, =IMA_SIZE
+        BL      vxMmuEarlyInit
+
+        /* continue at the kernel virtual address */
+
+        LDR     X0, =sysResumeVirt
+        BR      X0
+
+sysResumeVirt:
+        LDR     X1, =sysCpuCtx
+
+        /* switch to the kernel translation tables */
+
+        LDR     X2, [X1, #CTX_MAIR_EL1]
+        MSR     MAIR_EL1, X2
+        LDR     X2, [X1, #CTX_TCR_EL1]
+        MSR     TCR_EL1, X2
+        LDR     X2, [X1, #CTX_TTBR0_EL1]
+        MSR     TTBR0_EL1, X2
+        LDR     X2, [X1, #CTX_TTBR1_EL1]
+        MSR     TTBR1_EL1, X2
+        ISB
+        TLBI    VMALLE1
+        DSB     SY
+        ISB
+
+        LDR     X2, [X1, #CTX_SCTLR_EL1]
+        MSR     SCTLR_EL1, X2
+        LDR     X2, [X1, #CTX_VBAR_EL1]
+        MSR     VBAR_EL1, X2
+        LDR     X2, [X1, #CTX_CPACR_EL1]
+        MSR     CPACR_EL1, X2
+        LDR     X2, [X1, #CTX_CONTEXTIDR_EL1]
+        MSR     CONTEXTIDR_EL1, X2
+        LDR     X2, [X1, #CTX_TPIDR_EL1]
+        MSR     TPIDR_EL1, X2
+        LDR     X2, [X1, #CTX_TPIDR_EL0]
+        MSR     TPIDR_EL0, X2
+        LDR     X2, [X1, #CTX_TPIDRRO_EL0]
+        MSR     TPIDRRO_EL0, X2
+        LDR     X2, [X1, #CTX_CNTKCTL_EL1]
+        MSR     CNTKCTL_EL1, X2
+        LDR     X2, [X1, #CTX_CNTV_CVAL_EL0]
+        MSR     CNTV_CVAL_EL0, X2
+        LDR     X2, [X1, #CTX_CNTV_CTL_EL0]
+        MSR     CNTV_CTL_EL0, X2
+        LDR     X2, [X1, #CTX_CNTP_CVAL_EL0]
+        MSR     CNTP_CVAL_EL0, X2
+        LDR     X2, [X1, #CTX_CNTP_CTL_EL0]
+        MSR     CNTP_CTL_EL0, X2
+        ISB
+
+        LDR     X2, [X1, #CTX_FPCR]
+        MSR     FPCR, X2
+        LDR     X2, [X1, #CTX_FPSR]
+        MSR     FPSR, X2
+
+        LDR     X2, [X1, #CTX_SP_EL1]
+        MSR     SPSel, #1
+        MOV     SP, X2
+        MSR     SPSel, #0
+        LDR     X2, [X1, #CTX_SP]
+        MOV     SP, X2
+
+        LDP     D8, D9, [X1, #CTX_D8]
+        LDP     D10, D11, [X1, #CTX_D8 + 0x10]
+        LDP     D12, D13, [X1, #CTX_D8 + 0x20]
+        LDP     D14, D15, [X1, #CTX_D8 + 0x30]
+        LDP     X19, X20, [X1, #CTX_X19]
+        LDP     X21, X22, [X1, #CTX_X19 + 0x10]
+        LDP     X23, X24, [X1, #CTX_X19 + 0x20]
+        LDP     X25, X26, [X1, #CTX_X19 + 0x30]
+        LDP     X27, X28, [X1, #CTX_X19 + 0x40]
+        LDP     X29, X30, [X1, #CTX_X19 + 0x50]
+
+        /* return from sysCpuCtxSave() a second time */
+
+        MOV     X0, #1
+        RET
+
+FUNC_END (sysResume)
+
+        .data
+        .balign CTX_CACHE_LINE
+
+sysCpuCtx:
+        .fill   CTX_SIZE, 1, 0
+
+#endif /* _WRS_CONFIG_LP64 */
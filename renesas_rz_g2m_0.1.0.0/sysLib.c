@@ -32,6 +32,8 @@
 /*
 modification history
 --------------------
+19oct26,agt  set the generated PFC boot program
+19oct26,agt  added sysSuspend()
 17sep19,hli  created (VXWPG-394)
 */
 
@@ -39,6 +41,16 @@ modification history
 DESCRIPTION
 This library provides board-specific functions for Renesas RZ/G2 processors.
 
+For 64-bit VxWorks, sysSuspend() suspends the board to RAM through
+rzg2SystemSuspend(), with the CPU context save routine and resume entry point
+of sysALib.s. The devices must be quiesced first, and an SMP image must be
+configured for one CPU.
+
+If RZG2_PFC_BOOT_PROG is TRUE, the board initialisation passes the PFC boot
+program rzg2PfcBootProg.c to rzg2PfcBootProgSet() before the devices attach.
+The file is generated by the build rules from the compiled device tree, so the
+pins of all the enabled devices are set when the PFC attaches.
+
 INCLUDE FILES:
 
 SEE ALSO:
@@ -52,13 +64,27 @@ SEE ALSO:
 #include <boardLib.h>
 #include <prjParams.h>
 #include <vxFdtCpu.h>
+#include <vmLib.h>
 
 #include <rzg2Lib.h>
 
+#if (RZG2_PFC_BOOT_PROG == TRUE)
+#include <vxbFdtRsRzg2PfcPinMux.h>
+
+/* generated from the compiled device tree, see rules.bsp.mk */
+
+#include "rzg2PfcBootProg.c"
+#endif /* RZG2_PFC_BOOT_PROG == TRUE */
+
 /* externs */
 
 IMPORT void cpuArmVerShow (void);
 
+#ifdef _WRS_CONFIG_LP64
+IMPORT int  sysCpuCtxSave (ULONG contextId);
+IMPORT void sysResume (void);
+#endif /* _WRS_CONFIG_LP64 */
+
 /* globals */
 
 /*
@@ -78,6 +104,8 @@ const VIRT_ADDR sysCpuStartAddr = (VIRT_ADDR)(LOCAL_MEM_LOCAL_ADRS +
 
 /* locals */
 
+LOCAL void   sysBoardInit      (void);
+
 #ifdef INCLUDE_SHOW_ROUTINES
 LOCAL void   rzg2BoardInfoShow (void);
 LOCAL char * rzg2CpuRevGet     (void);
@@ -89,7 +117,7 @@ LOCAL char * rzg2CpuNameGet    (void);
 LOCAL BOARD_FUNC_TBL rzg2FuncTbl =
     {
     /* .earlyInit  = */ rzg2EarlyInit,
-    /* .init       = */ rzg2Init,
+    /* .init       = */ sysBoardInit,
     /* .reset      = */ rzg2Reset,
     /* .model      = */ rzg2ModelGet,
     /* .usDelay    = */ rzg2UsDelay,
@@ -128,6 +156,58 @@ LOCAL BOARD_DESC renesasRzg2 =
 
 BOARD_DEF (renesasRzg2)
 
+/*******************************************************************************
+*
+* sysBoardInit - initialise the board
+*
+* This function sets the PFC boot program, if it is configured, then calls
+* rzg2Init().
+*
+* RETURNS: N/A.
+*
+* ERRNO: N/A.
+*/
+
+LOCAL void sysBoardInit (void)
+    {
+#if (RZG2_PFC_BOOT_PROG == TRUE)
+    rzg2PfcBootProgSet (rzg2PfcBootWrites,
+                        (UINT32) NELEMENTS (rzg2PfcBootWrites));
+#endif /* RZG2_PFC_BOOT_PROG == TRUE */
+
+    rzg2Init ();
+    }
+
+#ifdef _WRS_CONFIG_LP64
+
+/*******************************************************************************
+*
+* sysSuspend - suspend the board to RAM
+*
+* This function suspends the board with rzg2SystemSuspend(), which saves the
+* RZ/G2 driver contexts and makes the PSCI SYSTEM_SUSPEND call. The CPU context
+* is saved by sysCpuCtxSave(), and the firmware resumes the board at the
+* physical address of sysResume(). The function returns after resume.
+*
+* RETURNS: OK after resume, or ERROR if the board cannot be suspended.
+*
+* ERRNO: N/A.
+*/
+
+STATUS sysSuspend (void)
+    {
+    PHYS_ADDR resumeEntry;
+
+    if (vmTranslate (NULL, (VIRT_ADDR)sysResume, &resumeEntry) == ERROR)
+        {
+        return ERROR;
+        }
+
+    return rzg2SystemSuspend (sysCpuCtxSave, resumeEntry, 0);
+    }
+
+#endif /* _WRS_CONFIG_LP64 */
+
 #ifdef INCLUDE_SHOW_ROUTINES
 
 /*******************************************************************************